@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace engine {
+
+class World;
+
+/**
+ * @brief Benchmarks of engine subsystems, run by the TidalBench executable
+ *
+ * Each one works on chunks, players or files of its own (at most copying
+ * chunks out of the World it is given), so none of them touch a running
+ * server. Results are logged.
+ */
+namespace bench {
+
+/**
+ * @brief Time lighting of copies of the chunks around spawn, then single block edits
+ * @param world World to copy the chunks from (they are loaded if missing)
+ * @param columnRadius Radius in columns around spawn to copy
+ * @param editCount Number of block place/break relights to time
+ */
+void runLightBenchmark(World& world, int32_t columnRadius, size_t editCount);
+
+/**
+ * @brief Time swept player moves against copies of the chunks around spawn
+ *
+ * Runs on the calling thread, so the rate is per core.
+ * @param world World to copy the chunks from (they are loaded if missing)
+ * @param columnRadius Radius in columns around spawn to copy
+ * @param moveCount Number of moves to time
+ */
+void runCollisionBenchmark(World& world, int32_t columnRadius, size_t moveCount);
+
+/**
+ * @brief Time block-reach raycasts against copies of the chunks around spawn
+ *
+ * Casts the rays one at a time and as one Raycaster::castMany() batch
+ * (grouped by origin, like validating every player's actions in a tick).
+ * Runs on the calling thread, so the rates are per core.
+ * @param world World to copy the chunks from (they are loaded if missing)
+ * @param columnRadius Radius in columns around spawn to copy
+ * @param rayCount Number of rays to time
+ */
+void runRaycastBenchmark(World& world, int32_t columnRadius, size_t rayCount);
+
+/**
+ * @brief Time a sand slab collapsing onto a floor
+ *
+ * The slab starts 32 blocks up, so every column falls that far. Times
+ * the simulation steps and the relighting of their changes separately.
+ * @param width Slab width and length in blocks
+ * @param depth Slab thickness in blocks
+ */
+void runFallingBlockBenchmark(int32_t width, int32_t depth);
+
+/**
+ * @brief Time scheduling, cancelling, firing and chunk drops on a BlockTickScheduler
+ * @param timerCount Number of ticks to schedule
+ */
+void runBlockTickBenchmark(size_t timerCount);
+
+/**
+ * @brief Time a block-heavy region task with 1 worker up to one per core
+ *
+ * Checks that every worker count leaves the same blocks behind.
+ * @param regionSpan Width and length of the area in regions
+ * @param tickCount Ticks to time per worker count
+ */
+void runRegionTickBenchmark(int32_t regionSpan, int32_t tickCount);
+
+/**
+ * @brief Time the per-tick player loops over synthetic players, hash map vs PlayerStore
+ *
+ * Runs movement fan-out, block change interest checks, chunk retention
+ * position collection and a save pass over playerCount players, once
+ * with players in a map keyed by peer holding whole player records (the
+ * previous layout), once in a PlayerStore, and once more in the store
+ * sending only to players in view through its spatial grid.
+ */
+void runPlayerLoopBenchmark(size_t playerCount, size_t tickCount);
+
+/**
+ * @brief Time a join storm's profile loads, one file per player vs PlayerProfileStore
+ *
+ * Writes playerCount profiles to a temporary directory in both formats,
+ * then loads them all, once with blocking per-file reads (the previous
+ * path, which ran on the tick thread) and once by queueing loads on a
+ * PlayerProfileStore. Reports the time the calling thread is held up
+ * and the time until every profile is available.
+ * @param tickBudgetMs Server tick length to compare against
+ */
+void runProfileLoadBenchmark(size_t playerCount, double tickBudgetMs);
+
+/**
+ * @brief Time client chunk meshing with and without ambient occlusion
+ *
+ * Meshes generated rough terrain (hills over caves) through
+ * ChunkMesh::generateMesh(), alternating the two modes each round.
+ * @param columnSpan Width and length of the terrain in chunk columns
+ * @param rounds Times each chunk is meshed in each mode
+ */
+void runMeshBenchmark(int32_t columnSpan, uint32_t rounds);
+
+} // namespace bench
+
+} // namespace engine
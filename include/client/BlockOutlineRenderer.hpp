@@ -6,7 +6,7 @@
 #include <vector>
 #include <array>
 #include <string>
-#include "client/Raycaster.hpp"
+#include "shared/Raycaster.hpp"
 
 namespace engine {
 
@@ -4,6 +4,7 @@
 #include "vulkan/Vertex.hpp"
 #include <vector>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <functional>
 
 namespace engine {
@@ -15,7 +16,11 @@ class TextureAtlas;
  * @brief Generates renderable mesh from chunk block data
  *
  * Uses greedy meshing algorithm to minimize vertex count by merging
- * adjacent faces of the same block type into larger quads.
+ * adjacent faces of the same block type into larger quads. Each face is
+ * shaded by the light of the block in front of it, baked into the vertex
+ * color, and darkened at each corner by ambient occlusion from the opaque
+ * blocks around that corner. Only faces with equal light and equal corner
+ * occlusion merge.
  */
 class ChunkMesh {
 public:
@@ -31,6 +36,7 @@ public:
      * @param neighborPosY Neighboring chunk in +Y direction (optional, for cross-chunk culling)
      * @param neighborNegZ Neighboring chunk in -Z direction (optional, for cross-chunk culling)
      * @param neighborPosZ Neighboring chunk in +Z direction (optional, for cross-chunk culling)
+     * @param ambientOcclusion Compute per-corner ambient occlusion (false leaves every corner unoccluded)
      * @return Number of vertices generated
      */
     static size_t generateMesh(const Chunk& chunk,
@@ -42,18 +48,22 @@ public:
                               const Chunk* neighborNegY = nullptr,
                               const Chunk* neighborPosY = nullptr,
                               const Chunk* neighborNegZ = nullptr,
-                              const Chunk* neighborPosZ = nullptr);
+                              const Chunk* neighborPosZ = nullptr,
+                              bool ambientOcclusion = true);
 
     /**
-     * @brief Get color tint for a block type (used for vertex colors alongside textures)
+     * @brief Get color tint for a block face (used for vertex colors alongside textures)
      * @param type Block type to get color for
-     * @param normal Face normal direction (used for grass top face detection)
+     * @param face Face being drawn (tints can apply to some faces only)
      */
-    static glm::vec3 getBlockColor(BlockType type, const glm::vec3& normal);
+    static glm::vec3 getBlockColor(BlockType type, BlockFace face);
 
 private:
     /**
      * @brief Add a quad face to the mesh
+     * @param occlusion Ambient occlusion of the four corners, 2 bits each
+     *        (0 = darkest, 3 = open), in vertex order: origin, +tangent,
+     *        +tangent+bitangent, +bitangent
      */
     static void addQuad(std::vector<Vertex>& vertices,
                        std::vector<uint32_t>& indices,
@@ -62,6 +72,8 @@ private:
                        const glm::vec3& normal,
                        const glm::vec3& color,
                        BlockType blockType,
+                       BlockFace face,
+                       uint8_t occlusion,
                        const TextureAtlas* atlas);
 };
 
@@ -3,10 +3,17 @@
 #include "shared/Protocol.hpp"
 #include "shared/Chunk.hpp"
 #include "shared/ChunkCoord.hpp"
+#include "shared/ColumnHeightmap.hpp"
+#include "shared/LightEngine.hpp"
+#include "shared/NetworkStats.hpp"
+#include "client/SnapshotInterpolator.hpp"
 
 #include <enet/enet.h>
+#include <chrono>
+#include <deque>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <functional>
 
@@ -57,19 +64,41 @@ public:
 
     /**
      * @brief Send player movement to server
+     *
+     * Sent unreliably with an input sequence number when the server negotiated
+     * CAPABILITY_UNRELIABLE_MOVEMENT, reliably otherwise.
      */
     void sendPlayerMove(const glm::vec3& position, const glm::vec3& velocity, float yaw, float pitch);
 
+    /**
+     * @brief Get minimum time between movement updates in seconds
+     *
+     * Defaults to DEFAULT_MOVE_SEND_INTERVAL and follows MoveRateHint messages
+     * from servers that negotiated CAPABILITY_UNRELIABLE_MOVEMENT.
+     */
+    float getMoveSendInterval() const { return moveSendInterval; }
+
     /**
      * @brief Send block placement request
+     *
+     * The block is placed locally right away and recorded as a predicted edit.
+     * It is rolled back if the server answers with a different block or
+     * doesn't answer within PREDICTION_TIMEOUT.
      */
     void sendBlockPlace(int32_t x, int32_t y, int32_t z, uint16_t blockType);  // NOLINT(readability-identifier-length)
 
     /**
      * @brief Send block break request
+     *
+     * Predicted locally the same way as sendBlockPlace().
      */
     void sendBlockBreak(int32_t x, int32_t y, int32_t z);  // NOLINT(readability-identifier-length)
 
+    /**
+     * @brief Get number of block edits still waiting for server confirmation
+     */
+    size_t getPendingPredictionCount() const { return predictedEdits.size(); }
+
     /**
      * @brief Send inventory update to server for persistence
      */
@@ -86,6 +115,19 @@ public:
      */
     const std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>>& getChunks() const { return chunks; }
 
+    /**
+     * @brief Get the heightmap of a chunk column (nullptr if no section of it is loaded)
+     */
+    const ColumnHeightmap* getColumnHeightmap(int32_t chunkX, int32_t chunkZ) const;
+
+    /**
+     * @brief Check if a loaded chunk is known to be entirely air
+     *
+     * Empty sections need no mesh, and their arrival doesn't change any
+     * neighbour's faces (a missing neighbour is already treated as air).
+     */
+    bool isSectionEmpty(const ChunkCoord& coord) const;
+
     /**
      * @brief Set callback for when new chunk is received
      */
@@ -93,6 +135,16 @@ public:
         onChunkReceived = std::move(callback);
     }
 
+    /**
+     * @brief Set callback for when a batch of sections of one column is received
+     *
+     * Called with the column's chunk X/Z and the levels that arrived, once
+     * per ChunkColumnData. Without it, onChunkReceived is called per section.
+     */
+    void setOnColumnReceived(std::function<void(int32_t, int32_t, const std::vector<int32_t>&)> callback) {
+        onColumnReceived = std::move(callback);
+    }
+
     /**
      * @brief Set callback for when chunk is unloaded
      */
@@ -100,6 +152,29 @@ public:
         onChunkUnloaded = std::move(callback);
     }
 
+    /**
+     * @brief Set callback for when a single block changes (predicted, corrected or server update)
+     *
+     * Receives the world position of the block, so the caller can remesh the
+     * owning chunk with priority instead of queueing it behind chunk streaming.
+     * When set, block updates no longer go through the chunk received callback.
+     */
+    void setOnBlockChanged(std::function<void(const glm::ivec3&)> callback) {
+        onBlockChanged = std::move(callback);
+    }
+
+    /**
+     * @brief Set callback for when a chunk's lighting changes without its blocks changing
+     *
+     * Called after relighting for every loaded, non-empty chunk whose faces
+     * are shaded differently (light spreading across borders or from a block
+     * edit next door). Chunks already reported through the received or block
+     * changed callbacks for the same update are left out.
+     */
+    void setOnChunkLightChanged(std::function<void(const ChunkCoord&)> callback) {
+        onChunkLightChanged = std::move(callback);
+    }
+
     /**
      * @brief Set callback for when inventory sync is received from server
      */
@@ -107,6 +182,17 @@ public:
         onInventorySync = std::move(callback);
     }
 
+    /**
+     * @brief Set callback for when the server resolved one of our moves differently
+     *
+     * Receives the position the server put the player at and the movement
+     * of each move sent after that one, oldest first, so the caller can
+     * replay them from the corrected position (CAPABILITY_MOVE_CORRECTION).
+     */
+    void setOnMoveCorrected(std::function<void(const glm::vec3&, const std::vector<glm::vec3>&)> callback) {
+        onMoveCorrected = std::move(callback);
+    }
+
     /**
      * @brief Get all other players' positions
      */
@@ -118,21 +204,169 @@ public:
 
     const std::unordered_map<uint32_t, PlayerData>& getOtherPlayers() const { return otherPlayers; }
 
+    /**
+     * @brief Set how far in the past remote players are rendered
+     *
+     * Should cover at least one server update interval plus typical jitter.
+     * Players whose updates carry a longer move interval (CAPABILITY_POSITION_INTERVAL)
+     * are rendered MOVE_INTERVAL_DELAY_FACTOR of their interval in the past instead.
+     * @param seconds Minimum interpolation delay in seconds
+     */
+    void setInterpolationDelay(float seconds) { interpolationDelay = seconds; }
+
+    /**
+     * @brief Set how long remote players keep moving after updates stop
+     * @param seconds Maximum extrapolation time in seconds
+     */
+    void setMaxExtrapolation(float seconds) { maxExtrapolation = seconds; }
+
+    /**
+     * @brief Get traffic counters, RTT and bandwidth for the server connection
+     */
+    const NetworkStats& getNetworkStats() const { return netStats; }
+
+    /**
+     * @brief Get the "host:port" string of the server we connected to
+     */
+    const std::string& getServerAddress() const { return serverAddress; }
+
+    /**
+     * @brief Get capability bits negotiated with the server
+     *
+     * Falls back to protocol::LEGACY_CAPABILITIES until the server replies,
+     * and stays there when talking to a server that predates negotiation.
+     */
+    uint32_t getCapabilities() const { return capabilities; }
+
+    /**
+     * @brief Check if an optional protocol feature was negotiated
+     */
+    bool hasCapability(uint32_t capability) const { return (capabilities & capability) != 0; }
+
 private:
     ENetHost* client = nullptr;
     ENetPeer* serverPeer = nullptr;
     bool connected = false;
+    uint32_t capabilities = protocol::LEGACY_CAPABILITIES;  ///< Negotiated protocol::CAPABILITY_* bits
+    std::string serverAddress;  ///< "host:port" of the current server
+
+    // Movement
+    static constexpr float DEFAULT_MOVE_SEND_INTERVAL = 0.1f;  ///< Seconds between moves until the server hints otherwise
+    float moveSendInterval = DEFAULT_MOVE_SEND_INTERVAL;  ///< Current movement send interval in seconds
+    uint32_t inputSequence = 0;  ///< Sequence number of the last sent PlayerMove
+    uint32_t appliedCorrection = 0;  ///< Input sequence of the last PlayerCorrection applied (0 = none)
+
+    /**
+     * @brief A sequenced move the server may still correct
+     */
+    struct SentMove {
+        uint32_t sequence = 0;    ///< Input sequence it was sent with
+        glm::vec3 position{0.0f}; ///< Position it reported
+    };
+
+    static constexpr size_t MAX_SENT_MOVES = 64;  ///< Moves kept for replay (over 3 s at the fastest send rate)
+    std::deque<SentMove> sentMoves;               ///< Moves since the last correction, oldest first
+
+    // Telemetry
+    static constexpr float KEEPALIVE_INTERVAL = 1.0f;  ///< Seconds between RTT pings
+    NetworkStats netStats;
+    std::chrono::steady_clock::time_point lastKeepAlive;  ///< When the last ping was sent
 
     // Received chunks from server
     std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>> chunks;
+    std::unordered_map<ChunkCoord, ColumnHeightmap> columns;  ///< Keyed by (chunkX, 0, chunkZ)
+    std::shared_ptr<ChunkBlocks> emptySectionBlocks;          ///< All-air buffer shared by every empty section
+    LightEngine lightEngine;                                  ///< Lights received chunks and local edits
+    std::unordered_set<ChunkCoord> lightChanged;              ///< Relight output scratch
+
+    /**
+     * @brief Drop all chunks and column heightmaps
+     */
+    void clearChunks();
+
+    /**
+     * @brief Find loaded sections of a column for ColumnHeightmap rescans
+     */
+    ColumnHeightmap::SectionLookup sectionLookup(int32_t chunkX, int32_t chunkZ) const;
+
+    /**
+     * @brief Run queued lighting and report chunks whose shading changed
+     * @param notified Chunks the caller remeshes anyway (not reported again)
+     */
+    void relight(const std::unordered_set<ChunkCoord>& notified);
 
     // Other players
-    std::unordered_map<uint32_t, PlayerData> otherPlayers;  ///< Player ID -> Player data (position, yaw, pitch)
+    std::unordered_map<uint32_t, PlayerData> otherPlayers;  ///< Player ID -> interpolated render state
+    std::unordered_map<uint32_t, SnapshotInterpolator> playerSnapshots;  ///< Player ID -> received snapshots
+    std::unordered_map<uint32_t, float> playerMoveIntervals;  ///< Player ID -> its reported move interval (seconds)
+    static constexpr float MOVE_INTERVAL_DELAY_FACTOR = 1.5f;  ///< Remote players are rendered at least this many of their move intervals in the past
+    float interpolationDelay = 0.1f;  ///< Render remote players at least this far in the past (seconds)
+    float maxExtrapolation = 0.25f;   ///< Extrapolation limit past the newest snapshot (seconds)
+    std::chrono::steady_clock::time_point clockStart = std::chrono::steady_clock::now();  ///< Epoch for snapshot times
+
+    // Block edit prediction
+    static constexpr float PREDICTION_TIMEOUT = 2.0f;  ///< Seconds before an unconfirmed edit is rolled back
+
+    /**
+     * @brief A locally applied block edit awaiting server confirmation
+     */
+    struct PredictedEdit {
+        glm::ivec3 position;                              ///< World block position
+        BlockType previousType = BlockType::Air;          ///< Block before the edit (rollback target)
+        BlockType predictedType = BlockType::Air;         ///< Block the client expects the server to confirm
+        std::chrono::steady_clock::time_point sentTime;   ///< When the request was sent
+    };
+
+    std::deque<PredictedEdit> predictedEdits;  ///< Oldest first (same order the server processes them)
 
     // Callbacks
     std::function<void(const ChunkCoord&)> onChunkReceived;
+    std::function<void(int32_t, int32_t, const std::vector<int32_t>&)> onColumnReceived;
     std::function<void(const ChunkCoord&)> onChunkUnloaded;
     std::function<void(const ItemStack[9], uint32_t, const glm::vec3&, float, float)> onInventorySync;
+    std::function<void(const glm::ivec3&)> onBlockChanged;
+    std::function<void(const ChunkCoord&)> onChunkLightChanged;
+    std::function<void(const glm::vec3&, const std::vector<glm::vec3>&)> onMoveCorrected;
+
+    /**
+     * @brief Set a block in the local chunk cache
+     * @param position World block position
+     * @param type New block type
+     * @param outPrevious Receives the block type that was replaced
+     * @param relightNow Run lighting before returning (false: the caller calls relight())
+     * @return false if the owning chunk isn't loaded
+     */
+    bool setLocalBlock(const glm::ivec3& position, BlockType type, BlockType& outPrevious, bool relightNow = true);
+
+    /**
+     * @brief Apply a block edit locally and remember it for reconciliation
+     */
+    void predictBlockEdit(const glm::ivec3& position, BlockType type);
+
+    /**
+     * @brief Restore the oldest pending prediction at a position and drop all predictions there
+     */
+    void rollbackPrediction(const glm::ivec3& position);
+
+    /**
+     * @brief Roll back predictions the server never answered
+     */
+    void expirePredictions();
+
+    /**
+     * @brief Notify the renderer that a block changed
+     */
+    void notifyBlockChanged(const glm::ivec3& position);
+
+    /**
+     * @brief Get seconds elapsed on the local snapshot clock
+     */
+    double snapshotTime() const;
+
+    /**
+     * @brief Resample every remote player's snapshot buffer at the current render time
+     */
+    void updateRemotePlayers();
 
     /**
      * @brief Handle received packet from server
@@ -144,6 +378,17 @@ private:
      */
     void handleChunkData(const uint8_t* data, size_t size);
 
+    /**
+     * @brief Handle chunk column message (several sections plus the column heightmap)
+     */
+    void handleChunkColumnData(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Decode a ChunkData/ChunkColumnData section payload with the negotiated codec
+     * @return false if the payload is corrupted
+     */
+    bool decodeChunkPayload(const uint8_t* data, size_t size, Chunk& outChunk);
+
     /**
      * @brief Handle chunk unload message
      */
@@ -151,13 +396,38 @@ private:
 
     /**
      * @brief Handle block update message
+     * @param batched Part of a BlockUpdateBatch: skip relighting and notifying (the batch does both once)
+     * @return true if the local block changed
+     */
+    bool handleBlockUpdate(const protocol::BlockUpdateMessage& msg, bool batched = false);
+
+    /**
+     * @brief Handle a batch of block updates, relighting once and notifying each chunk border once
+     */
+    void handleBlockUpdateBatch(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Send a KeepAlive ping if KEEPALIVE_INTERVAL has passed
+     */
+    void sendKeepAliveIfDue();
+
+    /**
+     * @brief Handle a KeepAlive ping (echo it) or echo (record RTT) from the server
+     */
+    void handleKeepAlive(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Hand a PlayerCorrection and the moves to replay to the callback
      */
-    void handleBlockUpdate(const protocol::BlockUpdateMessage& msg);
+    void handleMoveCorrection(const protocol::PlayerCorrectionMessage& msg);
 
     /**
      * @brief Send a message to server
+     * @param channel ENet channel (0 = game state, 1 = latency-sensitive unreliable traffic)
+     * @param flags ENet packet flags (reliable by default)
      */
-    void sendMessage(protocol::MessageType type, const void* data, size_t size);
+    void sendMessage(protocol::MessageType type, const void* data, size_t size,
+                     uint8_t channel = 0, uint32_t flags = ENET_PACKET_FLAG_RELIABLE);
 };
 
 } // namespace engine
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+
+namespace engine {
+
+/**
+ * @brief A single timestamped state sample for a remote player
+ */
+struct PlayerSnapshot {
+    double time = 0.0;          ///< Local receive time in seconds
+    glm::vec3 position{0.0f};   ///< Player position in world coordinates
+    float yaw = 0.0f;           ///< Camera yaw angle in degrees
+    float pitch = 0.0f;         ///< Camera pitch angle in degrees
+};
+
+/**
+ * @brief Fixed-size snapshot buffer with render-time interpolation
+ *
+ * Stores the most recent position updates for one remote player and samples
+ * them at a time slightly in the past, so the renderer always has two known
+ * states to blend between. When updates stop arriving the last known motion
+ * is extrapolated for a bounded time before the player is held in place.
+ */
+class SnapshotInterpolator {
+public:
+    static constexpr size_t CAPACITY = 32;  ///< Snapshots kept per player (~3s at 10 Hz)
+
+    /**
+     * @brief Add a new snapshot
+     *
+     * Snapshots older than the newest stored one are dropped, so reordered
+     * unreliable packets can never move a player backwards.
+     * @param snapshot Snapshot to add
+     */
+    void push(const PlayerSnapshot& snapshot);
+
+    /**
+     * @brief Sample the buffer at a given render time
+     * @param renderTime Time to sample at (usually now minus interpolation delay)
+     * @param maxExtrapolation Maximum time in seconds to extrapolate past the newest snapshot
+     * @param outSnapshot Interpolated state
+     * @return false if the buffer is empty
+     */
+    bool sample(double renderTime, double maxExtrapolation, PlayerSnapshot& outSnapshot) const;
+
+    /**
+     * @brief Drop all snapshots
+     */
+    void clear() { count = 0; }
+
+    /**
+     * @brief Check if no snapshots have been received
+     */
+    bool empty() const { return count == 0; }
+
+private:
+    std::array<PlayerSnapshot, CAPACITY> snapshots{};
+    size_t head = 0;   ///< Index of the oldest snapshot
+    size_t count = 0;  ///< Number of valid snapshots
+
+    /**
+     * @brief Get snapshot by age order (0 = oldest)
+     */
+    const PlayerSnapshot& at(size_t index) const { return snapshots[(head + index) % CAPACITY]; }
+
+    /**
+     * @brief Blend two snapshots, taking the shortest path for angles
+     */
+    static PlayerSnapshot blend(const PlayerSnapshot& from, const PlayerSnapshot& to, float alpha);
+};
+
+} // namespace engine
@@ -2,8 +2,8 @@
 
 #include <vulkan/vulkan.h>
 #include <glm/glm.hpp>
+#include <array>
 #include <string>
-#include <unordered_map>
 #include "shared/Block.hpp"
 
 namespace engine {
@@ -46,11 +46,11 @@ public:
     void loadTextures(const std::string& texturePath);
 
     /**
-     * @brief Get UV coordinates for a specific block type
-     * @param type Block type
+     * @brief Get UV coordinates of a texture in the atlas
+     * @param texture Texture (see BlockRegistry::getFaceTexture)
      * @return vec4 containing (u_min, v_min, u_max, v_max)
      */
-    glm::vec4 getBlockUVs(BlockType type) const;
+    glm::vec4 getTextureUVs(BlockTexture texture) const;
 
     /**
      * @brief Get the texture atlas image view
@@ -120,7 +120,7 @@ private:
     VkImageView textureImageView = VK_NULL_HANDLE;      ///< Image view for texture sampling
     VkSampler textureSampler = VK_NULL_HANDLE;          ///< Sampler for texture filtering
 
-    std::unordered_map<BlockType, glm::vec4> blockUVs;  ///< Map block type to UV coordinates in atlas
+    std::array<glm::vec4, BLOCK_TEXTURE_COUNT> textureUVs{};  ///< UV coordinates in the atlas, indexed by BlockTexture
 
     uint32_t atlasWidth = 0;        ///< Total atlas width in pixels
     uint32_t atlasHeight = 0;       ///< Total atlas height in pixels
@@ -8,7 +8,7 @@
 #include "vulkan/Vertex.hpp"
 #include "core/EngineConfig.hpp"
 #include "core/PerformanceMetrics.hpp"
-#include "client/Raycaster.hpp"
+#include "shared/Raycaster.hpp"
 #include "shared/Chunk.hpp"
 #include "shared/ChunkCoord.hpp"
 
@@ -20,6 +20,7 @@
 #include <queue>
 #include <mutex>
 #include <future>
+#include <unordered_map>
 
 namespace engine {
 
@@ -40,6 +41,7 @@ class HotbarUI;
 class CreativeMenu;
 class Console;
 class PlayerCubeRenderer;
+class CollisionResolver;
 
 /**
  * @brief Uniform buffer object for shader uniforms
@@ -108,6 +110,7 @@ private:
     std::unique_ptr<CreativeMenu> creativeMenu;
     std::unique_ptr<Console> console;
     std::unique_ptr<PlayerCubeRenderer> playerCubeRenderer;
+    std::unique_ptr<CollisionResolver> collision;  ///< Stops camera movement at solid blocks in received chunks
 
     EngineConfig::Runtime config;
     PerformanceMetrics performanceMetrics;
@@ -125,6 +128,9 @@ private:
     // Position update throttling
     std::chrono::steady_clock::time_point lastPositionUpdate;
     glm::vec3 lastSentPosition;
+    float lastSentYaw = 0.0f;
+    float lastSentPitch = 0.0f;
+    static constexpr float MOVE_HEARTBEAT_INTERVAL = 1.0f;  // seconds between moves when standing still
 
     // Block breaking state
     std::chrono::steady_clock::time_point lastBlockBreak;
@@ -145,6 +151,7 @@ private:
     // Async chunk loading
     struct PendingChunk {
         ChunkCoord coord{0, 0, 0};
+        uint64_t revision = 0;  // meshRevisions value when queued
         std::shared_ptr<Chunk> chunk;  // Use shared_ptr to avoid stack overflow
         std::shared_ptr<Chunk> neighborNegX;
         std::shared_ptr<Chunk> neighborPosX;
@@ -156,18 +163,24 @@ private:
 
     struct CompletedMesh {
         ChunkCoord coord;
+        uint64_t revision = 0;
         std::vector<Vertex> vertices;
         std::vector<uint32_t> indices;
     };
 
-    std::queue<PendingChunk> pendingChunks;
+    std::queue<std::vector<PendingChunk>> pendingChunks;  // Mesh jobs; a column arrives as one batch
     std::queue<CompletedMesh> completedMeshes;
     std::mutex pendingChunksMutex;
     std::mutex completedMeshesMutex;
     std::vector<std::future<void>> meshGenerationTasks;
+    std::unordered_map<ChunkCoord, uint64_t> meshRevisions;  // Latest mesh request per chunk (main thread only)
 
-    static constexpr size_t MAX_CHUNKS_PER_FRAME = 10;
+    static constexpr size_t MAX_MESH_JOBS_PER_FRAME = 10;
 
+    bool makePendingChunk(const ChunkCoord& coord, PendingChunk& outPending);
+    void queueChunkMesh(const ChunkCoord& coord);
+    void queueColumnMesh(int32_t chunkX, int32_t chunkZ, const std::vector<int32_t>& levels);
+    void remeshChunkNow(const ChunkCoord& coord);
     void processPendingChunks();
     void uploadCompletedMeshes();
 
@@ -27,6 +27,10 @@ struct EngineConfig {
     static constexpr float DEFAULT_CAMERA_SPEED = 2.5f;         ///< Default camera movement speed (units/second)
     static constexpr float DEFAULT_MOUSE_SENSITIVITY = 0.1f;    ///< Default mouse look sensitivity
 
+    // Network settings
+    static constexpr float DEFAULT_INTERPOLATION_DELAY = 0.1f;  ///< Remote players are rendered this far in the past (seconds)
+    static constexpr float DEFAULT_MAX_EXTRAPOLATION = 0.25f;   ///< Max time to extrapolate remote players past the last update (seconds)
+
     // Vulkan settings
     static constexpr const char* ENGINE_NAME = "Tidal Engine";  ///< Engine name for Vulkan application info
     static constexpr uint32_t ENGINE_VERSION_MAJOR = 0;         ///< Engine major version number
@@ -48,6 +52,8 @@ struct EngineConfig {
         float fov = FOV_DEGREES;                                ///< Field of view in degrees
         float cameraSpeed = DEFAULT_CAMERA_SPEED;               ///< Camera movement speed (units/second)
         float mouseSensitivity = DEFAULT_MOUSE_SENSITIVITY;     ///< Mouse look sensitivity multiplier
+        float interpolationDelay = DEFAULT_INTERPOLATION_DELAY; ///< Remote player interpolation delay (seconds)
+        float maxExtrapolation = DEFAULT_MAX_EXTRAPOLATION;     ///< Remote player extrapolation limit (seconds)
     };
 };
 
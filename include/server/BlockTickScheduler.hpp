@@ -0,0 +1,186 @@
+#pragma once
+
+#include "shared/Block.hpp"
+#include "shared/Chunk.hpp"
+#include "shared/ChunkCoord.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace engine {
+
+/**
+ * @brief A scheduled block tick that came due
+ */
+struct BlockTick {
+    glm::ivec3 position;  ///< World block position
+    BlockType type;       ///< Block type the tick was scheduled for
+};
+
+/**
+ * @brief A pending block tick as stored with its chunk
+ */
+struct SavedBlockTick {
+    uint16_t localIndex = 0;          ///< Chunk::getIndex() of the block
+    BlockType type = BlockType::Air;  ///< Block type the tick was scheduled for
+    uint32_t delay = 0;               ///< Ticks left when saved
+};
+
+/**
+ * @brief Handle to a scheduled block tick, for BlockTickScheduler::cancel()
+ */
+struct BlockTickHandle {
+    uint32_t index = std::numeric_limits<uint32_t>::max();  ///< Timer slot (max = none)
+    uint32_t generation = 0;                                ///< Timer reuse count when scheduled
+
+    bool isValid() const { return index != std::numeric_limits<uint32_t>::max(); }
+};
+
+/**
+ * @brief Delayed per-block work (growth, fluids, ...) on a hierarchical timing wheel
+ *
+ * Timers live in LEVEL_COUNT wheels of SLOT_COUNT slots. Level 0 has one
+ * slot per tick; each level above covers SLOT_COUNT times the span of the
+ * one below. A timer goes into the lowest level whose span reaches its due
+ * tick, and is moved down a level when the wheel below wraps around to it,
+ * so scheduling, cancelling and firing are O(1) and advance() only touches
+ * the timers that come due (plus occasional cascades). Nothing is scanned
+ * while no timers are pending.
+ *
+ * Every timer is also linked into a list for its chunk, so the timers of a
+ * chunk can be saved with it and dropped when it unloads in time
+ * proportional to that chunk's timers. saveChunk()/appendSaved() write them
+ * relative to the current tick, and restoreChunk() re-schedules them when
+ * the chunk loads again.
+ *
+ * Not thread-safe: call from the thread that owns the chunks.
+ */
+class BlockTickScheduler {
+public:
+    static constexpr uint32_t SLOT_BITS = 6;
+    static constexpr uint32_t SLOT_COUNT = 1u << SLOT_BITS;  ///< Slots per wheel level
+    static constexpr uint32_t LEVEL_COUNT = 4;               ///< Wheel levels
+    static constexpr uint32_t MAX_DELAY = (1u << (SLOT_BITS * LEVEL_COUNT)) - 1;  ///< Longer delays are clamped (~4.8 days at 40 TPS)
+
+    /**
+     * @brief Scheduler counters
+     */
+    struct Stats {
+        uint64_t scheduled = 0;  ///< Timers scheduled (including restored ones)
+        uint64_t cancelled = 0;  ///< Timers cancelled
+        uint64_t fired = 0;      ///< Timers that came due
+        uint64_t cascaded = 0;   ///< Timers moved down a wheel level
+        uint64_t dropped = 0;    ///< Timers dropped with their chunk
+    };
+
+    BlockTickScheduler();
+
+    /**
+     * @brief Schedule a tick for a block
+     * @param worldPos World block position
+     * @param type Block type the tick is for (the caller skips it if the block changed)
+     * @param delay Ticks from now, clamped to [1, MAX_DELAY]
+     */
+    BlockTickHandle schedule(const glm::ivec3& worldPos, BlockType type, uint32_t delay);
+
+    /**
+     * @brief Cancel a scheduled tick
+     * @return false if it already fired, was cancelled or was dropped with its chunk
+     */
+    bool cancel(BlockTickHandle handle);
+
+    /**
+     * @brief Move to the next tick
+     * @param outDue Receives the ticks that came due (appended)
+     */
+    void advance(std::vector<BlockTick>& outDue);
+
+    /**
+     * @brief Copy a chunk's pending ticks, with delays relative to the current tick
+     * @param outSaved Receives the ticks (appended)
+     */
+    void saveChunk(const ChunkCoord& coord, std::vector<SavedBlockTick>& outSaved) const;
+
+    /**
+     * @brief Drop every pending tick of a chunk (when it unloads)
+     * @return Number of ticks dropped
+     */
+    size_t dropChunk(const ChunkCoord& coord);
+
+    /**
+     * @brief Re-schedule ticks saved with a chunk (when it loads)
+     */
+    void restoreChunk(const ChunkCoord& coord, const std::vector<SavedBlockTick>& saved);
+
+    /**
+     * @brief Append saved ticks to serialized chunk data (nothing if there are none)
+     */
+    static void appendSaved(const std::vector<SavedBlockTick>& saved, std::vector<uint8_t>& data);
+
+    /**
+     * @brief Remove the saved ticks appended to serialized chunk data
+     * @param data Chunk file contents; the ticks are cut off the end
+     * @param outSaved Receives the ticks (cleared first)
+     * @return false if the data carries no ticks (left unchanged)
+     */
+    static bool extractSaved(std::vector<uint8_t>& data, std::vector<SavedBlockTick>& outSaved);
+
+    uint64_t getCurrentTick() const { return currentTick; }
+    size_t getPendingCount() const { return pendingCount; }
+    size_t getChunkCount() const { return chunkHeads.size(); }
+    const Stats& getStats() const { return stats; }
+
+private:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t SLOT_MASK = SLOT_COUNT - 1;
+
+    /**
+     * @brief Scheduled tick, linked into a wheel slot and its chunk's list
+     */
+    struct Timer {
+        glm::ivec3 position{0};
+        uint64_t due = 0;                 ///< Tick it fires on
+        BlockType type = BlockType::Air;
+        uint32_t generation = 0;          ///< Bumped on release, so stale handles don't match
+        uint32_t slot = NONE;             ///< level * SLOT_COUNT + slot index (NONE = free)
+        uint32_t slotPrev = NONE;
+        uint32_t slotNext = NONE;
+        uint32_t chunkPrev = NONE;
+        uint32_t chunkNext = NONE;
+    };
+
+    std::vector<Timer> timers;                                 ///< Timer pool, indexed by handle
+    std::vector<uint32_t> freeTimers;                          ///< Released pool entries
+    std::array<uint32_t, LEVEL_COUNT * SLOT_COUNT> slotHeads;  ///< First timer of each wheel slot
+    std::unordered_map<ChunkCoord, uint32_t> chunkHeads;       ///< First timer of each chunk with ticks
+    uint64_t currentTick = 0;                                  ///< Last tick advance() reached
+    size_t pendingCount = 0;
+    Stats stats;
+
+    static ChunkCoord chunkOf(const glm::ivec3& worldPos);
+
+    /**
+     * @brief Put a timer into the wheel slot for its due tick
+     */
+    void insertIntoWheel(uint32_t index);
+
+    void unlinkFromSlot(uint32_t index);
+    void linkIntoChunk(uint32_t index);
+    void unlinkFromChunk(uint32_t index);
+
+    /**
+     * @brief Return a timer to the pool, invalidating its handles
+     */
+    void release(uint32_t index);
+
+    /**
+     * @brief Re-insert every timer of a higher-level slot one level down (or lower)
+     */
+    void cascade(uint32_t slot);
+};
+
+} // namespace engine
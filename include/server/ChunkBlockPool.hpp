@@ -0,0 +1,51 @@
+#pragma once
+
+#include "shared/Chunk.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace engine {
+
+/**
+ * @brief Content-addressed pool that lets identical chunks share one block buffer
+ *
+ * Generated terrain is mostly byte-identical (every untouched stone, surface
+ * or air chunk), so chunks are interned by a hash of their blocks. A match
+ * is confirmed with a full compare before the buffer is shared, and the
+ * chunk's copy-on-write takes a private copy again on its first edit.
+ *
+ * The pool holds weak references only: a buffer is freed when the last
+ * chunk using it is unloaded or edited. Not thread-safe; World calls it
+ * with chunksMutex held.
+ */
+class ChunkBlockPool {
+public:
+    /**
+     * @brief Share an identical pooled buffer with the chunk, or pool the chunk's own buffer
+     * @param chunk Chunk to intern
+     * @return true if the chunk now shares an existing buffer
+     */
+    bool intern(Chunk& chunk);
+
+    /**
+     * @brief Drop entries whose buffers are no longer used by any chunk
+     */
+    void prune();
+
+    /**
+     * @brief Get number of pool entries (live or not yet pruned)
+     */
+    size_t getEntryCount() const { return entries.size(); }
+
+private:
+    std::unordered_multimap<uint64_t, std::weak_ptr<ChunkBlocks>> entries;  ///< Content hash -> buffer
+
+    /**
+     * @brief Hash block contents (64-bit FNV-1a over 8-byte words)
+     */
+    static uint64_t hashBlocks(const ChunkBlocks& blocks);
+};
+
+} // namespace engine
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "shared/ChunkCoord.hpp"
+#include "shared/ChunkOffsetTable.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+/**
+ * @brief Fixed-size toroidal record of which chunks a player has received
+ *
+ * Covers a circle of chunk columns (XZ radius) around the player's chunk,
+ * with a fixed band of vertical levels. Storage is a bitset over a
+ * (2r+1) x (2r+1) x levels grid addressed by coordinate modulo the window
+ * size, so a column keeps the same bit while it stays in view and the bit
+ * is reused when the window scrolls past it.
+ *
+ * Recentering walks only the rows whose extent changed and emits the
+ * chunks leaving the circle. A one-chunk step costs O(radius) and never
+ * hashes or allocates (the caller's output vector is reused).
+ *
+ * Chunks still to send are found by walking the shared ChunkOffsetTable's
+ * columns from a cursor, nearest column first and, within a column, the
+ * levels nearest the center's level first. A column's sections go out
+ * together so tall worlds stream whole columns.
+ *
+ * Moving the center doesn't restart the walk. If it had finished, the
+ * columns entering the view are queued by their rank in the table and
+ * drained first. If it hadn't, the cursor steps back only as far as the
+ * step could have brought unsent columns nearer. Jumps of more than half
+ * the radius restart the walk.
+ */
+class ChunkViewWindow {
+public:
+    /**
+     * @brief Create a window
+     * @param radius View radius in chunks (XZ, Euclidean)
+     * @param minChunkY Lowest chunk Y level in view
+     * @param maxChunkY Highest chunk Y level in view
+     */
+    ChunkViewWindow(int32_t radius, int32_t minChunkY, int32_t maxChunkY);
+
+    /**
+     * @brief Move the window to a new center chunk
+     *
+     * Chunks leaving the view that were marked sent are cleared and reported
+     * in outLeaving. The XZ part of the center selects the view; Y (clamped
+     * to the level band) only affects the order nextUnsent() returns levels in.
+     * @param center New center chunk
+     * @param outLeaving Cleared, then filled with sent chunks now out of view
+     */
+    void recenter(const ChunkCoord& center, std::vector<ChunkCoord>& outLeaving);
+
+    /**
+     * @brief Check if recenter(coord) would change anything
+     */
+    bool isCenteredOn(const ChunkCoord& coord) const {
+        return centered && coord.x == center.x && coord.z == center.z && clampLevel(coord.y) == center.y;
+    }
+
+    /**
+     * @brief Get the next chunk in view that has not been sent yet
+     *
+     * Nearest column first, then the column's levels nearest the center first.
+     * Advances the send cursor past the returned chunk, so the caller is
+     * expected to send it and call markSent().
+     * @param outCoord Set to the chunk to send
+     * @return false if every chunk in view has been sent
+     */
+    bool nextUnsent(ChunkCoord& outCoord);
+
+    /**
+     * @brief Get every unsent level of the next column that has any
+     *
+     * Same walk as nextUnsent(), but takes a whole column at once and moves
+     * the cursor past it. Levels come back nearest the center first. The
+     * caller is expected to send them and call markSent() for each.
+     * @param outX Set to the column's chunk X
+     * @param outZ Set to the column's chunk Z
+     * @param outLevels Cleared, then filled with the column's unsent levels
+     * @return false if every chunk in view has been sent
+     */
+    bool nextUnsentColumn(int32_t& outX, int32_t& outZ, std::vector<int32_t>& outLevels);
+
+    /**
+     * @brief Forget the center and all sent chunks
+     */
+    void reset();
+
+    /**
+     * @brief Check if a chunk is inside the current view
+     */
+    bool contains(const ChunkCoord& coord) const;
+
+    /**
+     * @brief Check if a chunk in view was marked sent
+     */
+    bool isSent(const ChunkCoord& coord) const;
+
+    /**
+     * @brief Mark a chunk in view as sent (ignored if out of view)
+     */
+    void markSent(const ChunkCoord& coord);
+
+    /**
+     * @brief Get number of chunks marked sent
+     */
+    size_t getSentCount() const { return sentCount; }
+
+    /**
+     * @brief Get number of chunks in view that have not been sent yet
+     */
+    size_t getPendingCount() const { return centered ? getChunkCount() - sentCount : 0; }
+
+    /**
+     * @brief Get number of chunks the view covers
+     */
+    size_t getChunkCount() const {
+        return offsetTable->getColumns().size() * static_cast<size_t>(maxChunkY - minChunkY + 1);
+    }
+
+    /**
+     * @brief Check if recenter() has been called since construction/reset
+     */
+    bool hasCenter() const { return centered; }
+
+    /**
+     * @brief Get current center chunk (Y clamped to the level band)
+     */
+    const ChunkCoord& getCenter() const { return center; }
+
+    /**
+     * @brief Get view radius in chunks
+     */
+    int32_t getRadius() const { return radius; }
+
+private:
+    int32_t radius;
+    int32_t size;       ///< Window side length (2 * radius + 1)
+    int32_t minChunkY;
+    int32_t maxChunkY;
+
+    const ChunkOffsetTable* offsetTable;  ///< Shared circle and nearest-first column order
+    std::vector<uint64_t> sentBits;       ///< Toroidal bitset, one bit per chunk in the window
+    std::vector<int32_t> levelOrder;      ///< Band levels nearest center.y first
+
+    ChunkCoord center{0, 0, 0};
+    bool centered = false;
+    size_t sentCount = 0;
+    size_t sendCursor = 0;   ///< Index into offsetTable->getColumns() where nextUnsent() resumes
+    size_t levelCursor = 0;  ///< Index into levelOrder within the current column
+
+    /**
+     * @brief A column queued by recenter(), with its rank in the table around the center
+     */
+    struct QueuedColumn {
+        uint32_t rank = 0;
+        int32_t chunkX = 0;
+        int32_t chunkZ = 0;
+    };
+
+    std::vector<QueuedColumn> queuedColumns;  ///< Columns to walk before the cursor, by rank (reused)
+    size_t queueHead = 0;                     ///< Index into queuedColumns of the current column
+
+    int32_t clampLevel(int32_t chunkY) const { return std::clamp(chunkY, minChunkY, maxChunkY); }
+
+    /**
+     * @brief Get the column the send walk is on (the queue first, then the cursor)
+     * @return false if the walk has finished
+     */
+    bool currentColumn(int32_t& outX, int32_t& outZ) const;
+
+    /**
+     * @brief Move the send walk to the next column
+     */
+    void advanceColumn();
+
+    /**
+     * @brief Keep the send walk valid across a step of the center to target
+     *
+     * Called after the leaving pass, before center is updated.
+     */
+    void carrySendWalk(const ChunkCoord& target);
+
+    /**
+     * @brief Get X extent of the view row at world chunk Z around a center
+     * @return false if the row is outside the view
+     */
+    bool rowExtent(const ChunkCoord& rowCenter, int32_t chunkZ, int32_t& outMinX, int32_t& outMaxX) const;
+
+    /**
+     * @brief Get bit index for a chunk (toroidal wrap)
+     */
+    size_t bitIndex(int32_t chunkX, int32_t chunkY, int32_t chunkZ) const;
+
+    bool testBit(size_t index) const { return (sentBits[index / 64] >> (index % 64)) & 1u; }
+    void setBit(size_t index) { sentBits[index / 64] |= (uint64_t{1} << (index % 64)); }
+    void clearBit(size_t index) { sentBits[index / 64] &= ~(uint64_t{1} << (index % 64)); }
+};
+
+} // namespace engine
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "shared/Block.hpp"
+#include "shared/Chunk.hpp"
+#include "shared/ChunkCoord.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace engine {
+
+/**
+ * @brief A block changed by the server itself rather than by a player edit
+ */
+struct BlockChange {
+    glm::ivec3 position;  ///< World block position
+    BlockType type;       ///< Block type after the change
+    BlockType previous;   ///< Block type before the change
+};
+
+/**
+ * @brief Gravity for blocks like sand (BlockRegistry::hasGravity()), simulated over an active set
+ *
+ * Only positions that may hold an unsupported block are tracked. They are
+ * queued by block edits (the edited block and the one above it) and by
+ * chunk loads (gravity blocks resting on air in the chunk, or on its top
+ * layer from the chunk above). Each step() checks the queued positions
+ * bottom-up: a gravity block with air below drops one block, carrying the
+ * gravity blocks stacked on it along as one column, and its new position
+ * is queued for the next step. Supported blocks leave the set, so an idle
+ * world costs nothing and a collapse costs per falling column, never a
+ * chunk scan.
+ *
+ * A block resting on an unloaded chunk (including below the world's
+ * height range) counts as supported; loading the chunk below checks it
+ * again.
+ *
+ * Not thread-safe: call from the thread that owns the chunks.
+ */
+class FallingBlockSimulator {
+public:
+    /**
+     * @brief Finds a loaded chunk (nullptr if not loaded)
+     */
+    using ChunkLookup = std::function<Chunk*(const ChunkCoord&)>;
+
+    /**
+     * @brief Simulation counters
+     */
+    struct Stats {
+        uint64_t steps = 0;             ///< step() calls that had work
+        uint64_t checked = 0;           ///< Queued positions checked
+        uint64_t moves = 0;             ///< Columns moved down one block
+        uint64_t chunkScans = 0;        ///< Loaded chunks scanned for unsupported blocks
+        uint64_t stepMicrosTotal = 0;   ///< Total time spent in step()
+        uint64_t stepMicrosMax = 0;     ///< Slowest step()
+    };
+
+    explicit FallingBlockSimulator(ChunkLookup lookup);
+
+    /**
+     * @brief Queue checks around a block that changed (the block itself and the one above)
+     */
+    void enqueueEdit(const glm::ivec3& worldPos);
+
+    /**
+     * @brief Queue a scan of a newly loaded chunk for unsupported gravity blocks
+     */
+    void enqueueChunk(const ChunkCoord& coord);
+
+    /**
+     * @brief Check if any positions or chunks are queued
+     */
+    bool hasPending() const { return !active.empty() || !loadedChunks.empty(); }
+
+    /**
+     * @brief Get the number of positions queued for the next step
+     */
+    size_t getActiveCount() const { return active.size(); }
+
+    /**
+     * @brief Drop every unsupported queued block by one block
+     * @param outChanges Receives every block changed (appended)
+     */
+    void step(std::vector<BlockChange>& outChanges);
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    ChunkLookup lookup;
+    std::vector<glm::ivec3> active;          ///< Positions to check next step
+    std::unordered_set<uint64_t> activeKeys; ///< packPosition() of every entry in active
+    std::vector<ChunkCoord> loadedChunks;    ///< Chunks to scan next step
+    std::vector<glm::ivec3> checking;        ///< Positions being checked (reused between steps)
+    std::vector<BlockType> column;           ///< Column being dropped, bottom first (reused)
+    Stats stats;
+
+    /// Last chunk looked up during the current step; chunks can't load or unload mid-step
+    ChunkCoord lastCoord{};
+    Chunk* lastChunk = nullptr;
+    bool hasLast = false;
+
+    /**
+     * @brief Pack a world position into a set key (x and z: 24 bits, y: 16 bits)
+     */
+    static uint64_t packPosition(const glm::ivec3& worldPos);
+
+    /**
+     * @brief Queue one position (ignored if already queued)
+     */
+    void enqueue(const glm::ivec3& worldPos);
+
+    /**
+     * @brief Find the loaded chunk holding a block
+     * @param outLocal Receives the block's local coordinates
+     * @return nullptr if the chunk is not loaded
+     */
+    Chunk* findChunk(const glm::ivec3& worldPos, glm::ivec3& outLocal);
+
+    /**
+     * @brief Get a block type (outLoaded false and Air if its chunk is not loaded)
+     */
+    BlockType getBlockType(const glm::ivec3& worldPos, bool& outLoaded);
+
+    /**
+     * @brief Set a block and record the change
+     */
+    void setBlockType(const glm::ivec3& worldPos, BlockType type, BlockType previous,
+                      std::vector<BlockChange>& outChanges);
+
+    /**
+     * @brief Queue the unsupported gravity blocks of a chunk and of the bottom layer of the chunk above
+     */
+    void scanChunk(const ChunkCoord& coord);
+
+    /**
+     * @brief Move a gravity block and the gravity blocks stacked on it down one block
+     * @param bottom Lowest block of the column (the block below it is air)
+     */
+    void dropColumn(const glm::ivec3& bottom, std::vector<BlockChange>& outChanges);
+};
+
+} // namespace engine
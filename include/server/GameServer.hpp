@@ -3,19 +3,23 @@
 #include <enet/enet.h>
 #include <memory>
 #include <atomic>
-#include <array>
 #include <cstdint>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
 #include <glm/glm.hpp>
 #include "shared/ChunkCoord.hpp"
-#include "shared/Item.hpp"
+#include "shared/NetworkStats.hpp"
+#include "server/ChunkViewWindow.hpp"
+#include "server/PlayerProfileStore.hpp"
+#include "server/PlayerStore.hpp"
+#include "server/WorldSettings.hpp"
 
 namespace engine {
 
 // Forward declarations
 class World;
+class Chunk;
+struct BlockChange;
 
 /**
  * @brief Main game server class
@@ -25,12 +29,16 @@ class World;
  */
 class GameServer {
 public:
+    static constexpr int32_t CHUNK_LOAD_RADIUS = 10;  ///< Radius to load chunks around player (10 chunks = 160 blocks)
+    static constexpr float INTEREST_RADIUS = (CHUNK_LOAD_RADIUS + 1) * 32.0f;  ///< Blocks in X and Z within which a player's view can reach
+
     /**
      * @brief Construct a new game server
      * @param port Port to listen on (default: 25565)
      * @param tickRate Server tick rate in ticks per second (default: 40)
+     * @param worldSettings Options the world is created with
      */
-    GameServer(uint16_t port = 25565, double tickRate = 40.0);
+    GameServer(uint16_t port = 25565, double tickRate = 40.0, const WorldSettings& worldSettings = WorldSettings{});
     ~GameServer();
 
     // Delete copy/move operations (server is unique)
@@ -80,23 +88,30 @@ public:
      */
     World* getWorld() const { return world.get(); }
 
-private:
-    // Player tracking
-    struct PlayerData {
-        uint32_t playerId = 0;                 ///< Unique player ID
-        std::string playerName;                ///< Player's display name
-        glm::vec3 position{0.0f, 5.0f, 0.0f};  ///< Player world position (spawn at Y=5)
-        float yaw = -90.0f;                    ///< Camera yaw angle in degrees
-        float pitch = -20.0f;                  ///< Camera pitch angle in degrees
-        glm::vec3 lastChunkUpdatePos{0.0f, 5.0f, 0.0f};  ///< Last position where chunks were sent
-        std::unordered_set<ChunkCoord> loadedChunks;  ///< Chunks this player has loaded
-        std::array<ItemStack, 9> hotbar;       ///< Player hotbar inventory (9 slots)
-        size_t selectedHotbarSlot = 0;         ///< Currently selected hotbar slot (0-8)
-    };
-
-    std::unordered_map<ENetPeer*, PlayerData> players;  ///< Track all connected players
+    /**
+     * @brief Ask the server thread to log network statistics on its next tick
+     *
+     * Safe to call from the console thread.
+     */
+    void requestNetworkReport() { networkReportRequested = true; }
 
-    static constexpr int32_t CHUNK_LOAD_RADIUS = 10;  ///< Radius to load chunks around player (10 chunks = 160 blocks)
+private:
+    // Network tuning
+    static constexpr uint64_t KEEPALIVE_INTERVAL_TICKS = 10;              ///< Ping every player 4x per second at 40 TPS
+    static constexpr float CHUNK_SEND_RATE_INITIAL = 512.0f * 1024.0f;    ///< Starting chunk budget (bytes/s)
+    static constexpr float CHUNK_SEND_RATE_MIN = 64.0f * 1024.0f;         ///< Budget floor (bytes/s)
+    static constexpr float CHUNK_SEND_RATE_MAX = 8.0f * 1024.0f * 1024.0f; ///< Budget ceiling (bytes/s)
+    static constexpr float QUEUE_DELAY_TARGET_MS = 50.0f;                 ///< RTT above path minimum treated as congestion
+    static constexpr float MOVE_INTERVAL_MIN_MS = 50.0f;                  ///< Fastest movement rate we ask for (20 Hz)
+    static constexpr float MOVE_INTERVAL_MAX_MS = 250.0f;                 ///< Slowest movement rate we ask for (4 Hz)
+    static constexpr float MOVE_CORRECTION_DISTANCE = 0.01f;              ///< Collision corrections larger than this are sent to the mover
+
+    // World simulation
+    static constexpr uint32_t RANDOM_TICKS_PER_CHUNK = 3;                 ///< Blocks picked per loaded chunk per tick for grass spread and decay
+
+    PlayerStore players;  ///< Track all connected players
+    PlayerProfileStore profiles{"players"};       ///< Saved players, read and written off the tick thread
+    std::vector<ProfileLoadResult> profileLoads;  ///< Scratch output of PlayerProfileStore::pollLoads (reused)
 
     ENetHost* server = nullptr;
     std::unique_ptr<World> world;
@@ -109,6 +124,16 @@ private:
     std::atomic<bool> running{false};
 
     size_t lastLoggedChunkCount = 0;  ///< Last chunk count logged (to reduce spam)
+    float tickLoad = 0.0f;            ///< Smoothed fraction of the tick budget spent in tick()
+
+    uint32_t serverCapabilities;  ///< Capability bits this server is willing to negotiate
+
+    std::vector<ChunkCoord> viewLeaving;  ///< Scratch output of ChunkViewWindow::recenter (reused)
+    std::vector<int32_t> columnLevels;    ///< Scratch output of ChunkViewWindow::nextUnsentColumn (reused)
+    std::vector<uint32_t> nearbyPlayers;  ///< Scratch output of findPlayersInView (reused)
+
+    NetworkStats serverNetStats;  ///< Traffic counters across all peers
+    std::atomic<bool> networkReportRequested{false};  ///< Set by requestNetworkReport()
 
     // Player ID generation
     uint32_t nextPlayerId = 1;  ///< Next player ID to assign
@@ -149,13 +174,180 @@ private:
      */
     void onClientPacket(ENetPeer* peer, ENetPacket* packet);
 
+    /**
+     * @brief Negotiate protocol capabilities from a ClientJoin packet
+     *
+     * Stores the result in the peer's capability bits and replies with a
+     * ServerCapabilities message when the client supports negotiation.
+     * @param peer Joining player
+     * @param packet ClientJoin packet (may be a legacy packet without capabilities)
+     */
+    void negotiateCapabilities(ENetPeer* peer, const ENetPacket* packet);
+
+    /**
+     * @brief Send a packet to one peer and record it in the traffic counters
+     * @param peer Destination peer
+     * @param channel ENet channel
+     * @param packet Packet starting with a protocol::MessageHeader (ownership passes to ENet)
+     */
+    void sendPacket(ENetPeer* peer, uint8_t channel, ENetPacket* packet);
+
+    /**
+     * @brief Broadcast a packet to all peers and record it in the traffic counters
+     * @param channel ENet channel
+     * @param packet Packet starting with a protocol::MessageHeader (ownership passes to ENet)
+     */
+    void broadcastPacket(uint8_t channel, ENetPacket* packet);
+
+    /**
+     * @brief Send a KeepAlive ping to every player
+     */
+    void sendKeepAlives();
+
+    /**
+     * @brief Handle a KeepAlive ping or echo from a client
+     */
+    void handleKeepAlive(ENetPeer* peer, const ENetPacket* packet);
+
+    /**
+     * @brief Pick the movement send interval to request from clients
+     *
+     * Scales with player count and tick load, clamped to MOVE_INTERVAL_MIN_MS..MOVE_INTERVAL_MAX_MS.
+     */
+    uint16_t computeMoveIntervalMs() const;
+
+    /**
+     * @brief Send a MoveRateHint to every capable player whose interval changed
+     */
+    void sendMoveRateHints();
+
+    /**
+     * @brief Adjust a player's chunk send budget from its latest RTT estimate
+     *
+     * Delay-based: when smoothed RTT rises more than QUEUE_DELAY_TARGET_MS above
+     * the lowest RTT seen, packets are queueing somewhere on the path and the
+     * budget is cut; otherwise it grows while there is still data to send.
+     */
+    void adaptChunkSendRate(PlayerSession& session);
+
+    /**
+     * @brief Send unsent chunks in view to every player within their per-tick budget
+     */
+    void sendQueuedChunks();
+
+    /**
+     * @brief Serialize and send one chunk with the best codec the player supports
+     * @param capabilities Negotiated protocol::CAPABILITY_* bits of the peer
+     * @return Number of bytes sent
+     */
+    size_t sendChunk(ENetPeer* peer, uint32_t capabilities, const ChunkCoord& coord);
+
+    /**
+     * @brief Send several sections of one column and its heightmap in a single ChunkColumnData packet
+     *
+     * Loads every level of the column so the heightmap covers the whole world height.
+     * @param capabilities Negotiated protocol::CAPABILITY_* bits of the peer
+     * @param levels Sections to include, in send order
+     * @return Number of bytes sent
+     */
+    size_t sendChunkColumn(ENetPeer* peer, uint32_t capabilities, int32_t chunkX, int32_t chunkZ,
+                           const std::vector<int32_t>& levels);
+
+    /**
+     * @brief Encode a section payload in the best codec the player supports
+     *
+     * All-air sections shrink to EMPTY_SECTION_MARKER, otherwise the brick or RLE codec is used.
+     * @param capabilities Negotiated protocol::CAPABILITY_* bits of the peer
+     * @param outBuffer Cleared, then filled with the payload
+     * @return Payload size in bytes
+     */
+    static size_t encodeChunkPayload(const Chunk& chunk, uint32_t capabilities, std::vector<uint8_t>& outBuffer);
+
+    /**
+     * @brief Log traffic, RTT and budget statistics
+     */
+    void logNetworkReport();
+
+    /**
+     * @brief Send the authoritative state of one block to a single player
+     *
+     * Used when a block edit is rejected so the client can roll back its
+     * predicted change immediately instead of waiting for a timeout.
+     * @param peer Player whose edit was rejected
+     * @param worldX Block X coordinate
+     * @param worldY Block Y coordinate
+     * @param worldZ Block Z coordinate
+     */
+    void sendBlockCorrection(ENetPeer* peer, int32_t worldX, int32_t worldY, int32_t worldZ);
+
+    /**
+     * @brief Tell a player where the server resolved their last move (CAPABILITY_MOVE_CORRECTION)
+     * @param index Dense index of the player in players
+     */
+    void sendMoveCorrection(uint32_t index);
+
+    /**
+     * @brief Build a PlayerPositionUpdate packet with a player's current pose
+     * @param index Dense index of the player that moved
+     * @param withInterval Append the player's move interval (for receivers with CAPABILITY_POSITION_INTERVAL)
+     */
+    ENetPacket* createPositionUpdatePacket(uint32_t index, bool withInterval) const;
+
+    /**
+     * @brief Find the players whose view can reach a position
+     *
+     * Looks the players up in the spatial grid within INTEREST_RADIUS in X
+     * and Z (any height), so the cost follows the number of players nearby.
+     * Players that haven't spawned yet (profile still loading) are left out.
+     * @param outIndices Receives dense indices into players (appended)
+     */
+    void findPlayersInView(const glm::vec3& position, std::vector<uint32_t>& outIndices) const;
+
+    /**
+     * @brief Send a packet to every player that has been sent a chunk
+     * @param worldPos Block in the chunk
+     * @param packet Packet starting with a protocol::MessageHeader (copied per player, then destroyed)
+     */
+    void sendToChunkViewers(const glm::ivec3& worldPos, uint8_t channel, ENetPacket* packet);
+
+    /**
+     * @brief Send a player the current pose of every player in its view
+     *
+     * Movement is only fanned out to players in view, so this catches a
+     * player up on the others when its view moves.
+     */
+    void sendNearbyPlayerPositions(uint32_t index);
+
+    /**
+     * @brief Spread grass onto dirt and turn covered grass back into dirt
+     *
+     * Picks RANDOM_TICKS_PER_CHUNK random blocks in every loaded chunk and
+     * runs them through World::tickRegions(), so regions tick in parallel.
+     * Each region draws from its own generator seeded by the tick number
+     * and the region, so the result doesn't depend on the worker count.
+     * Cold chunks are skipped (see World::tickRegions()).
+     * @return Blocks changed, to send to clients
+     */
+    std::vector<BlockChange> tickGrass();
+
+    /**
+     * @brief Send blocks changed by the server (falling blocks, grass) to the players that have their chunks
+     *
+     * Players with CAPABILITY_BLOCK_BATCH get the changes in BlockUpdateBatch
+     * packets, others one BlockUpdate per change.
+     */
+    void broadcastBlockChanges(const std::vector<BlockChange>& changes);
+
     /**
      * @brief Cleanup networking resources
      */
     void cleanupNetworking();
 
     /**
-     * @brief Send chunks in radius around player
+     * @brief Recenter the player's view and unload chunks out of range
+     *
+     * Chunks in view are sent nearest-first by sendQueuedChunks() within the
+     * player's adaptive budget.
      * @param peer Player to send chunks to
      * @param position Player position
      */
@@ -167,19 +359,30 @@ private:
     void updatePlayerChunks();
 
     /**
-     * @brief Save player data to disk
-     * @param playerData Player data to save
-     * @return true if saved successfully
+     * @brief Queue a player's profile for saving on the profile I/O thread
+     * @param index Dense index of the player in players
+     */
+    void savePlayerData(uint32_t index);
+
+    /**
+     * @brief Save every player that joined with a name (autosave and shutdown)
+     * @return Number of players queued for saving
+     */
+    size_t saveAllPlayers();
+
+    /**
+     * @brief Finish the joins whose profile loads have completed
+     *
+     * Applies each loaded profile and sends the spawn, chunks and inventory.
+     * Loads for players that disconnected while waiting are dropped.
      */
-    bool savePlayerData(const PlayerData& playerData);
+    void processProfileLoads();
 
     /**
-     * @brief Load player data from disk
-     * @param playerName Name of player to load
-     * @param outPlayerData Output player data
-     * @return true if loaded successfully
+     * @brief Introduce a player whose profile is applied to the world and to the other players
+     * @param index Dense index of the player in players
      */
-    bool loadPlayerData(const std::string& playerName, PlayerData& outPlayerData);
+    void finishJoin(uint32_t index);
 };
 
 } // namespace engine
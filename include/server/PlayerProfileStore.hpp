@@ -0,0 +1,217 @@
+#pragma once
+
+#include "server/PlayerStore.hpp"
+#include "shared/Item.hpp"
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace engine {
+
+/**
+ * @brief What is saved of a player between sessions
+ */
+struct PlayerProfile {
+    std::string playerName;                ///< Player's display name (the profile key)
+    glm::vec3 position{0.0f};              ///< Last world position
+    float yaw = 0.0f;                      ///< Camera yaw angle in degrees
+    float pitch = 0.0f;                    ///< Camera pitch angle in degrees
+    uint32_t selectedHotbarSlot = 0;       ///< Selected hotbar slot (0-8)
+    std::array<ItemStack, 9> hotbar{};     ///< Hotbar inventory
+};
+
+/**
+ * @brief A finished profile load, handed back to the tick thread
+ */
+struct ProfileLoadResult {
+    PlayerHandle player;      ///< Player the load was requested for (may have left since)
+    std::string playerName;   ///< Name that was looked up
+    bool found = false;       ///< Whether a saved profile existed
+    PlayerProfile profile;    ///< The saved profile (only valid if found)
+};
+
+/**
+ * @brief Player profiles in one append-only log, read and written on a background thread
+ *
+ * Every save appends a checksummed record to <directory>/profiles.log, and
+ * the newest record of a name wins. The I/O thread keeps an index of where
+ * each name's newest record is, so a load is one seek and one read. Saves
+ * queued together are written with a single flush. Once superseded records
+ * make up most of the log, it is rewritten with only the newest records
+ * (also on compact()).
+ *
+ * Loads and saves are queued and run in order on the I/O thread, so a save
+ * followed by a load of the same name sees the save. Finished loads are
+ * collected with pollLoads() on the tick thread, which never waits on the
+ * disk.
+ *
+ * A name with no record in the log falls back to the previous format, one
+ * <name>.dat file per player, and is copied into the log.
+ *
+ * Thread-safe. The destructor writes every queued save before returning.
+ */
+class PlayerProfileStore {
+public:
+    static constexpr uint64_t COMPACT_MIN_BYTES = 64 * 1024;  ///< Logs smaller than this are never compacted
+    static constexpr uint32_t MAX_RECORD_BYTES = 4096;        ///< Larger records are treated as corruption
+
+    /**
+     * @brief Counters since the store was opened
+     */
+    struct Stats {
+        uint64_t loads = 0;          ///< Loads finished (found or not)
+        uint64_t legacyLoads = 0;    ///< Loads served from a <name>.dat file
+        uint64_t saves = 0;          ///< Records appended
+        uint64_t batches = 0;        ///< Queue drains (one flush each)
+        uint64_t compactions = 0;    ///< Times the log was rewritten
+        uint64_t logBytes = 0;       ///< Current log size
+        uint64_t liveBytes = 0;      ///< Bytes of the newest record of each name
+        size_t profileCount = 0;     ///< Names in the log
+    };
+
+    /**
+     * @param directory Directory holding the log (created if missing)
+     */
+    explicit PlayerProfileStore(std::filesystem::path directory);
+    ~PlayerProfileStore();
+
+    PlayerProfileStore(const PlayerProfileStore&) = delete;
+    PlayerProfileStore& operator=(const PlayerProfileStore&) = delete;
+
+    /**
+     * @brief Queue a load of a player's profile (the result comes back through pollLoads())
+     */
+    void requestLoad(PlayerHandle player, const std::string& playerName);
+
+    /**
+     * @brief Queue a save of a profile
+     */
+    void save(PlayerProfile profile);
+
+    /**
+     * @brief Queue a rewrite of the log without superseded records (skipped if there are none)
+     */
+    void compact();
+
+    /**
+     * @brief Wait until everything queued so far has been written
+     */
+    void flush();
+
+    /**
+     * @brief Move the finished loads into a list
+     * @return Number of results appended
+     */
+    size_t pollLoads(std::vector<ProfileLoadResult>& outResults);
+
+    /**
+     * @brief Get the counters (a snapshot as of the last finished batch)
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief Read a profile in the previous one-file-per-player format
+     */
+    static bool readProfileFile(const std::filesystem::path& path, PlayerProfile& outProfile);
+
+    /**
+     * @brief Write a profile in the previous one-file-per-player format
+     */
+    static bool writeProfileFile(const std::filesystem::path& path, const PlayerProfile& profile);
+
+private:
+    /**
+     * @brief A queued operation
+     */
+    struct Request {
+        enum class Kind : uint8_t { Load, Save, Compact };
+        Kind kind = Kind::Load;
+        PlayerHandle player;     ///< Load only
+        PlayerProfile profile;   ///< Name to load, or the profile to save
+    };
+
+    /**
+     * @brief Where the newest record of a name is in the log
+     */
+    struct RecordLocation {
+        uint64_t offset = 0;  ///< Offset of the record header
+        uint32_t size = 0;    ///< Header plus payload bytes
+    };
+
+    std::filesystem::path directory;
+    std::filesystem::path logPath;
+
+    // Shared with the I/O thread
+    mutable std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::condition_variable queueDrained;
+    std::vector<Request> queue;                  ///< Requests not yet taken by the I/O thread
+    std::vector<ProfileLoadResult> finished;     ///< Loads not yet polled
+    bool busy = false;                           ///< The I/O thread is working on a batch
+    bool stopping = false;
+    Stats stats;
+
+    // Owned by the I/O thread
+    std::fstream log;
+    bool logOpen = false;
+    std::unordered_map<std::string, RecordLocation> index;  ///< Newest record of each name
+    uint64_t logBytes = 0;
+    uint64_t liveBytes = 0;
+    std::vector<uint8_t> writeBuffer;                       ///< Records of the current batch not yet written
+    std::vector<uint8_t> recordBuffer;                      ///< Scratch for reading one record
+
+    std::thread worker;  ///< Runs workerLoop()
+
+    /**
+     * @brief Drain the queue in batches until stopped
+     */
+    void workerLoop();
+
+    /**
+     * @brief Open the log (creating it if missing) and index its records
+     *
+     * A torn record at the end (from a crash mid-write) is cut off.
+     */
+    void openLog();
+
+    /**
+     * @brief Queue a record for writing and point the index at it
+     */
+    void appendRecord(const PlayerProfile& profile);
+
+    /**
+     * @brief Write the queued records with one flush
+     */
+    void writePending();
+
+    /**
+     * @brief Look a name up in the log, then in the previous format
+     */
+    ProfileLoadResult load(PlayerHandle player, const std::string& playerName, Stats& batchStats);
+
+    /**
+     * @brief Read the record at a location
+     */
+    bool readRecord(const RecordLocation& location, PlayerProfile& outProfile);
+
+    /**
+     * @brief Read the record at a location into recordBuffer and verify its checksum
+     */
+    bool readRecordBytes(const RecordLocation& location);
+
+    /**
+     * @brief Rewrite the log with only the newest record of each name
+     */
+    void rewriteLog();
+};
+
+} // namespace engine
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "server/ChunkViewWindow.hpp"
+#include "server/SpatialHashGrid.hpp"
+#include "shared/Item.hpp"
+#include "shared/NetworkStats.hpp"
+
+#include <enet/enet.h>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace engine {
+
+/**
+ * @brief Handle to a player in a PlayerStore, stable while dense indices move
+ */
+struct PlayerHandle {
+    uint32_t slot = std::numeric_limits<uint32_t>::max();  ///< Slot in the handle table (max = none)
+    uint32_t generation = 0;                               ///< Slot reuse count when the player was added
+
+    bool isValid() const { return slot != std::numeric_limits<uint32_t>::max(); }
+    bool operator==(const PlayerHandle& other) const = default;
+};
+
+/**
+ * @brief Per-player state the per-tick loops rarely touch
+ */
+struct PlayerSession {
+    std::string playerName;                ///< Player's display name
+    ChunkViewWindow view{0, 0, 0};         ///< Chunks this player has loaded (sized by the server on connect)
+    std::array<ItemStack, 9> hotbar;       ///< Player hotbar inventory (9 slots)
+    size_t selectedHotbarSlot = 0;         ///< Currently selected hotbar slot (0-8)
+    uint32_t clientVersion = 0;            ///< Protocol version reported in ClientJoin
+    NetworkStats netStats;                 ///< Traffic counters and RTT for this peer
+    float chunkSendRate = 0.0f;            ///< Adaptive chunk budget in bytes per second
+    float chunkSendCredit = 0.0f;          ///< Budget carried over between ticks in bytes
+    uint32_t lastInputSequence = 0;        ///< Sequence of the last applied PlayerMove
+    bool hasInputSequence = false;         ///< Whether lastInputSequence is valid yet
+    uint32_t correctionSequence = 0;       ///< Input sequence of the last PlayerCorrection sent
+    bool correctionPending = false;        ///< That correction hasn't been acknowledged yet
+    uint16_t moveIntervalMs = 0;           ///< Last MoveRateHint sent (0 = none yet)
+    bool profilePending = false;           ///< Sent ClientJoin, waiting for the saved profile to load
+    bool spawned = false;                  ///< Announced to the other players (finishJoin has run)
+};
+
+/**
+ * @brief Connected players as a struct of arrays with dense indices
+ *
+ * Every player occupies one dense index in [0, size()). The fields read by
+ * the per-tick loops (peer, ID, pose, capabilities) each live in their own
+ * contiguous array, and everything else sits in a parallel PlayerSession
+ * array, so replication and chunk retention walk a few packed arrays
+ * instead of hash map nodes holding the whole player.
+ *
+ * Removing a player moves the last player into its index, so indices are
+ * only valid until the next remove(). Keep a PlayerHandle (or the peer)
+ * across that: handles go through a slot table with a generation per slot,
+ * so a handle to a removed player stops resolving even after its slot is
+ * reused.
+ *
+ * Positions are also kept in a SpatialHashGrid (keyed by handle slot, so
+ * it doesn't care about index moves), updated by setPose(), for findNear()
+ * and findInBox().
+ *
+ * Not thread-safe: call from the server thread.
+ */
+class PlayerStore {
+public:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();  ///< No dense index
+    static constexpr float GRID_CELL_SIZE = 384.0f;                         ///< Spatial grid column size in blocks (12 chunks, about a view's reach)
+
+    /**
+     * @brief Add a player at the end of the arrays (replaces any player already on the peer)
+     * @return Handle to the new player
+     */
+    PlayerHandle add(ENetPeer* peer, uint32_t playerId);
+
+    /**
+     * @brief Remove a player, moving the last player into its index
+     * @return false if the handle no longer resolves
+     */
+    bool remove(PlayerHandle handle);
+
+    /**
+     * @brief Find a peer's player (invalid handle if the peer has none)
+     */
+    PlayerHandle find(ENetPeer* peer) const;
+
+    /**
+     * @brief Get the dense index of a player (NONE if the handle no longer resolves)
+     */
+    uint32_t indexOf(PlayerHandle handle) const;
+
+    /**
+     * @brief Get the dense index of a peer's player (NONE if the peer has none)
+     */
+    uint32_t indexOf(ENetPeer* peer) const { return indexOf(find(peer)); }
+
+    /**
+     * @brief Get the handle of the player at a dense index
+     */
+    PlayerHandle getHandle(uint32_t index) const { return PlayerHandle{indexSlots[index], slotGenerations[indexSlots[index]]}; }
+
+    size_t size() const { return peers.size(); }
+    bool empty() const { return peers.empty(); }
+
+    // Hot columns, indexed by dense index
+
+    ENetPeer* getPeer(uint32_t index) const { return peers[index]; }
+    uint32_t getPlayerId(uint32_t index) const { return playerIds[index]; }
+    const glm::vec3& getPosition(uint32_t index) const { return positions[index]; }
+    float getYaw(uint32_t index) const { return yaws[index]; }
+    float getPitch(uint32_t index) const { return pitches[index]; }
+    uint32_t getCapabilities(uint32_t index) const { return capabilities[index]; }
+
+    /**
+     * @brief Get every position, in dense index order
+     */
+    const std::vector<glm::vec3>& getPositions() const { return positions; }
+
+    /**
+     * @brief Get every peer, in dense index order
+     */
+    const std::vector<ENetPeer*>& getPeers() const { return peers; }
+
+    /**
+     * @brief Set a player's position and look angles
+     */
+    void setPose(uint32_t index, const glm::vec3& position, float yaw, float pitch) {
+        positions[index] = position;
+        yaws[index] = yaw;
+        pitches[index] = pitch;
+        grid.move(indexSlots[index], position);
+    }
+
+    /**
+     * @brief Set the negotiated protocol::CAPABILITY_* bits of a player
+     */
+    void setCapabilities(uint32_t index, uint32_t bits) { capabilities[index] = bits; }
+
+    /**
+     * @brief Check if an optional protocol feature was negotiated with a player
+     */
+    bool hasCapability(uint32_t index, uint32_t capability) const { return (capabilities[index] & capability) != 0; }
+
+    /**
+     * @brief Find the players within a radius of a point
+     * @param outIndices Receives dense indices (appended, in no particular order)
+     */
+    void findNear(const glm::vec3& center, float radius, std::vector<uint32_t>& outIndices) const;
+
+    /**
+     * @brief Find the players inside a box
+     * @param outIndices Receives dense indices (appended, in no particular order)
+     */
+    void findInBox(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& outIndices) const;
+
+    /**
+     * @brief Get the spatial grid of player positions (IDs are handle slots)
+     */
+    const SpatialHashGrid& getGrid() const { return grid; }
+
+    // Cold column
+
+    PlayerSession& getSession(uint32_t index) { return sessions[index]; }
+    const PlayerSession& getSession(uint32_t index) const { return sessions[index]; }
+
+private:
+    // Dense arrays, all size()
+    std::vector<ENetPeer*> peers;          ///< Connection of each player
+    std::vector<uint32_t> playerIds;       ///< Unique player ID
+    std::vector<glm::vec3> positions;      ///< Player world position
+    std::vector<float> yaws;               ///< Camera yaw angle in degrees
+    std::vector<float> pitches;            ///< Camera pitch angle in degrees
+    std::vector<uint32_t> capabilities;    ///< Negotiated protocol::CAPABILITY_* bits
+    std::vector<PlayerSession> sessions;   ///< Everything else
+    std::vector<uint32_t> indexSlots;      ///< Handle slot of each dense index
+
+    // Handle table
+    std::vector<uint32_t> slotIndices;      ///< Dense index of each slot (NONE = free)
+    std::vector<uint32_t> slotGenerations;  ///< Bumped when a slot is freed, so stale handles don't match
+    std::vector<uint32_t> freeSlots;        ///< Slots to reuse
+
+    std::unordered_map<ENetPeer*, PlayerHandle> peerHandles;  ///< Player of each connected peer
+    SpatialHashGrid grid{GRID_CELL_SIZE};                     ///< Player positions by handle slot
+
+    /**
+     * @brief Replace the handle slots appended to a list by their dense indices
+     */
+    void slotsToIndices(std::vector<uint32_t>& ids, size_t first) const;
+};
+
+} // namespace engine
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "server/FallingBlockSimulator.hpp"
+#include "shared/Chunk.hpp"
+#include "shared/ChunkCoord.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace engine {
+
+/**
+ * @brief Splits loaded chunks into regions of columns and ticks the regions in parallel
+ *
+ * A region is REGION_CHUNKS x REGION_CHUNKS chunk columns (every level).
+ * Regions are coloured by the parity of their X and Z, so two regions of
+ * the same colour are never adjacent. A tick runs the colours one after
+ * another and the regions of one colour in parallel on a worker pool.
+ *
+ * A region's task may read blocks in its own region and the eight around it
+ * (none of which is written while it runs) and writes blocks in its own
+ * region directly. Writes anywhere else are buffered and applied on the
+ * calling thread once every colour has run, in region order, so the result
+ * of a tick doesn't depend on the number of workers.
+ *
+ * Chunks are looked up on the calling thread before the workers start, so
+ * the lookup needn't be thread-safe. A chunk the lookup doesn't return sits
+ * the tick out and reads as Air. Not thread-safe itself: call from the
+ * thread that owns the chunks.
+ */
+class RegionScheduler {
+    struct Region;
+
+public:
+    static constexpr int32_t REGION_CHUNKS = 8;  ///< Region width and length in chunk columns
+    static constexpr uint32_t COLOR_COUNT = 4;   ///< Regions ticked one colour at a time
+
+    /**
+     * @brief Finds a loaded chunk (nullptr if not loaded, or if it should sit this tick out)
+     */
+    using ChunkLookup = std::function<Chunk*(const ChunkCoord&)>;
+
+    /**
+     * @brief A task's view of the world while its region ticks (one per region, not shared)
+     */
+    class RegionContext {
+    public:
+        /**
+         * @brief Get the region's coordinate (x and z in regions; y is 0)
+         */
+        const ChunkCoord& getRegion() const;
+
+        /**
+         * @brief Get the chunks of the region being ticked (those the lookup returned)
+         */
+        const std::vector<ChunkCoord>& getChunks() const;
+
+        /**
+         * @brief Get a block type (Air if unloaded or outside this region and its neighbours)
+         */
+        BlockType getBlock(const glm::ivec3& worldPos);
+
+        /**
+         * @brief Check if a block can be read, i.e. getBlock() returning Air means air
+         */
+        bool canRead(const glm::ivec3& worldPos);
+
+        /**
+         * @brief Set a block: now inside this region, at the end of the tick anywhere else
+         */
+        void setBlock(const glm::ivec3& worldPos, BlockType type);
+
+    private:
+        friend class RegionScheduler;
+
+        RegionScheduler& scheduler;
+        Region& region;
+
+        /// Last chunk looked up; chunks can't load or unload during a tick
+        ChunkCoord lastCoord{};
+        Chunk* lastChunk = nullptr;
+        bool hasLast = false;
+
+        RegionContext(RegionScheduler& scheduler, Region& region) : scheduler(scheduler), region(region) {}
+
+        /**
+         * @brief Find the chunk holding a block if this region may read it
+         * @param outLocal Receives the block's local coordinates
+         */
+        Chunk* findChunk(const glm::ivec3& worldPos, glm::ivec3& outLocal);
+    };
+
+    /**
+     * @brief Work done for one region per tick (called concurrently for different regions)
+     */
+    using RegionTask = std::function<void(RegionContext&)>;
+
+    /**
+     * @brief Tick counters
+     */
+    struct Stats {
+        uint64_t ticks = 0;               ///< tick() calls
+        uint64_t regionTicks = 0;         ///< Region tasks run
+        uint64_t crossRegionEdits = 0;    ///< Writes buffered until the end of a tick
+        uint64_t droppedEdits = 0;        ///< Buffered writes to unloaded chunks
+        uint64_t tickMicrosTotal = 0;     ///< Total time spent in tick()
+        uint64_t tickMicrosMax = 0;       ///< Slowest tick()
+    };
+
+    /**
+     * @param lookup Finds loaded chunks (called on the ticking thread only)
+     * @param workerCount Threads ticking regions, including the caller (0 = one per core)
+     */
+    explicit RegionScheduler(ChunkLookup lookup, size_t workerCount = 0);
+    ~RegionScheduler();
+
+    RegionScheduler(const RegionScheduler&) = delete;
+    RegionScheduler& operator=(const RegionScheduler&) = delete;
+    RegionScheduler(RegionScheduler&&) = delete;
+    RegionScheduler& operator=(RegionScheduler&&) = delete;
+
+    /**
+     * @brief Add a loaded chunk to its region
+     */
+    void addChunk(const ChunkCoord& coord);
+
+    /**
+     * @brief Remove an unloaded chunk from its region (the region goes when it empties)
+     */
+    void removeChunk(const ChunkCoord& coord);
+
+    /**
+     * @brief Run a task for every region, then apply the buffered cross-region writes
+     * @param outChanges Receives every block changed (appended)
+     */
+    void tick(const RegionTask& task, std::vector<BlockChange>& outChanges);
+
+    /**
+     * @brief Get the region holding a chunk (y is 0)
+     */
+    static ChunkCoord regionOf(const ChunkCoord& coord);
+
+    size_t getRegionCount() const { return regions.size(); }
+    size_t getWorkerCount() const { return workerCount; }
+    const Stats& getStats() const { return stats; }
+
+private:
+    /**
+     * @brief A write outside the writing region, applied at the end of the tick
+     */
+    struct DeferredEdit {
+        glm::ivec3 position;
+        BlockType type;
+    };
+
+    /**
+     * @brief Chunks of one region and the writes its task made this tick
+     */
+    struct Region {
+        ChunkCoord coord{};                    ///< Region coordinate (y is 0)
+        std::vector<ChunkCoord> chunks;        ///< Loaded chunks of the region
+        std::vector<ChunkCoord> ticking;       ///< Chunks of the region the lookup returned this tick
+        std::vector<BlockChange> changes;      ///< Writes made inside the region
+        std::vector<DeferredEdit> deferred;    ///< Writes outside the region
+    };
+
+    ChunkLookup lookup;
+    size_t workerCount;
+    std::unordered_map<ChunkCoord, Region> regions;         ///< Keyed by regionOf()
+    std::array<std::vector<Region*>, COLOR_COUNT> colors;   ///< Regions of each colour, in coordinate order
+    bool colorsStale = false;                               ///< Regions added or removed since colors was built
+    std::unordered_map<ChunkCoord, Chunk*> resolved;        ///< Chunks of every region, looked up for this tick
+    Stats stats;
+
+    // Worker pool (started on the first tick that has regions to share)
+    std::vector<std::thread> workers;
+    std::mutex poolMutex;
+    std::condition_variable workReady;
+    std::condition_variable workDone;
+    const std::vector<Region*>* batch = nullptr;   ///< Regions being ticked
+    const RegionTask* batchTask = nullptr;
+    std::atomic<size_t> nextRegion{0};             ///< Next index of batch to claim
+    size_t busyWorkers = 0;                        ///< Workers still on the current batch
+    uint64_t batchNumber = 0;                      ///< Bumped per batch to wake the workers
+    bool stopping = false;
+    std::exception_ptr failure;                    ///< First exception a task threw this batch
+
+    /**
+     * @brief Sort the regions into colours, in coordinate order
+     */
+    void rebuildColors();
+
+    /**
+     * @brief Run the task for every region of a batch on the pool and the calling thread
+     */
+    void runBatch(const std::vector<Region*>& regionsToTick, const RegionTask& task);
+
+    /**
+     * @brief Claim and run regions of the current batch until none are left
+     */
+    void drainBatch();
+
+    void workerLoop();
+
+    /**
+     * @brief Set a block in a looked-up chunk and record the change (no-op if unchanged)
+     * @return false if the chunk isn't loaded
+     */
+    bool applyEdit(const glm::ivec3& worldPos, BlockType type, std::vector<BlockChange>& outChanges);
+};
+
+} // namespace engine
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace engine {
+
+/**
+ * @brief Uniform hash grid of point entities for proximity queries
+ *
+ * The grid buckets entities into square columns of cellSize in X and Z
+ * (every height), keyed by a hash of the column, so only occupied columns
+ * cost memory. Entities keep their full position; queries visit the
+ * columns overlapping the query's XZ extent and test each entity exactly,
+ * so their cost follows the number of entities nearby rather than the
+ * total. A query wider than the occupied columns visits those instead.
+ *
+ * Entity IDs index a location table, so keep them small and dense (for
+ * example PlayerStore handle slots). Positions and radii are in whatever
+ * unit the caller uses, as long as cellSize is in the same unit.
+ *
+ * Not thread-safe: call from the thread that owns the entities.
+ */
+class SpatialHashGrid {
+public:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @param cellSize Column width and length (around the usual query radius works well)
+     */
+    explicit SpatialHashGrid(float cellSize);
+
+    /**
+     * @brief Add an entity (moves it if already present)
+     */
+    void insert(uint32_t id, const glm::vec3& position);
+
+    /**
+     * @brief Update an entity's position (only touches the columns when it crosses into another)
+     */
+    void move(uint32_t id, const glm::vec3& position);
+
+    /**
+     * @brief Remove an entity
+     * @return false if it wasn't in the grid
+     */
+    bool remove(uint32_t id);
+
+    /**
+     * @brief Remove every entity
+     */
+    void clear();
+
+    /**
+     * @brief Find the entities within a radius of a point (boundary included)
+     * @param outIds Receives the IDs (appended, in no particular order)
+     */
+    void queryRadius(const glm::vec3& center, float radius, std::vector<uint32_t>& outIds) const;
+
+    /**
+     * @brief Find the entities inside a box (boundary included)
+     * @param outIds Receives the IDs (appended, in no particular order)
+     */
+    void queryBox(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& outIds) const;
+
+    /**
+     * @brief Check if any entity is within a radius of a point (boundary included)
+     */
+    bool anyWithin(const glm::vec3& center, float radius) const;
+
+    /**
+     * @brief Check if an entity is in the grid
+     */
+    bool contains(uint32_t id) const { return id < locations.size() && locations[id].slot != NONE; }
+
+    size_t size() const { return entityCount; }
+    size_t getCellCount() const { return cells.size(); }
+    float getCellSize() const { return cellSize; }
+
+private:
+    /**
+     * @brief An entity as stored in its column, so queries read positions in place
+     */
+    struct Member {
+        glm::vec3 position;
+        uint32_t id;
+    };
+
+    /**
+     * @brief Where an entity is stored
+     */
+    struct Location {
+        uint64_t cell = 0;     ///< Column key
+        uint32_t slot = NONE;  ///< Index in the column (NONE = not in the grid)
+    };
+
+    float cellSize;
+    float inverseCellSize;
+    std::unordered_map<uint64_t, std::vector<Member>> cells;  ///< Occupied columns
+    std::vector<Location> locations;                          ///< Indexed by entity ID
+    size_t entityCount = 0;
+
+    int32_t cellOf(float coordinate) const;
+    static uint64_t cellKey(int32_t cellX, int32_t cellZ);
+    uint64_t cellKeyOf(const glm::vec3& position) const { return cellKey(cellOf(position.x), cellOf(position.z)); }
+
+    /**
+     * @brief Remove an entity from its column (the location is left to the caller)
+     */
+    void unlink(const Location& location);
+
+    /**
+     * @brief Call visit(member) for every entity in the columns overlapping an XZ range
+     *
+     * Stops early when visit returns true.
+     * @return true if visit returned true
+     */
+    template<typename Visit>
+    bool forEachInRange(float minX, float minZ, float maxX, float maxZ, Visit&& visit) const;
+};
+
+} // namespace engine
@@ -2,7 +2,19 @@
 
 #include "shared/Chunk.hpp"
 #include "shared/ChunkCoord.hpp"
+#include "shared/Collision.hpp"
+#include "shared/LightEngine.hpp"
+#include "server/BlockTickScheduler.hpp"
+#include "server/ChunkBlockPool.hpp"
+#include "server/FallingBlockSimulator.hpp"
+#include "server/RegionScheduler.hpp"
+#include "server/WorldSettings.hpp"
 
+#include <array>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <string>
 #include <unordered_map>
 #include <memory>
 #include <vector>
@@ -18,7 +30,11 @@ namespace engine {
  */
 class World {
 public:
-    World();
+    /**
+     * @brief Create an empty world
+     * @param settings Height range and chunk memory options
+     */
+    explicit World(const WorldSettings& settings = WorldSettings{});
     ~World() = default;
 
     // Delete copy and move operations (mutex is not movable)
@@ -30,10 +46,96 @@ public:
     /**
      * @brief Update the world (called every server tick)
      *
-     * Processes chunk updates, block ticks, etc.
+     * Processes chunk updates, block ticks, etc. Relights everything queued
+     * since the last tick as one batch.
      */
     void update();
 
+    /**
+     * @brief Run queued lighting work now (e.g. before sending chunks)
+     */
+    void updateLighting();
+
+    /**
+     * @brief Queue relighting around an edited block (call after the block is set)
+     * @param worldPos World block coordinates of the edit
+     * @param previous Block type before the edit
+     */
+    void queueLightUpdate(const glm::ivec3& worldPos, BlockType previous);
+
+    /**
+     * @brief Queue falling-block checks around an edited block (call after the block is set)
+     */
+    void queueFallingBlockCheck(const glm::ivec3& worldPos);
+
+    /**
+     * @brief Drop unsupported gravity blocks by one block and queue their relighting
+     *
+     * Call once per tick, before update() so the changes are relit that tick.
+     * @return Every block changed, to send to clients
+     */
+    std::vector<BlockChange> updateFallingBlocks();
+
+    /**
+     * @brief Called when a block's scheduled tick comes due, with the block's world position
+     */
+    using BlockTickHandler = std::function<void(const glm::ivec3&)>;
+
+    /**
+     * @brief Schedule a tick for the block at a position
+     *
+     * The tick is saved with its chunk and dropped if the chunk unloads
+     * first. When it comes due, the handler for the block's type runs
+     * (during update()), unless the block has changed type since.
+     * @param worldPos World block coordinates
+     * @param delay Server ticks from now (clamped to BlockTickScheduler::MAX_DELAY)
+     * @return Handle for cancelBlockTick() (invalid if the chunk isn't loaded)
+     */
+    BlockTickHandle scheduleBlockTick(const glm::ivec3& worldPos, uint32_t delay);
+
+    /**
+     * @brief Cancel a scheduled block tick
+     * @return false if it already ran, was cancelled or its chunk unloaded
+     */
+    bool cancelBlockTick(BlockTickHandle handle);
+
+    /**
+     * @brief Set the handler run by due ticks of blocks of a type (set before the server starts ticking)
+     */
+    void setBlockTickHandler(BlockType type, BlockTickHandler handler);
+
+    /**
+     * @brief Run a task for every region of loaded chunks, in parallel (see RegionScheduler)
+     *
+     * Cold chunks sit the tick out (they read as Air) until something else
+     * accesses them.
+     *
+     * The changed blocks are queued for relighting and falling-block checks.
+     * @return Every block changed, to send to clients
+     */
+    std::vector<BlockChange> tickRegions(const RegionScheduler::RegionTask& task);
+
+    /**
+     * @brief Get relight timing counters
+     */
+    LightEngine::Stats getLightStats() const;
+
+    /**
+     * @brief Log relight counts and timings
+     */
+    void logLightReport() const;
+
+    /**
+     * @brief Move a player towards a requested position, stopping at solid blocks
+     *
+     * Sweeps the player's box from where the server last had them, so a
+     * reported position behind a wall resolves to the near side of it.
+     * @param eyeFrom Current eye position
+     * @param eyeTo Requested eye position
+     * @return Eye position the player actually reaches
+     */
+    glm::vec3 resolvePlayerMove(const glm::vec3& eyeFrom, const glm::vec3& eyeTo);
+
     /**
      * @brief Get a chunk at the given coordinate
      * @param coord Chunk coordinate
@@ -101,11 +203,30 @@ public:
 
     /**
      * @brief Generate initial chunks for a new world
+     *
+     * Covers the 3x3 columns around the origin over the whole height range.
      */
     void generateInitialChunks();
 
+    /**
+     * @brief Get the vertical extent of the world in chunk levels
+     *
+     * Only levels in this range are streamed to players. It is fixed by the
+     * WorldSettings the world was created with.
+     */
+    int32_t getMinChunkY() const { return minChunkY; }
+    int32_t getMaxChunkY() const { return maxChunkY; }
+
+    /**
+     * @brief Check if a chunk level lies inside the world's height range
+     */
+    bool isInHeightRange(int32_t chunkY) const { return chunkY >= minChunkY && chunkY <= maxChunkY; }
+
     /**
      * @brief Get chunks within a radius of a position
+     *
+     * Columns come nearest first; within a column, levels nearest the
+     * center's level come first (the order chunks are streamed in).
      * @param centerPos World position center
      * @param chunkRadius Radius in chunks
      * @return Vector of chunk coordinates within radius
@@ -113,17 +234,205 @@ public:
     std::vector<ChunkCoord> getChunksInRadius(const glm::vec3& centerPos, int32_t chunkRadius) const;
 
     /**
-     * @brief Unload chunks that are not near any of the given positions
+     * @brief Unload chunks that have not been near any of the given positions for a while
+     *
+     * Each loaded chunk is tested against nearby players only (players are
+     * put into a SpatialHashGrid of chunk columns first). A chunk out of range starts an
+     * idle timer and is unloaded once it has stayed out of range for the
+     * retention time; dirty chunks are kept until they are saved. Idle chunks
+     * are then evicted early if resident memory exceeds the budget
+     * (see setMemoryBudget()).
      * @param playerPositions List of player positions to check
      * @param keepRadius Radius in chunks to keep loaded around each position
-     * @return Number of chunks unloaded
+     *        (horizontal circle, every level of the height range)
+     * @return Number of chunks unloaded or evicted
      */
     size_t unloadDistantChunks(const std::vector<glm::vec3>& playerPositions, int32_t keepRadius);
 
+    /**
+     * @brief Chunk memory usage and eviction counters
+     */
+    struct MemoryStats {
+        size_t residentChunks = 0;  ///< Chunks in memory
+        size_t residentBytes = 0;   ///< Estimated bytes used by resident chunks (shared buffers counted once)
+        size_t blockBuffers = 0;    ///< Distinct block buffers after deduplication
+        size_t dedupSavedBytes = 0; ///< Bytes saved by chunks sharing block buffers
+        size_t budgetBytes = 0;     ///< Configured budget (0 = unlimited)
+        size_t idleChunks = 0;      ///< Resident chunks out of every player's range
+        uint64_t evictions = 0;     ///< Chunks evicted to stay under budget
+        uint64_t writeBacks = 0;    ///< Dirty chunks saved during eviction
+        uint64_t unloads = 0;       ///< Chunks unloaded after the retention time
+        uint64_t reloads = 0;       ///< Chunks read back from disk
+        float evictionRate = 0.0f;  ///< Evictions plus unloads per second
+        float reloadRate = 0.0f;    ///< Reloads per second
+        float coldDelaySeconds = 0.0f;  ///< Unused time before a chunk is compressed (0 = disabled)
+        size_t coldChunks = 0;      ///< Resident chunks held compressed
+        size_t coldBytes = 0;       ///< Bytes used by compressed block and light data
+        uint64_t compressions = 0;  ///< Chunks compressed after going cold
+        uint64_t thaws = 0;         ///< Accesses that hit a cold chunk and decompressed it
+        uint64_t thawMicrosTotal = 0;  ///< Total decompression time in microseconds
+        uint64_t thawMicrosMax = 0;    ///< Slowest decompression in microseconds
+        float thawRate = 0.0f;      ///< Cold hits per second
+    };
+
+    /**
+     * @brief Set the resident chunk memory budget
+     *
+     * When resident chunks exceed the budget, idle chunks (out of every
+     * player's range) are evicted least recently used first, clean before
+     * dirty; dirty chunks are written to disk before they are dropped.
+     * Chunks in range are never evicted.
+     * @param bytes Budget in bytes, 0 for unlimited
+     */
+    void setMemoryBudget(size_t bytes);
+
+    /**
+     * @brief Set how long a chunk must go unused before its blocks are compressed in memory
+     *
+     * Cold chunks keep their RLE form in memory and are decompressed on the
+     * next access through getChunk()/loadChunk(). Chunks sharing a
+     * deduplicated buffer are left alone.
+     * @param seconds Delay in seconds, 0 to disable
+     */
+    void setColdCompressionDelay(float seconds);
+
+    /**
+     * @brief Get memory usage and eviction counters
+     */
+    MemoryStats getMemoryStats() const;
+
+    /**
+     * @brief Log resident memory, eviction and reload rates
+     */
+    void logMemoryReport() const;
+
+
 private:
-    std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>> chunks;
+    static constexpr std::chrono::seconds CHUNK_RETENTION{15};  ///< Time out of range before a chunk is unloaded
+
+    /**
+     * @brief Resident chunk, either warm (decompressed) or cold (RLE blocks in memory)
+     */
+    struct ChunkSlot {
+        std::unique_ptr<Chunk> chunk;     ///< Decompressed chunk, null while cold
+        std::vector<uint8_t> compressed;  ///< Brick-codec block data (ChunkSerializer::serializeBricks) while cold
+        std::vector<uint8_t> compressedLight;  ///< Light data (ChunkSerializer::serializeLight) while cold
+        bool coldDirty = false;           ///< Dirty flag carried while cold
+        std::chrono::steady_clock::time_point lastAccess;  ///< Retention pass time of the last access
+
+        bool isCold() const { return !chunk; }
+        bool isDirty() const { return chunk ? chunk->isDirty() : coldDirty; }
+    };
+
+    static constexpr size_t SLOT_OVERHEAD = sizeof(ChunkCoord) + sizeof(ChunkSlot) + (2 * sizeof(void*));  ///< Map node per resident chunk
+    static constexpr size_t WARM_OVERHEAD = sizeof(Chunk) + (3 * sizeof(void*));  ///< Chunk object and shared_ptr control block
+    static constexpr size_t MAX_COMPRESSIONS_PER_PASS = 256;  ///< Bounds the compression work per retention pass
+
+    std::unordered_map<ChunkCoord, ChunkSlot> chunks;
     mutable std::mutex chunksMutex;
 
+    int32_t minChunkY;
+    int32_t maxChunkY;
+
+    /**
+     * @brief Resident chunk out of every player's range
+     */
+    struct IdleChunk {
+        ChunkCoord coord;
+        std::chrono::steady_clock::time_point since;  ///< When it left range
+    };
+
+    // Guarded by chunksMutex
+    std::list<IdleChunk> idleChunks;  ///< Idle chunks, least recently in range first
+    std::unordered_map<ChunkCoord, std::list<IdleChunk>::iterator> idleIndex;  ///< Position of each idle chunk in idleChunks
+    ChunkBlockPool blockPool;         ///< Shares block buffers between identical chunks
+    size_t memoryBudget = 0;          ///< Resident chunk budget in bytes (0 = unlimited)
+    std::string chunkDir = "world";   ///< Directory chunks are loaded from and written back to
+    std::vector<uint8_t> writeBackBuffer;  ///< Serialization scratch for evicted dirty chunks
+    MemoryStats memoryStats;
+    std::chrono::steady_clock::time_point rateWindowStart = std::chrono::steady_clock::now();
+    uint64_t rateWindowEvictions = 0;
+    uint64_t rateWindowReloads = 0;
+    uint64_t rateWindowThaws = 0;
+    std::chrono::steady_clock::time_point passTime = std::chrono::steady_clock::now();  ///< Time of the last retention pass (access stamp)
+    std::chrono::steady_clock::duration coldDelay{0};  ///< Unused time before compression (0 = disabled)
+    std::vector<uint8_t> compressBuffer;  ///< Serialization scratch for cold compression
+    LightEngine lightEngine;              ///< Guarded by chunksMutex; looks chunks up without locking
+    CollisionResolver collision;          ///< Guarded by chunksMutex; looks chunks up without locking
+    FallingBlockSimulator fallingBlocks;  ///< Guarded by chunksMutex; looks chunks up without locking
+    BlockTickScheduler blockTicks;        ///< Guarded by chunksMutex
+    RegionScheduler regions;              ///< Guarded by chunksMutex; every loaded chunk
+    std::array<BlockTickHandler, static_cast<size_t>(BlockType::Count)> blockTickHandlers;  ///< Indexed by BlockType
+    std::vector<BlockTick> dueBlockTicks;  ///< Scratch for update()
+
+    /**
+     * @brief Advance the block tick wheel and run the handlers of the ticks that came due
+     */
+    void updateBlockTicks();
+
+    /**
+     * @brief Mark a chunk accessed and decompress it if cold (chunksMutex held)
+     */
+    Chunk& accessChunk(const ChunkCoord& coord, ChunkSlot& slot);
+
+    /**
+     * @brief Find a loaded chunk for lighting or collision, marking it accessed and decompressing it if cold (chunksMutex held)
+     */
+    Chunk* findLoadedChunk(const ChunkCoord& coord);
+
+    /**
+     * @brief Find a loaded chunk for region ticks: nullptr if cold, and not counted as an access (chunksMutex held)
+     *
+     * Region tasks visit every chunk each tick, so counting them as accesses
+     * would keep the whole world warm, and thawing would undo compression.
+     */
+    Chunk* findWarmChunk(const ChunkCoord& coord);
+
+    /**
+     * @brief Decompress a cold chunk in place without counting an access (chunksMutex held)
+     */
+    Chunk& thawChunk(const ChunkCoord& coord, ChunkSlot& slot);
+
+    /**
+     * @brief Compress chunks unused for coldDelay (chunksMutex held)
+     */
+    void compressColdChunks(std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Get bytes freed by dropping a chunk slot
+     */
+    static size_t slotBytes(const ChunkSlot& slot);
+
+    /**
+     * @brief Evict idle chunks until resident memory fits the budget (chunksMutex held)
+     * @return Number of chunks evicted
+     */
+    size_t enforceMemoryBudget();
+
+    /**
+     * @brief Estimate resident chunk memory, counting each shared block buffer once (chunksMutex held)
+     * @param outBlockBuffers Set to the number of distinct block buffers
+     */
+    size_t computeResidentBytes(size_t& outBlockBuffers) const;
+
+    /**
+     * @brief Recompute eviction and reload rates once per second (chunksMutex held)
+     */
+    void updateMemoryRates(std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Get the file a chunk is stored in
+     */
+    static std::string chunkFilePath(const std::string& worldDir, const ChunkCoord& coord);
+
+    /**
+     * @brief Serialize a chunk and its pending block ticks to its file and clear its dirty flag (chunksMutex held)
+     * @param buffer Serialization scratch buffer
+     * @return false if the file could not be written
+     */
+    bool writeChunkFile(const std::string& worldDir, const ChunkCoord& coord, Chunk& chunk,
+                               std::vector<uint8_t>& buffer);
+
     /**
      * @brief Generate a new chunk
      * @param coord Chunk coordinate
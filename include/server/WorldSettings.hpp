@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace engine {
+
+/**
+ * @brief World options fixed when the world is created
+ *
+ * Passed to the World constructor, so the initial chunks are generated
+ * and loaded with them already in effect.
+ */
+struct WorldSettings {
+    static constexpr int32_t DEFAULT_MIN_CHUNK_Y = -1;  ///< Lowest chunk level unless configured
+    static constexpr int32_t DEFAULT_MAX_CHUNK_Y = 1;   ///< Highest chunk level unless configured
+
+    int32_t minChunkY = DEFAULT_MIN_CHUNK_Y;  ///< Lowest chunk level
+    int32_t maxChunkY = DEFAULT_MAX_CHUNK_Y;  ///< Highest chunk level (>= minChunkY)
+    size_t memoryBudgetBytes = 0;             ///< Resident chunk memory budget (0 = unlimited)
+    float coldCompressionDelay = 0.0f;        ///< Seconds unused before a chunk is compressed (0 = disabled)
+};
+
+} // namespace engine
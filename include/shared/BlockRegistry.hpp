@@ -0,0 +1,224 @@
+#pragma once
+
+#include "shared/BlockType.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine {
+
+/**
+ * @brief Cube face directions, in the same order as the ADJACENT_BITMASK_* bits
+ */
+enum class BlockFace : uint8_t {  // NOLINT(performance-enum-size)
+    NegX = 0,  // NOLINT(readability-identifier-naming)
+    PosX = 1,  // NOLINT(readability-identifier-naming)
+    NegY = 2,  // NOLINT(readability-identifier-naming)
+    PosY = 3,  // NOLINT(readability-identifier-naming)
+    NegZ = 4,  // NOLINT(readability-identifier-naming)
+    PosZ = 5,  // NOLINT(readability-identifier-naming)
+
+    Count  // NOLINT(readability-identifier-naming)
+};
+
+constexpr size_t BLOCK_FACE_COUNT = static_cast<size_t>(BlockFace::Count);
+
+/**
+ * @brief Get the face an axis (0 = X, 1 = Y, 2 = Z) and direction (-1 / +1) point to
+ */
+constexpr BlockFace faceFromAxis(int axis, int dir) {
+    return static_cast<BlockFace>((axis * 2) + (dir > 0 ? 1 : 0));
+}
+
+/**
+ * @brief Block texture identifiers (slot in the texture atlas)
+ */
+enum class BlockTexture : uint8_t {  // NOLINT(performance-enum-size)
+    Stone = 0,  // NOLINT(readability-identifier-naming)
+    Dirt = 1,  // NOLINT(readability-identifier-naming)
+    GrassSide = 2,  // NOLINT(readability-identifier-naming)
+    GrassTop = 3,  // NOLINT(readability-identifier-naming)
+    Cobblestone = 4,  // NOLINT(readability-identifier-naming)
+    Wood = 5,  // NOLINT(readability-identifier-naming)
+    Sand = 6,  // NOLINT(readability-identifier-naming)
+    Brick = 7,  // NOLINT(readability-identifier-naming)
+    Snow = 8,  // NOLINT(readability-identifier-naming)
+
+    Count  // NOLINT(readability-identifier-naming)
+};
+
+constexpr size_t BLOCK_TEXTURE_COUNT = static_cast<size_t>(BlockTexture::Count);
+
+/**
+ * @brief Authoring row for one block type
+ *
+ * Block types are described here and flattened into BlockRegistry's
+ * per-property tables at compile time.
+ */
+struct BlockDefinition {
+    BlockType type = BlockType::Air;
+    bool solid = false;        ///< Collides, can be targeted and produces faces
+    bool opaque = false;       ///< Hides the faces of blocks behind it
+    uint8_t cullGroup = 0;     ///< Faces between two blocks of the same non-zero group are culled
+    std::array<BlockTexture, BLOCK_FACE_COUNT> faceTextures{};  ///< Texture per BlockFace
+    uint32_t tint = 0xFFFFFF;  ///< Vertex color as 0xRRGGBB
+    uint8_t tintFaces = 0;     ///< ADJACENT_BITMASK_* bits of the faces the tint applies to
+    uint8_t lightEmission = 0; ///< Block light level emitted (0-15)
+    bool gravity = false;      ///< Falls while the block below is air (server-simulated)
+};
+
+namespace detail {
+
+constexpr std::array<BlockTexture, BLOCK_FACE_COUNT> allFaces(BlockTexture texture) {
+    return {texture, texture, texture, texture, texture, texture};
+}
+
+constexpr BlockDefinition opaqueCube(BlockType type, BlockTexture texture) {
+    return BlockDefinition{type, true, true, 0, allFaces(texture), 0xFFFFFF, 0};
+}
+
+constexpr BlockDefinition fallingCube(BlockType type, BlockTexture texture) {
+    BlockDefinition definition = opaqueCube(type, texture);
+    definition.gravity = true;
+    return definition;
+}
+
+} // namespace detail
+
+/**
+ * @brief Every block type's properties; add a row here to add a block
+ */
+inline constexpr std::array<BlockDefinition, static_cast<size_t>(BlockType::Count)> BLOCK_DEFINITIONS = {{
+    {BlockType::Air, false, false, 0, detail::allFaces(BlockTexture::Stone), 0xFFFFFF, 0},
+    detail::opaqueCube(BlockType::Stone, BlockTexture::Stone),
+    detail::opaqueCube(BlockType::Dirt, BlockTexture::Dirt),
+    detail::opaqueCube(BlockType::GrassSide, BlockTexture::GrassSide),
+    detail::opaqueCube(BlockType::GrassTop, BlockTexture::GrassTop),
+    detail::opaqueCube(BlockType::Cobblestone, BlockTexture::Cobblestone),
+    detail::opaqueCube(BlockType::Wood, BlockTexture::Wood),
+    detail::fallingCube(BlockType::Sand, BlockTexture::Sand),
+    detail::opaqueCube(BlockType::Brick, BlockTexture::Brick),
+    detail::opaqueCube(BlockType::Snow, BlockTexture::Snow),
+    {BlockType::Grass, true, true, 0,
+     {BlockTexture::GrassSide, BlockTexture::GrassSide, BlockTexture::Dirt,
+      BlockTexture::GrassTop, BlockTexture::GrassSide, BlockTexture::GrassSide},
+     0x66CC4D, ADJACENT_BITMASK_POS_Y},
+}};
+
+/**
+ * @brief Atlas file name (without extension) of each BlockTexture
+ */
+inline constexpr std::array<const char*, BLOCK_TEXTURE_COUNT> BLOCK_TEXTURE_NAMES = {
+    "stone", "dirt", "grass_side", "grass_top", "cobblestone", "wood", "sand", "brick", "snow"
+};
+
+namespace detail {
+
+constexpr size_t BLOCK_TYPE_COUNT = static_cast<size_t>(BlockType::Count);
+
+/**
+ * @brief Flatten one property of every definition into a table indexed by BlockType
+ */
+template <typename T, typename Fn>
+constexpr std::array<T, BLOCK_TYPE_COUNT> blockColumn(Fn&& property) {
+    std::array<T, BLOCK_TYPE_COUNT> table{};
+    for (const BlockDefinition& definition : BLOCK_DEFINITIONS) {
+        table[static_cast<size_t>(definition.type)] = property(definition);
+    }
+    return table;
+}
+
+/**
+ * @brief Flatten one per-face property into a table indexed by BlockType * 6 + BlockFace
+ */
+template <typename T, typename Fn>
+constexpr std::array<T, BLOCK_TYPE_COUNT * BLOCK_FACE_COUNT> blockFaceColumn(Fn&& property) {
+    std::array<T, BLOCK_TYPE_COUNT * BLOCK_FACE_COUNT> table{};
+    for (const BlockDefinition& definition : BLOCK_DEFINITIONS) {
+        for (size_t face = 0; face < BLOCK_FACE_COUNT; face++) {
+            table[(static_cast<size_t>(definition.type) * BLOCK_FACE_COUNT) + face] = property(definition, face);
+        }
+    }
+    return table;
+}
+
+constexpr bool everyBlockTypeDefinedOnce() {
+    std::array<int, BLOCK_TYPE_COUNT> seen{};
+    for (const BlockDefinition& definition : BLOCK_DEFINITIONS) {
+        auto type = static_cast<size_t>(definition.type);
+        if (type >= BLOCK_TYPE_COUNT || seen[type]++ != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(everyBlockTypeDefinedOnce(), "BLOCK_DEFINITIONS needs exactly one row per BlockType");
+
+inline constexpr auto BLOCK_SOLID = blockColumn<bool>([](const BlockDefinition& def) { return def.solid; });
+inline constexpr auto BLOCK_OPAQUE = blockColumn<bool>([](const BlockDefinition& def) { return def.opaque; });
+inline constexpr auto BLOCK_CULL_GROUP = blockColumn<uint8_t>([](const BlockDefinition& def) { return def.cullGroup; });
+inline constexpr auto BLOCK_LIGHT_EMISSION = blockColumn<uint8_t>([](const BlockDefinition& def) { return def.lightEmission; });
+inline constexpr auto BLOCK_GRAVITY = blockColumn<bool>([](const BlockDefinition& def) { return def.gravity; });
+inline constexpr auto BLOCK_FACE_TEXTURE = blockFaceColumn<BlockTexture>(
+    [](const BlockDefinition& def, size_t face) { return def.faceTextures[face]; });
+inline constexpr auto BLOCK_FACE_TINT = blockFaceColumn<uint32_t>(
+    [](const BlockDefinition& def, size_t face) { return ((def.tintFaces >> face) & 1u) != 0 ? def.tint : 0xFFFFFFu; });
+
+} // namespace detail
+
+/**
+ * @brief Compile-time block property tables
+ *
+ * BLOCK_DEFINITIONS flattened into one array per property (struct of
+ * arrays), indexed by BlockType. Hot loops like the mesher and raycaster
+ * read a property with a single indexed load instead of branching on
+ * block types, and new block types are a table row rather than code.
+ *
+ * Lookups don't check their type, so types read from the network or disk
+ * must be checked with isValid() first.
+ */
+class BlockRegistry {
+public:
+    static constexpr size_t COUNT = detail::BLOCK_TYPE_COUNT;
+
+    /**
+     * @brief Check if a raw block type value names a block in the tables
+     */
+    static constexpr bool isValid(uint16_t value) { return value < COUNT; }
+
+    static constexpr bool isSolid(BlockType type) { return detail::BLOCK_SOLID[index(type)]; }
+    static constexpr bool isOpaque(BlockType type) { return detail::BLOCK_OPAQUE[index(type)]; }
+    static constexpr uint8_t getCullGroup(BlockType type) { return detail::BLOCK_CULL_GROUP[index(type)]; }
+    static constexpr uint8_t getLightEmission(BlockType type) { return detail::BLOCK_LIGHT_EMISSION[index(type)]; }
+    static constexpr bool hasGravity(BlockType type) { return detail::BLOCK_GRAVITY[index(type)]; }
+
+    /**
+     * @brief Check if a face of a solid block is hidden by the block next to it
+     *
+     * Hidden when the neighbour is opaque, or both share a non-zero cull group.
+     */
+    static constexpr bool isFaceCulled(BlockType type, BlockType neighbor) {
+        uint8_t group = detail::BLOCK_CULL_GROUP[index(type)];
+        return detail::BLOCK_OPAQUE[index(neighbor)] || (group != 0 && group == detail::BLOCK_CULL_GROUP[index(neighbor)]);
+    }
+
+    /**
+     * @brief Get the texture drawn on one face of a block
+     */
+    static constexpr BlockTexture getFaceTexture(BlockType type, BlockFace face) {
+        return detail::BLOCK_FACE_TEXTURE[(index(type) * BLOCK_FACE_COUNT) + static_cast<size_t>(face)];
+    }
+
+    /**
+     * @brief Get the vertex color of one face as 0xRRGGBB (0xFFFFFF = untinted)
+     */
+    static constexpr uint32_t getFaceTint(BlockType type, BlockFace face) {
+        return detail::BLOCK_FACE_TINT[(index(type) * BLOCK_FACE_COUNT) + static_cast<size_t>(face)];
+    }
+
+private:
+    static constexpr size_t index(BlockType type) { return static_cast<size_t>(type); }
+};
+
+} // namespace engine
@@ -3,6 +3,7 @@
 #include "shared/Block.hpp"
 #include "shared/ChunkCoord.hpp"
 #include <array>
+#include <memory>
 #include <vector>
 #include <cstdint>
 
@@ -14,11 +15,116 @@ namespace engine {
 constexpr uint32_t CHUNK_SIZE = 32;
 constexpr uint32_t CHUNK_VOLUME = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE; // 32,768 blocks
 
+/**
+ * @brief Brick size in each dimension (a chunk is 4x4x4 bricks)
+ */
+constexpr uint32_t BRICK_SIZE = 8;
+constexpr uint32_t BRICKS_PER_AXIS = CHUNK_SIZE / BRICK_SIZE;                       // 4
+constexpr uint32_t BRICK_COUNT = BRICKS_PER_AXIS * BRICKS_PER_AXIS * BRICKS_PER_AXIS;  // 64, one bit each in a uint64_t mask
+constexpr uint32_t BRICK_VOLUME = BRICK_SIZE * BRICK_SIZE * BRICK_SIZE;             // 512 blocks
+
+static_assert(BRICK_COUNT == 64, "Brick masks are stored in a uint64_t");
+
+/**
+ * @brief Contents of one brick
+ */
+enum class BrickState : uint8_t {
+    Empty,    ///< Every block is air
+    Uniform,  ///< Every block has the same non-air type
+    Dense     ///< Mixed types
+};
+
+/**
+ * @brief Block storage of one chunk
+ */
+using ChunkBlocks = std::array<Block, CHUNK_VOLUME>;
+
+/**
+ * @brief Skylight and block light of every block in a chunk (4 bits each)
+ *
+ * Each block's light is one byte, (sky << 4) | block, indexed like the
+ * block array. Most sections are entirely open sky or entirely dark, so a
+ * store starts as a single uniform value and only allocates its array on
+ * the first differing write. The array is reference counted and copied on
+ * write like the block buffer, so chunk copies handed to mesh workers keep
+ * a stable snapshot.
+ */
+class ChunkLight {
+public:
+    static constexpr uint8_t MAX_LEVEL = 15;
+    using Values = std::array<uint8_t, CHUNK_VOLUME>;
+
+    /**
+     * @brief Pack a sky and block light level into one value
+     */
+    static constexpr uint8_t pack(uint8_t sky, uint8_t block) { return static_cast<uint8_t>((sky << 4) | block); }
+
+    /**
+     * @brief Create a store with every block at the same levels
+     */
+    explicit ChunkLight(uint8_t sky = MAX_LEVEL, uint8_t block = 0) : uniformValue(pack(sky, block)) {}
+
+    uint8_t get(uint32_t index) const { return values ? (*values)[index] : uniformValue; }
+    uint8_t getSky(uint32_t index) const { return get(index) >> 4; }
+    uint8_t getBlock(uint32_t index) const { return get(index) & 0x0F; }
+
+    void setSky(uint32_t index, uint8_t level) { set(index, pack(level, getBlock(index))); }
+    void setBlock(uint32_t index, uint8_t level) { set(index, pack(getSky(index), level)); }
+
+    /**
+     * @brief Set a block's packed value
+     */
+    void set(uint32_t index, uint8_t value);
+
+    /**
+     * @brief Reset every block to the same levels (frees the array)
+     */
+    void fill(uint8_t sky, uint8_t block);
+
+    /**
+     * @brief Replace every block's packed value (stays uniform if they all match)
+     */
+    void assign(const Values& newValues);
+
+    /**
+     * @brief Check if every block has the same value without an allocated array
+     */
+    bool isUniform() const { return !values; }
+
+    /**
+     * @brief Get the packed value of a uniform store
+     */
+    uint8_t getUniformValue() const { return uniformValue; }
+
+    /**
+     * @brief Get heap bytes owned by this store (0 while uniform)
+     */
+    size_t getAllocatedBytes() const { return values ? sizeof(Values) : 0; }
+
+private:
+    std::shared_ptr<Values> values;  ///< Null while uniform; immutable while shared
+    uint8_t uniformValue;
+};
+
 /**
  * @brief A 32x32x32 section of the world
  *
  * Chunks are the fundamental unit of world storage and streaming.
  * They contain a 3D array of blocks and their associated data.
+ *
+ * The block array is reference counted so identical chunks can share one
+ * buffer (see shareBlockData()). A shared buffer is treated as immutable:
+ * any mutable access copies it first (copy-on-write).
+ *
+ * Blocks are also grouped into 8x8x8 bricks, tracked by two 64-bit masks:
+ * an occupancy mask (bit clear = brick is all air) and a uniform mask (bit
+ * set = every block in the brick has the same type). Meshing, raycasting and
+ * serialization use them to skip empty bricks without reading their blocks.
+ * The masks are kept up to date by every mutator, so const readers on other
+ * threads never write them. They are conservative: an occupied bit may be
+ * set for a brick that became empty through the non-const getBlock(), and a
+ * uniform bit may be clear for a brick that is uniform; updateBrickMasks()
+ * makes them exact again.
  */
 class Chunk {
 public:
@@ -28,12 +134,24 @@ public:
      */
     explicit Chunk(const ChunkCoord& coord);
 
+    /**
+     * @brief Copy a chunk (shares its block buffer; the copy gets its own revisions)
+     */
+    Chunk(const Chunk& other);
+    Chunk& operator=(const Chunk& other);
+    Chunk(Chunk&&) noexcept = default;
+    Chunk& operator=(Chunk&&) noexcept = default;
+    ~Chunk() = default;
+
     /**
      * @brief Get block at local chunk coordinates
      * @param x Local X coordinate (0-31)
      * @param y Local Y coordinate (0-31)
      * @param z Local Z coordinate (0-31)
      * @return Reference to block at that position
+     *
+     * The non-const overload may be written through, so it marks the block's
+     * brick occupied and non-uniform; use setBlock() for edits.
      */
     Block& getBlock(uint32_t x, uint32_t y, uint32_t z);  // NOLINT(readability-identifier-length)
     const Block& getBlock(uint32_t x, uint32_t y, uint32_t z) const;  // NOLINT(readability-identifier-length)
@@ -62,24 +180,150 @@ public:
      */
     void clearDirty() { dirty = false; }
 
+    /**
+     * @brief Mark chunk as needing a save without a block change (e.g. its block ticks changed)
+     */
+    void markDirty() { dirty = true; }
+
     /**
      * @brief Get raw block data for serialization
      */
-    const std::array<Block, CHUNK_VOLUME>& getBlockData() const { return blocks; }
+    const ChunkBlocks& getBlockData() const { return *blocks; }
 
     /**
      * @brief Set raw block data (for deserialization)
      */
-    void setBlockData(const std::array<Block, CHUNK_VOLUME>& data);
+    void setBlockData(const ChunkBlocks& data);
+
+    /**
+     * @brief Replace this chunk's blocks with a buffer shared with other chunks
+     *
+     * The buffer must hold the same blocks as this chunk; the dirty flag is
+     * unchanged. The next mutable access takes a private copy.
+     * @param shared Buffer to share
+     */
+    void shareBlockData(std::shared_ptr<ChunkBlocks> shared) { blocks = std::move(shared); }
+
+    /**
+     * @brief Get the block buffer so other identical chunks can share it
+     */
+    const std::shared_ptr<ChunkBlocks>& getSharedBlockData() const { return blocks; }
+
+    /**
+     * @brief Check if the block buffer is shared with another chunk
+     */
+    bool isBlockDataShared() const { return blocks.use_count() > 1; }
+
+    /**
+     * @brief Get the revision of the block contents
+     *
+     * Changes on every block mutation, including mutable getBlock() access.
+     * Each chunk object draws its revisions from its own range, so no two
+     * chunks (or states of one chunk) share a revision. Caches derived from
+     * the blocks compare it to tell when to rebuild.
+     */
+    uint64_t getRevision() const { return revision; }
+
+    /**
+     * @brief Get the light store (filled in by LightEngine; full skylight until then)
+     */
+    const ChunkLight& getLight() const { return light; }
+    ChunkLight& getLight() { return light; }
+
+    /**
+     * @brief Get mask of bricks that may contain non-air blocks (bit = getBrickIndex())
+     */
+    uint64_t getOccupiedBricks() const { return occupiedBricks; }
+
+    /**
+     * @brief Get mask of bricks known to hold a single block type
+     */
+    uint64_t getUniformBricks() const { return uniformBricks; }
+
+    /**
+     * @brief Check if a brick is all air
+     */
+    bool isBrickEmpty(uint32_t brickIndex) const { return ((occupiedBricks >> brickIndex) & 1u) == 0; }
+
+    /**
+     * @brief Check if every brick is all air
+     */
+    bool isEmpty() const { return occupiedBricks == 0; }
+
+    /**
+     * @brief Get the state of a brick
+     */
+    BrickState getBrickState(uint32_t brickIndex) const {
+        if (isBrickEmpty(brickIndex)) {
+            return BrickState::Empty;
+        }
+        return ((uniformBricks >> brickIndex) & 1u) != 0 ? BrickState::Uniform : BrickState::Dense;
+    }
+
+    /**
+     * @brief Recompute both brick masks exactly from the blocks
+     *
+     * Call after bulk setBlock() edits (e.g. terrain generation) so bricks
+     * filled one block at a time are recognised as uniform.
+     */
+    void updateBrickMasks();
+
+    /**
+     * @brief Convert 3D coordinates to 1D array index
+     * @param x Local X coordinate (0-31)
+     * @param y Local Y coordinate (0-31)
+     * @param z Local Z coordinate (0-31)
+     * @return Index into getBlockData() and the light store
+     */
+    static constexpr uint32_t getIndex(uint32_t x, uint32_t y, uint32_t z) {  // NOLINT(readability-identifier-length)
+        // Layout: X varies fastest, then Z, then Y
+        // This gives better cache locality for horizontal iteration
+        return (y * (CHUNK_SIZE * CHUNK_SIZE)) + (z * CHUNK_SIZE) + x;
+    }
+
+    /**
+     * @brief Get brick index from brick coordinates (0-3 each)
+     */
+    static constexpr uint32_t getBrickIndex(uint32_t brickX, uint32_t brickY, uint32_t brickZ) {
+        // Same axis order as getIndex(): X fastest, then Z, then Y
+        return (brickY * (BRICKS_PER_AXIS * BRICKS_PER_AXIS)) + (brickZ * BRICKS_PER_AXIS) + brickX;
+    }
+
+    /**
+     * @brief Get index of the brick containing a block
+     */
+    static constexpr uint32_t getBrickIndexAt(uint32_t x, uint32_t y, uint32_t z) {  // NOLINT(readability-identifier-length)
+        return getBrickIndex(x / BRICK_SIZE, y / BRICK_SIZE, z / BRICK_SIZE);
+    }
+
+    /**
+     * @brief Get the block array index of a block inside a brick
+     * @param brickIndex Brick index (0-63)
+     * @param localIndex Block within the brick (0-511, X fastest, then Z, then Y)
+     * @return Index into getBlockData()
+     */
+    static constexpr uint32_t getBrickBlockIndex(uint32_t brickIndex, uint32_t localIndex) {
+        uint32_t originX = (brickIndex % BRICKS_PER_AXIS) * BRICK_SIZE;
+        uint32_t originZ = ((brickIndex / BRICKS_PER_AXIS) % BRICKS_PER_AXIS) * BRICK_SIZE;
+        uint32_t originY = (brickIndex / (BRICKS_PER_AXIS * BRICKS_PER_AXIS)) * BRICK_SIZE;
+        return getIndex(originX + (localIndex % BRICK_SIZE),
+                        originY + (localIndex / (BRICK_SIZE * BRICK_SIZE)),
+                        originZ + ((localIndex / BRICK_SIZE) % BRICK_SIZE));
+    }
 
     /**
      * @brief Serialize chunk to binary data
+     *
+     * Writes the brick format: empty bricks are omitted and uniform bricks
+     * are stored as a single block.
      * @param outData Output buffer for serialized data
      */
     void serialize(std::vector<uint8_t>& outData) const;
 
     /**
      * @brief Deserialize chunk from binary data
+     *
+     * Accepts the brick format and the older fixed-size dump of every block.
      * @param data Input buffer containing serialized data
      * @return true if deserialization successful
      */
@@ -87,21 +331,28 @@ public:
 
 private:
     ChunkCoord coord;
-    std::array<Block, CHUNK_VOLUME> blocks;
+    std::shared_ptr<ChunkBlocks> blocks;  ///< Never null; immutable while shared
     bool dirty = false; // True if chunk has been modified
+    uint64_t occupiedBricks = 0;      ///< Bit set = brick may hold non-air blocks
+    uint64_t uniformBricks = ~0ull;   ///< Bit set = brick holds a single block type
+    ChunkLight light;
+    uint64_t revision = newRevisionRange();  ///< See getRevision()
 
     /**
-     * @brief Convert 3D coordinates to 1D array index
-     * @param x Local X coordinate (0-31)
-     * @param y Local Y coordinate (0-31)
-     * @param z Local Z coordinate (0-31)
-     * @return Array index
+     * @brief Reserve a range of revisions for one chunk object (thread-safe)
+     * @return First revision of the range
      */
-    static constexpr uint32_t getIndex(uint32_t x, uint32_t y, uint32_t z) {  // NOLINT(readability-identifier-length)
-        // Layout: X varies fastest, then Z, then Y
-        // This gives better cache locality for horizontal iteration
-        return (y * (CHUNK_SIZE * CHUNK_SIZE)) + (z * CHUNK_SIZE) + x;
-    }
+    static uint64_t newRevisionRange();
+
+    /**
+     * @brief Recompute both mask bits of one brick from its blocks
+     */
+    void updateBrick(uint32_t brickIndex);
+
+    /**
+     * @brief Take a private copy of the block buffer if it is shared
+     */
+    void makeBlocksUnique();
 };
 
 } // namespace engine
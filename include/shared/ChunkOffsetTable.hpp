@@ -0,0 +1,95 @@
+#pragma once
+
+#include "shared/ChunkCoord.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+/**
+ * @brief Precomputed chunk offsets within a cylinder, sorted nearest first
+ *
+ * Covers every (dx, dy, dz) with dx^2 + dz^2 <= radius^2 and
+ * |dy| <= verticalExtent, ordered by squared 3D distance (ties broken by
+ * |dy|, then scan order, so the order is deterministic). Radius queries
+ * walk the table instead of scanning a square and taking square roots.
+ *
+ * Tables are built once per (radius, verticalExtent) and shared; get() is
+ * thread-safe and the returned reference stays valid for the program's life.
+ */
+class ChunkOffsetTable {
+public:
+    /**
+     * @brief Get (building on first use) the table for a radius and vertical extent
+     * @param radius Horizontal radius in chunks
+     * @param verticalExtent Maximum |dy| in chunks
+     */
+    static const ChunkOffsetTable& get(int32_t radius, int32_t verticalExtent);
+
+    /**
+     * @brief Get all 3D offsets, nearest first
+     */
+    const std::vector<ChunkCoord>& getOffsets() const { return offsets; }
+
+    /**
+     * @brief Get XZ column offsets (y = 0), nearest first
+     */
+    const std::vector<ChunkCoord>& getColumns() const { return columns; }
+
+    /**
+     * @brief Get the X half-width of the circle at a Z offset
+     * @param offsetZ Z offset from the center
+     * @return Largest |dx| in the circle for that row, or -1 if the row is outside
+     */
+    int32_t getRowHalfWidth(int32_t offsetZ) const {
+        if (offsetZ < -radius || offsetZ > radius) {
+            return -1;
+        }
+        return rowHalfWidth[static_cast<size_t>(offsetZ + radius)];
+    }
+
+    /**
+     * @brief Check if a column offset lies inside the circle
+     */
+    bool containsColumn(int32_t offsetX, int32_t offsetZ) const {
+        int32_t halfWidth = getRowHalfWidth(offsetZ);
+        return offsetX >= -halfWidth && offsetX <= halfWidth;
+    }
+
+    /**
+     * @brief Get a column's index in getColumns()
+     * @param offsetX X offset from the center (must be inside the circle)
+     * @param offsetZ Z offset from the center (must be inside the circle)
+     */
+    uint32_t getColumnRank(int32_t offsetX, int32_t offsetZ) const {
+        size_t side = static_cast<size_t>((2 * radius) + 1);
+        return columnRank[(static_cast<size_t>(offsetZ + radius) * side) + static_cast<size_t>(offsetX + radius)];
+    }
+
+    /**
+     * @brief Order the chunk levels of a column nearest a given level first
+     *
+     * Levels at equal distance go below first (ground under the player before sky).
+     * @param centerY Level to start from (clamped into the range)
+     * @param minChunkY Lowest level
+     * @param maxChunkY Highest level
+     * @param outLevels Cleared, then filled with every level in the range
+     */
+    static void levelsNearestFirst(int32_t centerY, int32_t minChunkY, int32_t maxChunkY, std::vector<int32_t>& outLevels);
+
+    int32_t getRadius() const { return radius; }
+    int32_t getVerticalExtent() const { return verticalExtent; }
+
+    ChunkOffsetTable(int32_t radius, int32_t verticalExtent);
+
+private:
+    int32_t radius;
+    int32_t verticalExtent;
+    std::vector<int32_t> rowHalfWidth;  ///< Indexed by dz + radius
+    std::vector<ChunkCoord> columns;
+    std::vector<uint32_t> columnRank;   ///< Index into columns, by (dz + radius) * (2 * radius + 1) + dx + radius
+    std::vector<ChunkCoord> offsets;
+};
+
+} // namespace engine
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "shared/Chunk.hpp"
+#include "shared/ColumnHeightmap.hpp"
 #include <vector>
 #include <cstdint>
 
@@ -31,6 +32,61 @@ public:
      */
     static bool deserialize(const uint8_t* buffer, size_t size, Chunk& outChunk);
 
+    /**
+     * @brief Serialize chunk with the brick codec
+     *
+     * Format: [occupied:uint64_t] followed by RLE runs covering only the
+     * blocks of occupied bricks, brick by brick in index order. Empty bricks
+     * are skipped without being read and uniform bricks become a single run,
+     * so sparse chunks encode in time proportional to their occupied bricks.
+     * Only used with peers that negotiated protocol::CAPABILITY_CHUNK_BRICKS.
+     * @param chunk Chunk to serialize
+     * @param outBuffer Output buffer for compressed data
+     * @return Size of compressed data in bytes
+     */
+    static size_t serializeBricks(const Chunk& chunk, std::vector<uint8_t>& outBuffer);
+
+    /**
+     * @brief Deserialize chunk written by serializeBricks()
+     * @param buffer Input buffer with compressed data
+     * @param size Size of compressed data
+     * @param outChunk Output chunk to populate
+     * @return true if successful, false if data corrupted
+     */
+    static bool deserializeBricks(const uint8_t* buffer, size_t size, Chunk& outChunk);
+
+    /**
+     * @brief Append a chunk's light store to a buffer
+     *
+     * Format: [count:uint16_t][value:uint8_t]... run-length encoded packed
+     * (sky << 4) | block values in block index order. A uniform store is a
+     * single-byte payload holding its value.
+     * @return Number of bytes appended
+     */
+    static size_t serializeLight(const ChunkLight& light, std::vector<uint8_t>& outBuffer);
+
+    /**
+     * @brief Decode a light store written by serializeLight()
+     * @return true if successful, false if data corrupted
+     */
+    static bool deserializeLight(const uint8_t* buffer, size_t size, ChunkLight& outLight);
+
+    /**
+     * @brief Append a column heightmap to a buffer
+     *
+     * Format: [count:uint16_t][height:int16_t]... run-length encoded in
+     * (x, z) order. Heights are clamped to int16_t (world Y +-32767);
+     * ColumnHeightmap::NO_BLOCKS is stored as INT16_MIN.
+     * @return Number of bytes appended
+     */
+    static size_t serializeHeightmap(const ColumnHeightmap::Heights& heights, std::vector<uint8_t>& outBuffer);
+
+    /**
+     * @brief Decode a heightmap written by serializeHeightmap()
+     * @return true if successful, false if data corrupted
+     */
+    static bool deserializeHeightmap(const uint8_t* buffer, size_t size, ColumnHeightmap::Heights& outHeights);
+
 private:
     /**
      * @brief Compress block data using run-length encoding
@@ -40,6 +96,11 @@ private:
      */
     static size_t compressRLE(const Block* blocks, size_t count, std::vector<uint8_t>& outBuffer);
 
+    /**
+     * @brief Append one [count][blockType] run
+     */
+    static void appendRun(uint16_t runLength, BlockType type, std::vector<uint8_t>& outBuffer);
+
     /**
      * @brief Decompress run-length encoded data
      */
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "shared/Chunk.hpp"
+#include "shared/ChunkCoord.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+namespace engine {
+
+/**
+ * @brief Axis-aligned box in world space
+ */
+struct AABB {
+    glm::vec3 min;  ///< Lowest corner
+    glm::vec3 max;  ///< Highest corner
+
+    /**
+     * @brief Check if two boxes overlap (touching faces don't count)
+     */
+    bool intersects(const AABB& other) const {
+        return glm::all(glm::lessThan(min, other.max)) && glm::all(glm::greaterThan(max, other.min));
+    }
+
+    AABB translated(const glm::vec3& offset) const { return AABB{min + offset, max + offset}; }
+};
+
+/**
+ * @brief Player collision box, relative to the eye (camera) position players are tracked by
+ */
+constexpr float PLAYER_HALF_WIDTH = 0.3f;   ///< Half the box width on X and Z
+constexpr float PLAYER_HEIGHT = 1.8f;       ///< Box height
+constexpr float PLAYER_EYE_HEIGHT = 1.62f;  ///< Eye height above the bottom of the box
+
+/**
+ * @brief Get the collision box of a player whose eye is at a position
+ */
+inline AABB playerBoxAt(const glm::vec3& eyePos) {
+    return AABB{eyePos - glm::vec3(PLAYER_HALF_WIDTH, PLAYER_EYE_HEIGHT, PLAYER_HALF_WIDTH),
+                eyePos + glm::vec3(PLAYER_HALF_WIDTH, PLAYER_HEIGHT - PLAYER_EYE_HEIGHT, PLAYER_HALF_WIDTH)};
+}
+
+/**
+ * @brief Swept-AABB collision against solid blocks
+ *
+ * Movement is resolved one axis at a time (Y, then X, then Z): the box
+ * sweeps through the block layers it would enter along that axis and stops
+ * flush against the first layer holding a solid block, so it cannot tunnel
+ * through blocks however far it moves. Sliding along walls falls out of the
+ * per-axis order. A box that already overlaps solid blocks moves unchecked,
+ * so a player inside terrain (spawned or built over) can always get out.
+ *
+ * Block solidity is read from a cached bitmask per chunk (one 32-bit row per
+ * (y, z), bit x set when BlockRegistry::isSolid()), built from the chunk's
+ * bricks and rebuilt when Chunk::getRevision() changes. Chunks that are not
+ * loaded are treated as empty, like in Raycaster.
+ *
+ * The client runs it on camera movement and the server on every PlayerMove,
+ * so both agree on where a player can go. Not thread-safe: use one resolver
+ * per thread.
+ */
+class CollisionResolver {
+public:
+    /**
+     * @brief Finds a loaded chunk (nullptr if not loaded)
+     */
+    using ChunkLookup = std::function<const Chunk*(const ChunkCoord&)>;
+
+    /**
+     * @brief Outcome of one move()
+     */
+    struct MoveResult {
+        glm::vec3 offset{0.0f};        ///< Displacement actually applied
+        glm::bvec3 blocked{false};     ///< Axes on which a block stopped the box short
+        bool startedInside = false;    ///< Box already overlapped solid blocks, so it moved unchecked
+    };
+
+    static constexpr size_t MAX_CACHED_CHUNKS = 256;  ///< Cache is cleared when it grows past this
+    static constexpr float MAX_MOVE_DISTANCE = 256.0f;  ///< Longest move on any axis that is resolved
+
+    explicit CollisionResolver(ChunkLookup lookup);
+
+    /**
+     * @brief Move a box as far as solid blocks let it
+     *
+     * Moves longer than MAX_MOVE_DISTANCE on an axis, or with non-finite
+     * components, are refused (zero offset, every axis blocked).
+     * @param box Box before the move
+     * @param displacement Requested movement
+     */
+    MoveResult move(const AABB& box, const glm::vec3& displacement);
+
+    /**
+     * @brief Move a player as far as solid blocks let them
+     * @param eyePos Eye position before the move
+     * @param displacement Requested movement
+     * @return Eye position after the move
+     */
+    glm::vec3 movePlayer(const glm::vec3& eyePos, const glm::vec3& displacement);
+
+    /**
+     * @brief Check if a box overlaps any solid block
+     */
+    bool overlapsSolid(const AABB& box);
+
+    /**
+     * @brief Drop every cached solidity mask
+     */
+    void clearCache();
+
+    size_t getCachedChunkCount() const { return cache.size(); }
+
+private:
+    using SolidRows = std::array<uint32_t, static_cast<size_t>(CHUNK_SIZE) * CHUNK_SIZE>;
+    static_assert(CHUNK_SIZE == 32, "Solidity rows are stored in a uint32_t");
+
+    /**
+     * @brief Solidity bitmask of one chunk and the block revision it was built from
+     */
+    struct CachedSolidity {
+        const Chunk* chunk = nullptr;
+        uint64_t revision = 0;
+        bool empty = true;  ///< No solid blocks (rows not filled)
+        SolidRows rows{};   ///< Bit x of rows[y * CHUNK_SIZE + z] = block (x, y, z) is solid
+    };
+
+    ChunkLookup lookup;
+    std::unordered_map<ChunkCoord, CachedSolidity> cache;
+
+    /// Last chunk looked up during the current query; chunks can't change mid-query
+    ChunkCoord lastCoord{};
+    const CachedSolidity* lastSolidity = nullptr;
+    bool hasLast = false;
+
+    /**
+     * @brief Get the up-to-date solidity of a chunk (nullptr if not loaded)
+     */
+    const CachedSolidity* getSolidity(const ChunkCoord& coord);
+
+    /**
+     * @brief Fill a solidity mask from a chunk's blocks, skipping empty bricks
+     */
+    static void buildSolidity(const Chunk& chunk, CachedSolidity& out);
+
+    /**
+     * @brief Check if any block in an inclusive range of world block coordinates is solid
+     */
+    bool anySolid(const glm::ivec3& low, const glm::ivec3& high);
+
+    /**
+     * @brief How far a box can move along one axis before touching a solid block
+     * @return Allowed movement, same sign as distance and no longer than it
+     */
+    float sweepAxis(const AABB& box, int axis, float distance);
+};
+
+} // namespace engine
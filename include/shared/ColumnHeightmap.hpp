@@ -0,0 +1,111 @@
+#pragma once
+
+#include "shared/Chunk.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace engine {
+
+/**
+ * @brief Highest non-air block of every (x, z) in one chunk column
+ *
+ * Tracks which sections (the chunks stacked in a column) are present and
+ * which of them are entirely air, plus the world Y of the top block at each
+ * (x, z). Empty sections let callers skip meshing (and remeshing their
+ * neighbours) without touching any blocks.
+ *
+ * Heights are raised as sections and blocks are added. When the top block
+ * at an (x, z) goes away, the sections below are rescanned at just that
+ * (x, z) through a SectionLookup, so no per-section copy of the map is kept.
+ */
+class ColumnHeightmap {
+public:
+    static constexpr int32_t NO_BLOCKS = std::numeric_limits<int32_t>::min();  ///< Height of an (x, z) with no known blocks
+    static constexpr uint32_t COLUMN_AREA = CHUNK_SIZE * CHUNK_SIZE;
+
+    using Heights = std::array<int32_t, COLUMN_AREA>;  ///< Indexed by localZ * CHUNK_SIZE + localX
+
+    /**
+     * @brief Finds a present section of this column by chunk Y (nullptr if not loaded)
+     */
+    using SectionLookup = std::function<const Chunk*(int32_t chunkY)>;
+
+    ColumnHeightmap();
+
+    /**
+     * @brief Record a section and raise heights from its blocks
+     *
+     * A section recorded before is removed first, so re-sent sections are handled.
+     * @param chunk Section to scan (its coordinate selects the level)
+     * @param lookup Finds the column's other sections
+     */
+    void setSection(const Chunk& chunk, const SectionLookup& lookup);
+
+    /**
+     * @brief Record sections and heights computed elsewhere (e.g. received with a column)
+     *
+     * Nothing is scanned; the heights must cover every section of the column.
+     * @param levels Chunk Y of each section
+     * @param emptyFlags Whether each section is entirely air (same order as levels)
+     * @param columnHeights Top block world Y per (x, z)
+     */
+    void setColumn(const std::vector<int32_t>& levels, const std::vector<bool>& emptyFlags, const Heights& columnHeights);
+
+    /**
+     * @brief Forget a section (e.g. it was unloaded)
+     * @param lookup Finds the column's remaining sections
+     */
+    void removeSection(int32_t chunkY, const SectionLookup& lookup);
+
+    /**
+     * @brief Refresh one (x, z) after a block edit in a section
+     * @param chunk Edited section
+     * @param localX Local X coordinate (0-31)
+     * @param localZ Local Z coordinate (0-31)
+     * @param lookup Finds the column's other sections
+     */
+    void updateBlockColumn(const Chunk& chunk, uint32_t localX, uint32_t localZ, const SectionLookup& lookup);
+
+    /**
+     * @brief Get world Y of the highest known non-air block at a local (x, z)
+     * @return Height, or NO_BLOCKS if no section holds a block there
+     */
+    int32_t getHeight(uint32_t localX, uint32_t localZ) const { return heights[(localZ * CHUNK_SIZE) + localX]; }
+
+    /**
+     * @brief Get heights of every (x, z)
+     */
+    const Heights& getHeights() const { return heights; }
+
+    /**
+     * @brief Check if a section was recorded and is entirely air
+     */
+    bool isSectionEmpty(int32_t chunkY) const;
+
+    /**
+     * @brief Check if any section is recorded
+     */
+    bool hasSections() const { return !sectionEmpty.empty(); }
+
+    /**
+     * @brief Find the highest non-air local Y of a section at (x, z), skipping empty bricks
+     * @return Local Y, or -1 if that column of the section is air
+     */
+    static int32_t scanColumn(const Chunk& chunk, uint32_t localX, uint32_t localZ);
+
+private:
+    std::map<int32_t, bool> sectionEmpty;  ///< Recorded sections by chunk Y -> entirely air
+    Heights heights;
+
+    /**
+     * @brief Find the top block at (x, z) in the sections below a level
+     */
+    int32_t scanBelow(uint32_t index, int32_t belowChunkY, const SectionLookup& lookup) const;
+};
+
+} // namespace engine
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "shared/Chunk.hpp"
+#include "shared/ChunkCoord.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace engine {
+
+/**
+ * @brief Breadth-first skylight and block light propagation over loaded chunks
+ *
+ * Light lives in each chunk's ChunkLight store. Work is queued and run in
+ * batches by process() (once per tick on the server, right away on the
+ * client):
+ *
+ * - Fresh sections get straight-down skylight column by column (top section
+ *   first, so each reads the one above), then a flood fill confined to the
+ *   section, spread over worker threads. A serial pass then exchanges light
+ *   with already-lit neighbours across section borders.
+ * - Sections that arrive already lit (received with light) only take part
+ *   in the border exchange.
+ * - Block edits clear the light the old block let through or emitted with a
+ *   removal flood, then refill the cleared region from its surroundings.
+ *
+ * Light passes only through non-opaque blocks and drops one level per
+ * block, except skylight at full strength going down, which stays at full
+ * strength. Unloaded chunks are treated as open sky above and dark on the
+ * other sides; fixups happen when they arrive.
+ *
+ * Not thread-safe: call from the thread that owns the chunks.
+ */
+class LightEngine {
+public:
+    /**
+     * @brief Finds a loaded chunk (nullptr if not loaded)
+     */
+    using ChunkLookup = std::function<Chunk*(const ChunkCoord&)>;
+
+    /**
+     * @brief Relight timing counters
+     */
+    struct Stats {
+        uint64_t sections = 0;            ///< Fresh sections lit
+        uint64_t sectionBatches = 0;      ///< Batches that lit fresh sections
+        uint64_t sectionMicrosTotal = 0;  ///< Total time spent lighting fresh sections
+        uint64_t sectionMicrosMax = 0;    ///< Slowest fresh-section batch
+        uint64_t merges = 0;              ///< Pre-lit sections merged with their neighbours
+        uint64_t edits = 0;               ///< Block edits relit
+        uint64_t editBatches = 0;         ///< Batches that relit edits
+        uint64_t editMicrosTotal = 0;     ///< Total time spent relighting edits
+        uint64_t editMicrosMax = 0;       ///< Slowest edit batch
+    };
+
+    explicit LightEngine(ChunkLookup lookup);
+
+    /**
+     * @brief Queue a section whose light has not been computed
+     */
+    void enqueueSection(const ChunkCoord& coord);
+
+    /**
+     * @brief Queue a section that already holds valid light, to blend it with its neighbours
+     */
+    void enqueueBorderMerge(const ChunkCoord& coord);
+
+    /**
+     * @brief Queue relighting around a block that changed (call after setting the new block)
+     * @param worldPos World block coordinates of the edit
+     * @param previous Block type before the edit
+     */
+    void enqueueEdit(const glm::ivec3& worldPos, BlockType previous);
+
+    /**
+     * @brief Check if any work is queued
+     */
+    bool hasPending() const { return !freshSections.empty() || !mergeSections.empty() || !edits.empty(); }
+
+    /**
+     * @brief Run all queued work
+     * @param outChanged If given, receives every chunk whose light (or whose
+     *        neighbour's border light) changed, i.e. the chunks to remesh
+     */
+    void process(std::unordered_set<ChunkCoord>* outChanged = nullptr);
+
+    const Stats& getStats() const { return stats; }
+
+    /**
+     * @brief Compute a section's skylight and block light without reading its neighbours
+     *
+     * Skylight enters from above as given and floods the section; block
+     * light floods from emitting blocks. This is the per-worker step of fresh
+     * lighting.
+     * @param chunk Section to light (its light store is overwritten)
+     * @param skyFromAbove Whether full skylight enters each (x, z) from above,
+     *        indexed by localZ * CHUNK_SIZE + localX
+     */
+    static void lightSection(Chunk& chunk, const std::vector<bool>& skyFromAbove);
+
+private:
+    /**
+     * @brief One light level at a block, queued for propagation
+     */
+    struct LightNode {
+        Chunk* chunk;
+        uint8_t x;  // NOLINT(readability-identifier-length)
+        uint8_t y;  // NOLINT(readability-identifier-length)
+        uint8_t z;  // NOLINT(readability-identifier-length)
+        uint8_t level;  ///< Level before removal (removal queue only)
+    };
+
+    /**
+     * @brief Add and removal queues of one light channel
+     */
+    struct ChannelQueues {
+        std::vector<LightNode> add;
+        std::vector<LightNode> remove;
+    };
+
+    struct PendingEdit {
+        glm::ivec3 worldPos;
+        BlockType previous;
+    };
+
+    ChunkLookup lookup;
+    std::vector<ChunkCoord> freshSections;
+    std::vector<ChunkCoord> mergeSections;
+    std::vector<PendingEdit> edits;
+    ChannelQueues skyQueues;
+    ChannelQueues blockQueues;
+    std::unordered_set<ChunkCoord>* changed = nullptr;  ///< Output set during process()
+    const Chunk* lastMarked = nullptr;  ///< Chunk last added to changed (skips repeat inserts)
+    Stats stats;
+
+    /**
+     * @brief Light fresh sections and exchange light with their neighbours
+     * @return Number of sections lit (unloaded ones are skipped)
+     */
+    size_t processFresh(const std::vector<ChunkCoord>& coords);
+
+    /**
+     * @brief Queue light crossing between sections and their loaded neighbours
+     *
+     * Also queues removal of full skylight in a section below that was lit
+     * as open sky but is now covered.
+     * @param sections Sections to blend in
+     * @param batch Coordinates of those sections (their shared borders are seeded once)
+     */
+    void seedBorders(const std::vector<Chunk*>& sections, const std::unordered_set<ChunkCoord>& batch);
+
+    /**
+     * @brief Clear and refill light around queued edits
+     */
+    void processEdits();
+
+    /**
+     * @brief Drain the removal queue, then the add queue, of one channel
+     */
+    void propagate(ChannelQueues& queues, bool sky);
+    void propagateRemove(ChannelQueues& queues, bool sky);
+    void propagateAdd(ChannelQueues& queues, bool sky);
+
+    /**
+     * @brief Find the chunk and local position of the block next to a node
+     * @return false if the neighbour's chunk is not loaded
+     */
+    bool step(const LightNode& node, int direction, LightNode& outNeighbor);
+
+    /**
+     * @brief Record that a block's light changed (and the chunks meshing it)
+     */
+    void markChanged(const LightNode& node);
+};
+
+} // namespace engine
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "shared/Protocol.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine {
+
+/**
+ * @brief Per-connection network telemetry
+ *
+ * Counts packets and bytes per message type in both directions, keeps a
+ * smoothed round-trip time and jitter estimate from KeepAlive echoes, and
+ * derives send/receive bandwidth over a rolling one second window.
+ *
+ * Byte counts cover the message header and payload only (not ENet/UDP overhead).
+ */
+class NetworkStats {
+public:
+    /**
+     * @brief Packet and byte totals for one direction of one message type
+     */
+    struct Counter {
+        uint64_t packets = 0;  ///< Number of messages
+        uint64_t bytes = 0;    ///< Total message size in bytes
+    };
+
+    /**
+     * @brief Record an outgoing message
+     * @param type Message type
+     * @param bytes Message size including header
+     */
+    void recordSent(protocol::MessageType type, size_t bytes);
+
+    /**
+     * @brief Record an incoming message
+     * @param type Message type
+     * @param bytes Message size including header
+     */
+    void recordReceived(protocol::MessageType type, size_t bytes);
+
+    /**
+     * @brief Add a round-trip time sample
+     *
+     * Uses the RFC 6298 estimator: smoothed RTT with gain 1/8 and mean
+     * deviation (reported as jitter) with gain 1/4.
+     * @param rttMs Measured round-trip time in milliseconds
+     */
+    void addRttSample(float rttMs);
+
+    /**
+     * @brief Update bandwidth rates (call regularly, rates refresh once per second)
+     */
+    void updateRates();
+
+    /**
+     * @brief Check if at least one RTT sample was recorded
+     */
+    bool hasRtt() const { return rttSamples > 0; }
+
+    /**
+     * @brief Get smoothed round-trip time in milliseconds
+     */
+    float getRtt() const { return smoothedRtt; }
+
+    /**
+     * @brief Get round-trip time variation in milliseconds
+     */
+    float getJitter() const { return rttVariance; }
+
+    /**
+     * @brief Get lowest round-trip time seen in milliseconds (path latency without queueing)
+     */
+    float getMinRtt() const { return minRtt; }
+
+    /**
+     * @brief Get most recent RTT sample in milliseconds
+     */
+    float getLastRtt() const { return lastRtt; }
+
+    /**
+     * @brief Get outgoing bandwidth in bytes per second
+     */
+    float getSendRate() const { return sendRate; }
+
+    /**
+     * @brief Get incoming bandwidth in bytes per second
+     */
+    float getReceiveRate() const { return receiveRate; }
+
+    /**
+     * @brief Get outgoing totals for one message type
+     */
+    const Counter& getSent(protocol::MessageType type) const { return sent[static_cast<uint8_t>(type)]; }
+
+    /**
+     * @brief Get incoming totals for one message type
+     */
+    const Counter& getReceived(protocol::MessageType type) const { return received[static_cast<uint8_t>(type)]; }
+
+    /**
+     * @brief Get outgoing totals across all message types
+     */
+    const Counter& getTotalSent() const { return totalSent; }
+
+    /**
+     * @brief Get incoming totals across all message types
+     */
+    const Counter& getTotalReceived() const { return totalReceived; }
+
+    /**
+     * @brief Get a printable name for a message type ("Unknown" if not a known type)
+     */
+    static const char* getMessageTypeName(protocol::MessageType type);
+
+    /**
+     * @brief Current time in microseconds for KeepAlive timestamps
+     *
+     * Steady clock, so only meaningful to the side that produced it.
+     */
+    static uint64_t timestampMicros();
+
+    static constexpr size_t MESSAGE_TYPE_COUNT = 256;  ///< One slot per possible MessageType value
+
+private:
+    std::array<Counter, MESSAGE_TYPE_COUNT> sent{};
+    std::array<Counter, MESSAGE_TYPE_COUNT> received{};
+    Counter totalSent;
+    Counter totalReceived;
+
+    // RTT estimator
+    uint32_t rttSamples = 0;
+    float smoothedRtt = 0.0f;
+    float rttVariance = 0.0f;
+    float minRtt = 0.0f;
+    float lastRtt = 0.0f;
+
+    // Bandwidth window
+    std::chrono::steady_clock::time_point rateWindowStart = std::chrono::steady_clock::now();
+    uint64_t rateWindowSentBytes = 0;      ///< totalSent.bytes at window start
+    uint64_t rateWindowReceivedBytes = 0;  ///< totalReceived.bytes at window start
+    float sendRate = 0.0f;
+    float receiveRate = 0.0f;
+};
+
+} // namespace engine
@@ -20,6 +20,77 @@
 
 namespace engine::protocol {
 
+/**
+ * @brief Protocol version spoken by this build
+ *
+ * Version 1 clients send a bare ClientJoinMessage. Version 2 clients append a
+ * ClientCapabilitiesMessage and receive a ServerCapabilitiesMessage in reply.
+ */
+constexpr uint32_t PROTOCOL_VERSION = 2;
+
+/**
+ * @brief Capability bits negotiated per connection
+ *
+ * The client advertises every bit it understands, the server answers with the
+ * intersection of that set and its own. Optimized encodings and message types
+ * must only be used when the corresponding bit was negotiated.
+ */
+constexpr uint32_t CAPABILITY_CHUNK_RLE = 1u << 0;  ///< RLE chunk codec (baseline, always supported)
+constexpr uint32_t CAPABILITY_UNRELIABLE_MOVEMENT = 1u << 1;  ///< Sequenced PlayerMove on the unreliable channel + MoveRateHint
+constexpr uint32_t CAPABILITY_CHUNK_BRICKS = 1u << 2;  ///< ChunkData payloads use the brick codec (ChunkSerializer::serializeBricks)
+constexpr uint32_t CAPABILITY_EMPTY_SECTIONS = 1u << 3;  ///< All-air ChunkData payloads are the single byte EMPTY_SECTION_MARKER
+constexpr uint32_t CAPABILITY_COLUMN_BATCH = 1u << 4;  ///< Chunks are streamed as whole columns in ChunkColumnData
+constexpr uint32_t CAPABILITY_CHUNK_LIGHT = 1u << 5;  ///< Chunk payloads carry sky/block light (ChunkSerializer::serializeLight)
+constexpr uint32_t CAPABILITY_BLOCK_BATCH = 1u << 6;  ///< Server-made block changes arrive in BlockUpdateBatch
+constexpr uint32_t CAPABILITY_MOVE_CORRECTION = 1u << 7;  ///< Server sends PlayerCorrection when it resolves a move differently
+constexpr uint32_t CAPABILITY_POSITION_INTERVAL = 1u << 8;  ///< PlayerPositionUpdate carries the mover's send interval
+
+constexpr uint32_t LEGACY_CAPABILITIES = CAPABILITY_CHUNK_RLE;  ///< Assumed for version 1 clients
+constexpr uint32_t SUPPORTED_CAPABILITIES = CAPABILITY_CHUNK_RLE |
+                                            CAPABILITY_UNRELIABLE_MOVEMENT |
+                                            CAPABILITY_CHUNK_BRICKS |
+                                            CAPABILITY_EMPTY_SECTIONS |
+                                            CAPABILITY_COLUMN_BATCH |
+                                            CAPABILITY_CHUNK_LIGHT |
+                                            CAPABILITY_BLOCK_BATCH |
+                                            CAPABILITY_MOVE_CORRECTION |
+                                            CAPABILITY_POSITION_INTERVAL;  ///< Everything this build implements
+
+/**
+ * @brief ChunkData payload of an all-air section (with CAPABILITY_EMPTY_SECTIONS)
+ *
+ * No chunk codec produces a one-byte payload, so it cannot be mistaken for block data.
+ */
+constexpr uint8_t EMPTY_SECTION_MARKER = 0xE0;
+
+/**
+ * @brief ENet channel assignment
+ *
+ * Reliable game state goes on channel 0. Frequent, self-superseding updates
+ * (movement, pings) go unreliable on channel 1 so they never wait behind a
+ * retransmitted chunk.
+ */
+constexpr uint8_t CHANNEL_RELIABLE = 0;
+constexpr uint8_t CHANNEL_UNRELIABLE = 1;
+
+/**
+ * @brief Compare wrapping sequence numbers
+ * @return true if a is newer than b (handles uint32_t wraparound)
+ */
+constexpr bool isSequenceNewer(uint32_t a, uint32_t b) {  // NOLINT(readability-identifier-length)
+    return static_cast<int32_t>(a - b) > 0;
+}
+
+/**
+ * @brief Pick the best mutual capability set for a connection
+ * @param clientCapabilities Bits advertised by the client
+ * @param serverCapabilities Bits the server is willing to use
+ * @return Bits both sides support (baseline codec is always kept)
+ */
+constexpr uint32_t negotiateCapabilities(uint32_t clientCapabilities, uint32_t serverCapabilities) {
+    return (clientCapabilities & serverCapabilities) | LEGACY_CAPABILITIES;
+}
+
 /**
  * @brief Network message types
  */
@@ -39,6 +110,11 @@ enum class MessageType : uint8_t {
     PlayerPositionUpdate = 14,  // NOLINT(readability-identifier-naming)
     PlayerRemove = 15,  // NOLINT(readability-identifier-naming)
     InventorySync = 16,  // NOLINT(readability-identifier-naming)
+    ServerCapabilities = 17,  // NOLINT(readability-identifier-naming)
+    MoveRateHint = 18,  // NOLINT(readability-identifier-naming)
+    ChunkColumnData = 19,  // NOLINT(readability-identifier-naming)
+    BlockUpdateBatch = 22,  // NOLINT(readability-identifier-naming)
+    PlayerCorrection = 23,  // NOLINT(readability-identifier-naming)
 
     // Bidirectional
     Disconnect = 20,  // NOLINT(readability-identifier-naming)
@@ -65,6 +141,30 @@ struct ClientJoinMessage {
 } PACKED;
 PACK_END
 
+/**
+ * @brief Capability advertisement (client -> server)
+ *
+ * Appended directly after ClientJoinMessage by version 2+ clients. Older
+ * servers ignore the trailing bytes, older clients simply never send it.
+ */
+PACK_BEGIN
+struct ClientCapabilitiesMessage {
+    uint32_t supportedCapabilities; ///< Bitset of CAPABILITY_* flags the client understands
+} PACKED;
+PACK_END
+
+/**
+ * @brief Negotiated capability set (server -> client)
+ *
+ * Only sent to clients that advertised capabilities in their join request.
+ */
+PACK_BEGIN
+struct ServerCapabilitiesMessage {
+    uint32_t protocolVersion;       ///< Server protocol version number
+    uint32_t enabledCapabilities;   ///< Bitset of CAPABILITY_* flags in use for this connection
+} PACKED;
+PACK_END
+
 /**
  * @brief Player movement update (client -> server)
  */
@@ -78,6 +178,59 @@ struct PlayerMoveMessage {
 } PACKED;
 PACK_END
 
+/**
+ * @brief Input sequence trailer for PlayerMoveMessage (client -> server)
+ *
+ * Appended after PlayerMoveMessage when CAPABILITY_UNRELIABLE_MOVEMENT is
+ * negotiated. The move is then sent unreliably and the server drops any
+ * move whose sequence is not newer than the last one applied.
+ */
+PACK_BEGIN
+struct PlayerMoveSequenceMessage {
+    uint32_t inputSequence;     ///< Incremented by the client for every move sent
+} PACKED;
+PACK_END
+
+/**
+ * @brief Correction acknowledgement trailer for PlayerMoveMessage (client -> server)
+ *
+ * Appended after PlayerMoveSequenceMessage when CAPABILITY_MOVE_CORRECTION
+ * is negotiated. The server sends no further correction until a move
+ * acknowledges the last one, since moves sent before it arrived were made
+ * from the position it replaced.
+ */
+PACK_BEGIN
+struct PlayerMoveAckMessage {
+    uint32_t correctionSequence;  ///< inputSequence of the last PlayerCorrection applied (0 = none)
+} PACKED;
+PACK_END
+
+/**
+ * @brief Authoritative position after the server resolved a move differently (server -> client)
+ *
+ * Only sent when CAPABILITY_MOVE_CORRECTION is negotiated, on the reliable
+ * channel. The client moves to position and replays the moves it sent
+ * after inputSequence from there.
+ */
+PACK_BEGIN
+struct PlayerCorrectionMessage {
+    uint32_t inputSequence;     ///< Sequence of the move the server resolved to position
+    glm::vec3 position;         ///< Where the server put the player after that move
+} PACKED;
+PACK_END
+
+/**
+ * @brief Movement send rate hint (server -> client)
+ *
+ * Only sent when CAPABILITY_UNRELIABLE_MOVEMENT is negotiated. The server
+ * raises the interval when it is under load.
+ */
+PACK_BEGIN
+struct MoveRateHintMessage {
+    uint16_t moveIntervalMs;    ///< Minimum time between PlayerMove messages in milliseconds
+} PACKED;
+PACK_END
+
 /**
  * @brief Block placement (client -> server)
  */
@@ -100,7 +253,8 @@ PACK_END
 /**
  * @brief Chunk data header (server -> client)
  *
- * Followed by compressed chunk data
+ * Followed by compressed chunk data. With CAPABILITY_CHUNK_LIGHT the
+ * chunk's light data follows the block data, up to the end of the message.
  */
 PACK_BEGIN
 struct ChunkDataMessage {
@@ -110,6 +264,37 @@ struct ChunkDataMessage {
 } PACKED;
 PACK_END
 
+/**
+ * @brief Chunk column header (server -> client, with CAPABILITY_COLUMN_BATCH)
+ *
+ * Carries every unsent section of one (x, z) column in a single reliable
+ * packet. Followed by heightmapSize bytes of column heightmap
+ * (ChunkSerializer::serializeHeightmap, covering every level of the world),
+ * then sectionCount ColumnSectionHeader + payload pairs. Section payloads
+ * use the same encoding as ChunkData for the negotiated capabilities.
+ */
+PACK_BEGIN
+struct ChunkColumnDataMessage {
+    int32_t chunkX = 0;         ///< Column X in chunks
+    int32_t chunkZ = 0;         ///< Column Z in chunks
+    uint16_t sectionCount = 0;  ///< Number of sections that follow
+    uint16_t heightmapSize = 0; ///< Size of the heightmap that follows in bytes
+} PACKED;
+PACK_END
+
+/**
+ * @brief One section inside a ChunkColumnData message
+ *
+ * With CAPABILITY_CHUNK_LIGHT the section data is followed by a uint32_t
+ * light data size and the section's light data.
+ */
+PACK_BEGIN
+struct ColumnSectionHeader {
+    int32_t chunkY = 0;         ///< Section level
+    uint32_t dataSize = 0;      ///< Size of the section payload that follows in bytes
+} PACKED;
+PACK_END
+
 /**
  * @brief Chunk unload notification (server -> client)
  */
@@ -129,6 +314,19 @@ struct BlockUpdateMessage {
 } PACKED;
 PACK_END
 
+/**
+ * @brief Batch of block updates (server -> client, with CAPABILITY_BLOCK_BATCH)
+ *
+ * Followed by count BlockUpdateMessage entries, applied in order. Used for
+ * block changes the server makes itself (falling blocks), so the client
+ * relights and remeshes once per batch instead of once per block.
+ */
+PACK_BEGIN
+struct BlockUpdateBatchMessage {
+    uint16_t count = 0;         ///< Number of BlockUpdateMessage entries that follow
+} PACKED;
+PACK_END
+
 /**
  * @brief Player spawn data (server -> client)
  */
@@ -152,6 +350,19 @@ struct PlayerPositionUpdateMessage {
 } PACKED;
 PACK_END
 
+/**
+ * @brief Move interval trailer for PlayerPositionUpdateMessage (server -> client)
+ *
+ * Appended when CAPABILITY_POSITION_INTERVAL is negotiated, so the receiver
+ * can render the player far enough in the past to always have an update
+ * to interpolate towards.
+ */
+PACK_BEGIN
+struct PlayerPositionIntervalMessage {
+    uint16_t moveIntervalMs;    ///< Interval the moving player was last asked to send moves at (0 = unknown)
+} PACKED;
+PACK_END
+
 /**
  * @brief Player removal notification (server -> client)
  */
@@ -163,10 +374,14 @@ PACK_END
 
 /**
  * @brief Keep-alive ping (bidirectional)
+ *
+ * Either side may send a ping; the receiver echoes it back unchanged with
+ * isReply set, and the original sender measures RTT from the timestamp.
  */
 PACK_BEGIN
 struct KeepAliveMessage {
-    uint64_t timestamp;         ///< Unix timestamp in milliseconds for RTT measurement
+    uint64_t timestamp;         ///< Sender's steady clock in microseconds (opaque to the receiver)
+    uint8_t isReply;            ///< 0 = ping, 1 = echo of a received ping
 } PACKED;
 PACK_END
 
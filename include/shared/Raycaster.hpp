@@ -0,0 +1,86 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <functional>
+#include <optional>
+#include <vector>
+#include "shared/Block.hpp"
+#include "shared/Chunk.hpp"
+#include "shared/ChunkCoord.hpp"
+
+namespace engine {
+
+/**
+ * @brief Result of a raycast operation
+ */
+struct RaycastHit {
+    glm::ivec3 blockPos;      ///< Position of the hit block
+    glm::ivec3 placePos;      ///< Position where a new block should be placed (blockPos + normal)
+    glm::ivec3 normal;        ///< Face normal of the hit (-1, 0, or 1 for each axis)
+    glm::vec3 hitPoint;       ///< Exact hit point on the block face
+    float distance;           ///< Distance from ray origin to hit point
+    BlockType blockType;      ///< Type of block that was hit
+};
+
+/**
+ * @brief One ray of a Raycaster::castMany() batch
+ */
+struct Ray {
+    glm::vec3 origin;      ///< Ray origin in world space
+    glm::vec3 direction;   ///< Ray direction (normalized by the cast)
+    float maxDistance;     ///< Maximum ray distance
+};
+
+/**
+ * @brief Voxel raycasting using DDA algorithm (Amanatides & Woo)
+ *
+ * Implements "A Fast Voxel Traversal Algorithm for Ray Tracing"
+ * Efficiently traverses voxel grid to find ray-block intersections
+ *
+ * The traversal keeps a cursor on the current chunk and steps local block
+ * coordinates, so chunks are looked up only when the ray crosses into one.
+ * Voxels inside a missing or empty chunk, an empty 8x8x8 brick (see
+ * Chunk::isBrickEmpty()) or a uniform brick of a non-solid block are
+ * stepped through without reading blocks. Unloaded chunks are treated as
+ * air.
+ *
+ * Lives in the shared library so the server can cast the same rays as
+ * clients (e.g. to check what a player can reach).
+ */
+class Raycaster {
+public:
+    /**
+     * @brief Finds a loaded chunk (nullptr if not loaded)
+     */
+    using ChunkLookup = std::function<const Chunk*(const ChunkCoord&)>;
+
+    /**
+     * @brief Cast a ray through the voxel world
+     *
+     * @param origin Ray origin in world space
+     * @param direction Ray direction (should be normalized)
+     * @param maxDistance Maximum ray distance
+     * @param lookup Finds the chunks the ray passes through
+     * @return RaycastHit if a solid block was hit, std::nullopt otherwise
+     */
+    static std::optional<RaycastHit> cast(
+        const glm::vec3& origin,
+        const glm::vec3& direction,
+        float maxDistance,
+        const ChunkLookup& lookup
+    );
+
+    /**
+     * @brief Cast a batch of rays
+     *
+     * Rays share one chunk cursor, so consecutive rays starting in the same
+     * chunk (e.g. every action of one player) skip the lookup. Cast rays
+     * from the same area next to each other.
+     * @param rays Rays to cast
+     * @param lookup Finds the chunks the rays pass through
+     * @return One result per ray, in order
+     */
+    static std::vector<std::optional<RaycastHit>> castMany(const std::vector<Ray>& rays, const ChunkLookup& lookup);
+};
+
+} // namespace engine
@@ -3,13 +3,15 @@
 #include <vulkan/vulkan.h>
 #include <glm/glm.hpp>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 
 namespace engine {
 
 /**
  * @brief Vertex data structure for 3D geometry
  *
- * Contains position, color, and normal data for each vertex.
+ * Contains position, color, normal, texture and ambient occlusion data for each vertex.
  * Provides Vulkan binding and attribute descriptions for the graphics pipeline.
  */
 struct Vertex {
@@ -19,6 +21,7 @@ struct Vertex {
     glm::vec2 texCoord;     ///< Texture coordinates (UV, tiled for greedy meshing)
     glm::vec2 atlasOffset;  ///< Texture atlas offset (uvMin)
     glm::vec2 atlasSize;    ///< Texture atlas size for this block type
+    uint32_t ambientOcclusion = 3;  ///< Corner occlusion, 0 (darkest) to 3 (open)
 
     /**
      * @brief Get the Vulkan vertex input binding description
@@ -34,10 +37,10 @@ struct Vertex {
 
     /**
      * @brief Get the Vulkan vertex attribute descriptions
-     * @return Array of attribute descriptions for position, color, normal, texCoord, atlasOffset, and atlasSize
+     * @return Array of attribute descriptions for position, color, normal, texCoord, atlasOffset, atlasSize, and ambientOcclusion
      */
-    static std::array<VkVertexInputAttributeDescription, 6> getAttributeDescriptions() {
-        std::array<VkVertexInputAttributeDescription, 6> attributeDescriptions{};
+    static std::array<VkVertexInputAttributeDescription, 7> getAttributeDescriptions() {
+        std::array<VkVertexInputAttributeDescription, 7> attributeDescriptions{};
 
         // Position
         attributeDescriptions[0].binding = 0;
@@ -75,6 +78,12 @@ struct Vertex {
         attributeDescriptions[5].format = VK_FORMAT_R32G32_SFLOAT;
         attributeDescriptions[5].offset = offsetof(Vertex, atlasSize);
 
+        // Ambient occlusion
+        attributeDescriptions[6].binding = 0;
+        attributeDescriptions[6].location = 6;
+        attributeDescriptions[6].format = VK_FORMAT_R32_UINT;
+        attributeDescriptions[6].offset = offsetof(Vertex, ambientOcclusion);
+
         return attributeDescriptions;
     }
 };
@@ -14,6 +14,7 @@ layout(location = 2) in vec3 inNormal;
 layout(location = 3) in vec2 inTexCoord;
 layout(location = 4) in vec2 inAtlasOffset;
 layout(location = 5) in vec2 inAtlasSize;
+layout(location = 6) in uint inAmbientOcclusion;
 
 layout(location = 0) out vec3 fragColor;
 layout(location = 1) out vec3 fragNormal;
@@ -24,6 +25,9 @@ layout(location = 5) out vec2 fragTexCoord;
 layout(location = 6) out vec2 fragAtlasOffset;
 layout(location = 7) out vec2 fragAtlasSize;
 
+// Brightness per ambient occlusion level (0 = corner closed in, 3 = open)
+const float AO_BRIGHTNESS[4] = float[](0.45, 0.65, 0.82, 1.0);
+
 void main() {
     vec4 worldPos = ubo.model * vec4(inPosition, 1.0);
     fragPos = worldPos.xyz;
@@ -31,7 +35,7 @@ void main() {
     // Transform normal to world space
     fragNormal = mat3(transpose(inverse(ubo.model))) * inNormal;
 
-    fragColor = inColor;
+    fragColor = inColor * AO_BRIGHTNESS[min(inAmbientOcclusion, 3u)];
     fragLightPos = ubo.lightPos.xyz;
     fragViewPos = ubo.viewPos.xyz;
     fragTexCoord = inTexCoord;
@@ -0,0 +1,102 @@
+#include "bench/Benchmarks.hpp"
+#include "core/Logger.hpp"
+#include "core/CrashHandler.hpp"
+#include "server/World.hpp"
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief A benchmark that can be picked on the command line
+ */
+struct BenchmarkEntry {
+    std::string name;         ///< Command-line name
+    std::string description;  ///< Shown by --help
+    std::function<void()> run;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    engine::Logger::init("TidalBench", "logs/bench.log");
+    engine::CrashHandler::init();
+
+    // Light, collision and raycast benchmarks copy the generated chunks around spawn out of this world
+    std::unique_ptr<engine::World> world;
+    auto spawnWorld = [&world]() -> engine::World& {
+        if (!world) {
+            world = std::make_unique<engine::World>();
+        }
+        return *world;
+    };
+
+    const std::vector<BenchmarkEntry> benchmarks = {
+        {"light", "Time fresh-chunk and single-edit relighting around spawn",
+         [&spawnWorld]() { engine::bench::runLightBenchmark(spawnWorld(), 2, 64); }},
+        {"collision", "Time swept player collision moves around spawn",
+         [&spawnWorld]() { engine::bench::runCollisionBenchmark(spawnWorld(), 2, 200000); }},
+        {"raycast", "Time block-reach raycasts around spawn",
+         [&spawnWorld]() { engine::bench::runRaycastBenchmark(spawnWorld(), 2, 200000); }},
+        {"fall", "Time a 64x64x4 sand slab collapsing",
+         []() { engine::bench::runFallingBlockBenchmark(64, 4); }},
+        {"tick", "Time a million scheduled block ticks",
+         []() { engine::bench::runBlockTickBenchmark(1000000); }},
+        {"region", "Time parallel region ticking from 1 worker to one per core",
+         []() { engine::bench::runRegionTickBenchmark(4, 20); }},
+        {"player", "Time the per-tick player loops for 500 players (hash map, player store, spatial grid)",
+         []() { engine::bench::runPlayerLoopBenchmark(500, 200); }},
+        {"profile", "Time 1000 players' profile loads and saves, one file each vs the profile log",
+         []() { engine::bench::runProfileLoadBenchmark(1000, 1000.0 / 40.0); }},
+        {"mesh", "Time client chunk meshing with and without ambient occlusion",
+         []() { engine::bench::runMeshBenchmark(6, 5); }},
+    };
+
+    // Run the benchmarks named on the command line, or all of them
+    std::vector<const BenchmarkEntry*> selected;
+    for (int i = 1; i < argc; i++) {
+        std::string name = argv[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const BenchmarkEntry* match = nullptr;
+        for (const BenchmarkEntry& benchmark : benchmarks) {
+            if (benchmark.name == name) {
+                match = &benchmark;
+            }
+        }
+
+        if (match == nullptr) {
+            if (name != "--help") {
+                LOG_ERROR("Unknown benchmark: {}", name);
+            }
+            LOG_INFO("Usage: TidalBench [benchmark...] (runs all of them by default)");
+            for (const BenchmarkEntry& benchmark : benchmarks) {
+                LOG_INFO("  {:<10} {}", benchmark.name, benchmark.description);
+            }
+            engine::Logger::shutdown();
+            return name == "--help" ? 0 : 1;
+        }
+        selected.push_back(match);
+    }
+    if (selected.empty()) {
+        for (const BenchmarkEntry& benchmark : benchmarks) {
+            selected.push_back(&benchmark);
+        }
+    }
+
+    try {
+        for (const BenchmarkEntry* benchmark : selected) {
+            benchmark->run();
+        }
+    } catch (const std::exception& e) {
+        LOG_CRITICAL("Benchmark failed: {}", e.what());
+        engine::CrashHandler::logStackTrace();
+        engine::Logger::shutdown();
+        return 1;
+    }
+
+    engine::Logger::shutdown();
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include "bench/Benchmarks.hpp"
+#include "client/ChunkMesh.hpp"
+#include "core/Logger.hpp"
+#include "shared/Chunk.hpp"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::bench {
+
+void runMeshBenchmark(int32_t columnSpan, uint32_t rounds) {
+    constexpr int32_t LEVELS = 2;              // Chunk levels per column
+    constexpr int32_t SURFACE = 32;            // Average terrain height in blocks
+    constexpr double CAVE_CHANCE = 0.08;       // Share of underground blocks left as air
+    if (columnSpan <= 0 || rounds == 0) {
+        return;
+    }
+
+    // Rolling hills with scattered caves, so most faces have occluders nearby
+    std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>> chunks;
+    std::mt19937 rng(12345);  // NOLINT(cert-msc32-c,cert-msc51-cpp) - fixed seed for repeatable runs
+    std::uniform_int_distribution<int32_t> bump(0, 2);
+    std::bernoulli_distribution cave(CAVE_CHANCE);
+    constexpr auto EXTENT = static_cast<int32_t>(CHUNK_SIZE);
+    for (int32_t chunkX = 0; chunkX < columnSpan; chunkX++) {
+        for (int32_t chunkZ = 0; chunkZ < columnSpan; chunkZ++) {
+            for (int32_t chunkY = 0; chunkY < LEVELS; chunkY++) {
+                auto chunk = std::make_unique<Chunk>(ChunkCoord{chunkX, chunkY, chunkZ});
+                ChunkBlocks blocks{};
+                // NOLINTNEXTLINE(readability-identifier-length)
+                for (int32_t x = 0; x < EXTENT; x++) {
+                    // NOLINTNEXTLINE(readability-identifier-length)
+                    for (int32_t z = 0; z < EXTENT; z++) {
+                        int32_t worldX = (chunkX * EXTENT) + x;
+                        int32_t worldZ = (chunkZ * EXTENT) + z;
+                        int32_t height = SURFACE + bump(rng) +
+                                         static_cast<int32_t>(std::lround(10.0 * std::sin(worldX * 0.11) * std::cos(worldZ * 0.07)));
+                        // NOLINTNEXTLINE(readability-identifier-length)
+                        for (int32_t y = 0; y < EXTENT; y++) {
+                            int32_t worldY = (chunkY * EXTENT) + y;
+                            BlockType type = BlockType::Air;
+                            if (worldY < height - 3) {
+                                type = cave(rng) ? BlockType::Air : BlockType::Stone;
+                            } else if (worldY < height) {
+                                type = BlockType::Dirt;
+                            } else if (worldY == height) {
+                                type = BlockType::Grass;
+                            }
+                            blocks[Chunk::getIndex(static_cast<uint32_t>(x), static_cast<uint32_t>(y), static_cast<uint32_t>(z))].type = type;
+                        }
+                    }
+                }
+                chunk->setBlockData(blocks);
+                chunks.emplace(chunk->getCoord(), std::move(chunk));
+            }
+        }
+    }
+
+    struct Job {
+        const Chunk* chunk;
+        std::array<const Chunk*, BLOCK_FACE_COUNT> neighbors;
+    };
+    auto find = [&chunks](const ChunkCoord& coord) -> const Chunk* {
+        auto chunkIt = chunks.find(coord);
+        return chunkIt != chunks.end() ? chunkIt->second.get() : nullptr;
+    };
+    std::vector<Job> jobs;
+    for (const auto& [coord, chunk] : chunks) {
+        if (chunk->isEmpty()) {
+            continue;
+        }
+        jobs.push_back({chunk.get(),
+                        {find({coord.x - 1, coord.y, coord.z}), find({coord.x + 1, coord.y, coord.z}),
+                         find({coord.x, coord.y - 1, coord.z}), find({coord.x, coord.y + 1, coord.z}),
+                         find({coord.x, coord.y, coord.z - 1}), find({coord.x, coord.y, coord.z + 1})}});
+    }
+
+    // Rounds alternate between the two modes so caches and clocks affect both alike
+    std::array<uint64_t, 2> micros{};
+    std::array<size_t, 2> quads{};
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    for (uint32_t round = 0; round < rounds; round++) {
+        for (bool occluded : {false, true}) {
+            size_t roundQuads = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (const Job& job : jobs) {
+                roundQuads += ChunkMesh::generateMesh(*job.chunk, vertices, indices, nullptr,
+                                                      job.neighbors[0], job.neighbors[1], job.neighbors[2],
+                                                      job.neighbors[3], job.neighbors[4], job.neighbors[5], occluded) / 4;
+            }
+            micros[occluded ? 1 : 0] += static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+            quads[occluded ? 1 : 0] = roundQuads;
+        }
+    }
+
+    auto roundCount = static_cast<double>(rounds);
+    double plainMs = static_cast<double>(micros[0]) / 1000.0 / roundCount;
+    double occludedMs = static_cast<double>(micros[1]) / 1000.0 / roundCount;
+    LOG_INFO("Mesh benchmark: {} chunks x {} rounds of rough terrain", jobs.size(), rounds);
+    LOG_INFO("  without AO: {:.2f} ms/round, {} quads | with AO: {:.2f} ms/round, {} quads ({:+.1f}%)",
+             plainMs, quads[0], occludedMs, quads[1], plainMs > 0.0 ? (occludedMs - plainMs) * 100.0 / plainMs : 0.0);
+}
+
+} // namespace engine::bench
@@ -0,0 +1,396 @@
+#include "bench/Benchmarks.hpp"
+#include "core/Logger.hpp"
+#include "server/ChunkViewWindow.hpp"
+#include "server/GameServer.hpp"
+#include "server/PlayerProfileStore.hpp"
+#include "server/PlayerStore.hpp"
+#include "shared/Chunk.hpp"
+#include "shared/Protocol.hpp"
+
+#include <enet/enet.h>
+#include <glm/glm.hpp>
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::bench {
+
+void runPlayerLoopBenchmark(size_t playerCount, size_t tickCount) {
+    constexpr float SPREAD = 2048.0f;        // Players are spread over this many blocks in X and Z
+    constexpr size_t CHANGES_PER_TICK = 64;  // Server block changes checked against every view
+    if (playerCount == 0 || tickCount == 0) {
+        return;
+    }
+
+    // The previous layout: the whole player record in a hash map node keyed by peer
+    struct MappedPlayer {
+        uint32_t playerId = 0;
+        glm::vec3 position{0.0f};
+        float yaw = 0.0f;
+        float pitch = 0.0f;
+        uint32_t capabilities = 0;
+        PlayerSession session;
+    };
+
+    /**
+     * @brief Time per phase of one layout, and a checksum both layouts must agree on
+     */
+    struct Timing {
+        double move = 0.0;       ///< Apply moves and fan position updates out to every other player
+        double interest = 0.0;   ///< Check block changes against every player's view
+        double retention = 0.0;  ///< Collect positions for the chunk retention pass
+        double save = 0.0;       ///< Serialize every player
+        uint64_t checksum = 0;
+    };
+
+    std::mt19937 rng(12345);  // NOLINT(cert-msc32-c,cert-msc51-cpp) - fixed seed for repeatable runs
+    std::uniform_real_distribution<float> horizontal(0.0f, SPREAD);
+    std::uniform_real_distribution<float> step(-0.5f, 0.5f);
+    std::uniform_int_distribution<int32_t> changeHorizontal(0, static_cast<int32_t>(SPREAD) - 1);
+    std::uniform_int_distribution<int32_t> changeVertical(0, (4 * static_cast<int32_t>(CHUNK_SIZE)) - 1);
+
+    std::vector<ENetPeer> peerStorage(playerCount);  // Only their addresses are used
+    std::vector<glm::vec3> moves(playerCount);       // Per player, alternating direction each tick
+    std::unordered_map<ENetPeer*, MappedPlayer> mapped;
+    PlayerStore store;
+    std::vector<ChunkCoord> leaving;
+
+    // Views cover four levels, with every chunk in them sent
+    auto fillView = [&leaving](ChunkViewWindow& view, const glm::vec3& position) {
+        view = ChunkViewWindow(GameServer::CHUNK_LOAD_RADIUS, 0, 3);
+        view.recenter(ChunkCoord::fromWorldPos(position), leaving);
+        ChunkCoord coord{};
+        while (view.nextUnsent(coord)) {
+            view.markSent(coord);
+        }
+    };
+
+    for (size_t player = 0; player < playerCount; player++) {
+        ENetPeer* peer = &peerStorage[player];
+        auto playerId = static_cast<uint32_t>(player + 1);
+        glm::vec3 position(horizontal(rng), 64.0f, horizontal(rng));
+        moves[player] = glm::vec3(step(rng), 0.0f, step(rng));
+
+        MappedPlayer& record = mapped[peer];
+        record.playerId = playerId;
+        record.position = position;
+        record.session.playerName = "Bench_" + std::to_string(playerId);
+        fillView(record.session.view, position);
+
+        uint32_t index = store.indexOf(store.add(peer, playerId));
+        store.setPose(index, position, 0.0f, 0.0f);
+        store.getSession(index).playerName = record.session.playerName;
+        fillView(store.getSession(index).view, position);
+    }
+
+    std::vector<ChunkCoord> changedChunks(CHANGES_PER_TICK);
+    for (ChunkCoord& coord : changedChunks) {
+        coord = ChunkCoord::fromWorldPos(glm::vec3(changeHorizontal(rng), changeVertical(rng), changeHorizontal(rng)));
+    }
+
+    auto secondsSince = [](std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    auto positionSum = [](const std::vector<glm::vec3>& positions) {
+        uint64_t sum = 0;
+        for (const glm::vec3& position : positions) {
+            sum += static_cast<uint64_t>(static_cast<int64_t>(position.x) + static_cast<int64_t>(position.z));
+        }
+        return sum;
+    };
+    auto serialize = [](const std::string& playerName, const glm::vec3& position, float yaw, float pitch,
+                        const PlayerSession& session, std::vector<uint8_t>& out) {
+        auto append = [&out](const void* data, size_t size) {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            out.insert(out.end(), bytes, bytes + size);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        };
+        auto nameLength = static_cast<uint32_t>(playerName.size());
+        auto selectedSlot = static_cast<uint32_t>(session.selectedHotbarSlot);
+        append(&nameLength, sizeof(nameLength));
+        append(playerName.data(), nameLength);
+        append(&position, sizeof(position));
+        append(&yaw, sizeof(yaw));
+        append(&pitch, sizeof(pitch));
+        append(&selectedSlot, sizeof(selectedSlot));
+        append(session.hotbar.data(), session.hotbar.size() * sizeof(ItemStack));
+    };
+
+    // Position updates are queued per recipient, standing in for the ENet send queues
+    struct QueuedUpdate {
+        ENetPeer* peer;
+        protocol::PlayerPositionUpdateMessage message;
+    };
+    std::vector<QueuedUpdate> outgoing;
+    auto makeUpdate = [](uint32_t playerId, const glm::vec3& position) {
+        protocol::PlayerPositionUpdateMessage update{};
+        update.playerId = playerId;
+        update.position = position;
+        return update;
+    };
+
+    std::vector<glm::vec3> positions;
+    std::vector<uint8_t> saveBuffer;
+
+    Timing mapTiming;
+    for (size_t tick = 0; tick < tickCount; tick++) {
+        float direction = (tick % 2 == 0) ? 1.0f : -1.0f;
+
+        auto start = std::chrono::steady_clock::now();
+        outgoing.clear();
+        for (auto& [peer, player] : mapped) {
+            player.position += moves[player.playerId - 1] * direction;
+            protocol::PlayerPositionUpdateMessage update = makeUpdate(player.playerId, player.position);
+            for (const auto& [otherPeer, other] : mapped) {
+                if (otherPeer != peer) {
+                    outgoing.push_back(QueuedUpdate{otherPeer, update});
+                }
+            }
+        }
+        mapTiming.move += secondsSince(start);
+        mapTiming.checksum += outgoing.size();
+
+        start = std::chrono::steady_clock::now();
+        for (const auto& [peer, player] : mapped) {
+            for (const ChunkCoord& coord : changedChunks) {
+                mapTiming.checksum += player.session.view.isSent(coord) ? 1 : 0;
+            }
+        }
+        mapTiming.interest += secondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        positions.clear();
+        for (const auto& [peer, player] : mapped) {
+            positions.push_back(player.position);
+        }
+        mapTiming.checksum += positionSum(positions);
+        mapTiming.retention += secondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        saveBuffer.clear();
+        for (const auto& [peer, player] : mapped) {
+            serialize(player.session.playerName, player.position, player.yaw, player.pitch, player.session, saveBuffer);
+        }
+        mapTiming.checksum += saveBuffer.size();
+        mapTiming.save += secondsSince(start);
+    }
+
+    Timing storeTiming;
+    const std::vector<ENetPeer*>& peers = store.getPeers();
+    for (size_t tick = 0; tick < tickCount; tick++) {
+        float direction = (tick % 2 == 0) ? 1.0f : -1.0f;
+
+        auto start = std::chrono::steady_clock::now();
+        outgoing.clear();
+        for (uint32_t index = 0; index < store.size(); index++) {
+            uint32_t playerId = store.getPlayerId(index);
+            glm::vec3 position = store.getPosition(index) + (moves[playerId - 1] * direction);
+            store.setPose(index, position, store.getYaw(index), store.getPitch(index));
+            protocol::PlayerPositionUpdateMessage update = makeUpdate(playerId, position);
+            for (uint32_t other = 0; other < peers.size(); other++) {
+                if (other != index) {
+                    outgoing.push_back(QueuedUpdate{peers[other], update});
+                }
+            }
+        }
+        storeTiming.move += secondsSince(start);
+        storeTiming.checksum += outgoing.size();
+
+        start = std::chrono::steady_clock::now();
+        for (uint32_t index = 0; index < store.size(); index++) {
+            const ChunkViewWindow& view = store.getSession(index).view;
+            for (const ChunkCoord& coord : changedChunks) {
+                storeTiming.checksum += view.isSent(coord) ? 1 : 0;
+            }
+        }
+        storeTiming.interest += secondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        storeTiming.checksum += positionSum(store.getPositions());
+        storeTiming.retention += secondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        saveBuffer.clear();
+        for (uint32_t index = 0; index < store.size(); index++) {
+            const PlayerSession& session = store.getSession(index);
+            serialize(session.playerName, store.getPosition(index), store.getYaw(index), store.getPitch(index),
+                      session, saveBuffer);
+        }
+        storeTiming.checksum += saveBuffer.size();
+        storeTiming.save += secondsSince(start);
+    }
+
+    // Same store, but movement and block changes only go to players in view (spatial grid lookups)
+    Timing gridTiming;
+    gridTiming.retention = storeTiming.retention;
+    gridTiming.save = storeTiming.save;
+    constexpr float ANY_HEIGHT = std::numeric_limits<float>::max();
+    std::vector<uint32_t> nearby;
+    uint64_t recipients = 0;
+    for (size_t tick = 0; tick < tickCount; tick++) {
+        float direction = (tick % 2 == 0) ? 1.0f : -1.0f;
+
+        auto start = std::chrono::steady_clock::now();
+        outgoing.clear();
+        for (uint32_t index = 0; index < store.size(); index++) {
+            uint32_t playerId = store.getPlayerId(index);
+            glm::vec3 position = store.getPosition(index) + (moves[playerId - 1] * direction);
+            store.setPose(index, position, store.getYaw(index), store.getPitch(index));
+            protocol::PlayerPositionUpdateMessage update = makeUpdate(playerId, position);
+            nearby.clear();
+            store.findInBox(glm::vec3(position.x - GameServer::INTEREST_RADIUS, -ANY_HEIGHT, position.z - GameServer::INTEREST_RADIUS),
+                            glm::vec3(position.x + GameServer::INTEREST_RADIUS, ANY_HEIGHT, position.z + GameServer::INTEREST_RADIUS), nearby);
+            for (uint32_t other : nearby) {
+                if (other != index) {
+                    outgoing.push_back(QueuedUpdate{peers[other], update});
+                }
+            }
+        }
+        gridTiming.move += secondsSince(start);
+        gridTiming.checksum += outgoing.size();
+        recipients += outgoing.size();
+
+        start = std::chrono::steady_clock::now();
+        for (const ChunkCoord& coord : changedChunks) {
+            glm::vec3 center = (glm::vec3(coord.x, coord.y, coord.z) + 0.5f) * static_cast<float>(CHUNK_SIZE);
+            nearby.clear();
+            store.findInBox(glm::vec3(center.x - GameServer::INTEREST_RADIUS, -ANY_HEIGHT, center.z - GameServer::INTEREST_RADIUS),
+                            glm::vec3(center.x + GameServer::INTEREST_RADIUS, ANY_HEIGHT, center.z + GameServer::INTEREST_RADIUS), nearby);
+            for (uint32_t index : nearby) {
+                gridTiming.checksum += store.getSession(index).view.isSent(coord) ? 1 : 0;
+            }
+        }
+        gridTiming.interest += secondsSince(start);
+    }
+
+    auto microsPerTick = [tickCount](double seconds) { return seconds * 1e6 / static_cast<double>(tickCount); };
+    auto logTiming = [&microsPerTick](const char* layout, const Timing& timing) {
+        LOG_INFO("  {:<10} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f}", layout,
+                 microsPerTick(timing.move), microsPerTick(timing.interest),
+                 microsPerTick(timing.retention), microsPerTick(timing.save),
+                 microsPerTick(timing.move + timing.interest + timing.retention + timing.save));
+    };
+
+    LOG_INFO("Player loop benchmark: {} players, {} ticks, {} block changes per tick (us per tick)",
+             playerCount, tickCount, CHANGES_PER_TICK);
+    LOG_INFO("  {:<10} {:>10} {:>10} {:>10} {:>10} {:>10}", "Layout", "Move", "Interest", "Retention", "Save", "Total");
+    logTiming("Hash map", mapTiming);
+    logTiming("Store", storeTiming);
+    logTiming("Store+grid", gridTiming);
+    LOG_INFO("  Grid: {:.1f} of {} players in view per move", static_cast<double>(recipients) / static_cast<double>(tickCount * playerCount),
+             playerCount - 1);
+    if (mapTiming.checksum != storeTiming.checksum) {
+        LOG_ERROR("Player loop benchmark: checksums differ (map {:016x}, store {:016x})",
+                  mapTiming.checksum, storeTiming.checksum);
+    }
+}
+
+void runProfileLoadBenchmark(size_t playerCount, double tickBudgetMs) {
+    using Clock = std::chrono::steady_clock;
+    if (playerCount == 0) {
+        return;
+    }
+    auto millisSince = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    std::error_code error;
+    std::filesystem::path root = std::filesystem::temp_directory_path(error) / "tidal_profile_bench";
+    std::filesystem::path fileDir = root / "files";
+    std::filesystem::path logDir = root / "log";
+    std::filesystem::remove_all(root, error);
+    std::filesystem::create_directories(fileDir, error);
+    if (error) {
+        LOG_ERROR("Profile load benchmark: can't create {}: {}", fileDir.string(), error.message());
+        return;
+    }
+
+    std::vector<PlayerProfile> saved(playerCount);
+    for (size_t player = 0; player < playerCount; player++) {
+        saved[player].playerName = "bench_" + std::to_string(player);
+        saved[player].position = glm::vec3(static_cast<float>(player), 64.0f, static_cast<float>(player % 97));
+        saved[player].selectedHotbarSlot = static_cast<uint32_t>(player % 9);
+    }
+
+    // Saves: a blocking write per player (the previous path) vs queued appends
+    auto start = Clock::now();
+    for (const PlayerProfile& profile : saved) {
+        PlayerProfileStore::writeProfileFile(fileDir / (profile.playerName + ".dat"), profile);
+    }
+    double fileSaveMs = millisSince(start);
+
+    double logSaveCallerMs = 0.0;
+    double logSaveMs = 0.0;
+    uint64_t saveBatches = 0;
+    {
+        PlayerProfileStore store(logDir);
+        start = Clock::now();
+        for (const PlayerProfile& profile : saved) {
+            store.save(profile);
+        }
+        logSaveCallerMs = millisSince(start);
+        store.flush();
+        logSaveMs = millisSince(start);
+        saveBatches = store.getStats().batches;
+    }
+
+    // Join storm, previous path: exists() and a blocking read per player on the calling thread
+    size_t fileFound = 0;
+    start = Clock::now();
+    for (const PlayerProfile& profile : saved) {
+        std::filesystem::path path = fileDir / (profile.playerName + ".dat");
+        PlayerProfile loaded;
+        if (std::filesystem::exists(path, error) && PlayerProfileStore::readProfileFile(path, loaded)) {
+            fileFound++;
+        }
+    }
+    double fileLoadMs = millisSince(start);
+
+    // Join storm through a freshly opened store (so indexing the log is included), polled like a tick would
+    size_t logFound = 0;
+    double logCallerMs = 0.0;
+    double logLoadMs = 0.0;
+    {
+        PlayerProfileStore store(logDir);
+        std::vector<ProfileLoadResult> results;
+        results.reserve(playerCount);
+
+        start = Clock::now();
+        for (size_t player = 0; player < playerCount; player++) {
+            store.requestLoad(PlayerHandle{static_cast<uint32_t>(player), 0}, saved[player].playerName);
+        }
+        logCallerMs = millisSince(start);
+        while (results.size() < playerCount) {
+            auto pollStart = Clock::now();
+            store.pollLoads(results);
+            logCallerMs += millisSince(pollStart);
+            if (results.size() < playerCount) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+        logLoadMs = millisSince(start);
+
+        for (const ProfileLoadResult& result : results) {
+            if (result.found && result.profile.position == saved[result.player.slot].position) {
+                logFound++;
+            }
+        }
+    }
+    std::filesystem::remove_all(root, error);
+
+    LOG_INFO("Profile load benchmark: {} players joining at once (tick budget {:.1f} ms)",
+             playerCount, tickBudgetMs);
+    LOG_INFO("  {:<16} {:>12} {:>12} {:>8}", "Loads", "Caller ms", "Done ms", "Found");
+    LOG_INFO("  {:<16} {:>12.2f} {:>12.2f} {:>8}", "File per player", fileLoadMs, fileLoadMs, fileFound);
+    LOG_INFO("  {:<16} {:>12.2f} {:>12.2f} {:>8}", "Profile log", logCallerMs, logLoadMs, logFound);
+    LOG_INFO("  {:<16} {:>12.2f} {:>12.2f} {:>8}", "Saves: files", fileSaveMs, fileSaveMs, playerCount);
+    LOG_INFO("  {:<16} {:>12.2f} {:>12.2f} {:>8}", "Saves: log", logSaveCallerMs, logSaveMs, playerCount);
+    LOG_INFO("  Profile log wrote {} saves with {} flushes", playerCount, saveBatches);
+}
+
+} // namespace engine::bench
@@ -0,0 +1,527 @@
+#include "bench/Benchmarks.hpp"
+#include "core/Logger.hpp"
+#include "server/BlockTickScheduler.hpp"
+#include "server/FallingBlockSimulator.hpp"
+#include "server/RegionScheduler.hpp"
+#include "server/World.hpp"
+#include "shared/Chunk.hpp"
+#include "shared/ChunkOffsetTable.hpp"
+#include "shared/Collision.hpp"
+#include "shared/LightEngine.hpp"
+#include "shared/Raycaster.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace engine::bench {
+
+namespace {
+
+using ChunkCopies = std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>>;
+
+/**
+ * @brief Copy every level of the columns around spawn out of a world, loading them first if needed
+ *
+ * Copies share block buffers with the world, so this is cheap.
+ */
+ChunkCopies copyChunksAroundSpawn(World& world, int32_t columnRadius) {
+    ChunkCopies copies;
+    for (const auto& column : ChunkOffsetTable::get(columnRadius, 0).getColumns()) {
+        for (int32_t chunkY = world.getMinChunkY(); chunkY <= world.getMaxChunkY(); chunkY++) {
+            ChunkCoord coord{column.x, chunkY, column.z};
+            copies.emplace(coord, std::make_unique<Chunk>(world.loadChunk(coord)));
+        }
+    }
+    return copies;
+}
+
+} // namespace
+
+void runLightBenchmark(World& world, int32_t columnRadius, size_t editCount) {
+    ChunkCopies copies = copyChunksAroundSpawn(world, columnRadius);
+    if (copies.empty()) {
+        LOG_WARN("Light benchmark: no chunks around spawn");
+        return;
+    }
+
+    LightEngine engine([&copies](const ChunkCoord& coord) -> Chunk* {
+        auto chunkIt = copies.find(coord);
+        return chunkIt != copies.end() ? chunkIt->second.get() : nullptr;
+    });
+
+    for (const auto& [coord, chunk] : copies) {
+        engine.enqueueSection(coord);
+    }
+    engine.process();
+
+    // Place then break a block on the surface of each column, relighting after every edit
+    std::vector<uint64_t> editMicros;
+    editMicros.reserve(editCount * 2);
+    for (size_t edit = 0; edit < editCount; edit++) {
+        const auto& columns = ChunkOffsetTable::get(columnRadius, 0).getColumns();
+        const ChunkCoord& column = columns[edit % columns.size()];
+        glm::ivec3 worldPos{(column.x * static_cast<int32_t>(CHUNK_SIZE)) + static_cast<int32_t>(edit % CHUNK_SIZE), 1,
+                            (column.z * static_cast<int32_t>(CHUNK_SIZE)) + static_cast<int32_t>((edit * 7) % CHUNK_SIZE)};
+        ChunkCoord coord = ChunkCoord::fromWorldPos(glm::vec3(worldPos));
+        auto chunkIt = copies.find(coord);
+        if (chunkIt == copies.end()) {
+            continue;
+        }
+
+        glm::ivec3 local = worldPos - (glm::ivec3(coord.x, coord.y, coord.z) * static_cast<int32_t>(CHUNK_SIZE));
+        for (BlockType type : {BlockType::Stone, BlockType::Air}) {
+            Chunk& chunk = *chunkIt->second;
+            BlockType previous = std::as_const(chunk).getBlock(local.x, local.y, local.z).type;
+            chunk.setBlock(local.x, local.y, local.z, Block{type});
+            engine.enqueueEdit(worldPos, previous);
+
+            uint64_t before = engine.getStats().editMicrosTotal;
+            engine.process();
+            editMicros.push_back(engine.getStats().editMicrosTotal - before);
+        }
+    }
+
+    const LightEngine::Stats& stats = engine.getStats();
+    LOG_INFO("Light benchmark: {} fresh sections lit in {:.2f} ms ({:.0f} us/section)",
+             stats.sections, static_cast<double>(stats.sectionMicrosTotal) / 1000.0,
+             stats.sections > 0 ? static_cast<double>(stats.sectionMicrosTotal) / static_cast<double>(stats.sections) : 0.0);
+    if (!editMicros.empty()) {
+        std::sort(editMicros.begin(), editMicros.end());
+        LOG_INFO("  {} single-block relights: avg {:.0f} us, median {} us, max {} us",
+                 editMicros.size(),
+                 static_cast<double>(stats.editMicrosTotal) / static_cast<double>(editMicros.size()),
+                 editMicros[editMicros.size() / 2], editMicros.back());
+    }
+}
+
+void runCollisionBenchmark(World& world, int32_t columnRadius, size_t moveCount) {
+    ChunkCopies copies = copyChunksAroundSpawn(world, columnRadius);
+    if (copies.empty() || moveCount == 0) {
+        LOG_WARN("Collision benchmark: no chunks around spawn");
+        return;
+    }
+
+    CollisionResolver resolver([&copies](const ChunkCoord& coord) -> const Chunk* {
+        auto chunkIt = copies.find(coord);
+        return chunkIt != copies.end() ? chunkIt->second.get() : nullptr;
+    });
+
+    // Player-sized moves of up to a block per axis (a fast step between two
+    // move packets), starting from open positions in the copied area
+    std::mt19937 rng(12345);  // NOLINT(cert-msc32-c,cert-msc51-cpp) - fixed seed for repeatable runs
+    auto extent = static_cast<float>((columnRadius + 1) * static_cast<int32_t>(CHUNK_SIZE));
+    std::uniform_real_distribution<float> horizontal(-extent, extent);
+    std::uniform_real_distribution<float> vertical(static_cast<float>(world.getMinChunkY() * static_cast<int32_t>(CHUNK_SIZE)),
+                                                   static_cast<float>((world.getMaxChunkY() + 1) * static_cast<int32_t>(CHUNK_SIZE)));
+    std::uniform_real_distribution<float> step(-1.0f, 1.0f);
+
+    std::vector<std::pair<glm::vec3, glm::vec3>> moves;
+    moves.reserve(moveCount);
+    for (size_t attempt = 0; moves.size() < moveCount && attempt < moveCount * 16; attempt++) {
+        glm::vec3 eyePos(horizontal(rng), vertical(rng), horizontal(rng));
+        if (!resolver.overlapsSolid(playerBoxAt(eyePos))) {
+            moves.emplace_back(eyePos, glm::vec3(step(rng), step(rng), step(rng)));
+        }
+    }
+    if (moves.empty()) {
+        LOG_WARN("Collision benchmark: no open space around spawn");
+        return;
+    }
+
+    // Warm-up pass builds every solidity mask, so the timed pass measures steady state
+    auto buildStart = std::chrono::steady_clock::now();
+    for (const auto& [eyePos, displacement] : moves) {
+        resolver.move(playerBoxAt(eyePos), displacement);
+    }
+    auto buildMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - buildStart).count();
+
+    size_t blockedMoves = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& [eyePos, displacement] : moves) {
+        CollisionResolver::MoveResult result = resolver.move(playerBoxAt(eyePos), displacement);
+        if (glm::any(result.blocked)) {
+            blockedMoves++;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    LOG_INFO("Collision benchmark: {} moves over {} chunks in {:.2f} ms ({:.2f} M moves/s on one core)",
+             moves.size(), copies.size(), seconds * 1000.0,
+             seconds > 0.0 ? static_cast<double>(moves.size()) / seconds / 1e6 : 0.0);
+    LOG_INFO("  {} moves hit a block; first pass incl. building {} solidity masks took {:.2f} ms",
+             blockedMoves, resolver.getCachedChunkCount(), static_cast<double>(buildMicros) / 1000.0);
+}
+
+void runRaycastBenchmark(World& world, int32_t columnRadius, size_t rayCount) {
+    ChunkCopies copies = copyChunksAroundSpawn(world, columnRadius);
+    if (copies.empty() || rayCount == 0) {
+        LOG_WARN("Raycast benchmark: no chunks around spawn");
+        return;
+    }
+
+    Raycaster::ChunkLookup lookup = [&copies](const ChunkCoord& coord) -> const Chunk* {
+        auto chunkIt = copies.find(coord);
+        return chunkIt != copies.end() ? chunkIt->second.get() : nullptr;
+    };
+
+    // Groups of rays in random directions from one eye position each, at
+    // the reach the block handlers allow
+    constexpr size_t RAYS_PER_ORIGIN = 64;
+    constexpr float REACH = 15.0f;
+    std::mt19937 rng(12345);  // NOLINT(cert-msc32-c,cert-msc51-cpp) - fixed seed for repeatable runs
+    auto extent = static_cast<float>((columnRadius + 1) * static_cast<int32_t>(CHUNK_SIZE));
+    std::uniform_real_distribution<float> horizontal(-extent, extent);
+    std::uniform_real_distribution<float> vertical(static_cast<float>(world.getMinChunkY() * static_cast<int32_t>(CHUNK_SIZE)),
+                                                   static_cast<float>((world.getMaxChunkY() + 1) * static_cast<int32_t>(CHUNK_SIZE)));
+    std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+
+    std::vector<Ray> rays;
+    rays.reserve(rayCount);
+    glm::vec3 origin(0.0f);
+    while (rays.size() < rayCount) {
+        if (rays.size() % RAYS_PER_ORIGIN == 0) {
+            origin = glm::vec3(horizontal(rng), vertical(rng), horizontal(rng));
+        }
+        glm::vec3 direction(axis(rng), axis(rng), axis(rng));
+        if (glm::dot(direction, direction) > 1e-4f) {
+            rays.push_back(Ray{origin, direction, REACH});
+        }
+    }
+
+    auto singleStart = std::chrono::steady_clock::now();
+    size_t singleHits = 0;
+    for (const Ray& ray : rays) {
+        if (Raycaster::cast(ray.origin, ray.direction, ray.maxDistance, lookup)) {
+            singleHits++;
+        }
+    }
+    double singleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - singleStart).count();
+
+    auto batchStart = std::chrono::steady_clock::now();
+    std::vector<std::optional<RaycastHit>> hits = Raycaster::castMany(rays, lookup);
+    double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - batchStart).count();
+    auto batchHits = static_cast<size_t>(std::count_if(hits.begin(), hits.end(),
+                                                       [](const std::optional<RaycastHit>& hit) { return hit.has_value(); }));
+
+    auto nanosPerRay = [&rays](double seconds) { return seconds * 1e9 / static_cast<double>(rays.size()); };
+    LOG_INFO("Raycast benchmark: {} rays of {:.0f} blocks over {} chunks, {} hit a block",
+             rays.size(), REACH, copies.size(), batchHits);
+    LOG_INFO("  one at a time: {:.2f} ms ({:.0f} ns/ray), castMany: {:.2f} ms ({:.0f} ns/ray)",
+             singleSeconds * 1000.0, nanosPerRay(singleSeconds), batchSeconds * 1000.0, nanosPerRay(batchSeconds));
+    if (singleHits != batchHits) {
+        LOG_ERROR("Raycast benchmark: one-at-a-time casts hit {} blocks but castMany hit {}", singleHits, batchHits);
+    }
+}
+
+void runFallingBlockBenchmark(int32_t width, int32_t depth) {
+    constexpr int32_t DROP = 32;  // Blocks between the floor and the bottom of the slab
+    constexpr auto SIZE = static_cast<int32_t>(CHUNK_SIZE);
+    if (width <= 0 || depth <= 0) {
+        return;
+    }
+
+    // Stone floor at y = 0, sand slab from y = DROP + 1
+    std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>> chunks;
+    int32_t chunkSpan = (width + SIZE - 1) / SIZE;
+    int32_t topChunkY = (DROP + depth) / SIZE;
+    for (int32_t chunkX = 0; chunkX < chunkSpan; chunkX++) {
+        for (int32_t chunkY = 0; chunkY <= topChunkY; chunkY++) {
+            for (int32_t chunkZ = 0; chunkZ < chunkSpan; chunkZ++) {
+                ChunkCoord coord{chunkX, chunkY, chunkZ};
+                chunks.emplace(coord, std::make_unique<Chunk>(coord));
+            }
+        }
+    }
+    auto setBlock = [&chunks](int32_t worldX, int32_t worldY, int32_t worldZ, BlockType type) {
+        Chunk& chunk = *chunks.at(ChunkCoord{worldX / SIZE, worldY / SIZE, worldZ / SIZE});
+        chunk.setBlock(worldX % SIZE, worldY % SIZE, worldZ % SIZE, Block{type});
+    };
+    for (int32_t worldX = 0; worldX < width; worldX++) {
+        for (int32_t worldZ = 0; worldZ < width; worldZ++) {
+            setBlock(worldX, 0, worldZ, BlockType::Stone);
+            for (int32_t worldY = DROP + 1; worldY <= DROP + depth; worldY++) {
+                setBlock(worldX, worldY, worldZ, BlockType::Sand);
+            }
+        }
+    }
+
+    auto lookup = [&chunks](const ChunkCoord& coord) -> Chunk* {
+        auto chunkIt = chunks.find(coord);
+        return chunkIt != chunks.end() ? chunkIt->second.get() : nullptr;
+    };
+    LightEngine light(lookup);
+    FallingBlockSimulator simulator(lookup);
+    for (auto& [coord, chunk] : chunks) {
+        chunk->updateBrickMasks();
+        light.enqueueSection(coord);
+        simulator.enqueueChunk(coord);
+    }
+    light.process();
+
+    // Step until everything has landed (bounded in case something never settles)
+    const int32_t maxSteps = DROP + depth + 8;
+    std::vector<BlockChange> changes;
+    size_t totalChanges = 0;
+    size_t peakChanges = 0;
+    uint64_t lightMicrosTotal = 0;
+    uint64_t lightMicrosMax = 0;
+    int32_t steps = 0;
+    for (; steps < maxSteps && simulator.hasPending(); steps++) {
+        changes.clear();
+        simulator.step(changes);
+
+        auto lightStart = std::chrono::steady_clock::now();
+        for (const BlockChange& change : changes) {
+            light.enqueueEdit(change.position, change.previous);
+        }
+        light.process();
+        auto lightMicros = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - lightStart).count());
+
+        totalChanges += changes.size();
+        peakChanges = std::max(peakChanges, changes.size());
+        lightMicrosTotal += lightMicros;
+        lightMicrosMax = std::max(lightMicrosMax, lightMicros);
+    }
+
+    size_t landed = 0;
+    for (int32_t worldX = 0; worldX < width; worldX++) {
+        for (int32_t worldZ = 0; worldZ < width; worldZ++) {
+            for (int32_t worldY = 1; worldY <= depth; worldY++) {
+                const Chunk& chunk = *chunks.at(ChunkCoord{worldX / SIZE, worldY / SIZE, worldZ / SIZE});
+                if (chunk.getBlock(worldX % SIZE, worldY % SIZE, worldZ % SIZE).type == BlockType::Sand) {
+                    landed++;
+                }
+            }
+        }
+    }
+
+    const FallingBlockSimulator::Stats& stats = simulator.getStats();
+    auto blocks = static_cast<size_t>(width) * static_cast<size_t>(width) * static_cast<size_t>(depth);
+    LOG_INFO("Falling block benchmark: {}x{}x{} sand slab ({} blocks, {} columns) dropped {} blocks in {} steps",
+             width, width, depth, blocks, static_cast<size_t>(width) * static_cast<size_t>(width), DROP, steps);
+    LOG_INFO("  simulation: {:.2f} ms/step avg, {:.2f} ms max | {} column moves, {} block changes ({} max per step)",
+             stats.steps > 0 ? static_cast<double>(stats.stepMicrosTotal) / 1000.0 / static_cast<double>(stats.steps) : 0.0,
+             static_cast<double>(stats.stepMicrosMax) / 1000.0, stats.moves, totalChanges, peakChanges);
+    LOG_INFO("  relighting: {:.2f} ms/step avg, {:.2f} ms max",
+             steps > 0 ? static_cast<double>(lightMicrosTotal) / 1000.0 / static_cast<double>(steps) : 0.0,
+             static_cast<double>(lightMicrosMax) / 1000.0);
+    if (landed != blocks || simulator.hasPending()) {
+        LOG_ERROR("Falling block benchmark: {} of {} blocks landed on the floor", landed, blocks);
+    }
+}
+
+void runBlockTickBenchmark(size_t timerCount) {
+    constexpr int32_t AREA_CHUNKS = 16;     // Ticks spread over 16x16 columns, 4 levels high
+    constexpr uint32_t SHORT_DELAY = 2400;  // One minute at 40 TPS (growth, fluids)
+    constexpr uint32_t LONG_DELAY = 200000;
+    if (timerCount == 0) {
+        return;
+    }
+
+    std::mt19937 rng(12345);  // NOLINT(cert-msc32-c,cert-msc51-cpp) - fixed seed for repeatable runs
+    std::uniform_int_distribution<int32_t> horizontal(0, (AREA_CHUNKS * static_cast<int32_t>(CHUNK_SIZE)) - 1);
+    std::uniform_int_distribution<int32_t> vertical(0, (4 * static_cast<int32_t>(CHUNK_SIZE)) - 1);
+    std::uniform_int_distribution<uint32_t> shortDelay(1, SHORT_DELAY);
+    std::uniform_int_distribution<uint32_t> longDelay(1, LONG_DELAY);
+    std::vector<glm::ivec3> positions(timerCount);
+    std::vector<uint32_t> delays(timerCount);
+    for (size_t index = 0; index < timerCount; index++) {
+        positions[index] = glm::ivec3(horizontal(rng), vertical(rng), horizontal(rng));
+        delays[index] = index % 8 == 0 ? longDelay(rng) : shortDelay(rng);  // 1 in 8 long
+    }
+
+    auto secondsSince = [](std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    auto nanosPer = [](double seconds, size_t count) { return seconds * 1e9 / static_cast<double>(std::max<size_t>(count, 1)); };
+
+    BlockTickScheduler scheduler;
+    std::vector<BlockTickHandle> handles;
+    handles.reserve(timerCount);
+    auto scheduleStart = std::chrono::steady_clock::now();
+    for (size_t index = 0; index < timerCount; index++) {
+        handles.push_back(scheduler.schedule(positions[index], BlockType::Grass, delays[index]));
+    }
+    double scheduleSeconds = secondsSince(scheduleStart);
+
+    // Cancel every fourth tick (none of them long)
+    size_t cancelled = 0;
+    auto cancelStart = std::chrono::steady_clock::now();
+    for (size_t index = 1; index < handles.size(); index += 4) {
+        cancelled += scheduler.cancel(handles[index]) ? 1 : 0;
+    }
+    double cancelSeconds = secondsSince(cancelStart);
+
+    // Run the wheel until every remaining tick has fired
+    std::vector<BlockTick> due;
+    size_t fired = 0;
+    size_t ticks = 0;
+    double slowestTick = 0.0;
+    auto advanceStart = std::chrono::steady_clock::now();
+    while (scheduler.getPendingCount() > 0) {
+        auto tickStart = std::chrono::steady_clock::now();
+        due.clear();
+        scheduler.advance(due);
+        slowestTick = std::max(slowestTick, secondsSince(tickStart));
+        fired += due.size();
+        ticks++;
+    }
+    double advanceSeconds = secondsSince(advanceStart);
+
+    // Schedule again and unload every chunk
+    for (size_t index = 0; index < timerCount; index++) {
+        scheduler.schedule(positions[index], BlockType::Grass, delays[index]);
+    }
+    size_t chunkCount = scheduler.getChunkCount();
+    size_t dropped = 0;
+    auto dropStart = std::chrono::steady_clock::now();
+    for (int32_t chunkX = 0; chunkX < AREA_CHUNKS; chunkX++) {
+        for (int32_t chunkZ = 0; chunkZ < AREA_CHUNKS; chunkZ++) {
+            for (int32_t chunkY = 0; chunkY < 4; chunkY++) {
+                dropped += scheduler.dropChunk(ChunkCoord{chunkX, chunkY, chunkZ});
+            }
+        }
+    }
+    double dropSeconds = secondsSince(dropStart);
+
+    LOG_INFO("Block tick benchmark: {} ticks over {} chunks, delays up to {} ticks (1 in 8 up to {})",
+             timerCount, chunkCount, SHORT_DELAY, LONG_DELAY);
+    LOG_INFO("  schedule: {:.0f} ns/tick, cancel: {:.0f} ns/tick ({} cancelled)",
+             nanosPer(scheduleSeconds, timerCount), nanosPer(cancelSeconds, cancelled), cancelled);
+    LOG_INFO("  fire: {} ticks over {} server ticks in {:.2f} ms ({:.0f} ns/tick fired, slowest server tick {:.3f} ms, {} cascaded)",
+             fired, ticks, advanceSeconds * 1000.0, nanosPer(advanceSeconds, fired), slowestTick * 1000.0,
+             scheduler.getStats().cascaded);
+    LOG_INFO("  chunk unload: {} ticks dropped from {} chunks in {:.2f} ms", dropped, chunkCount, dropSeconds * 1000.0);
+    if (fired + cancelled != timerCount || dropped != timerCount || scheduler.getPendingCount() != 0) {
+        LOG_ERROR("Block tick benchmark: {} scheduled but {} fired, {} cancelled, {} dropped",
+                  timerCount, fired, cancelled, dropped);
+    }
+}
+
+void runRegionTickBenchmark(int32_t regionSpan, int32_t tickCount) {
+    constexpr int32_t LEVELS = 1;              // Chunk levels per column
+    constexpr uint32_t UPDATES_PER_CHUNK = 256;
+    constexpr std::array<glm::ivec3, 6> NEIGHBORS{{
+        {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}
+    }};
+    if (regionSpan <= 0 || tickCount <= 0) {
+        return;
+    }
+
+    // Random rock, 45% full
+    int32_t columns = regionSpan * RegionScheduler::REGION_CHUNKS;
+    std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>> original;
+    std::mt19937 rng(12345);  // NOLINT(cert-msc32-c,cert-msc51-cpp) - fixed seed for repeatable runs
+    std::bernoulli_distribution solid(0.45);
+    for (int32_t chunkX = 0; chunkX < columns; chunkX++) {
+        for (int32_t chunkZ = 0; chunkZ < columns; chunkZ++) {
+            for (int32_t chunkY = 0; chunkY < LEVELS; chunkY++) {
+                auto chunk = std::make_unique<Chunk>(ChunkCoord{chunkX, chunkY, chunkZ});
+                ChunkBlocks blocks{};
+                for (Block& block : blocks) {
+                    block.type = solid(rng) ? BlockType::Stone : BlockType::Air;
+                }
+                chunk->setBlockData(blocks);
+                original.emplace(chunk->getCoord(), std::move(chunk));
+            }
+        }
+    }
+
+    // Erosion: each update looks at a block's six neighbours, removes lonely
+    // rock and fills enclosed air; rock over air also pushes sand one block
+    // along +X, which crosses into the next region at region borders
+    uint64_t tickNumber = 0;
+    RegionScheduler::RegionTask task = [&tickNumber, &NEIGHBORS](RegionScheduler::RegionContext& context) {
+        const ChunkCoord& region = context.getRegion();
+        std::mt19937 regionRng(static_cast<uint32_t>((tickNumber * 73856093u) ^ (static_cast<uint64_t>(region.x) * 19349663u) ^
+                                                     (static_cast<uint64_t>(region.z) * 83492791u)));
+        std::uniform_int_distribution<int32_t> local(0, static_cast<int32_t>(CHUNK_SIZE) - 1);
+        for (const ChunkCoord& coord : context.getChunks()) {
+            glm::ivec3 origin = glm::ivec3(coord.x, coord.y, coord.z) * static_cast<int32_t>(CHUNK_SIZE);
+            for (uint32_t update = 0; update < UPDATES_PER_CHUNK; update++) {
+                glm::ivec3 pos = origin + glm::ivec3(local(regionRng), local(regionRng), local(regionRng));
+                int32_t solidNeighbors = 0;
+                for (const glm::ivec3& offset : NEIGHBORS) {
+                    solidNeighbors += context.getBlock(pos + offset) != BlockType::Air ? 1 : 0;
+                }
+                BlockType type = context.getBlock(pos);
+                if (type != BlockType::Air && solidNeighbors < 2) {
+                    context.setBlock(pos, BlockType::Air);
+                } else if (type == BlockType::Air && solidNeighbors >= 5) {
+                    context.setBlock(pos, BlockType::Stone);
+                } else if (type != BlockType::Air && context.getBlock(pos - glm::ivec3(0, 1, 0)) == BlockType::Air) {
+                    context.setBlock(pos + glm::ivec3(1, 0, 0), BlockType::Sand);
+                }
+            }
+        }
+    };
+
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> workerCounts;
+    for (size_t workers = 1; workers < cores; workers *= 2) {
+        workerCounts.push_back(workers);
+    }
+    workerCounts.push_back(cores);
+
+    LOG_INFO("Region tick benchmark: {}x{} regions ({} chunks), {} block updates per chunk per tick, {} ticks, {} cores",
+             regionSpan, regionSpan, original.size(), UPDATES_PER_CHUNK, tickCount, cores);
+    double serialMs = 0.0;
+    uint64_t firstChecksum = 0;
+    for (size_t workers : workerCounts) {
+        std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>> chunks;
+        for (const auto& [coord, chunk] : original) {
+            chunks.emplace(coord, std::make_unique<Chunk>(*chunk));
+        }
+        RegionScheduler scheduler([&chunks](const ChunkCoord& coord) -> Chunk* {
+            auto chunkIt = chunks.find(coord);
+            return chunkIt != chunks.end() ? chunkIt->second.get() : nullptr;
+        }, workers);
+        for (const auto& [coord, chunk] : chunks) {
+            scheduler.addChunk(coord);
+        }
+
+        std::vector<BlockChange> changes;
+        size_t changeCount = 0;
+        for (tickNumber = 0; tickNumber < static_cast<uint64_t>(tickCount); tickNumber++) {
+            changes.clear();
+            scheduler.tick(task, changes);
+            changeCount += changes.size();
+        }
+
+        // FNV-1a over every block, in coordinate order
+        uint64_t checksum = 14695981039346656037ull;
+        for (int32_t chunkX = 0; chunkX < columns; chunkX++) {
+            for (int32_t chunkZ = 0; chunkZ < columns; chunkZ++) {
+                for (int32_t chunkY = 0; chunkY < LEVELS; chunkY++) {
+                    for (const Block& block : chunks.at(ChunkCoord{chunkX, chunkY, chunkZ})->getBlockData()) {
+                        checksum = (checksum ^ static_cast<uint64_t>(block.type)) * 1099511628211ull;
+                    }
+                }
+            }
+        }
+
+        const RegionScheduler::Stats& stats = scheduler.getStats();
+        double averageMs = static_cast<double>(stats.tickMicrosTotal) / 1000.0 / static_cast<double>(stats.ticks);
+        if (workers == 1) {
+            serialMs = averageMs;
+            firstChecksum = checksum;
+        }
+        LOG_INFO("  {:>2} workers: {:.2f} ms/tick avg, {:.2f} ms max ({:.2f}x) | {} changes, {} cross-region",
+                 workers, averageMs, static_cast<double>(stats.tickMicrosMax) / 1000.0,
+                 averageMs > 0.0 ? serialMs / averageMs : 0.0, changeCount, stats.crossRegionEdits);
+        if (checksum != firstChecksum) {
+            LOG_ERROR("Region tick benchmark: {} workers left different blocks than 1 worker", workers);
+        }
+    }
+}
+
+} // namespace engine::bench
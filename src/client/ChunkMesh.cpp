@@ -1,16 +1,179 @@
 #include "client/ChunkMesh.hpp"
 #include "client/TextureAtlas.hpp"
 #include "core/Logger.hpp"
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <optional>
 
 namespace engine {
 
 // Helper struct for greedy meshing mask
 struct MaskCell {
     BlockType blockType = BlockType::Air;
+    uint8_t light = 0;  ///< Packed light of the block in front of the face
+    uint8_t occlusion = 0xFF;  ///< Corner ambient occlusion, 2 bits per corner (0xFF = all open)
     bool processed = false;
+
+    bool mergesWith(const MaskCell& other) const {
+        return blockType == other.blockType && light == other.light && occlusion == other.occlusion && !other.processed;
+    }
+};
+
+namespace {
+
+/// Face brightness per light level: each level below full is 20% darker, with a small floor
+const std::array<float, ChunkLight::MAX_LEVEL + 1> LIGHT_BRIGHTNESS = []() {
+    std::array<float, ChunkLight::MAX_LEVEL + 1> table{};
+    for (size_t level = 0; level < table.size(); level++) {
+        table[level] = 0.05f + (0.95f * std::pow(0.8f, static_cast<float>(ChunkLight::MAX_LEVEL - level)));
+    }
+    return table;
+}();
+
+/// Blocks per axis of the occupancy grid: the chunk plus a one-block border
+constexpr int32_t PADDED_SIZE = static_cast<int32_t>(CHUNK_SIZE) + 2;
+
+/**
+ * @brief Corner ambient occlusion of a face for every 3x3 opaque neighbourhood
+ *
+ * Indexed by the neighbourhood in the layer in front of the face, bit
+ * (t + 1) + 3 * (b + 1) for tangent and bitangent offsets t and b. Each
+ * corner looks at its two side blocks and its diagonal block: two sides close
+ * it off fully, otherwise every opaque block darkens it by one step. Entries
+ * hold 2 bits per corner (0 = darkest, 3 = open), in ChunkMesh::addQuad's
+ * vertex order (origin, +tangent, +tangent+bitangent, +bitangent) from the
+ * low bits up.
+ */
+constexpr std::array<uint8_t, 512> CORNER_OCCLUSION = []() {
+    constexpr std::array<int, 4> TANGENT_SIGN = {-1, 1, 1, -1};
+    constexpr std::array<int, 4> BITANGENT_SIGN = {-1, -1, 1, 1};
+
+    std::array<uint8_t, 512> table{};
+    for (uint32_t neighborhood = 0; neighborhood < table.size(); neighborhood++) {
+        auto opaque = [neighborhood](int offsetT, int offsetB) {
+            return static_cast<int>((neighborhood >> static_cast<uint32_t>((offsetT + 1) + (3 * (offsetB + 1)))) & 1u);
+        };
+        uint8_t occlusion = 0;
+        for (uint32_t corner = 0; corner < 4; corner++) {
+            int side1 = opaque(TANGENT_SIGN[corner], 0);
+            int side2 = opaque(0, BITANGENT_SIGN[corner]);
+            int diagonal = opaque(TANGENT_SIGN[corner], BITANGENT_SIGN[corner]);
+            int level = (side1 != 0 && side2 != 0) ? 0 : 3 - (side1 + side2 + diagonal);
+            occlusion |= static_cast<uint8_t>(level << (corner * 2));
+        }
+        table[neighborhood] = occlusion;
+    }
+    return table;
+}();
+
+/**
+ * @brief Opaque-block bitmask of a chunk and the border blocks of its face neighbours
+ *
+ * One 64-bit row per (y, z), bit x + 1 set when block (x, y, z) is opaque,
+ * for x, y, z in [-1, CHUNK_SIZE]. Border blocks along the chunk's edges and
+ * corners belong to diagonal neighbours that the mesher is not given and
+ * stay clear, as do missing face neighbours.
+ */
+class OpaqueGrid {
+public:
+    OpaqueGrid(const Chunk& chunk, const std::array<const Chunk*, BLOCK_FACE_COUNT>& neighbors) {
+        const ChunkBlocks& blocks = chunk.getBlockData();
+        for (uint32_t brick = 0; brick < BRICK_COUNT; brick++) {
+            if (chunk.isBrickEmpty(brick)) {
+                continue;
+            }
+            for (uint32_t local = 0; local < BRICK_VOLUME; local++) {
+                uint32_t index = Chunk::getBrickBlockIndex(brick, local);
+                if (BlockRegistry::isOpaque(blocks[index].type)) {
+                    set(static_cast<int32_t>(index % CHUNK_SIZE),
+                        static_cast<int32_t>(index / (CHUNK_SIZE * CHUNK_SIZE)),
+                        static_cast<int32_t>((index / CHUNK_SIZE) % CHUNK_SIZE));
+                }
+            }
+        }
+
+        // One layer of each face neighbour, the one touching this chunk
+        constexpr auto LAST = static_cast<int32_t>(CHUNK_SIZE) - 1;
+        for (size_t face = 0; face < BLOCK_FACE_COUNT; face++) {
+            const Chunk* neighbor = neighbors[face];
+            if (neighbor == nullptr || neighbor->isEmpty()) {
+                continue;
+            }
+            const int axis = static_cast<int>(face / 2);
+            const bool positive = (face % 2) != 0;
+            const ChunkBlocks& border = neighbor->getBlockData();
+            for (int32_t first = 0; first <= LAST; first++) {
+                for (int32_t second = 0; second <= LAST; second++) {
+                    int32_t local[3] = {0, 0, 0};
+                    local[axis] = positive ? 0 : LAST;
+                    local[(axis + 1) % 3] = first;
+                    local[(axis + 2) % 3] = second;
+                    uint32_t index = Chunk::getIndex(static_cast<uint32_t>(local[0]), static_cast<uint32_t>(local[1]), static_cast<uint32_t>(local[2]));
+                    if (!BlockRegistry::isOpaque(border[index].type)) {
+                        continue;
+                    }
+                    local[axis] = positive ? LAST + 1 : -1;
+                    set(local[0], local[1], local[2]);
+                }
+            }
+        }
+    }
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    bool isOpaque(int32_t x, int32_t y, int32_t z) const {
+        return ((rows[row(y, z)] >> static_cast<uint32_t>(x + 1)) & 1u) != 0;
+    }
+
+    /**
+     * @brief Ambient occlusion of the four corners of a face
+     * @param front Block in front of the face
+     * @param tangent Axis from corner 0 to corner 1
+     * @param bitangent Axis from corner 0 to corner 3
+     * @return 2 bits per corner (0 = darkest, 3 = open), corner 0 in the low bits
+     */
+    uint8_t faceOcclusion(const int32_t (&front)[3], int tangent, int bitangent) const {
+        // 3x3 opaque neighbourhood in the layer in front of the face, bit (t + 1) + 3 * (b + 1)
+        uint32_t neighborhood = 0;
+        if (tangent == 0) {
+            // Rows run along X, so each line of three is one shift
+            for (int32_t offset = -1; offset <= 1; offset++) {
+                int32_t pos[3] = {front[0], front[1], front[2]};
+                pos[bitangent] += offset;
+                auto line = static_cast<uint32_t>((rows[row(pos[1], pos[2])] >> static_cast<uint32_t>(pos[0])) & 0x7u);
+                neighborhood |= line << static_cast<uint32_t>(3 * (offset + 1));
+            }
+        } else {
+            for (int32_t offsetB = -1; offsetB <= 1; offsetB++) {
+                for (int32_t offsetT = -1; offsetT <= 1; offsetT++) {
+                    int32_t pos[3] = {front[0], front[1], front[2]};
+                    pos[tangent] += offsetT;
+                    pos[bitangent] += offsetB;
+                    if (isOpaque(pos[0], pos[1], pos[2])) {
+                        neighborhood |= 1u << static_cast<uint32_t>((offsetT + 1) + (3 * (offsetB + 1)));
+                    }
+                }
+            }
+        }
+        return CORNER_OCCLUSION[neighborhood];
+    }
+
+private:
+    std::array<uint64_t, static_cast<size_t>(PADDED_SIZE) * PADDED_SIZE> rows{};
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    static size_t row(int32_t y, int32_t z) {
+        return (static_cast<size_t>(y + 1) * PADDED_SIZE) + static_cast<size_t>(z + 1);
+    }
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    void set(int32_t x, int32_t y, int32_t z) {
+        rows[row(y, z)] |= uint64_t{1} << static_cast<uint32_t>(x + 1);
+    }
 };
 
+} // namespace
+
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 size_t ChunkMesh::generateMesh(const Chunk& chunk,
                                std::vector<Vertex>& vertices,
@@ -21,37 +184,68 @@ size_t ChunkMesh::generateMesh(const Chunk& chunk,
                                const Chunk* neighborNegY,
                                const Chunk* neighborPosY,
                                const Chunk* neighborNegZ,
-                               const Chunk* neighborPosZ) {
+                               const Chunk* neighborPosZ,
+                               bool ambientOcclusion) {
     vertices.clear();
     indices.clear();
 
+    // All air: nothing in this chunk can produce a face
+    if (chunk.isEmpty()) {
+        return 0;
+    }
+
     const glm::vec3 CHUNK_ORIGIN = chunk.getCoord().toWorldPos();
 
-    // Helper lambda to get block with cross-chunk support
+    // Helper lambda to get a block type with cross-chunk support (missing neighbours read as air)
     // NOLINTNEXTLINE(readability-identifier-length)
-    auto getBlock = [&](int32_t x, int32_t y, int32_t z) -> const Block* {
+    auto getBlockType = [&](int32_t x, int32_t y, int32_t z) -> BlockType {
         // Handle cross-chunk boundaries
         if (x < 0) {
-            return neighborNegX ? &neighborNegX->getBlock(CHUNK_SIZE - 1, y, z) : nullptr;
+            return neighborNegX ? neighborNegX->getBlock(CHUNK_SIZE - 1, y, z).type : BlockType::Air;
         }
         if (x >= static_cast<int32_t>(CHUNK_SIZE)) {
-            return neighborPosX ? &neighborPosX->getBlock(0, y, z) : nullptr;
+            return neighborPosX ? neighborPosX->getBlock(0, y, z).type : BlockType::Air;
         }
         if (y < 0) {
-            return neighborNegY ? &neighborNegY->getBlock(x, CHUNK_SIZE - 1, z) : nullptr;
+            return neighborNegY ? neighborNegY->getBlock(x, CHUNK_SIZE - 1, z).type : BlockType::Air;
         }
         if (y >= static_cast<int32_t>(CHUNK_SIZE)) {
-            return neighborPosY ? &neighborPosY->getBlock(x, 0, z) : nullptr;
+            return neighborPosY ? neighborPosY->getBlock(x, 0, z).type : BlockType::Air;
         }
         if (z < 0) {
-            return neighborNegZ ? &neighborNegZ->getBlock(x, y, CHUNK_SIZE - 1) : nullptr;
+            return neighborNegZ ? neighborNegZ->getBlock(x, y, CHUNK_SIZE - 1).type : BlockType::Air;
         }
         if (z >= static_cast<int32_t>(CHUNK_SIZE)) {
-            return neighborPosZ ? &neighborPosZ->getBlock(x, y, 0) : nullptr;
+            return neighborPosZ ? neighborPosZ->getBlock(x, y, 0).type : BlockType::Air;
+        }
+        return chunk.getBlock(static_cast<uint32_t>(x), static_cast<uint32_t>(y), static_cast<uint32_t>(z)).type;
+    };
+
+    // Same for packed light (missing neighbours read as full skylight)
+    // NOLINTNEXTLINE(readability-identifier-length)
+    auto getLight = [&](int32_t x, int32_t y, int32_t z) -> uint8_t {
+        constexpr auto SIZE = static_cast<int32_t>(CHUNK_SIZE);
+        const Chunk* source = &chunk;
+        if (x < 0) { source = neighborNegX; }
+        else if (x >= SIZE) { source = neighborPosX; }
+        else if (y < 0) { source = neighborNegY; }
+        else if (y >= SIZE) { source = neighborPosY; }
+        else if (z < 0) { source = neighborNegZ; }
+        else if (z >= SIZE) { source = neighborPosZ; }
+        if (source == nullptr) {
+            return ChunkLight::pack(ChunkLight::MAX_LEVEL, 0);
         }
-        return &chunk.getBlock(static_cast<uint32_t>(x), static_cast<uint32_t>(y), static_cast<uint32_t>(z));
+        return source->getLight().get(Chunk::getIndex((x + SIZE) % SIZE, (y + SIZE) % SIZE, (z + SIZE) % SIZE));
     };
 
+    // Opaque occupancy for ambient occlusion, built once so each corner test is a bit lookup
+    std::optional<OpaqueGrid> opaqueGrid;
+    if (ambientOcclusion) {
+        opaqueGrid.emplace(
+            chunk, std::array<const Chunk*, BLOCK_FACE_COUNT>{neighborNegX, neighborPosX, neighborNegY,
+                                                              neighborPosY, neighborNegZ, neighborPosZ});
+    }
+
     // Greedy meshing algorithm - sweep in 6 directions
     // We'll process each axis (X, Y, Z) and each direction (negative, positive)
 
@@ -61,52 +255,68 @@ size_t ChunkMesh::generateMesh(const Chunk& chunk,
         const int U = (axis + 1) % 3;  // First tangent axis
         // NOLINTNEXTLINE(readability-identifier-length)
         const int V = (axis + 2) % 3;  // Second tangent axis
+        // addQuad's tangent is X for Y-facing quads, V for that axis and U otherwise
+        const int TANGENT = axis == 1 ? V : U;
+        const int BITANGENT = axis == 1 ? U : V;
 
         // For each direction along this axis (backward = -1, forward = +1)
         for (int dir = -1; dir <= 1; dir += 2) {
+            const BlockFace face = faceFromAxis(axis, dir);
+
             // Sweep through slices perpendicular to this axis
             // NOLINTNEXTLINE(readability-identifier-length)
             for (int32_t d = 0; d < static_cast<int32_t>(CHUNK_SIZE); d++) {
+                // Faces only come from solid blocks, so empty bricks can be skipped
+                // without reading them. Bit (u + v * 4) = brick (u, v) of this slice is occupied.
+                uint32_t sliceBricks = 0;
+                for (uint32_t brickV = 0; brickV < BRICKS_PER_AXIS; brickV++) {
+                    for (uint32_t brickU = 0; brickU < BRICKS_PER_AXIS; brickU++) {
+                        uint32_t brick[3] = {0, 0, 0};
+                        brick[axis] = static_cast<uint32_t>(d) / BRICK_SIZE;
+                        brick[U] = brickU;
+                        brick[V] = brickV;
+                        if (!chunk.isBrickEmpty(Chunk::getBrickIndex(brick[0], brick[1], brick[2]))) {
+                            sliceBricks |= 1u << (brickU + (brickV * BRICKS_PER_AXIS));
+                        }
+                    }
+                }
+                if (sliceBricks == 0) {
+                    continue;
+                }
+
                 // Build mask for this slice
                 std::array<MaskCell, static_cast<std::size_t>(CHUNK_SIZE) * CHUNK_SIZE> mask{};
 
                 // Scan the slice and build mask
                 for (uint32_t j = 0; j < CHUNK_SIZE; j++) {
                     for (uint32_t i = 0; i < CHUNK_SIZE; i++) {
+                        if (((sliceBricks >> ((i / BRICK_SIZE) + ((j / BRICK_SIZE) * BRICKS_PER_AXIS))) & 1u) == 0) {
+                            i += BRICK_SIZE - 1;  // Jump to the next brick in this row
+                            continue;
+                        }
+
                         // Compute position in chunk space
                         int32_t pos[3] = {0, 0, 0};
                         pos[axis] = d;
                         pos[U] = static_cast<int32_t>(i);
                         pos[V] = static_cast<int32_t>(j);
 
-                        const Block* current = getBlock(pos[0], pos[1], pos[2]);
+                        BlockType current = getBlockType(pos[0], pos[1], pos[2]);
 
                         // Position of neighbor in the direction we're checking
                         int32_t neighborPos[3] = {pos[0], pos[1], pos[2]};
                         neighborPos[axis] += dir;
-                        const Block* neighbor = getBlock(neighborPos[0], neighborPos[1], neighborPos[2]);
-
-                        // Determine if we need a face here
-                        bool needsFace = false;
-                        BlockType faceBlockType = BlockType::Air;
-
-                        // NOLINTBEGIN(bugprone-branch-clone)
-                        if (current != nullptr && current->isSolid()) {
-                            // We have a solid block, check if neighbor blocks it
-                            if (neighbor == nullptr || !neighbor->isSolid()) {
-                                // Neighbor is air or doesn't exist - need face
-                                needsFace = true;
-                                faceBlockType = current->type;
-                            } else if (neighbor->type != current->type) {
-                                // Neighbor is different type - need face
-                                needsFace = true;
-                                faceBlockType = current->type;
-                            }
-                        }
-                        // NOLINTEND(bugprone-branch-clone)
+                        BlockType neighbor = getBlockType(neighborPos[0], neighborPos[1], neighborPos[2]);
 
+                        // A solid block shows this face unless the neighbour hides it
+                        bool needsFace = BlockRegistry::isSolid(current) && !BlockRegistry::isFaceCulled(current, neighbor);
                         if (needsFace) {
-                            mask[i + (j * CHUNK_SIZE)].blockType = faceBlockType;
+                            MaskCell& cell = mask[i + (j * CHUNK_SIZE)];
+                            cell.blockType = current;
+                            cell.light = getLight(neighborPos[0], neighborPos[1], neighborPos[2]);
+                            if (opaqueGrid) {
+                                cell.occlusion = opaqueGrid->faceOcclusion(neighborPos, TANGENT, BITANGENT);
+                            }
                         }
                     }
                 }
@@ -125,7 +335,7 @@ size_t ChunkMesh::generateMesh(const Chunk& chunk,
                         uint32_t width = 1;
                         while (i + width < CHUNK_SIZE) {
                             MaskCell& nextCell = mask[(i + width) + (j * CHUNK_SIZE)];
-                            if (nextCell.blockType != cell.blockType || nextCell.processed) {
+                            if (!cell.mergesWith(nextCell)) {
                                 break;
                             }
                             width++;
@@ -139,7 +349,7 @@ size_t ChunkMesh::generateMesh(const Chunk& chunk,
                             // NOLINTNEXTLINE(readability-identifier-length)
                             for (uint32_t k = 0; k < width; k++) {
                                 MaskCell& checkCell = mask[(i + k) + ((j + height) * CHUNK_SIZE)];
-                                if (checkCell.blockType != cell.blockType || checkCell.processed) {
+                                if (!cell.mergesWith(checkCell)) {
                                     done = true;
                                     break;
                                 }
@@ -177,9 +387,11 @@ size_t ChunkMesh::generateMesh(const Chunk& chunk,
                         glm::vec3 normal(0, 0, 0);
                         normal[axis] = static_cast<float>(dir);
 
-                        glm::vec3 color = getBlockColor(cell.blockType, normal);
+                        // Light is baked into the vertex color the shader already multiplies in
+                        uint8_t level = std::max<uint8_t>(cell.light >> 4, cell.light & 0x0F);
+                        glm::vec3 color = getBlockColor(cell.blockType, face) * LIGHT_BRIGHTNESS[level];
 
-                        addQuad(vertices, indices, quadPos, size, normal, color, cell.blockType, atlas);
+                        addQuad(vertices, indices, quadPos, size, normal, color, cell.blockType, face, cell.occlusion, atlas);
 
                         i += width;
                     }
@@ -195,17 +407,11 @@ size_t ChunkMesh::generateMesh(const Chunk& chunk,
     return vertices.size();
 }
 
-glm::vec3 ChunkMesh::getBlockColor(BlockType type, const glm::vec3& normal) {
-    // Special handling for grass blocks - only tint the top face
-    // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
-    if (type == BlockType::Grass && normal.y > 0.5f) {
-        // Top face: green tint for grass_top texture
-        return glm::vec3(0.4f, 0.8f, 0.3f);  // Green
-    }
-    // NOLINTEND(cppcoreguidelines-pro-type-union-access)
-
-    // All other blocks use white (no tinting)
-    return glm::vec3(1.0f, 1.0f, 1.0f);
+glm::vec3 ChunkMesh::getBlockColor(BlockType type, BlockFace face) {
+    uint32_t tint = BlockRegistry::getFaceTint(type, face);
+    return glm::vec3(static_cast<float>((tint >> 16) & 0xFFu),
+                     static_cast<float>((tint >> 8) & 0xFFu),
+                     static_cast<float>(tint & 0xFFu)) / 255.0f;
 }
 
 void ChunkMesh::addQuad(std::vector<Vertex>& vertices,
@@ -215,6 +421,8 @@ void ChunkMesh::addQuad(std::vector<Vertex>& vertices,
                         const glm::vec3& normal,
                         const glm::vec3& color,
                         BlockType blockType,
+                        BlockFace face,
+                        uint8_t occlusion,
                         const TextureAtlas* atlas) {
     uint32_t baseIndex = static_cast<uint32_t>(vertices.size());
 
@@ -241,23 +449,7 @@ void ChunkMesh::addQuad(std::vector<Vertex>& vertices,
     glm::vec2 uvMax;
     glm::vec2 uvBlockSize;
     if (atlas != nullptr) {
-        BlockType texBlockType = blockType;
-
-        // Special handling for grass blocks
-        if (blockType == BlockType::Grass) {
-            if (normal.y > 0.5f) {
-                // Top face (+Y): use grass_top texture
-                texBlockType = BlockType::GrassTop;
-            } else if (normal.y < -0.5f) {
-                // Bottom face (-Y): use dirt texture
-                texBlockType = BlockType::Dirt;
-            } else {
-                // Side faces: use grass_side texture
-                texBlockType = BlockType::GrassSide;
-            }
-        }
-
-        glm::vec4 uvs = atlas->getBlockUVs(texBlockType);
+        glm::vec4 uvs = atlas->getTextureUVs(BlockRegistry::getFaceTexture(blockType, face));
         uvMin = glm::vec2(uvs.x, uvs.y);
         uvMax = glm::vec2(uvs.z, uvs.w);
         uvBlockSize = uvMax - uvMin; // Size of one block's texture in UV space
@@ -313,14 +505,32 @@ void ChunkMesh::addQuad(std::vector<Vertex>& vertices,
     }
     // NOLINTEND(cppcoreguidelines-pro-type-union-access)
 
-    // Create two triangles (counter-clockwise winding)
-    indices.push_back(baseIndex);
-    indices.push_back(baseIndex + 1);
-    indices.push_back(baseIndex + 2);
+    std::array<uint32_t, 4> cornerOcclusion{};
+    for (uint32_t corner = 0; corner < 4; corner++) {
+        cornerOcclusion[corner] = (occlusion >> (corner * 2)) & 0x3u;
+        vertices[baseIndex + corner].ambientOcclusion = cornerOcclusion[corner];
+    }
+
+    // Create two triangles (counter-clockwise winding). Split along the
+    // diagonal whose corners are brighter together, otherwise the occlusion
+    // gradient is interpolated across the wrong triangle pair and looks lopsided.
+    if (cornerOcclusion[0] + cornerOcclusion[2] >= cornerOcclusion[1] + cornerOcclusion[3]) {
+        indices.push_back(baseIndex);
+        indices.push_back(baseIndex + 1);
+        indices.push_back(baseIndex + 2);
+
+        indices.push_back(baseIndex);
+        indices.push_back(baseIndex + 2);
+        indices.push_back(baseIndex + 3);
+    } else {
+        indices.push_back(baseIndex + 1);
+        indices.push_back(baseIndex + 2);
+        indices.push_back(baseIndex + 3);
 
-    indices.push_back(baseIndex);
-    indices.push_back(baseIndex + 2);
-    indices.push_back(baseIndex + 3);
+        indices.push_back(baseIndex + 1);
+        indices.push_back(baseIndex + 3);
+        indices.push_back(baseIndex);
+    }
 }
 
 } // namespace engine
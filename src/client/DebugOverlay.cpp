@@ -1,12 +1,14 @@
 #include "client/DebugOverlay.hpp"
 #include "client/Camera.hpp"
 #include "client/NetworkClient.hpp"
-#include "client/Raycaster.hpp"
+#include "shared/Raycaster.hpp"
 #include "core/PerformanceMetrics.hpp"
 #include "core/Logger.hpp"
 
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 namespace engine {
 
@@ -167,9 +169,40 @@ void DebugOverlay::renderNetworkInfo(const NetworkClient* networkClient) {
     ImGui::Text("Network");
 
     if (networkClient->isConnected()) {
+        const NetworkStats& stats = networkClient->getNetworkStats();
+
         ImGui::Text("  Status: Connected");
-        ImGui::Text("  Server: 127.0.0.1:25565");
-        // Future: Add ping latency, packets sent/received, bandwidth when needed for debugging
+        ImGui::Text("  Server: %s", networkClient->getServerAddress().c_str());
+        if (stats.hasRtt()) {
+            ImGui::Text("  Ping: %.1f ms (jitter %.1f ms)", stats.getRtt(), stats.getJitter());
+        } else {
+            ImGui::Text("  Ping: --");
+        }
+        ImGui::Text("  Up: %.1f KB/s | Down: %.1f KB/s",
+                    stats.getSendRate() / 1024.0f, stats.getReceiveRate() / 1024.0f);
+        ImGui::Text("  Packets: %s sent | %s received",
+                    formatNumber(static_cast<uint32_t>(stats.getTotalSent().packets)).c_str(),
+                    formatNumber(static_cast<uint32_t>(stats.getTotalReceived().packets)).c_str());
+
+        // Top incoming message types by volume
+        std::vector<protocol::MessageType> activeTypes;
+        for (size_t i = 0; i < NetworkStats::MESSAGE_TYPE_COUNT; i++) {
+            auto type = static_cast<protocol::MessageType>(i);
+            if (stats.getReceived(type).packets > 0) {
+                activeTypes.push_back(type);
+            }
+        }
+        size_t shown = std::min<size_t>(activeTypes.size(), 3);
+        std::partial_sort(activeTypes.begin(), activeTypes.begin() + static_cast<std::ptrdiff_t>(shown), activeTypes.end(),
+                          [&stats](protocol::MessageType lhs, protocol::MessageType rhs) {
+                              return stats.getReceived(lhs).bytes > stats.getReceived(rhs).bytes;
+                          });
+        for (size_t i = 0; i < shown; i++) {
+            const NetworkStats::Counter& counter = stats.getReceived(activeTypes[i]);
+            ImGui::Text("    %s: %s pkts, %.1f KB", NetworkStats::getMessageTypeName(activeTypes[i]),
+                        formatNumber(static_cast<uint32_t>(counter.packets)).c_str(),
+                        static_cast<double>(counter.bytes) / 1024.0);
+        }
     } else {
         ImGui::Text("  Status: Disconnected");
     }
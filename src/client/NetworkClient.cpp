@@ -1,13 +1,17 @@
 #include "client/NetworkClient.hpp"
 #include "shared/ChunkSerializer.hpp"
+#include "shared/BlockRegistry.hpp"
 #include "core/Logger.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <stdexcept>
+#include <utility>
 
 namespace engine {
 
-NetworkClient::NetworkClient() {
+NetworkClient::NetworkClient() : lightEngine([this](const ChunkCoord& coord) { return getChunk(coord); }) {
     // Initialize ENet (safe to call multiple times)
     if (enet_initialize() != 0) {
         LOG_ERROR("Failed to initialize ENet for client");
@@ -64,13 +68,31 @@ bool NetworkClient::connect(const std::string& host, const std::string& username
         event.type == ENET_EVENT_TYPE_CONNECT) {
         LOG_INFO("Connected to server successfully");
         connected = true;
+        serverAddress = host + ":" + std::to_string(port);
+        netStats = NetworkStats{};
+        lastKeepAlive = std::chrono::steady_clock::now();
 
-        // Send join message with username
+        // Send join message with username, followed by the capabilities we understand
         protocol::ClientJoinMessage joinMsg{};
         std::strncpy(joinMsg.playerName, username.c_str(), sizeof(joinMsg.playerName) - 1);
         joinMsg.playerName[sizeof(joinMsg.playerName) - 1] = '\0';  // Ensure null termination
-        joinMsg.clientVersion = 1;
-        sendMessage(protocol::MessageType::ClientJoin, &joinMsg, sizeof(joinMsg));
+        joinMsg.clientVersion = protocol::PROTOCOL_VERSION;
+
+        protocol::ClientCapabilitiesMessage capsMsg{};
+        capsMsg.supportedCapabilities = protocol::SUPPORTED_CAPABILITIES;
+
+        std::array<uint8_t, sizeof(joinMsg) + sizeof(capsMsg)> joinPayload{};
+        std::memcpy(joinPayload.data(), &joinMsg, sizeof(joinMsg));
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memcpy(joinPayload.data() + sizeof(joinMsg), &capsMsg, sizeof(capsMsg));
+
+        // Until the server answers we only rely on the baseline feature set
+        capabilities = protocol::LEGACY_CAPABILITIES;
+        moveSendInterval = DEFAULT_MOVE_SEND_INTERVAL;
+        inputSequence = 0;
+        appliedCorrection = 0;
+        sentMoves.clear();
+        sendMessage(protocol::MessageType::ClientJoin, joinPayload.data(), joinPayload.size());
 
         return true;
     }
@@ -102,7 +124,7 @@ void NetworkClient::disconnect() {
                 LOG_INFO("Disconnected from server");
                 connected = false;
                 serverPeer = nullptr;
-                chunks.clear();
+                clearChunks();
                 return;
 
             default:
@@ -114,7 +136,7 @@ void NetworkClient::disconnect() {
     enet_peer_reset(serverPeer);
     serverPeer = nullptr;
     connected = false;
-    chunks.clear();
+    clearChunks();
 }
 
 void NetworkClient::update() {
@@ -136,13 +158,80 @@ void NetworkClient::update() {
                 LOG_WARN("Disconnected from server unexpectedly");
                 connected = false;
                 serverPeer = nullptr;
-                chunks.clear();
+                clearChunks();
                 break;
 
             default:
                 break;
         }
     }
+
+    updateRemotePlayers();
+    expirePredictions();
+
+    if (connected) {
+        sendKeepAliveIfDue();
+        netStats.updateRates();
+    }
+}
+
+void NetworkClient::sendKeepAliveIfDue() {
+    auto now = std::chrono::steady_clock::now();
+    if (std::chrono::duration<float>(now - lastKeepAlive).count() < KEEPALIVE_INTERVAL) {
+        return;
+    }
+    lastKeepAlive = now;
+
+    protocol::KeepAliveMessage ping{};
+    ping.timestamp = NetworkStats::timestampMicros();
+    ping.isReply = 0;
+
+    // Unreliable channel so the sample isn't delayed behind reliable traffic
+    sendMessage(protocol::MessageType::KeepAlive, &ping, sizeof(ping), protocol::CHANNEL_UNRELIABLE, 0);
+}
+
+void NetworkClient::handleKeepAlive(const uint8_t* data, size_t size) {
+    if (size < sizeof(protocol::KeepAliveMessage)) {
+        return;
+    }
+
+    protocol::KeepAliveMessage msg{};
+    std::memcpy(&msg, data, sizeof(msg));
+
+    if (msg.isReply == 0) {
+        // Server is measuring its RTT to us - echo unchanged
+        msg.isReply = 1;
+        sendMessage(protocol::MessageType::KeepAlive, &msg, sizeof(msg), protocol::CHANNEL_UNRELIABLE, 0);
+        return;
+    }
+
+    uint64_t sentAt = msg.timestamp;
+    uint64_t now = NetworkStats::timestampMicros();
+    if (sentAt <= now) {
+        netStats.addRttSample(static_cast<float>(now - sentAt) / 1000.0f);
+    }
+}
+
+double NetworkClient::snapshotTime() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - clockStart).count();
+}
+
+void NetworkClient::updateRemotePlayers() {
+    double now = snapshotTime();
+
+    for (const auto& [playerId, buffer] : playerSnapshots) {
+        // A player asked to send moves slowly needs a longer delay to always have the next update
+        float delay = interpolationDelay;
+        auto interval = playerMoveIntervals.find(playerId);
+        if (interval != playerMoveIntervals.end()) {
+            delay = std::max(delay, interval->second * MOVE_INTERVAL_DELAY_FACTOR);
+        }
+
+        PlayerSnapshot state;
+        if (buffer.sample(now - static_cast<double>(delay), static_cast<double>(maxExtrapolation), state)) {
+            otherPlayers[playerId] = PlayerData{state.position, state.yaw, state.pitch};
+        }
+    }
 }
 
 void NetworkClient::sendPlayerMove(const glm::vec3& position, const glm::vec3& velocity, float yaw, float pitch) {
@@ -164,7 +253,63 @@ void NetworkClient::sendPlayerMove(const glm::vec3& position, const glm::vec3& v
         loggedOnce = true;
     }
 
-    sendMessage(protocol::MessageType::PlayerMove, &msg, sizeof(msg));
+    if (!hasCapability(protocol::CAPABILITY_UNRELIABLE_MOVEMENT)) {
+        sendMessage(protocol::MessageType::PlayerMove, &msg, sizeof(msg));
+        return;
+    }
+
+    // Each move supersedes the last, so a lost one is never worth retransmitting
+    protocol::PlayerMoveSequenceMessage sequenceMsg{};
+    sequenceMsg.inputSequence = ++inputSequence;
+
+    protocol::PlayerMoveAckMessage ackMsg{};
+    ackMsg.correctionSequence = appliedCorrection;
+
+    std::array<uint8_t, sizeof(msg) + sizeof(sequenceMsg) + sizeof(ackMsg)> movePayload{};
+    std::memcpy(movePayload.data(), &msg, sizeof(msg));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(movePayload.data() + sizeof(msg), &sequenceMsg, sizeof(sequenceMsg));
+    size_t payloadSize = sizeof(msg) + sizeof(sequenceMsg);
+    if (hasCapability(protocol::CAPABILITY_MOVE_CORRECTION)) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memcpy(movePayload.data() + payloadSize, &ackMsg, sizeof(ackMsg));
+        payloadSize += sizeof(ackMsg);
+
+        // Keep the move until the server can no longer correct it
+        sentMoves.push_back(SentMove{inputSequence, position});
+        if (sentMoves.size() > MAX_SENT_MOVES) {
+            sentMoves.pop_front();
+        }
+    }
+
+    sendMessage(protocol::MessageType::PlayerMove, movePayload.data(), payloadSize,
+                protocol::CHANNEL_UNRELIABLE, 0);
+}
+
+void NetworkClient::handleMoveCorrection(const protocol::PlayerCorrectionMessage& msg) {
+    uint32_t correctedSequence = msg.inputSequence;
+    glm::vec3 position = msg.position;
+
+    // The movement of every move after the corrected one, to redo from the corrected position
+    std::vector<glm::vec3> replay;
+    const SentMove* previous = nullptr;
+    for (const SentMove& move : sentMoves) {
+        if (previous != nullptr && protocol::isSequenceNewer(move.sequence, correctedSequence)) {
+            replay.push_back(move.position - previous->position);
+        }
+        previous = &move;
+    }
+
+    // Every move sent from now on starts from the corrected position
+    sentMoves.clear();
+    appliedCorrection = correctedSequence;
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+    LOG_DEBUG("Server corrected move {} to ({:.2f}, {:.2f}, {:.2f}), replaying {} moves",
+              correctedSequence, position.x, position.y, position.z, replay.size());
+    if (onMoveCorrected) {
+        onMoveCorrected(position, replay);
+    }
 }
 
 void NetworkClient::sendBlockPlace(int32_t posX, int32_t posY, int32_t posZ, uint16_t blockType) {
@@ -178,6 +323,7 @@ void NetworkClient::sendBlockPlace(int32_t posX, int32_t posY, int32_t posZ, uin
     msg.z = posZ;
     msg.blockType = blockType;
 
+    predictBlockEdit(glm::ivec3(posX, posY, posZ), static_cast<BlockType>(blockType));
     sendMessage(protocol::MessageType::BlockPlace, &msg, sizeof(msg));
 }
 
@@ -194,9 +340,89 @@ void NetworkClient::sendBlockBreak(int32_t posX, int32_t posY, int32_t posZ) {
     msg.y = posY;
     msg.z = posZ;
 
+    predictBlockEdit(glm::ivec3(posX, posY, posZ), BlockType::Air);
     sendMessage(protocol::MessageType::BlockBreak, &msg, sizeof(msg));
 }
 
+bool NetworkClient::setLocalBlock(const glm::ivec3& position, BlockType type, BlockType& outPrevious, bool relightNow) {
+    ChunkCoord chunkCoord = ChunkCoord::fromWorldPos(glm::vec3(position));
+    Chunk* chunk = getChunk(chunkCoord);
+    if (chunk == nullptr) {
+        return false;
+    }
+
+    // Convert world coords to local chunk coords
+    glm::ivec3 local = position - (glm::ivec3(chunkCoord.x, chunkCoord.y, chunkCoord.z) * static_cast<int32_t>(CHUNK_SIZE));
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+    const Block& block = std::as_const(*chunk).getBlock(static_cast<uint32_t>(local.x), static_cast<uint32_t>(local.y), static_cast<uint32_t>(local.z));
+    outPrevious = block.type;
+    if (outPrevious != type) {
+        chunk->setBlock(static_cast<uint32_t>(local.x), static_cast<uint32_t>(local.y), static_cast<uint32_t>(local.z), Block{type});
+        columns[ChunkCoord{chunkCoord.x, 0, chunkCoord.z}].updateBlockColumn(
+            *chunk, static_cast<uint32_t>(local.x), static_cast<uint32_t>(local.z),
+            sectionLookup(chunkCoord.x, chunkCoord.z));
+
+        // Relit here rather than sent by the server; the same edits give the same light
+        lightEngine.enqueueEdit(position, outPrevious);
+        if (relightNow) {
+            relight({chunkCoord});
+        }
+    }
+    // NOLINTEND(cppcoreguidelines-pro-type-union-access)
+    return true;
+}
+
+void NetworkClient::predictBlockEdit(const glm::ivec3& position, BlockType type) {
+    BlockType previous = BlockType::Air;
+    if (!setLocalBlock(position, type, previous) || previous == type) {
+        return;  // Nothing to predict - the server update will be applied as-is
+    }
+
+    predictedEdits.push_back(PredictedEdit{position, previous, type, std::chrono::steady_clock::now()});
+    notifyBlockChanged(position);
+}
+
+void NetworkClient::rollbackPrediction(const glm::ivec3& position) {
+    auto oldest = std::find_if(predictedEdits.begin(), predictedEdits.end(),
+                               [&position](const PredictedEdit& edit) { return edit.position == position; });
+    if (oldest == predictedEdits.end()) {
+        return;
+    }
+
+    // Later predictions at this block were built on top of the failed one, drop them too
+    BlockType restoreType = oldest->previousType;
+    std::erase_if(predictedEdits, [&position](const PredictedEdit& edit) { return edit.position == position; });
+
+    BlockType previous = BlockType::Air;
+    if (setLocalBlock(position, restoreType, previous) && previous != restoreType) {
+        notifyBlockChanged(position);
+    }
+}
+
+void NetworkClient::expirePredictions() {
+    auto now = std::chrono::steady_clock::now();
+    while (!predictedEdits.empty()) {
+        const PredictedEdit& oldest = predictedEdits.front();
+        if (std::chrono::duration<float>(now - oldest.sentTime).count() < PREDICTION_TIMEOUT) {
+            break;
+        }
+
+        glm::ivec3 position = oldest.position;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+        LOG_WARN("CLIENT: No server answer for block edit at ({}, {}, {}) - rolling back",
+                 position.x, position.y, position.z);
+        rollbackPrediction(position);
+    }
+}
+
+void NetworkClient::notifyBlockChanged(const glm::ivec3& position) {
+    if (onBlockChanged) {
+        onBlockChanged(position);
+    } else if (onChunkReceived) {
+        onChunkReceived(ChunkCoord::fromWorldPos(glm::vec3(position)));
+    }
+}
+
 void NetworkClient::sendInventoryUpdate(const ItemStack hotbar[9], uint32_t selectedSlot) {
     if (!connected) {
         return;
@@ -220,6 +446,43 @@ const Chunk* NetworkClient::getChunk(const ChunkCoord& coord) const {
     return (iter != chunks.end()) ? iter->second.get() : nullptr;
 }
 
+const ColumnHeightmap* NetworkClient::getColumnHeightmap(int32_t chunkX, int32_t chunkZ) const {
+    auto iter = columns.find(ChunkCoord{chunkX, 0, chunkZ});
+    return (iter != columns.end()) ? &iter->second : nullptr;
+}
+
+bool NetworkClient::isSectionEmpty(const ChunkCoord& coord) const {
+    const ColumnHeightmap* column = getColumnHeightmap(coord.x, coord.z);
+    return column != nullptr && column->isSectionEmpty(coord.y);
+}
+
+void NetworkClient::clearChunks() {
+    chunks.clear();
+    columns.clear();
+}
+
+ColumnHeightmap::SectionLookup NetworkClient::sectionLookup(int32_t chunkX, int32_t chunkZ) const {
+    return [this, chunkX, chunkZ](int32_t chunkY) { return getChunk(ChunkCoord{chunkX, chunkY, chunkZ}); };
+}
+
+void NetworkClient::relight(const std::unordered_set<ChunkCoord>& notified) {
+    if (!lightEngine.hasPending()) {
+        return;
+    }
+
+    lightChanged.clear();
+    lightEngine.process(&lightChanged);
+    if (!onChunkLightChanged) {
+        return;
+    }
+
+    for (const ChunkCoord& coord : lightChanged) {
+        if (!notified.contains(coord) && getChunk(coord) != nullptr && !isSectionEmpty(coord)) {
+            onChunkLightChanged(coord);
+        }
+    }
+}
+
 void NetworkClient::handlePacket(ENetPacket* packet) {
     if (packet->dataLength < sizeof(protocol::MessageHeader)) {
         LOG_WARN("Received malformed packet (too small)");
@@ -230,6 +493,8 @@ void NetworkClient::handlePacket(ENetPacket* packet) {
     protocol::MessageHeader header{};
     std::memcpy(&header, packet->data, sizeof(protocol::MessageHeader));
 
+    netStats.recordReceived(header.type, packet->dataLength);
+
     // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
     const uint8_t* payload = packet->data + sizeof(protocol::MessageHeader);
     size_t payloadSize = packet->dataLength - sizeof(protocol::MessageHeader);
@@ -240,6 +505,10 @@ void NetworkClient::handlePacket(ENetPacket* packet) {
             handleChunkData(payload, payloadSize);
             break;
 
+        case protocol::MessageType::ChunkColumnData:
+            handleChunkColumnData(payload, payloadSize);
+            break;
+
         case protocol::MessageType::ChunkUnload:
             if (payloadSize >= sizeof(protocol::ChunkUnloadMessage)) {
                 protocol::ChunkUnloadMessage msg;
@@ -256,12 +525,22 @@ void NetworkClient::handlePacket(ENetPacket* packet) {
             }
             break;
 
+        case protocol::MessageType::BlockUpdateBatch:
+            handleBlockUpdateBatch(payload, payloadSize);
+            break;
+
         case protocol::MessageType::PlayerSpawn:
             if (payloadSize >= sizeof(protocol::PlayerSpawnMessage)) {
                 protocol::PlayerSpawnMessage msg{};
                 std::memcpy(&msg, payload, sizeof(msg));
+                uint32_t playerId = msg.playerId;
                 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
-                otherPlayers[msg.playerId] = PlayerData{msg.spawnPosition, 0.0f, 0.0f};
+                otherPlayers[playerId] = PlayerData{msg.spawnPosition, 0.0f, 0.0f};
+
+                // Start a fresh buffer so the player doesn't glide in from a stale position
+                SnapshotInterpolator& buffer = playerSnapshots[playerId];
+                buffer.clear();
+                buffer.push(PlayerSnapshot{snapshotTime(), msg.spawnPosition, 0.0f, 0.0f});
                 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
                 LOG_INFO("Player {} spawned at ({:.1f}, {:.1f}, {:.1f})",
                          // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
@@ -273,7 +552,21 @@ void NetworkClient::handlePacket(ENetPacket* packet) {
             if (payloadSize >= sizeof(protocol::PlayerPositionUpdateMessage)) {
                 protocol::PlayerPositionUpdateMessage msg{};
                 std::memcpy(&msg, payload, sizeof(msg));
-                otherPlayers[msg.playerId] = PlayerData{msg.position, msg.yaw, msg.pitch};
+                // Buffer the update - otherPlayers is resampled at render time in update()
+                playerSnapshots[msg.playerId].push(PlayerSnapshot{snapshotTime(), msg.position, msg.yaw, msg.pitch});
+
+                if (hasCapability(protocol::CAPABILITY_POSITION_INTERVAL) &&
+                    payloadSize >= sizeof(msg) + sizeof(protocol::PlayerPositionIntervalMessage)) {
+                    protocol::PlayerPositionIntervalMessage intervalMsg{};
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    std::memcpy(&intervalMsg, payload + sizeof(msg), sizeof(intervalMsg));
+                    uint16_t intervalMs = intervalMsg.moveIntervalMs;
+                    if (intervalMs > 0) {
+                        playerMoveIntervals[msg.playerId] = static_cast<float>(intervalMs) / 1000.0f;
+                    } else {
+                        playerMoveIntervals.erase(msg.playerId);
+                    }
+                }
             }
             break;
 
@@ -282,6 +575,8 @@ void NetworkClient::handlePacket(ENetPacket* packet) {
                 protocol::PlayerRemoveMessage msg{};
                 std::memcpy(&msg, payload, sizeof(msg));
                 otherPlayers.erase(msg.playerId);
+                playerSnapshots.erase(msg.playerId);
+                playerMoveIntervals.erase(msg.playerId);
                 LOG_INFO("Player {} disconnected and removed", msg.playerId);
             }
             break;
@@ -300,6 +595,40 @@ void NetworkClient::handlePacket(ENetPacket* packet) {
             }
             break;
 
+        case protocol::MessageType::ServerCapabilities:
+            if (payloadSize >= sizeof(protocol::ServerCapabilitiesMessage)) {
+                protocol::ServerCapabilitiesMessage msg{};
+                std::memcpy(&msg, payload, sizeof(msg));
+                uint32_t serverVersion = msg.protocolVersion;
+                // Never enable something we did not advertise, whatever the server says
+                capabilities = protocol::negotiateCapabilities(msg.enabledCapabilities,
+                                                               protocol::SUPPORTED_CAPABILITIES);
+                LOG_INFO("Server protocol v{} | Negotiated capabilities: 0x{:08x}", serverVersion, capabilities);
+            }
+            break;
+
+        case protocol::MessageType::KeepAlive:
+            handleKeepAlive(payload, payloadSize);
+            break;
+
+        case protocol::MessageType::PlayerCorrection:
+            if (payloadSize >= sizeof(protocol::PlayerCorrectionMessage)) {
+                protocol::PlayerCorrectionMessage msg{};
+                std::memcpy(&msg, payload, sizeof(msg));
+                handleMoveCorrection(msg);
+            }
+            break;
+
+        case protocol::MessageType::MoveRateHint:
+            if (payloadSize >= sizeof(protocol::MoveRateHintMessage)) {
+                protocol::MoveRateHintMessage msg{};
+                std::memcpy(&msg, payload, sizeof(msg));
+                uint16_t intervalMs = msg.moveIntervalMs;
+                moveSendInterval = static_cast<float>(intervalMs) / 1000.0f;
+                LOG_DEBUG("Server requested movement every {} ms", intervalMs);
+            }
+            break;
+
         default:
             LOG_TRACE("Received unhandled message type: {}", static_cast<int>(header.type));
             break;
@@ -320,9 +649,22 @@ void NetworkClient::handleChunkData(const uint8_t* data, size_t size) {
     const uint8_t* compressedData = data + sizeof(protocol::ChunkDataMessage);
     size_t compressedSize = size - sizeof(protocol::ChunkDataMessage);
 
+    // With light, the block data is followed by the light data
+    bool receivedLight = hasCapability(protocol::CAPABILITY_CHUNK_LIGHT);
+    size_t lightSize = 0;
+    if (receivedLight) {
+        if (header.compressedSize > compressedSize) {
+            LOG_WARN("Malformed chunk data message");
+            return;
+        }
+        lightSize = compressedSize - header.compressedSize;
+        compressedSize = header.compressedSize;
+    }
+
     // Create chunk and deserialize
     auto chunk = std::make_unique<Chunk>(header.coord);
-    if (!ChunkSerializer::deserialize(compressedData, compressedSize, *chunk)) {
+    if (!decodeChunkPayload(compressedData, compressedSize, *chunk) ||
+        (receivedLight && !ChunkSerializer::deserializeLight(compressedData + compressedSize, lightSize, chunk->getLight()))) {  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         LOG_ERROR("Failed to deserialize chunk at ({}, {}, {})",
                   header.coord.x, header.coord.y, header.coord.z);
         return;
@@ -332,20 +674,167 @@ void NetworkClient::handleChunkData(const uint8_t* data, size_t size) {
               header.coord.x, header.coord.y, header.coord.z, compressedSize);
 
     // Store chunk
+    columns[ChunkCoord{header.coord.x, 0, header.coord.z}].setSection(
+        *chunk, sectionLookup(header.coord.x, header.coord.z));
     chunks[header.coord] = std::move(chunk);
 
+    if (receivedLight) {
+        lightEngine.enqueueBorderMerge(header.coord);
+    } else {
+        lightEngine.enqueueSection(header.coord);
+    }
+    // A non-empty section is remeshed with its neighbours by the received callback
+    const ChunkCoord& coord = header.coord;
+    if (isSectionEmpty(coord)) {
+        relight({coord});
+    } else {
+        relight({coord, {coord.x - 1, coord.y, coord.z}, {coord.x + 1, coord.y, coord.z}, {coord.x, coord.y - 1, coord.z},
+                 {coord.x, coord.y + 1, coord.z}, {coord.x, coord.y, coord.z - 1}, {coord.x, coord.y, coord.z + 1}});
+    }
+
     // Notify callback
     if (onChunkReceived) {
         onChunkReceived(header.coord);
     }
 }
 
+void NetworkClient::handleChunkColumnData(const uint8_t* data, size_t size) {
+    if (size < sizeof(protocol::ChunkColumnDataMessage)) {
+        LOG_WARN("Malformed chunk column message");
+        return;
+    }
+
+    protocol::ChunkColumnDataMessage header{};
+    std::memcpy(&header, data, sizeof(protocol::ChunkColumnDataMessage));
+    int32_t chunkX = header.chunkX;
+    int32_t chunkZ = header.chunkZ;
+    size_t offset = sizeof(protocol::ChunkColumnDataMessage);
+
+    // Heightmap comes precomputed over the whole column, so nothing is rescanned here
+    ColumnHeightmap::Heights heights{};
+    if (offset + header.heightmapSize > size ||
+        !ChunkSerializer::deserializeHeightmap(data + offset, header.heightmapSize, heights)) {  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        LOG_ERROR("Failed to decode heightmap of column ({}, {})", chunkX, chunkZ);
+        return;
+    }
+    offset += header.heightmapSize;
+
+    // Decode every section before storing any, so a corrupt packet leaves the cache untouched
+    bool receivedLight = hasCapability(protocol::CAPABILITY_CHUNK_LIGHT);
+    std::vector<std::unique_ptr<Chunk>> sections;
+    sections.reserve(header.sectionCount);
+    for (uint16_t i = 0; i < header.sectionCount; i++) {
+        if (offset + sizeof(protocol::ColumnSectionHeader) > size) {
+            LOG_ERROR("Truncated chunk column ({}, {})", chunkX, chunkZ);
+            return;
+        }
+        protocol::ColumnSectionHeader sectionHeader{};
+        std::memcpy(&sectionHeader, data + offset, sizeof(protocol::ColumnSectionHeader));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        offset += sizeof(protocol::ColumnSectionHeader);
+
+        int32_t chunkY = sectionHeader.chunkY;
+        size_t dataSize = sectionHeader.dataSize;
+        if (offset + dataSize > size) {
+            LOG_ERROR("Truncated section ({}, {}, {}) in chunk column", chunkX, chunkY, chunkZ);
+            return;
+        }
+
+        auto chunk = std::make_unique<Chunk>(ChunkCoord{chunkX, chunkY, chunkZ});
+        if (!decodeChunkPayload(data + offset, dataSize, *chunk)) {  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            LOG_ERROR("Failed to deserialize chunk at ({}, {}, {})", chunkX, chunkY, chunkZ);
+            return;
+        }
+        offset += dataSize;
+
+        if (receivedLight) {
+            uint32_t lightSize = 0;
+            if (offset + sizeof(uint32_t) > size) {
+                LOG_ERROR("Truncated section ({}, {}, {}) in chunk column", chunkX, chunkY, chunkZ);
+                return;
+            }
+            std::memcpy(&lightSize, data + offset, sizeof(uint32_t));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            offset += sizeof(uint32_t);
+            if (offset + lightSize > size ||
+                !ChunkSerializer::deserializeLight(data + offset, lightSize, chunk->getLight())) {  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                LOG_ERROR("Failed to decode light of chunk ({}, {}, {})", chunkX, chunkY, chunkZ);
+                return;
+            }
+            offset += lightSize;
+        }
+        sections.push_back(std::move(chunk));
+    }
+
+    std::vector<int32_t> levels;
+    std::vector<bool> emptyFlags;
+    levels.reserve(sections.size());
+    emptyFlags.reserve(sections.size());
+    for (auto& chunk : sections) {
+        ChunkCoord coord = chunk->getCoord();
+        levels.push_back(coord.y);
+        emptyFlags.push_back(chunk->isEmpty());
+        chunks[coord] = std::move(chunk);
+    }
+    columns[ChunkCoord{chunkX, 0, chunkZ}].setColumn(levels, emptyFlags, heights);
+
+    // Chunks the column callback remeshes anyway: the column (one level either side) and its neighbours
+    std::unordered_set<ChunkCoord> notified;
+    for (int32_t chunkY : levels) {
+        if (receivedLight) {
+            lightEngine.enqueueBorderMerge(ChunkCoord{chunkX, chunkY, chunkZ});
+        } else {
+            lightEngine.enqueueSection(ChunkCoord{chunkX, chunkY, chunkZ});
+        }
+        for (int32_t offsetY = -1; offsetY <= 1; offsetY++) {
+            notified.insert(ChunkCoord{chunkX, chunkY + offsetY, chunkZ});
+        }
+        notified.insert(ChunkCoord{chunkX - 1, chunkY, chunkZ});
+        notified.insert(ChunkCoord{chunkX + 1, chunkY, chunkZ});
+        notified.insert(ChunkCoord{chunkX, chunkY, chunkZ - 1});
+        notified.insert(ChunkCoord{chunkX, chunkY, chunkZ + 1});
+    }
+    relight(notified);
+
+    LOG_DEBUG("Received chunk column ({}, {}) | {} sections, {} bytes", chunkX, chunkZ, levels.size(), size);
+
+    if (onColumnReceived) {
+        onColumnReceived(chunkX, chunkZ, levels);
+    } else if (onChunkReceived) {
+        for (int32_t chunkY : levels) {
+            onChunkReceived(ChunkCoord{chunkX, chunkY, chunkZ});
+        }
+    }
+}
+
+bool NetworkClient::decodeChunkPayload(const uint8_t* data, size_t size, Chunk& outChunk) {
+    if (hasCapability(protocol::CAPABILITY_EMPTY_SECTIONS) && size == 1 &&
+        data[0] == protocol::EMPTY_SECTION_MARKER) {  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        // All air: share one buffer instead of holding 64 KB per empty section
+        if (!emptySectionBlocks) {
+            emptySectionBlocks = outChunk.getSharedBlockData();
+        }
+        outChunk.shareBlockData(emptySectionBlocks);
+        return true;
+    }
+    if (hasCapability(protocol::CAPABILITY_CHUNK_BRICKS)) {
+        return ChunkSerializer::deserializeBricks(data, size, outChunk);
+    }
+    return ChunkSerializer::deserialize(data, size, outChunk);
+}
+
 void NetworkClient::handleChunkUnload(const protocol::ChunkUnloadMessage& msg) {
     auto iter = chunks.find(msg.coord);
     if (iter != chunks.end()) {
         LOG_DEBUG("Unloading chunk ({}, {}, {})", msg.coord.x, msg.coord.y, msg.coord.z);
         chunks.erase(iter);
 
+        auto columnIt = columns.find(ChunkCoord{msg.coord.x, 0, msg.coord.z});
+        if (columnIt != columns.end()) {
+            columnIt->second.removeSection(msg.coord.y, sectionLookup(msg.coord.x, msg.coord.z));
+            if (!columnIt->second.hasSections()) {
+                columns.erase(columnIt);
+            }
+        }
+
         // Notify callback
         if (onChunkUnloaded) {
             onChunkUnloaded(msg.coord);
@@ -353,51 +842,111 @@ void NetworkClient::handleChunkUnload(const protocol::ChunkUnloadMessage& msg) {
     }
 }
 
-void NetworkClient::handleBlockUpdate(const protocol::BlockUpdateMessage& msg) {
-    // Find chunk containing this block
-    ChunkCoord chunkCoord = ChunkCoord::fromWorldPos(glm::vec3(msg.x, msg.y, msg.z));
-    Chunk* chunk = getChunk(chunkCoord);
+bool NetworkClient::handleBlockUpdate(const protocol::BlockUpdateMessage& msg, bool batched) {
+    glm::ivec3 position(msg.x, msg.y, msg.z);
+    if (!BlockRegistry::isValid(msg.blockType)) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+        LOG_WARN("Ignoring BlockUpdate at ({}, {}, {}) with unknown block type {}", position.x, position.y, position.z,
+                 msg.blockType);
+        return false;
+    }
+    auto serverType = static_cast<BlockType>(msg.blockType);
 
-    if (chunk == nullptr) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+    LOG_DEBUG("CLIENT: Received BlockUpdate at ({}, {}, {}) to type {}", position.x, position.y, position.z,
+              static_cast<int>(serverType));
+
+    // Reconcile against our oldest prediction at this block (server answers in request order)
+    auto pending = std::find_if(predictedEdits.begin(), predictedEdits.end(),
+                                [&position](const PredictedEdit& edit) { return edit.position == position; });
+    if (pending != predictedEdits.end()) {
+        if (pending->predictedType == serverType) {
+            // Confirmed - local state already shows this (or a newer prediction on top of it)
+            predictedEdits.erase(pending);
+            return false;
+        }
+
+        // Mispredicted, or someone else edited the block first: server state wins
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+        LOG_DEBUG("CLIENT: Block edit at ({}, {}, {}) mispredicted, applying server state",
+                  position.x, position.y, position.z);
+        std::erase_if(predictedEdits, [&position](const PredictedEdit& edit) { return edit.position == position; });
+    }
+
+    BlockType previous = BlockType::Air;
+    if (!setLocalBlock(position, serverType, previous, !batched)) {
+        ChunkCoord chunkCoord = ChunkCoord::fromWorldPos(glm::vec3(position));
         LOG_WARN("Received block update for unloaded chunk ({}, {}, {})",
                  chunkCoord.x, chunkCoord.y, chunkCoord.z);
-        return;
+        return false;
     }
 
-    // Convert world coords to local chunk coords
-    glm::vec3 worldOrigin = chunkCoord.toWorldPos();
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
-    uint32_t localX = msg.x - static_cast<int32_t>(worldOrigin.x);
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
-    uint32_t localY = msg.y - static_cast<int32_t>(worldOrigin.y);
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
-    uint32_t localZ = msg.z - static_cast<int32_t>(worldOrigin.z);
+    if (previous != serverType && !batched) {
+        notifyBlockChanged(position);
+    }
+    return previous != serverType;
+}
 
-    // Update block
-    Block block;
-    block.type = static_cast<BlockType>(msg.blockType);
-    chunk->setBlock(localX, localY, localZ, block);
+void NetworkClient::handleBlockUpdateBatch(const uint8_t* data, size_t size) {
+    protocol::BlockUpdateBatchMessage batchMsg{};
+    if (size < sizeof(batchMsg)) {
+        LOG_WARN("BlockUpdateBatch too small: {} bytes", size);
+        return;
+    }
+    std::memcpy(&batchMsg, data, sizeof(batchMsg));
+    size_t count = batchMsg.count;
+    if (size < sizeof(batchMsg) + (count * sizeof(protocol::BlockUpdateMessage))) {
+        LOG_WARN("BlockUpdateBatch truncated: {} entries in {} bytes", count, size);
+        return;
+    }
 
-    LOG_INFO("CLIENT: Received BlockUpdate at ({}, {}, {}) to type {}", msg.x, msg.y, msg.z, msg.blockType);
+    // A block change remeshes its chunk plus the neighbours whose border it
+    // touches, so one notification per (chunk, touched borders) covers the batch
+    std::unordered_map<ChunkCoord, uint64_t> notifiedMasks;  // Bit n = border mask n already notified
+    std::vector<glm::ivec3> toNotify;
+    std::unordered_set<ChunkCoord> changedChunks;
+    const uint8_t* entry = data + sizeof(batchMsg);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    for (size_t index = 0; index < count; index++) {
+        protocol::BlockUpdateMessage msg{};
+        std::memcpy(&msg, entry, sizeof(msg));
+        entry += sizeof(msg);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (!handleBlockUpdate(msg, true)) {
+            continue;
+        }
 
-    // Notify callback to regenerate mesh
-    if (onChunkReceived) {
-        LOG_INFO("CLIENT: Triggering mesh regeneration for chunk ({}, {}, {})",
-                 chunkCoord.x, chunkCoord.y, chunkCoord.z);
-        onChunkReceived(chunkCoord);
-    } else {
-        LOG_WARN("CLIENT: No chunk callback registered - mesh won't update!");
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+        glm::ivec3 position(msg.x, msg.y, msg.z);
+        ChunkCoord chunkCoord = ChunkCoord::fromWorldPos(glm::vec3(position));
+        glm::ivec3 local = position - (glm::ivec3(chunkCoord.x, chunkCoord.y, chunkCoord.z) * static_cast<int32_t>(CHUNK_SIZE));
+        uint32_t borders = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            borders |= (local[axis] == 0 ? 1u : 0u) << (axis * 2);
+            borders |= (local[axis] == static_cast<int32_t>(CHUNK_SIZE) - 1 ? 1u : 0u) << ((axis * 2) + 1);
+        }
+        // NOLINTEND(cppcoreguidelines-pro-type-union-access)
+        changedChunks.insert(chunkCoord);
+        uint64_t& seen = notifiedMasks[chunkCoord];
+        if ((seen & (uint64_t{1} << borders)) == 0) {
+            seen |= uint64_t{1} << borders;
+            toNotify.push_back(position);
+        }
+    }
+
+    relight(changedChunks);
+    for (const glm::ivec3& position : toNotify) {
+        notifyBlockChanged(position);
     }
 }
 
-void NetworkClient::sendMessage(protocol::MessageType type, const void* data, size_t size) {
+void NetworkClient::sendMessage(protocol::MessageType type, const void* data, size_t size,
+                                uint8_t channel, uint32_t flags) {
     if (!connected || serverPeer == nullptr) {
         return;
     }
 
     // Create packet with header + payload
     size_t totalSize = sizeof(protocol::MessageHeader) + size;
-    ENetPacket* packet = enet_packet_create(nullptr, totalSize, ENET_PACKET_FLAG_RELIABLE);
+    ENetPacket* packet = enet_packet_create(nullptr, totalSize, flags);
 
     // Write header
     protocol::MessageHeader header{};
@@ -412,7 +961,8 @@ void NetworkClient::sendMessage(protocol::MessageType type, const void* data, si
     }
 
     // Send packet
-    enet_peer_send(serverPeer, 0, packet);
+    netStats.recordSent(type, totalSize);
+    enet_peer_send(serverPeer, channel, packet);
 }
 
 } // namespace engine
@@ -0,0 +1,83 @@
+#include "client/SnapshotInterpolator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine {
+
+void SnapshotInterpolator::push(const PlayerSnapshot& snapshot) {
+    if (count > 0 && snapshot.time < at(count - 1).time) {
+        return;  // Out of order - newer state already known
+    }
+
+    if (count < CAPACITY) {
+        snapshots[(head + count) % CAPACITY] = snapshot;
+        count++;
+    } else {
+        // Buffer full: overwrite the oldest entry
+        snapshots[head] = snapshot;
+        head = (head + 1) % CAPACITY;
+    }
+}
+
+bool SnapshotInterpolator::sample(double renderTime, double maxExtrapolation, PlayerSnapshot& outSnapshot) const {
+    if (count == 0) {
+        return false;
+    }
+
+    const PlayerSnapshot& oldest = at(0);
+    const PlayerSnapshot& newest = at(count - 1);
+
+    // Render time is before anything we know about - hold the oldest state
+    if (renderTime <= oldest.time || count == 1) {
+        outSnapshot = (renderTime <= oldest.time) ? oldest : newest;
+        return true;
+    }
+
+    // Render time is past the newest snapshot - extrapolate along the last segment
+    if (renderTime >= newest.time) {
+        const PlayerSnapshot& previous = at(count - 2);
+        double span = newest.time - previous.time;
+        if (span <= 0.0) {
+            outSnapshot = newest;
+            return true;
+        }
+
+        double ahead = std::min(renderTime - newest.time, maxExtrapolation);
+        outSnapshot = blend(previous, newest, static_cast<float>(1.0 + (ahead / span)));
+        return true;
+    }
+
+    // Find the pair of snapshots surrounding the render time (newest first, that's the common case)
+    for (size_t idx = count - 1; idx > 0; idx--) {
+        const PlayerSnapshot& from = at(idx - 1);
+        if (from.time <= renderTime) {
+            const PlayerSnapshot& to = at(idx);
+            double span = to.time - from.time;
+            float alpha = (span > 0.0) ? static_cast<float>((renderTime - from.time) / span) : 1.0f;
+            outSnapshot = blend(from, to, alpha);
+            return true;
+        }
+    }
+
+    outSnapshot = oldest;
+    return true;
+}
+
+PlayerSnapshot SnapshotInterpolator::blend(const PlayerSnapshot& from, const PlayerSnapshot& to, float alpha) {
+    // Wrap angle difference into [-180, 180] so 359 -> 1 turns 2 degrees, not 358
+    auto lerpAngle = [alpha](float start, float end) {
+        float delta = end - start;
+        delta -= 360.0f * std::floor((delta + 180.0f) / 360.0f);
+        return start + (delta * alpha);
+    };
+
+    PlayerSnapshot result;
+    result.time = from.time + ((to.time - from.time) * static_cast<double>(alpha));
+    result.position = from.position + ((to.position - from.position) * alpha);
+    result.yaw = lerpAngle(from.yaw, to.yaw);
+    result.pitch = from.pitch + ((to.pitch - from.pitch) * alpha);
+    return result;
+}
+
+} // namespace engine
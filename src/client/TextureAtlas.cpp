@@ -35,20 +35,9 @@ TextureAtlas::~TextureAtlas() {
 void TextureAtlas::loadTextures(const std::string& texturePath) {
     LOG_INFO("Loading texture atlas from: {}", texturePath);
 
-    // Define all block textures to load (order matters for texture IDs)
-    std::vector<std::string> textureNames = {
-        "stone",
-        "dirt",
-        "grass_side",
-        "grass_top",
-        "cobblestone",
-        "wood",
-        "sand",
-        "brick",
-        "snow"
-    };
-
-    const uint32_t NUM_TEXTURES = textureNames.size();
+    // One atlas slot per BlockTexture, in BlockTexture order
+    const auto& textureNames = BLOCK_TEXTURE_NAMES;
+    const auto NUM_TEXTURES = static_cast<uint32_t>(textureNames.size());
     atlasWidth = textureSize * NUM_TEXTURES;
     atlasHeight = textureSize;
 
@@ -60,7 +49,7 @@ void TextureAtlas::loadTextures(const std::string& texturePath) {
     int height = 0;
     int channels = 0;
     for (uint32_t i = 0; i < NUM_TEXTURES; ++i) {
-        std::string texPath = texturePath + "/default/blocks/" + textureNames[i] + ".png";
+        std::string texPath = texturePath + "/default/blocks/" + std::string(textureNames[i]) + ".png";
         unsigned char* pixels = stbi_load(texPath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
 
         if (!pixels) {
@@ -96,21 +85,14 @@ void TextureAtlas::loadTextures(const std::string& texturePath) {
         stbi_image_free(pixels);
     }
 
-    // Calculate UV coordinates for each block type
-    // Atlas layout: [stone | dirt | grass_side | grass_top | cobblestone | wood | sand | brick | snow]
-    blockUVs[BlockType::Stone] = calculateUVs(0, NUM_TEXTURES);
-    blockUVs[BlockType::Dirt] = calculateUVs(1, NUM_TEXTURES);
-    blockUVs[BlockType::GrassSide] = calculateUVs(2, NUM_TEXTURES);
-    blockUVs[BlockType::GrassTop] = calculateUVs(3, NUM_TEXTURES);
-    blockUVs[BlockType::Cobblestone] = calculateUVs(4, NUM_TEXTURES);
-    blockUVs[BlockType::Wood] = calculateUVs(5, NUM_TEXTURES);
-    blockUVs[BlockType::Sand] = calculateUVs(6, NUM_TEXTURES);
-    blockUVs[BlockType::Brick] = calculateUVs(7, NUM_TEXTURES);
-    blockUVs[BlockType::Snow] = calculateUVs(8, NUM_TEXTURES);
+    // Calculate UV coordinates for each texture slot
+    for (uint32_t i = 0; i < NUM_TEXTURES; ++i) {
+        textureUVs[i] = calculateUVs(i, NUM_TEXTURES);
+    }
 
     LOG_INFO("Texture atlas created: {}x{}", atlasWidth, atlasHeight);
     for (uint32_t i = 0; i < NUM_TEXTURES; ++i) {
-        auto uvs = calculateUVs(i, NUM_TEXTURES);
+        const glm::vec4& uvs = textureUVs[i];
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
         LOG_INFO("{} UVs: ({}, {}) to ({}, {})", textureNames[i], uvs.x, uvs.y, uvs.z, uvs.w);
     }
@@ -121,22 +103,8 @@ void TextureAtlas::loadTextures(const std::string& texturePath) {
     createTextureSampler();
 }
 
-glm::vec4 TextureAtlas::getBlockUVs(BlockType type) const {
-    auto iter = blockUVs.find(type);
-    if (iter != blockUVs.end()) {
-        return iter->second;
-    }
-
-    // Fallback to dirt if block type not found
-    auto dirtIt = blockUVs.find(BlockType::Dirt);
-    if (dirtIt != blockUVs.end()) {
-        LOG_WARN("Block type {} not found in texture atlas, using Dirt as fallback", static_cast<int>(type));
-        return dirtIt->second;
-    }
-
-    // Ultimate fallback if even dirt is missing (should never happen)
-    LOG_ERROR("Texture atlas missing both requested block type {} and Dirt fallback!", static_cast<int>(type));
-    return glm::vec4(0.0f, 0.0f, 1.0f, 1.0f); // Return full atlas as error indicator
+glm::vec4 TextureAtlas::getTextureUVs(BlockTexture texture) const {
+    return textureUVs[static_cast<size_t>(texture)];
 }
 
 void TextureAtlas::createTextureImage(const unsigned char* pixels, uint32_t width, uint32_t height) {
@@ -20,16 +20,19 @@
 #include "vulkan/CubeGeometry.hpp"
 #include "core/Logger.hpp"
 #include "core/ResourceManager.hpp"
+#include "shared/Collision.hpp"
 
 #include <imgui.h>
 #include <imgui_impl_sdl3.h>
 #include <imgui_impl_vulkan.h>
 
+#include <algorithm>
 #include <stdexcept>
 #include <cstring>
 #include <chrono>
 #include <fstream>
 #include <random>
+#include <utility>
 
 namespace engine {
 
@@ -280,76 +283,90 @@ void VulkanEngine::initNetworking() {
 
     // Create network client
     networkClient = std::make_unique<NetworkClient>();
+    networkClient->setInterpolationDelay(config.interpolationDelay);
+    networkClient->setMaxExtrapolation(config.maxExtrapolation);
+
+    // Same swept collision the server validates moves with, over the chunks received so far
+    collision = std::make_unique<CollisionResolver>([this](const ChunkCoord& coord) {
+        return std::as_const(*networkClient).getChunk(coord);
+    });
 
     // Set up callback to queue chunks when received (async processing)
     networkClient->setOnChunkReceived([this](const ChunkCoord& coord) {
-        const Chunk* chunk = networkClient->getChunk(coord);
-        if (!chunk) {
+        if (!networkClient->getChunk(coord)) {
             return;
         }
 
-        // Helper to queue a chunk with its neighbors
-        auto queueChunk = [this](const ChunkCoord& chunkCoord) {
-            const Chunk* chk = networkClient->getChunk(chunkCoord);
-            if (!chk) {
-                return;
-            }
-
-            PendingChunk pending;
-            pending.coord = chunkCoord;
-            pending.chunk = std::make_shared<Chunk>(*chk);
-
-            // Copy neighbor chunks if they exist
-            const Chunk* neighborNegX = networkClient->getChunk({chunkCoord.x - 1, chunkCoord.y, chunkCoord.z});
-            const Chunk* neighborPosX = networkClient->getChunk({chunkCoord.x + 1, chunkCoord.y, chunkCoord.z});
-            const Chunk* neighborNegY = networkClient->getChunk({chunkCoord.x, chunkCoord.y - 1, chunkCoord.z});
-            const Chunk* neighborPosY = networkClient->getChunk({chunkCoord.x, chunkCoord.y + 1, chunkCoord.z});
-            const Chunk* neighborNegZ = networkClient->getChunk({chunkCoord.x, chunkCoord.y, chunkCoord.z - 1});
-            const Chunk* neighborPosZ = networkClient->getChunk({chunkCoord.x, chunkCoord.y, chunkCoord.z + 1});
-
-            if (neighborNegX) {
-                pending.neighborNegX = std::make_shared<Chunk>(*neighborNegX);
-            }
-            if (neighborPosX) {
-                pending.neighborPosX = std::make_shared<Chunk>(*neighborPosX);
-            }
-            if (neighborNegY) {
-                pending.neighborNegY = std::make_shared<Chunk>(*neighborNegY);
-            }
-            if (neighborPosY) {
-                pending.neighborPosY = std::make_shared<Chunk>(*neighborPosY);
-            }
-            if (neighborNegZ) {
-                pending.neighborNegZ = std::make_shared<Chunk>(*neighborNegZ);
-            }
-            if (neighborPosZ) {
-                pending.neighborPosZ = std::make_shared<Chunk>(*neighborPosZ);
-            }
-
-            {
-                std::lock_guard<std::mutex> lock(pendingChunksMutex);
-                pendingChunks.push(pending);
-            }
-        };
+        // An empty section has no faces of its own, and neighbours already
+        // treated the missing chunk as air, so nothing needs meshing
+        if (networkClient->isSectionEmpty(coord)) {
+            LOG_TRACE("Chunk ({}, {}, {}) is empty, skipping mesh", coord.x, coord.y, coord.z);
+            return;
+        }
 
         // Queue the new chunk
-        queueChunk(coord);
+        queueChunkMesh(coord);
 
         // Queue neighboring chunks for re-meshing (they can now cull faces against this chunk)
-        queueChunk({coord.x - 1, coord.y, coord.z});
-        queueChunk({coord.x + 1, coord.y, coord.z});
-        queueChunk({coord.x, coord.y - 1, coord.z});
-        queueChunk({coord.x, coord.y + 1, coord.z});
-        queueChunk({coord.x, coord.y, coord.z - 1});
-        queueChunk({coord.x, coord.y, coord.z + 1});
+        queueChunkMesh({coord.x - 1, coord.y, coord.z});
+        queueChunkMesh({coord.x + 1, coord.y, coord.z});
+        queueChunkMesh({coord.x, coord.y - 1, coord.z});
+        queueChunkMesh({coord.x, coord.y + 1, coord.z});
+        queueChunkMesh({coord.x, coord.y, coord.z - 1});
+        queueChunkMesh({coord.x, coord.y, coord.z + 1});
 
         LOG_DEBUG("Queued chunk ({}, {}, {}) and neighbors for async mesh generation",
                  coord.x, coord.y, coord.z);
     });
 
+    // A whole column arrives at once: mesh it and each neighbour column as one job apiece
+    networkClient->setOnColumnReceived([this](int32_t chunkX, int32_t chunkZ, const std::vector<int32_t>& levels) {
+        // The sections above and below the batch can now cull against it too
+        std::vector<int32_t> ownLevels = levels;
+        for (int32_t chunkY : levels) {
+            ownLevels.push_back(chunkY - 1);
+            ownLevels.push_back(chunkY + 1);
+        }
+        std::sort(ownLevels.begin(), ownLevels.end());
+        ownLevels.erase(std::unique(ownLevels.begin(), ownLevels.end()), ownLevels.end());
+
+        queueColumnMesh(chunkX, chunkZ, ownLevels);
+        queueColumnMesh(chunkX - 1, chunkZ, levels);
+        queueColumnMesh(chunkX + 1, chunkZ, levels);
+        queueColumnMesh(chunkX, chunkZ - 1, levels);
+        queueColumnMesh(chunkX, chunkZ + 1, levels);
+
+        LOG_DEBUG("Queued column ({}, {}) with {} sections and neighbors for async mesh generation",
+                 chunkX, chunkZ, levels.size());
+    });
+
+    // Single block edits skip the async queue so they show up the same frame
+    networkClient->setOnBlockChanged([this](const glm::ivec3& blockPos) {
+        ChunkCoord coord = ChunkCoord::fromWorldPos(glm::vec3(blockPos));
+        remeshChunkNow(coord);
+
+        // Neighbors only need a remesh when the block sits on the shared face
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+        glm::ivec3 local = blockPos - (glm::ivec3(coord.x, coord.y, coord.z) * static_cast<int32_t>(CHUNK_SIZE));
+        const auto last = static_cast<int32_t>(CHUNK_SIZE) - 1;
+        if (local.x == 0) { queueChunkMesh({coord.x - 1, coord.y, coord.z}); }
+        if (local.x == last) { queueChunkMesh({coord.x + 1, coord.y, coord.z}); }
+        if (local.y == 0) { queueChunkMesh({coord.x, coord.y - 1, coord.z}); }
+        if (local.y == last) { queueChunkMesh({coord.x, coord.y + 1, coord.z}); }
+        if (local.z == 0) { queueChunkMesh({coord.x, coord.y, coord.z - 1}); }
+        if (local.z == last) { queueChunkMesh({coord.x, coord.y, coord.z + 1}); }
+        // NOLINTEND(cppcoreguidelines-pro-type-union-access)
+    });
+
+    // Light spreading across chunk borders reshades chunks whose blocks didn't change
+    networkClient->setOnChunkLightChanged([this](const ChunkCoord& coord) {
+        queueChunkMesh(coord);
+    });
+
     // Set up callback to remove chunks when unloaded
     networkClient->setOnChunkUnloaded([this](const ChunkCoord& coord) {
         chunkRenderer->removeChunk(coord);
+        meshRevisions.erase(coord);
         LOG_INFO("Removed chunk ({}, {}, {}) from GPU | Total chunks: {}",
                  coord.x, coord.y, coord.z, chunkRenderer->getLoadedChunkCount());
     });
@@ -373,6 +390,16 @@ void VulkanEngine::initNetworking() {
                  position.x, position.y, position.z, yaw, pitch);
     });
 
+    networkClient->setOnMoveCorrected([this](const glm::vec3& position, const std::vector<glm::vec3>& replay) {
+        // Redo the moves the server hadn't resolved yet from where it put us, then the unsent movement
+        glm::vec3 unsent = camera->getPosition() - lastSentPosition;
+        glm::vec3 replayed = position;
+        for (const glm::vec3& delta : replay) {
+            replayed = collision->movePlayer(replayed, delta);
+        }
+        camera->setPosition(collision->movePlayer(replayed, unsent));
+    });
+
     // Load or generate username
     std::string username = loadUsername();
     console->setUsername(username);
@@ -795,7 +822,7 @@ void VulkanEngine::mainLoop() {
         // Process network messages
         networkClient->update();
 
-        // Process chunk loading asynchronously (up to MAX_CHUNKS_PER_FRAME per frame)
+        // Process chunk loading asynchronously (up to MAX_MESH_JOBS_PER_FRAME per frame)
         processPendingChunks();
 
         // Upload completed meshes to GPU
@@ -803,11 +830,12 @@ void VulkanEngine::mainLoop() {
 
         // Only update camera if mouse is captured and console is closed
         if (SDL_GetWindowRelativeMouseMode(window) && !console->isOpen()) {
-            // Update camera with noclip movement
+            // Update camera with flying movement, then stop it at solid blocks
             // Apply 8x speed boost when Ctrl is held
             float speedMultiplier = inputManager->isKeyPressed(SDL_SCANCODE_LCTRL) ||
                                    inputManager->isKeyPressed(SDL_SCANCODE_RCTRL) ? 8.0f : 1.0f;
 
+            glm::vec3 previousPosition = camera->getPosition();
             camera->processMovement(
                 inputManager->isKeyPressed(SDL_SCANCODE_W),  // Forward
                 inputManager->isKeyPressed(SDL_SCANCODE_S),  // Backward
@@ -818,6 +846,7 @@ void VulkanEngine::mainLoop() {
                 deltaTime,
                 config.cameraSpeed * speedMultiplier
             );
+            camera->setPosition(collision->movePlayer(previousPosition, camera->getPosition() - previousPosition));
 
             glm::vec2 mouseDelta = inputManager->getMouseDelta();
             // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
@@ -853,13 +882,15 @@ void VulkanEngine::mainLoop() {
 
         inputManager->endFrame();
 
-        // Send position updates to server (throttled to avoid spam)
+        // Send position updates to server at the rate the server asked for
         auto currentTime = std::chrono::steady_clock::now();
-        auto timeSinceLastUpdate = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - lastPositionUpdate).count();
-        float distanceMoved = glm::distance(camera->getPosition(), lastSentPosition);
+        float timeSinceLastUpdate = std::chrono::duration<float>(currentTime - lastPositionUpdate).count();
+        bool hasMoved = glm::distance(camera->getPosition(), lastSentPosition) > 0.01f ||
+                        camera->getYaw() != lastSentYaw || camera->getPitch() != lastSentPitch;
 
-        // Send update if moved more than 0.5 blocks OR 100ms has passed since last update
-        if (distanceMoved > 0.5f || timeSinceLastUpdate > 100) {
+        // Idle players still send a heartbeat so the server never goes long without a position
+        if (timeSinceLastUpdate >= networkClient->getMoveSendInterval() &&
+            (hasMoved || timeSinceLastUpdate >= MOVE_HEARTBEAT_INTERVAL)) {
             networkClient->sendPlayerMove(
                 camera->getPosition(),
                 glm::vec3(0.0f),  // velocity (not used yet)
@@ -868,6 +899,8 @@ void VulkanEngine::mainLoop() {
             );
             lastPositionUpdate = currentTime;
             lastSentPosition = camera->getPosition();
+            lastSentYaw = camera->getYaw();
+            lastSentPitch = camera->getPitch();
         }
 
         // Perform raycasting to find targeted block
@@ -875,7 +908,7 @@ void VulkanEngine::mainLoop() {
             camera->getPosition(),
             camera->getFront(),
             10.0f,  // 10 block reach distance
-            networkClient.get()
+            [this](const ChunkCoord& coord) { return std::as_const(*networkClient).getChunk(coord); }
         );
 
         // Handle block breaking (left click) - only when mouse is captured and console is closed
@@ -934,19 +967,10 @@ void VulkanEngine::mainLoop() {
                 if (shouldPlace) {
                     const glm::ivec3& placePos = targetedBlock->placePos;
 
-                    // Validate placement (don't place inside player)
-                    glm::vec3 playerPos = camera->getPosition();
-                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
-                    glm::ivec3 playerBlockPos(
-                        static_cast<int>(std::floor(playerPos.x)), // NOLINT(cppcoreguidelines-pro-type-union-access)
-                        static_cast<int>(std::floor(playerPos.y)), // NOLINT(cppcoreguidelines-pro-type-union-access)
-                        static_cast<int>(std::floor(playerPos.z))  // NOLINT(cppcoreguidelines-pro-type-union-access)
-                    );
-
-                    // Check if placement position conflicts with player's position
-                    // (Player occupies 2 blocks vertically: floor(y) and floor(y)+1)
-                    bool wouldBlockPlayer = (placePos == playerBlockPos) ||
-                                           (placePos == playerBlockPos + glm::ivec3(0, 1, 0));
+                    // Validate placement (don't place inside the player's collision box)
+                    glm::vec3 blockMin(placePos);
+                    bool wouldBlockPlayer = playerBoxAt(camera->getPosition()).intersects(
+                        AABB{blockMin, blockMin + glm::vec3(1.0f)});
 
                     if (!wouldBlockPlayer) {
                         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
@@ -1063,6 +1087,106 @@ void VulkanEngine::mainLoop() {
              performanceMetrics.getFrameCount(), performanceMetrics.getFPS());
 }
 
+bool VulkanEngine::makePendingChunk(const ChunkCoord& coord, PendingChunk& outPending) {
+    const Chunk* chk = networkClient->getChunk(coord);
+    if (!chk) {
+        return false;
+    }
+
+    // Empty sections never have geometry; drop any mesh and in-flight job instead
+    if (networkClient->isSectionEmpty(coord)) {
+        ++meshRevisions[coord];
+        chunkRenderer->removeChunk(coord);
+        return false;
+    }
+
+    outPending.coord = coord;
+    outPending.revision = ++meshRevisions[coord];
+    outPending.chunk = std::make_shared<Chunk>(*chk);
+
+    // Copy neighbor chunks if they exist
+    const Chunk* neighborNegX = networkClient->getChunk({coord.x - 1, coord.y, coord.z});
+    const Chunk* neighborPosX = networkClient->getChunk({coord.x + 1, coord.y, coord.z});
+    const Chunk* neighborNegY = networkClient->getChunk({coord.x, coord.y - 1, coord.z});
+    const Chunk* neighborPosY = networkClient->getChunk({coord.x, coord.y + 1, coord.z});
+    const Chunk* neighborNegZ = networkClient->getChunk({coord.x, coord.y, coord.z - 1});
+    const Chunk* neighborPosZ = networkClient->getChunk({coord.x, coord.y, coord.z + 1});
+
+    if (neighborNegX) {
+        outPending.neighborNegX = std::make_shared<Chunk>(*neighborNegX);
+    }
+    if (neighborPosX) {
+        outPending.neighborPosX = std::make_shared<Chunk>(*neighborPosX);
+    }
+    if (neighborNegY) {
+        outPending.neighborNegY = std::make_shared<Chunk>(*neighborNegY);
+    }
+    if (neighborPosY) {
+        outPending.neighborPosY = std::make_shared<Chunk>(*neighborPosY);
+    }
+    if (neighborNegZ) {
+        outPending.neighborNegZ = std::make_shared<Chunk>(*neighborNegZ);
+    }
+    if (neighborPosZ) {
+        outPending.neighborPosZ = std::make_shared<Chunk>(*neighborPosZ);
+    }
+    return true;
+}
+
+void VulkanEngine::queueChunkMesh(const ChunkCoord& coord) {
+    std::vector<PendingChunk> batch(1);
+    if (!makePendingChunk(coord, batch.front())) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(pendingChunksMutex);
+    pendingChunks.push(std::move(batch));
+}
+
+void VulkanEngine::queueColumnMesh(int32_t chunkX, int32_t chunkZ, const std::vector<int32_t>& levels) {
+    std::vector<PendingChunk> batch;
+    batch.reserve(levels.size());
+    for (int32_t chunkY : levels) {
+        PendingChunk pending;
+        if (makePendingChunk(ChunkCoord{chunkX, chunkY, chunkZ}, pending)) {
+            batch.push_back(std::move(pending));
+        }
+    }
+    if (batch.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(pendingChunksMutex);
+    pendingChunks.push(std::move(batch));
+}
+
+void VulkanEngine::remeshChunkNow(const ChunkCoord& coord) {
+    const Chunk* chunk = networkClient->getChunk(coord);
+    if (!chunk) {
+        return;
+    }
+
+    // Bump the revision so any in-flight async mesh of the old contents is discarded
+    ++meshRevisions[coord];
+
+    std::vector<Vertex> meshVertices;
+    std::vector<uint32_t> meshIndices;
+    ChunkMesh::generateMesh(
+        *chunk,
+        meshVertices,
+        meshIndices,
+        textureAtlas.get(),
+        networkClient->getChunk({coord.x - 1, coord.y, coord.z}),
+        networkClient->getChunk({coord.x + 1, coord.y, coord.z}),
+        networkClient->getChunk({coord.x, coord.y - 1, coord.z}),
+        networkClient->getChunk({coord.x, coord.y + 1, coord.z}),
+        networkClient->getChunk({coord.x, coord.y, coord.z - 1}),
+        networkClient->getChunk({coord.x, coord.y, coord.z + 1})
+    );
+
+    chunkRenderer->uploadChunkMesh(coord, meshVertices, meshIndices);
+}
+
 void VulkanEngine::processPendingChunks() {
     // Clean up completed tasks
     meshGenerationTasks.erase(
@@ -1073,45 +1197,52 @@ void VulkanEngine::processPendingChunks() {
         meshGenerationTasks.end()
     );
 
-    // Process up to MAX_CHUNKS_PER_FRAME chunks per frame
+    // Launch up to MAX_MESH_JOBS_PER_FRAME jobs per frame (a job is one chunk or one column)
     size_t processed = 0;
-    while (processed < MAX_CHUNKS_PER_FRAME) {
-        PendingChunk pending;
+    while (processed < MAX_MESH_JOBS_PER_FRAME) {
+        std::vector<PendingChunk> batch;
 
-        // Get next pending chunk
+        // Get next pending job
         {
             std::lock_guard<std::mutex> lock(pendingChunksMutex);
             if (pendingChunks.empty()) {
                 break;
             }
 
-            pending = std::move(pendingChunks.front());
+            batch = std::move(pendingChunks.front());
             pendingChunks.pop();
         }
 
         // Launch async mesh generation
-        auto task = std::async(std::launch::async, [this, pend = pending]() {
-            CompletedMesh completed;
-            completed.coord = pend.coord;
-
-            // Generate mesh on background thread
-            ChunkMesh::generateMesh(
-                *pend.chunk,
-                completed.vertices,
-                completed.indices,
-                textureAtlas.get(),
-                pend.neighborNegX ? pend.neighborNegX.get() : nullptr,
-                pend.neighborPosX ? pend.neighborPosX.get() : nullptr,
-                pend.neighborNegY ? pend.neighborNegY.get() : nullptr,
-                pend.neighborPosY ? pend.neighborPosY.get() : nullptr,
-                pend.neighborNegZ ? pend.neighborNegZ.get() : nullptr,
-                pend.neighborPosZ ? pend.neighborPosZ.get() : nullptr
-            );
+        auto task = std::async(std::launch::async, [this, jobs = std::move(batch)]() {
+            std::vector<CompletedMesh> meshes(jobs.size());
+            for (size_t i = 0; i < jobs.size(); i++) {
+                const PendingChunk& pend = jobs[i];
+                CompletedMesh& completed = meshes[i];
+                completed.coord = pend.coord;
+                completed.revision = pend.revision;
+
+                // Generate mesh on background thread
+                ChunkMesh::generateMesh(
+                    *pend.chunk,
+                    completed.vertices,
+                    completed.indices,
+                    textureAtlas.get(),
+                    pend.neighborNegX ? pend.neighborNegX.get() : nullptr,
+                    pend.neighborPosX ? pend.neighborPosX.get() : nullptr,
+                    pend.neighborNegY ? pend.neighborNegY.get() : nullptr,
+                    pend.neighborPosY ? pend.neighborPosY.get() : nullptr,
+                    pend.neighborNegZ ? pend.neighborNegZ.get() : nullptr,
+                    pend.neighborPosZ ? pend.neighborPosZ.get() : nullptr
+                );
+            }
 
-            // Queue completed mesh for upload
+            // Queue completed meshes for upload together so a column appears at once
             {
                 std::lock_guard<std::mutex> lock(completedMeshesMutex);
-                completedMeshes.push(std::move(completed));
+                for (CompletedMesh& completed : meshes) {
+                    completedMeshes.push(std::move(completed));
+                }
             }
         });
 
@@ -1126,8 +1257,13 @@ void VulkanEngine::uploadCompletedMeshes() {
     while (!completedMeshes.empty()) {
         CompletedMesh& completed = completedMeshes.front();
 
-        // Upload mesh to GPU (this is fast, just creating buffers)
-        if (!completed.vertices.empty() && !completed.indices.empty()) {
+        // Skip meshes of chunks that were edited or unloaded since they were queued
+        auto revision = meshRevisions.find(completed.coord);
+        bool stale = revision == meshRevisions.end() || revision->second != completed.revision;
+
+        // Upload mesh to GPU (this is fast, just creating buffers).
+        // Empty meshes are uploaded too so breaking the last block clears the chunk.
+        if (!stale) {
             chunkRenderer->uploadChunkMesh(completed.coord, completed.vertices, completed.indices);
             LOG_DEBUG("Uploaded mesh for chunk ({}, {}, {}) | {} vertices, {} indices",
                      completed.coord.x, completed.coord.y, completed.coord.z,
@@ -0,0 +1,295 @@
+#include "server/BlockTickScheduler.hpp"
+#include "shared/BlockRegistry.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace engine {
+
+namespace {
+
+constexpr auto CHUNK_EXTENT = static_cast<int32_t>(CHUNK_SIZE);
+
+/// Marks the end of chunk data that has block ticks appended ("TICK")
+constexpr uint32_t SAVED_TICKS_MAGIC = 0x4B434954;
+
+/// Bytes per saved tick: local index, block type, delay
+constexpr size_t SAVED_TICK_BYTES = sizeof(uint16_t) + sizeof(uint16_t) + sizeof(uint32_t);
+
+/// Trailer after the saved ticks: count, magic
+constexpr size_t SAVED_TRAILER_BYTES = sizeof(uint32_t) + sizeof(uint32_t);
+
+int32_t floorDiv(int32_t value, int32_t divisor) {
+    return (value >= 0) ? (value / divisor) : ((value - divisor + 1) / divisor);
+}
+
+template<typename T>
+void appendValue(std::vector<uint8_t>& data, const T& value) {
+    size_t offset = data.size();
+    data.resize(offset + sizeof(T));
+    std::memcpy(data.data() + offset, &value, sizeof(T));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+template<typename T>
+T readValue(const std::vector<uint8_t>& data, size_t& offset) {
+    T value;
+    std::memcpy(&value, data.data() + offset, sizeof(T));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    offset += sizeof(T);
+    return value;
+}
+
+} // namespace
+
+BlockTickScheduler::BlockTickScheduler() {
+    slotHeads.fill(NONE);
+}
+
+BlockTickHandle BlockTickScheduler::schedule(const glm::ivec3& worldPos, BlockType type, uint32_t delay) {
+    uint32_t index = 0;
+    if (!freeTimers.empty()) {
+        index = freeTimers.back();
+        freeTimers.pop_back();
+    } else {
+        index = static_cast<uint32_t>(timers.size());
+        timers.emplace_back();
+    }
+
+    Timer& timer = timers[index];
+    timer.position = worldPos;
+    timer.type = type;
+    timer.due = currentTick + std::clamp(delay, 1u, MAX_DELAY);
+    insertIntoWheel(index);
+    linkIntoChunk(index);
+
+    pendingCount++;
+    stats.scheduled++;
+    return BlockTickHandle{index, timer.generation};
+}
+
+bool BlockTickScheduler::cancel(BlockTickHandle handle) {
+    if (handle.index >= timers.size()) {
+        return false;
+    }
+    const Timer& timer = timers[handle.index];
+    if (timer.slot == NONE || timer.generation != handle.generation) {
+        return false;
+    }
+
+    unlinkFromSlot(handle.index);
+    unlinkFromChunk(handle.index);
+    release(handle.index);
+    stats.cancelled++;
+    return true;
+}
+
+void BlockTickScheduler::advance(std::vector<BlockTick>& outDue) {
+    currentTick++;
+    if (pendingCount == 0) {
+        return;
+    }
+
+    // Higher levels first: a timer cascaded from level 2 may land in the
+    // level 1 slot that is cascaded next, or in this tick's level 0 slot
+    for (uint32_t level = LEVEL_COUNT - 1; level > 0; level--) {
+        uint32_t shift = SLOT_BITS * level;
+        if ((currentTick & ((uint64_t{1} << shift) - 1)) == 0) {
+            cascade((level * SLOT_COUNT) + static_cast<uint32_t>((currentTick >> shift) & SLOT_MASK));
+        }
+    }
+
+    auto slot = static_cast<uint32_t>(currentTick & SLOT_MASK);
+    uint32_t index = slotHeads[slot];
+    slotHeads[slot] = NONE;
+    while (index != NONE) {
+        uint32_t next = timers[index].slotNext;
+        outDue.push_back(BlockTick{timers[index].position, timers[index].type});
+        unlinkFromChunk(index);
+        release(index);
+        stats.fired++;
+        index = next;
+    }
+}
+
+void BlockTickScheduler::saveChunk(const ChunkCoord& coord, std::vector<SavedBlockTick>& outSaved) const {
+    auto headIt = chunkHeads.find(coord);
+    if (headIt == chunkHeads.end()) {
+        return;
+    }
+
+    const glm::ivec3 origin = glm::ivec3(coord.x, coord.y, coord.z) * CHUNK_EXTENT;
+    for (uint32_t index = headIt->second; index != NONE; index = timers[index].chunkNext) {
+        const Timer& timer = timers[index];
+        glm::ivec3 local = timer.position - origin;
+        SavedBlockTick saved;
+        saved.localIndex = static_cast<uint16_t>(Chunk::getIndex(static_cast<uint32_t>(local.x),
+                                                                 static_cast<uint32_t>(local.y),
+                                                                 static_cast<uint32_t>(local.z)));
+        saved.type = timer.type;
+        saved.delay = static_cast<uint32_t>(timer.due - currentTick);
+        outSaved.push_back(saved);
+    }
+}
+
+size_t BlockTickScheduler::dropChunk(const ChunkCoord& coord) {
+    auto headIt = chunkHeads.find(coord);
+    if (headIt == chunkHeads.end()) {
+        return 0;
+    }
+
+    size_t dropped = 0;
+    uint32_t index = headIt->second;
+    chunkHeads.erase(headIt);
+    while (index != NONE) {
+        uint32_t next = timers[index].chunkNext;
+        unlinkFromSlot(index);
+        release(index);
+        dropped++;
+        index = next;
+    }
+    stats.dropped += dropped;
+    return dropped;
+}
+
+void BlockTickScheduler::restoreChunk(const ChunkCoord& coord, const std::vector<SavedBlockTick>& saved) {
+    const glm::ivec3 origin = glm::ivec3(coord.x, coord.y, coord.z) * CHUNK_EXTENT;
+    for (const SavedBlockTick& tick : saved) {
+        if (tick.localIndex >= CHUNK_VOLUME ||
+            static_cast<uint16_t>(tick.type) >= static_cast<uint16_t>(BlockType::Count)) {
+            continue;  // Corrupted entry
+        }
+        glm::ivec3 local(tick.localIndex % CHUNK_SIZE,
+                         tick.localIndex / (CHUNK_SIZE * CHUNK_SIZE),
+                         (tick.localIndex / CHUNK_SIZE) % CHUNK_SIZE);
+        schedule(origin + local, tick.type, tick.delay);
+    }
+}
+
+void BlockTickScheduler::appendSaved(const std::vector<SavedBlockTick>& saved, std::vector<uint8_t>& data) {
+    if (saved.empty()) {
+        return;
+    }
+
+    // Format: [ticks: local index u16, type u16, delay u32]...[count u32][magic u32]
+    data.reserve(data.size() + (saved.size() * SAVED_TICK_BYTES) + SAVED_TRAILER_BYTES);
+    for (const SavedBlockTick& tick : saved) {
+        appendValue(data, tick.localIndex);
+        appendValue(data, static_cast<uint16_t>(tick.type));
+        appendValue(data, tick.delay);
+    }
+    appendValue(data, static_cast<uint32_t>(saved.size()));
+    appendValue(data, SAVED_TICKS_MAGIC);
+}
+
+bool BlockTickScheduler::extractSaved(std::vector<uint8_t>& data, std::vector<SavedBlockTick>& outSaved) {
+    outSaved.clear();
+    if (data.size() < SAVED_TRAILER_BYTES) {
+        return false;
+    }
+
+    size_t offset = data.size() - SAVED_TRAILER_BYTES;
+    auto count = readValue<uint32_t>(data, offset);
+    auto magic = readValue<uint32_t>(data, offset);
+    if (magic != SAVED_TICKS_MAGIC || count > (data.size() - SAVED_TRAILER_BYTES) / SAVED_TICK_BYTES) {
+        return false;
+    }
+
+    size_t start = data.size() - SAVED_TRAILER_BYTES - (count * SAVED_TICK_BYTES);
+    offset = start;
+    outSaved.reserve(count);
+    for (uint32_t tick = 0; tick < count; tick++) {
+        SavedBlockTick saved;
+        saved.localIndex = readValue<uint16_t>(data, offset);
+        auto type = readValue<uint16_t>(data, offset);
+        saved.type = static_cast<BlockType>(type);
+        saved.delay = readValue<uint32_t>(data, offset);
+        if (BlockRegistry::isValid(type)) {
+            outSaved.push_back(saved);  // Ticks of unknown types would index past the handler table
+        }
+    }
+    data.resize(start);
+    return true;
+}
+
+ChunkCoord BlockTickScheduler::chunkOf(const glm::ivec3& worldPos) {
+    return ChunkCoord{floorDiv(worldPos.x, CHUNK_EXTENT), floorDiv(worldPos.y, CHUNK_EXTENT), floorDiv(worldPos.z, CHUNK_EXTENT)};
+}
+
+void BlockTickScheduler::insertIntoWheel(uint32_t index) {
+    Timer& timer = timers[index];
+
+    // Lowest level whose span still reaches the due tick; the slot is taken
+    // from the due tick itself, so it comes round exactly when the level
+    // below needs the timer
+    uint64_t remaining = timer.due - currentTick;
+    uint32_t level = 0;
+    while (level + 1 < LEVEL_COUNT && remaining >= (uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    uint32_t slot = (level * SLOT_COUNT) + static_cast<uint32_t>((timer.due >> (SLOT_BITS * level)) & SLOT_MASK);
+
+    timer.slot = slot;
+    timer.slotPrev = NONE;
+    timer.slotNext = slotHeads[slot];
+    if (timer.slotNext != NONE) {
+        timers[timer.slotNext].slotPrev = index;
+    }
+    slotHeads[slot] = index;
+}
+
+void BlockTickScheduler::unlinkFromSlot(uint32_t index) {
+    Timer& timer = timers[index];
+    if (timer.slotPrev != NONE) {
+        timers[timer.slotPrev].slotNext = timer.slotNext;
+    } else {
+        slotHeads[timer.slot] = timer.slotNext;
+    }
+    if (timer.slotNext != NONE) {
+        timers[timer.slotNext].slotPrev = timer.slotPrev;
+    }
+}
+
+void BlockTickScheduler::linkIntoChunk(uint32_t index) {
+    Timer& timer = timers[index];
+    auto [headIt, inserted] = chunkHeads.try_emplace(chunkOf(timer.position), NONE);
+    timer.chunkPrev = NONE;
+    timer.chunkNext = headIt->second;
+    if (timer.chunkNext != NONE) {
+        timers[timer.chunkNext].chunkPrev = index;
+    }
+    headIt->second = index;
+}
+
+void BlockTickScheduler::unlinkFromChunk(uint32_t index) {
+    Timer& timer = timers[index];
+    if (timer.chunkPrev != NONE) {
+        timers[timer.chunkPrev].chunkNext = timer.chunkNext;
+    } else if (timer.chunkNext != NONE) {
+        chunkHeads[chunkOf(timer.position)] = timer.chunkNext;
+    } else {
+        chunkHeads.erase(chunkOf(timer.position));
+    }
+    if (timer.chunkNext != NONE) {
+        timers[timer.chunkNext].chunkPrev = timer.chunkPrev;
+    }
+}
+
+void BlockTickScheduler::release(uint32_t index) {
+    Timer& timer = timers[index];
+    timer.slot = NONE;
+    timer.generation++;
+    freeTimers.push_back(index);
+    pendingCount--;
+}
+
+void BlockTickScheduler::cascade(uint32_t slot) {
+    uint32_t index = slotHeads[slot];
+    slotHeads[slot] = NONE;
+    while (index != NONE) {
+        uint32_t next = timers[index].slotNext;
+        insertIntoWheel(index);
+        stats.cascaded++;
+        index = next;
+    }
+}
+
+} // namespace engine
@@ -0,0 +1,56 @@
+#include "server/ChunkBlockPool.hpp"
+
+#include <cstring>
+
+namespace engine {
+
+bool ChunkBlockPool::intern(Chunk& chunk) {
+    const std::shared_ptr<ChunkBlocks>& own = chunk.getSharedBlockData();
+    uint64_t hash = hashBlocks(*own);
+
+    auto [first, last] = entries.equal_range(hash);
+    for (auto entryIt = first; entryIt != last;) {
+        std::shared_ptr<ChunkBlocks> pooled = entryIt->second.lock();
+        if (!pooled) {
+            entryIt = entries.erase(entryIt);
+            continue;
+        }
+        if (pooled == own) {
+            return false;
+        }
+        // Unshared pooled buffers may have been edited in place since they were pooled
+        if (std::memcmp(pooled->data(), own->data(), sizeof(ChunkBlocks)) == 0) {
+            chunk.shareBlockData(std::move(pooled));
+            return true;
+        }
+        ++entryIt;
+    }
+
+    entries.emplace(hash, own);
+    return false;
+}
+
+void ChunkBlockPool::prune() {
+    for (auto entryIt = entries.begin(); entryIt != entries.end();) {
+        if (entryIt->second.expired()) {
+            entryIt = entries.erase(entryIt);
+        } else {
+            ++entryIt;
+        }
+    }
+}
+
+uint64_t ChunkBlockPool::hashBlocks(const ChunkBlocks& blocks) {
+    static_assert(sizeof(ChunkBlocks) % sizeof(uint64_t) == 0, "Block buffer must be a whole number of words");
+
+    uint64_t hash = 14695981039346656037ull;
+    const auto* bytes = reinterpret_cast<const uint8_t*>(blocks.data());  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    for (size_t offset = 0; offset < sizeof(ChunkBlocks); offset += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + offset, sizeof(word));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace engine
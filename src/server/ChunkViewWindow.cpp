@@ -0,0 +1,288 @@
+#include "server/ChunkViewWindow.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine {
+
+namespace {
+
+/**
+ * @brief Call fn(x) for every x in [low, high] that is not in [excludeLow, excludeHigh]
+ *
+ * An empty exclusion range (excludeLow > excludeHigh) visits the whole range.
+ */
+template <typename Fn>
+void forEachOutside(int32_t low, int32_t high, int32_t excludeLow, int32_t excludeHigh, Fn&& visit) {
+    if (excludeLow > excludeHigh) {
+        for (int32_t x = low; x <= high; x++) {  // NOLINT(readability-identifier-length)
+            visit(x);
+        }
+        return;
+    }
+
+    for (int32_t x = low; x <= std::min(high, excludeLow - 1); x++) {  // NOLINT(readability-identifier-length)
+        visit(x);
+    }
+    for (int32_t x = std::max(low, excludeHigh + 1); x <= high; x++) {  // NOLINT(readability-identifier-length)
+        visit(x);
+    }
+}
+
+} // namespace
+
+ChunkViewWindow::ChunkViewWindow(int32_t radius, int32_t minChunkY, int32_t maxChunkY)
+    : radius(radius), size((2 * radius) + 1), minChunkY(minChunkY), maxChunkY(maxChunkY),
+      offsetTable(&ChunkOffsetTable::get(radius, 0)) {
+
+    size_t bitCount = static_cast<size_t>(size) * static_cast<size_t>(size) *
+                      static_cast<size_t>(maxChunkY - minChunkY + 1);
+    sentBits.assign((bitCount + 63) / 64, 0);
+    ChunkOffsetTable::levelsNearestFirst(0, minChunkY, maxChunkY, levelOrder);
+}
+
+void ChunkViewWindow::recenter(const ChunkCoord& newCenter, std::vector<ChunkCoord>& outLeaving) {
+    outLeaving.clear();
+
+    ChunkCoord target{newCenter.x, clampLevel(newCenter.y), newCenter.z};
+    if (centered && target.x == center.x && target.z == center.z) {
+        // Same columns, new level: only the send order changes
+        if (target.y != center.y) {
+            center.y = target.y;
+            ChunkOffsetTable::levelsNearestFirst(center.y, minChunkY, maxChunkY, levelOrder);
+            // Columns already walked are fully sent in any level order, so only the current one restarts
+            levelCursor = 0;
+        }
+        return;
+    }
+
+    // Leaving pass first: it frees the toroidal cells that entering chunks reuse
+    if (centered) {
+        for (int32_t chunkZ = center.z - radius; chunkZ <= center.z + radius; chunkZ++) {
+            int32_t oldMinX = 0;
+            int32_t oldMaxX = 0;
+            rowExtent(center, chunkZ, oldMinX, oldMaxX);
+
+            int32_t keepMinX = 1;
+            int32_t keepMaxX = 0;
+            rowExtent(target, chunkZ, keepMinX, keepMaxX);
+
+            forEachOutside(oldMinX, oldMaxX, keepMinX, keepMaxX, [&](int32_t chunkX) {
+                for (int32_t chunkY = minChunkY; chunkY <= maxChunkY; chunkY++) {
+                    size_t index = bitIndex(chunkX, chunkY, chunkZ);
+                    if (testBit(index)) {
+                        clearBit(index);
+                        sentCount--;
+                        outLeaving.push_back(ChunkCoord{chunkX, chunkY, chunkZ});
+                    }
+                }
+            });
+        }
+    }
+
+    if (centered) {
+        carrySendWalk(target);
+    } else {
+        queuedColumns.clear();
+        queueHead = 0;
+        sendCursor = 0;
+    }
+
+    if (!centered || target.y != center.y) {
+        ChunkOffsetTable::levelsNearestFirst(target.y, minChunkY, maxChunkY, levelOrder);
+    }
+    center = target;
+    centered = true;
+    levelCursor = 0;
+}
+
+void ChunkViewWindow::carrySendWalk(const ChunkCoord& target) {
+    const std::vector<ChunkCoord>& columns = offsetTable->getColumns();
+    int32_t stepX = target.x - center.x;
+    int32_t stepZ = target.z - center.z;
+    float step = std::sqrt(static_cast<float>((stepX * stepX) + (stepZ * stepZ)));
+
+    // Most of the view is new, so walking it again from the start costs about the same
+    if (step * 2.0f > static_cast<float>(radius)) {
+        queuedColumns.clear();
+        queueHead = 0;
+        sendCursor = 0;
+        return;
+    }
+
+    if (sendCursor < columns.size()) {
+        // Unsent columns were no nearer than the cursor's and are now at most `step` nearer.
+        // Entering columns are further out than that, so the cursor still reaches them.
+        const ChunkCoord& cursorColumn = columns[sendCursor];
+        float cursorDistance = std::sqrt(static_cast<float>((cursorColumn.x * cursorColumn.x) +
+                                                            (cursorColumn.z * cursorColumn.z)));
+        auto first = std::partition_point(columns.begin(), columns.begin() + static_cast<std::ptrdiff_t>(sendCursor),
+                                          [&](const ChunkCoord& column) {
+            float distance = std::sqrt(static_cast<float>((column.x * column.x) + (column.z * column.z)));
+            return distance + step < cursorDistance - 0.001f;
+        });
+        sendCursor = static_cast<size_t>(first - columns.begin());
+        return;
+    }
+
+    // The walk had finished, so only queued columns still in view and entering ones are unsent
+    size_t kept = 0;
+    for (size_t i = queueHead; i < queuedColumns.size(); i++) {
+        QueuedColumn column = queuedColumns[i];
+        int32_t offsetX = column.chunkX - target.x;
+        int32_t offsetZ = column.chunkZ - target.z;
+        if (offsetTable->containsColumn(offsetX, offsetZ)) {
+            column.rank = offsetTable->getColumnRank(offsetX, offsetZ);
+            queuedColumns[kept++] = column;
+        }
+    }
+    queuedColumns.resize(kept);
+    queueHead = 0;
+
+    for (int32_t chunkZ = target.z - radius; chunkZ <= target.z + radius; chunkZ++) {
+        int32_t newMinX = 0;
+        int32_t newMaxX = 0;
+        rowExtent(target, chunkZ, newMinX, newMaxX);
+
+        int32_t oldMinX = 1;
+        int32_t oldMaxX = 0;
+        rowExtent(center, chunkZ, oldMinX, oldMaxX);
+
+        forEachOutside(newMinX, newMaxX, oldMinX, oldMaxX, [&](int32_t chunkX) {
+            uint32_t rank = offsetTable->getColumnRank(chunkX - target.x, chunkZ - target.z);
+            queuedColumns.push_back(QueuedColumn{rank, chunkX, chunkZ});
+        });
+    }
+
+    std::sort(queuedColumns.begin(), queuedColumns.end(),
+              [](const QueuedColumn& lhs, const QueuedColumn& rhs) { return lhs.rank < rhs.rank; });
+}
+
+bool ChunkViewWindow::currentColumn(int32_t& outX, int32_t& outZ) const {
+    if (queueHead < queuedColumns.size()) {
+        outX = queuedColumns[queueHead].chunkX;
+        outZ = queuedColumns[queueHead].chunkZ;
+        return true;
+    }
+
+    const std::vector<ChunkCoord>& columns = offsetTable->getColumns();
+    if (sendCursor < columns.size()) {
+        outX = center.x + columns[sendCursor].x;
+        outZ = center.z + columns[sendCursor].z;
+        return true;
+    }
+    return false;
+}
+
+void ChunkViewWindow::advanceColumn() {
+    if (queueHead < queuedColumns.size()) {
+        queueHead++;
+        if (queueHead == queuedColumns.size()) {
+            queuedColumns.clear();
+            queueHead = 0;
+        }
+    } else {
+        sendCursor++;
+    }
+    levelCursor = 0;
+}
+
+bool ChunkViewWindow::nextUnsent(ChunkCoord& outCoord) {
+    if (!centered) {
+        return false;
+    }
+
+    int32_t chunkX = 0;
+    int32_t chunkZ = 0;
+    while (currentColumn(chunkX, chunkZ)) {
+        while (levelCursor < levelOrder.size()) {
+            int32_t chunkY = levelOrder[levelCursor++];
+            if (!testBit(bitIndex(chunkX, chunkY, chunkZ))) {
+                outCoord = ChunkCoord{chunkX, chunkY, chunkZ};
+                return true;
+            }
+        }
+        advanceColumn();
+    }
+    return false;
+}
+
+bool ChunkViewWindow::nextUnsentColumn(int32_t& outX, int32_t& outZ, std::vector<int32_t>& outLevels) {
+    outLevels.clear();
+    if (!centered) {
+        return false;
+    }
+
+    int32_t chunkX = 0;
+    int32_t chunkZ = 0;
+    while (currentColumn(chunkX, chunkZ)) {
+        while (levelCursor < levelOrder.size()) {
+            int32_t chunkY = levelOrder[levelCursor++];
+            if (!testBit(bitIndex(chunkX, chunkY, chunkZ))) {
+                outLevels.push_back(chunkY);
+            }
+        }
+        advanceColumn();
+
+        if (!outLevels.empty()) {
+            outX = chunkX;
+            outZ = chunkZ;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ChunkViewWindow::reset() {
+    std::fill(sentBits.begin(), sentBits.end(), 0);
+    sentCount = 0;
+    centered = false;
+    sendCursor = 0;
+    levelCursor = 0;
+    queuedColumns.clear();
+    queueHead = 0;
+}
+
+bool ChunkViewWindow::contains(const ChunkCoord& coord) const {
+    if (!centered || coord.y < minChunkY || coord.y > maxChunkY) {
+        return false;
+    }
+
+    return offsetTable->containsColumn(coord.x - center.x, coord.z - center.z);
+}
+
+bool ChunkViewWindow::isSent(const ChunkCoord& coord) const {
+    return contains(coord) && testBit(bitIndex(coord.x, coord.y, coord.z));
+}
+
+void ChunkViewWindow::markSent(const ChunkCoord& coord) {
+    if (!contains(coord)) {
+        return;
+    }
+
+    size_t index = bitIndex(coord.x, coord.y, coord.z);
+    if (!testBit(index)) {
+        setBit(index);
+        sentCount++;
+    }
+}
+
+bool ChunkViewWindow::rowExtent(const ChunkCoord& rowCenter, int32_t chunkZ, int32_t& outMinX, int32_t& outMaxX) const {
+    int32_t halfWidth = offsetTable->getRowHalfWidth(chunkZ - rowCenter.z);
+    if (halfWidth < 0) {
+        return false;
+    }
+
+    outMinX = rowCenter.x - halfWidth;
+    outMaxX = rowCenter.x + halfWidth;
+    return true;
+}
+
+size_t ChunkViewWindow::bitIndex(int32_t chunkX, int32_t chunkY, int32_t chunkZ) const {
+    int32_t wrappedX = ((chunkX % size) + size) % size;
+    int32_t wrappedZ = ((chunkZ % size) + size) % size;
+    int32_t level = chunkY - minChunkY;
+    return (static_cast<size_t>((level * size) + wrappedZ) * static_cast<size_t>(size)) + static_cast<size_t>(wrappedX);
+}
+
+} // namespace engine
@@ -0,0 +1,204 @@
+#include "server/FallingBlockSimulator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace engine {
+
+namespace {
+
+constexpr auto CHUNK_EXTENT = static_cast<int32_t>(CHUNK_SIZE);
+
+int32_t floorDiv(int32_t value, int32_t divisor) {
+    return (value >= 0) ? (value / divisor) : ((value - divisor + 1) / divisor);
+}
+
+uint64_t microsSince(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace
+
+FallingBlockSimulator::FallingBlockSimulator(ChunkLookup lookup) : lookup(std::move(lookup)) {}
+
+void FallingBlockSimulator::enqueueEdit(const glm::ivec3& worldPos) {
+    enqueue(worldPos);
+    enqueue(worldPos + glm::ivec3(0, 1, 0));
+}
+
+void FallingBlockSimulator::enqueueChunk(const ChunkCoord& coord) {
+    loadedChunks.push_back(coord);
+}
+
+void FallingBlockSimulator::step(std::vector<BlockChange>& outChanges) {
+    if (!hasPending()) {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    hasLast = false;
+
+    for (const ChunkCoord& coord : loadedChunks) {
+        scanChunk(coord);
+    }
+    stats.chunkScans += loadedChunks.size();
+    loadedChunks.clear();
+
+    // Bottom-up, so a column dropped this step is seen as support by the
+    // queued blocks above it; then x, z for chunk locality
+    checking.clear();
+    std::swap(checking, active);
+    activeKeys.clear();
+    std::sort(checking.begin(), checking.end(), [](const glm::ivec3& lhs, const glm::ivec3& rhs) {
+        if (lhs.y != rhs.y) {
+            return lhs.y < rhs.y;
+        }
+        return lhs.x != rhs.x ? lhs.x < rhs.x : lhs.z < rhs.z;
+    });
+
+    for (const glm::ivec3& pos : checking) {
+        bool loaded = false;
+        if (!BlockRegistry::hasGravity(getBlockType(pos, loaded))) {
+            continue;
+        }
+        bool belowLoaded = false;
+        if (getBlockType(pos - glm::ivec3(0, 1, 0), belowLoaded) != BlockType::Air || !belowLoaded) {
+            continue;
+        }
+        dropColumn(pos, outChanges);
+    }
+    stats.checked += checking.size();
+
+    uint64_t elapsedUs = microsSince(start);
+    stats.steps++;
+    stats.stepMicrosTotal += elapsedUs;
+    stats.stepMicrosMax = std::max(stats.stepMicrosMax, elapsedUs);
+}
+
+uint64_t FallingBlockSimulator::packPosition(const glm::ivec3& worldPos) {
+    constexpr uint64_t HORIZONTAL_MASK = (uint64_t{1} << 24) - 1;
+    constexpr uint64_t VERTICAL_MASK = (uint64_t{1} << 16) - 1;
+    return ((static_cast<uint64_t>(static_cast<uint32_t>(worldPos.x)) & HORIZONTAL_MASK) << 40) |
+           ((static_cast<uint64_t>(static_cast<uint32_t>(worldPos.y)) & VERTICAL_MASK) << 24) |
+           (static_cast<uint64_t>(static_cast<uint32_t>(worldPos.z)) & HORIZONTAL_MASK);
+}
+
+void FallingBlockSimulator::enqueue(const glm::ivec3& worldPos) {
+    if (activeKeys.insert(packPosition(worldPos)).second) {
+        active.push_back(worldPos);
+    }
+}
+
+Chunk* FallingBlockSimulator::findChunk(const glm::ivec3& worldPos, glm::ivec3& outLocal) {
+    ChunkCoord coord{floorDiv(worldPos.x, CHUNK_EXTENT), floorDiv(worldPos.y, CHUNK_EXTENT), floorDiv(worldPos.z, CHUNK_EXTENT)};
+    outLocal = worldPos - (glm::ivec3(coord.x, coord.y, coord.z) * CHUNK_EXTENT);
+    if (!hasLast || coord != lastCoord) {
+        lastCoord = coord;
+        lastChunk = lookup(coord);
+        hasLast = true;
+    }
+    return lastChunk;
+}
+
+BlockType FallingBlockSimulator::getBlockType(const glm::ivec3& worldPos, bool& outLoaded) {
+    glm::ivec3 local;
+    const Chunk* chunk = findChunk(worldPos, local);
+    outLoaded = chunk != nullptr;
+    if (chunk == nullptr) {
+        return BlockType::Air;
+    }
+    return chunk->getBlockData()[Chunk::getIndex(local.x, local.y, local.z)].type;
+}
+
+void FallingBlockSimulator::setBlockType(const glm::ivec3& worldPos, BlockType type, BlockType previous,
+                                         std::vector<BlockChange>& outChanges) {
+    if (type == previous) {
+        return;
+    }
+    glm::ivec3 local;
+    if (Chunk* chunk = findChunk(worldPos, local)) {
+        chunk->setBlock(local.x, local.y, local.z, Block{type});
+        outChanges.push_back(BlockChange{worldPos, type, previous});
+    }
+}
+
+void FallingBlockSimulator::scanChunk(const ChunkCoord& coord) {
+    hasLast = false;
+    const Chunk* chunk = lookup(coord);
+    if (chunk == nullptr) {
+        return;
+    }
+    const glm::ivec3 origin = glm::ivec3(coord.x, coord.y, coord.z) * CHUNK_EXTENT;
+    const ChunkBlocks& blocks = chunk->getBlockData();
+
+    // Gravity blocks in this chunk resting on air (skipping bricks that can't hold one)
+    const Chunk* below = lookup(ChunkCoord{coord.x, coord.y - 1, coord.z});
+    for (uint32_t brickIndex = 0; brickIndex < BRICK_COUNT; brickIndex++) {
+        BrickState state = chunk->getBrickState(brickIndex);
+        uint32_t originIndex = Chunk::getBrickBlockIndex(brickIndex, 0);
+        if (state == BrickState::Empty ||
+            (state == BrickState::Uniform && !BlockRegistry::hasGravity(blocks[originIndex].type))) {
+            continue;
+        }
+
+        for (uint32_t localIndex = 0; localIndex < BRICK_SIZE * BRICK_SIZE * BRICK_SIZE; localIndex++) {
+            uint32_t index = Chunk::getBrickBlockIndex(brickIndex, localIndex);
+            if (!BlockRegistry::hasGravity(blocks[index].type)) {
+                continue;
+            }
+            uint32_t localX = index % CHUNK_SIZE;
+            uint32_t localZ = (index / CHUNK_SIZE) % CHUNK_SIZE;
+            uint32_t localY = index / (CHUNK_SIZE * CHUNK_SIZE);
+            BlockType support = BlockType::Stone;
+            if (localY > 0) {
+                support = blocks[index - (CHUNK_SIZE * CHUNK_SIZE)].type;
+            } else if (below != nullptr) {
+                support = below->getBlockData()[Chunk::getIndex(localX, CHUNK_SIZE - 1, localZ)].type;
+            }
+            if (support == BlockType::Air) {
+                enqueue(origin + glm::ivec3(localX, localY, localZ));
+            }
+        }
+    }
+
+    // Gravity blocks on the bottom layer of the chunk above, which rested on this unloaded chunk
+    const Chunk* above = lookup(ChunkCoord{coord.x, coord.y + 1, coord.z});
+    if (above == nullptr || above->isEmpty()) {
+        return;
+    }
+    for (uint32_t localZ = 0; localZ < CHUNK_SIZE; localZ++) {
+        for (uint32_t localX = 0; localX < CHUNK_SIZE; localX++) {
+            if (BlockRegistry::hasGravity(above->getBlockData()[Chunk::getIndex(localX, 0, localZ)].type) &&
+                blocks[Chunk::getIndex(localX, CHUNK_SIZE - 1, localZ)].type == BlockType::Air) {
+                enqueue(origin + glm::ivec3(localX, CHUNK_EXTENT, localZ));
+            }
+        }
+    }
+}
+
+void FallingBlockSimulator::dropColumn(const glm::ivec3& bottom, std::vector<BlockChange>& outChanges) {
+    // Gravity blocks stacked on the bottom one (a column ends at an unloaded chunk)
+    column.clear();
+    glm::ivec3 pos = bottom;
+    bool loaded = true;
+    for (BlockType type = getBlockType(pos, loaded); loaded && BlockRegistry::hasGravity(type);
+         type = getBlockType(pos, loaded)) {
+        column.push_back(type);
+        pos.y++;
+    }
+
+    // Every cell from the one below the column takes the block above it; the top cell empties
+    BlockType previous = BlockType::Air;
+    for (size_t offset = 0; offset < column.size(); offset++) {
+        setBlockType(bottom + glm::ivec3(0, static_cast<int32_t>(offset) - 1, 0), column[offset], previous, outChanges);
+        previous = column[offset];
+    }
+    setBlockType(bottom + glm::ivec3(0, static_cast<int32_t>(column.size()) - 1, 0), BlockType::Air, previous, outChanges);
+
+    stats.moves++;
+    enqueue(bottom - glm::ivec3(0, 1, 0));
+}
+
+} // namespace engine
@@ -2,10 +2,13 @@
 #include "server/World.hpp"
 #include "shared/Protocol.hpp"
 #include "shared/ChunkSerializer.hpp"
+#include "shared/ColumnHeightmap.hpp"
+#include "shared/BlockRegistry.hpp"
 #include "core/Logger.hpp"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <stdexcept>
@@ -14,6 +17,8 @@
 #include <sstream>
 #include <iostream>
 #include <filesystem>
+#include <limits>
+#include <random>
 
 #ifndef _WIN32
 #include <sys/wait.h>
@@ -23,8 +28,9 @@
 
 namespace engine {
 
-GameServer::GameServer(uint16_t port, double tickRate)
-    : port(port), tickRate(tickRate), tickDuration(1.0 / tickRate) {
+GameServer::GameServer(uint16_t port, double tickRate, const WorldSettings& worldSettings)
+    : port(port), tickRate(tickRate), tickDuration(1.0 / tickRate),
+      serverCapabilities(protocol::SUPPORTED_CAPABILITIES) {
 
     LOG_INFO("Initializing game server on port {} at {} TPS", port, tickRate);
 
@@ -35,7 +41,7 @@ GameServer::GameServer(uint16_t port, double tickRate)
     }
 
     // Create world
-    world = std::make_unique<World>();
+    world = std::make_unique<World>(worldSettings);
 
     // Try to load existing world
     size_t loadedChunks = world->loadWorld("world");
@@ -57,9 +63,11 @@ GameServer::~GameServer() {
         stopTunnel();
     }
 
-    // Save world before shutting down
+    // Save world and connected players before shutting down
     LOG_INFO("Saving world before shutdown...");
     world->saveWorld("world");
+    saveAllPlayers();
+    profiles.flush();
 
     cleanupNetworking();
     enet_deinitialize();
@@ -79,8 +87,13 @@ void GameServer::run() {
 
         if (deltaTime >= tickDuration) {
             // Process one server tick
+            auto tickStart = std::chrono::steady_clock::now();
             tick();
 
+            // Track how much of the tick budget is used (feeds movement rate hints)
+            double tickTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - tickStart).count();
+            tickLoad = (0.9f * tickLoad) + (0.1f * static_cast<float>(tickTime / tickDuration));
+
             lastTick = now;
             currentTick++;
 
@@ -101,6 +114,12 @@ void GameServer::run() {
                 if (saved > 0) {
                     LOG_INFO("Autosave complete: {} chunks saved", saved);
                 }
+                size_t savedPlayers = saveAllPlayers();
+                if (savedPlayers > 0) {
+                    LOG_INFO("Autosave: {} players queued for saving", savedPlayers);
+                }
+                profiles.compact();
+                world->logMemoryReport();
             }
         } else {
             // Sleep to avoid busy-waiting (1ms granularity)
@@ -136,20 +155,46 @@ void GameServer::initNetworking() {
 }
 
 void GameServer::tick() {
-    // 1. Process network events
+    // 1. Process network events, then finish joins whose profiles have loaded
     processNetworkEvents();
+    processProfileLoads();
 
-    // 2. Update world state
+    // 2. Update world state (falling blocks and grass first, so their relighting runs this tick)
+    std::vector<BlockChange> changedBlocks = world->updateFallingBlocks();
+    std::vector<BlockChange> grassChanges = tickGrass();
+    changedBlocks.insert(changedBlocks.end(), grassChanges.begin(), grassChanges.end());
     world->update();
+    if (!changedBlocks.empty()) {
+        broadcastBlockChanges(changedBlocks);
+    }
 
     // 3. Update player chunks periodically (once per second at 40 TPS)
     if (currentTick % 40 == 0) {
         updatePlayerChunks();
     }
 
-    // 4. TODO: Update entities, physics, etc.
+    // 4. Stream queued chunks within each player's budget
+    sendQueuedChunks();
 
-    // 5. TODO: Send state updates to clients
+    // 5. Measure latency and bandwidth, tell clients how often to send movement
+    if (currentTick % KEEPALIVE_INTERVAL_TICKS == 0) {
+        sendKeepAlives();
+    }
+    if (currentTick % 40 == 20) {
+        sendMoveRateHints();
+    }
+    serverNetStats.updateRates();
+    for (uint32_t index = 0; index < players.size(); index++) {
+        players.getSession(index).netStats.updateRates();
+    }
+
+    if (networkReportRequested.exchange(false)) {
+        logNetworkReport();
+    }
+
+    // 6. TODO: Update entities, etc.
+
+    // 7. TODO: Send state updates to clients
 }
 
 void GameServer::processNetworkEvents() {
@@ -179,16 +224,16 @@ void GameServer::processNetworkEvents() {
 
 void GameServer::onClientConnect(ENetPeer* peer) {
     // Player data will be populated when we receive ClientJoin message with player name
-    PlayerData playerData;
-    playerData.playerId = nextPlayerId++;
-    playerData.playerName = "Player_" + std::to_string(playerData.playerId);  // Temporary until ClientJoin received
-    playerData.position = glm::vec3(0.0f, 5.0f, 0.0f);
+    uint32_t playerId = nextPlayerId++;
+    uint32_t index = players.indexOf(players.add(peer, playerId));
+    PlayerSession& session = players.getSession(index);
+    session.playerName = "Player_" + std::to_string(playerId);  // Temporary until ClientJoin received
+    session.view = ChunkViewWindow(CHUNK_LOAD_RADIUS, world->getMinChunkY(), world->getMaxChunkY());
+    session.chunkSendRate = CHUNK_SEND_RATE_INITIAL;
 
     // Initialize default hotbar (stone and dirt in first two slots)
-    playerData.hotbar[0] = ItemStack::fromBlock(BlockType::Stone, 64);
-    playerData.hotbar[1] = ItemStack::fromBlock(BlockType::Dirt, 64);
-
-    players[peer] = playerData;
+    session.hotbar[0] = ItemStack::fromBlock(BlockType::Stone, 64);
+    session.hotbar[1] = ItemStack::fromBlock(BlockType::Dirt, 64);
 
     // Set aggressive timeout to detect disconnects faster
     // Parameters: peer, limit (retries), min timeout (ms), max timeout (ms)
@@ -198,7 +243,7 @@ void GameServer::onClientConnect(ENetPeer* peer) {
 
     LOG_INFO("========================================");
     LOG_INFO(">>> PLAYER CONNECTED <<<");
-    LOG_INFO("Player ID: {}", playerData.playerId);
+    LOG_INFO("Player ID: {}", playerId);
     LOG_INFO("Address: {}:{}", peer->address.host, peer->address.port);
     LOG_INFO("Waiting for ClientJoin message with player name...");
     LOG_INFO("========================================");
@@ -208,20 +253,21 @@ void GameServer::onClientConnect(ENetPeer* peer) {
 
 void GameServer::onClientDisconnect(ENetPeer* peer) {
     // Find the player ID before removing
-    auto playerIt = players.find(peer);
-    if (playerIt != players.end()) {
-        uint32_t disconnectedPlayerId = playerIt->second.playerId;
-        std::string playerName = playerIt->second.playerName;  // Save name before erasing
-        const PlayerData& playerData = playerIt->second;
+    PlayerHandle handle = players.find(peer);
+    uint32_t index = players.indexOf(handle);
+    if (index != PlayerStore::NONE) {
+        uint32_t disconnectedPlayerId = players.getPlayerId(index);
+        std::string playerName = players.getSession(index).playerName;  // Save name before erasing
+        const glm::vec3& position = players.getPosition(index);
 
         // Save player data to disk
-        if (!playerData.playerName.empty() && !playerData.playerName.starts_with("Player_")) {
+        if (!playerName.empty() && !playerName.starts_with("Player_")) {
             // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
             LOG_INFO("Saving player data for {} at position ({:.1f}, {:.1f}, {:.1f})",
-                     playerData.playerName, playerData.position.x, playerData.position.y, playerData.position.z);
-            savePlayerData(playerData);
+                     playerName, position.x, position.y, position.z);
+            savePlayerData(index);
         } else {
-            LOG_DEBUG("Skipping save for temporary player: {}", playerData.playerName);
+            LOG_DEBUG("Skipping save for temporary player: {}", playerName);
         }
 
         // Broadcast player removal to all other clients
@@ -239,16 +285,18 @@ void GameServer::onClientDisconnect(ENetPeer* peer) {
         // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         std::memcpy(packet.data() + sizeof(protocol::MessageHeader), &removeMsg, sizeof(protocol::PlayerRemoveMessage));
 
-        // Send to all OTHER clients
-        for (const auto& [otherPeer, playerData] : players) {
-            if (otherPeer != peer) {
-                ENetPacket* enetPacket = enet_packet_create(packet.data(), packet.size(), ENET_PACKET_FLAG_RELIABLE);
-                enet_peer_send(otherPeer, 0, enetPacket);
+        // Send to all OTHER spawned clients (nobody was told about a player that never spawned)
+        if (players.getSession(index).spawned) {
+            for (uint32_t other = 0; other < players.size(); other++) {
+                if (other != index && players.getSession(other).spawned) {
+                    ENetPacket* enetPacket = enet_packet_create(packet.data(), packet.size(), ENET_PACKET_FLAG_RELIABLE);
+                    sendPacket(players.getPeer(other), 0, enetPacket);
+                }
             }
         }
 
         // Remove player from tracking
-        players.erase(playerIt);
+        players.remove(handle);
 
         LOG_INFO("========================================");
         LOG_INFO("<<< PLAYER LEFT >>>");
@@ -259,6 +307,123 @@ void GameServer::onClientDisconnect(ENetPeer* peer) {
     }
 }
 
+void GameServer::processProfileLoads() {
+    profileLoads.clear();
+    if (profiles.pollLoads(profileLoads) == 0) {
+        return;
+    }
+
+    for (ProfileLoadResult& result : profileLoads) {
+        uint32_t index = players.indexOf(result.player);
+        if (index == PlayerStore::NONE) {
+            LOG_DEBUG("Dropping profile of {}, who left while it loaded", result.playerName);
+            continue;
+        }
+
+        PlayerSession& session = players.getSession(index);
+        session.profilePending = false;
+        session.playerName = result.playerName;
+        if (result.found) {
+            const PlayerProfile& profile = result.profile;
+            players.setPose(index, profile.position, profile.yaw, profile.pitch);
+            session.selectedHotbarSlot = static_cast<size_t>(profile.selectedHotbarSlot);
+            session.hotbar = profile.hotbar;
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+            LOG_INFO("Loaded existing player data for {} at ({:.1f}, {:.1f}, {:.1f})",
+                     result.playerName, profile.position.x, profile.position.y, profile.position.z);
+        } else {
+            LOG_INFO("New player {}, using default spawn", result.playerName);
+            // Keep default position and inventory from onClientConnect
+        }
+
+        finishJoin(index);
+    }
+}
+
+void GameServer::finishJoin(uint32_t index) {
+    ENetPeer* peer = players.getPeer(index);
+    PlayerSession& session = players.getSession(index);
+    const std::string& playerName = session.playerName;
+
+    // Send all spawned players to the new player (the rest are announced when their own join finishes)
+    for (uint32_t other = 0; other < players.size(); other++) {
+        const PlayerSession& otherSession = players.getSession(other);
+        const std::string& otherName = otherSession.playerName;
+        if (other != index && otherSession.spawned) {
+            protocol::PlayerSpawnMessage spawnMsg{};
+            spawnMsg.playerId = players.getPlayerId(other);
+            spawnMsg.spawnPosition = players.getPosition(other);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+            std::snprintf(spawnMsg.playerName, sizeof(spawnMsg.playerName), "%s", otherName.c_str());
+
+            size_t totalSize = sizeof(protocol::MessageHeader) + sizeof(protocol::PlayerSpawnMessage);
+            ENetPacket* spawnPacket = enet_packet_create(nullptr, totalSize, ENET_PACKET_FLAG_RELIABLE);
+
+            protocol::MessageHeader spawnHeader{};
+            spawnHeader.type = protocol::MessageType::PlayerSpawn;
+            spawnHeader.payloadSize = sizeof(protocol::PlayerSpawnMessage);
+            std::memcpy(spawnPacket->data, &spawnHeader, sizeof(protocol::MessageHeader));
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            std::memcpy(spawnPacket->data + sizeof(protocol::MessageHeader), &spawnMsg, sizeof(spawnMsg));
+
+            sendPacket(peer, 0, spawnPacket);
+        }
+    }
+
+    // Broadcast new player spawn to all existing players
+    protocol::PlayerSpawnMessage spawnMsg{};
+    spawnMsg.playerId = players.getPlayerId(index);
+    spawnMsg.spawnPosition = players.getPosition(index);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    std::snprintf(spawnMsg.playerName, sizeof(spawnMsg.playerName), "%s", session.playerName.c_str());
+
+    size_t totalSize = sizeof(protocol::MessageHeader) + sizeof(protocol::PlayerSpawnMessage);
+    ENetPacket* spawnPacket = enet_packet_create(nullptr, totalSize, ENET_PACKET_FLAG_RELIABLE);
+
+    protocol::MessageHeader spawnHeader{};
+    spawnHeader.type = protocol::MessageType::PlayerSpawn;
+    spawnHeader.payloadSize = sizeof(protocol::PlayerSpawnMessage);
+    std::memcpy(spawnPacket->data, &spawnHeader, sizeof(protocol::MessageHeader));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(spawnPacket->data + sizeof(protocol::MessageHeader), &spawnMsg, sizeof(spawnMsg));
+
+    for (uint32_t other = 0; other < players.size(); other++) {
+        if (other != index && players.getSession(other).spawned) {
+            sendPacket(players.getPeer(other), 0,
+                       enet_packet_create(spawnPacket->data, spawnPacket->dataLength, ENET_PACKET_FLAG_RELIABLE));
+        }
+    }
+    enet_packet_destroy(spawnPacket);
+    session.spawned = true;
+
+    // Send chunks in radius around spawn point
+    sendChunksAroundPlayer(peer, players.getPosition(index));
+
+    // Send inventory sync and spawn position to client
+    protocol::InventorySyncMessage inventoryMsg;
+    std::memcpy(inventoryMsg.hotbar, session.hotbar.data(), 9 * sizeof(ItemStack));
+    inventoryMsg.selectedHotbarSlot = static_cast<uint32_t>(session.selectedHotbarSlot);
+    inventoryMsg.position = players.getPosition(index);
+    inventoryMsg.yaw = players.getYaw(index);
+    inventoryMsg.pitch = players.getPitch(index);
+
+    size_t invTotalSize = sizeof(protocol::MessageHeader) + sizeof(protocol::InventorySyncMessage);
+    ENetPacket* invPacket = enet_packet_create(nullptr, invTotalSize, ENET_PACKET_FLAG_RELIABLE);
+
+    protocol::MessageHeader invHeader{};
+    invHeader.type = protocol::MessageType::InventorySync;
+    invHeader.payloadSize = sizeof(protocol::InventorySyncMessage);
+    std::memcpy(invPacket->data, &invHeader, sizeof(protocol::MessageHeader));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(invPacket->data + sizeof(protocol::MessageHeader), &inventoryMsg, sizeof(inventoryMsg));
+
+    sendPacket(peer, 0, invPacket);
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+    LOG_INFO("Player {} joined at ({:.1f}, {:.1f}, {:.1f})",
+             playerName, players.getPosition(index).x, players.getPosition(index).y, players.getPosition(index).z);
+}
+
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 void GameServer::onClientPacket(ENetPeer* peer, ENetPacket* packet) {
     if (packet->dataLength < sizeof(protocol::MessageHeader)) {
@@ -270,6 +435,15 @@ void GameServer::onClientPacket(ENetPeer* peer, ENetPacket* packet) {
     protocol::MessageHeader header{};
     std::memcpy(&header, packet->data, sizeof(protocol::MessageHeader));
 
+    serverNetStats.recordReceived(header.type, packet->dataLength);
+    uint32_t sender = players.indexOf(peer);
+    if (sender != PlayerStore::NONE) {
+        players.getSession(sender).netStats.recordReceived(header.type, packet->dataLength);
+    } else {
+        LOG_WARN("Received packet from unknown peer");
+        return;
+    }
+
     // Handle different message types
     switch (header.type) {
         case protocol::MessageType::ClientJoin: {
@@ -285,93 +459,21 @@ void GameServer::onClientPacket(ENetPeer* peer, ENetPacket* packet) {
             );
 
             std::string playerName(joinMsg->playerName);
-            LOG_INFO("Client join request from player: {}", playerName);
-
-            // Try to load existing player data
-            PlayerData& playerData = players[peer];
-            playerData.playerName = playerName;
-
-            if (loadPlayerData(playerName, playerData)) {
-                LOG_INFO("Loaded existing player data for {}", playerName);
-            } else {
-                LOG_INFO("New player {}, using default spawn", playerName);
-                // Keep default position and inventory from onClientConnect
-            }
-
-            // Send all existing players to the new player
-            for (const auto& [otherPeer, otherPlayer] : players) {
-                if (otherPeer != peer && !otherPlayer.playerName.empty()) {
-                    protocol::PlayerSpawnMessage spawnMsg{};
-                    spawnMsg.playerId = otherPlayer.playerId;
-                    spawnMsg.spawnPosition = otherPlayer.position;
-                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
-                    std::snprintf(spawnMsg.playerName, sizeof(spawnMsg.playerName), "%s", otherPlayer.playerName.c_str());
-
-                    size_t totalSize = sizeof(protocol::MessageHeader) + sizeof(protocol::PlayerSpawnMessage);
-                    ENetPacket* spawnPacket = enet_packet_create(nullptr, totalSize, ENET_PACKET_FLAG_RELIABLE);
-
-                    protocol::MessageHeader spawnHeader{};
-                    spawnHeader.type = protocol::MessageType::PlayerSpawn;
-                    spawnHeader.payloadSize = sizeof(protocol::PlayerSpawnMessage);
-                    std::memcpy(spawnPacket->data, &spawnHeader, sizeof(protocol::MessageHeader));
-                    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-                    std::memcpy(spawnPacket->data + sizeof(protocol::MessageHeader), &spawnMsg, sizeof(spawnMsg));
-
-                    enet_peer_send(peer, 0, spawnPacket);
-                }
-            }
-
-            // Broadcast new player spawn to all existing players
-            protocol::PlayerSpawnMessage spawnMsg{};
-            spawnMsg.playerId = playerData.playerId;
-            spawnMsg.spawnPosition = playerData.position;
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
-            std::snprintf(spawnMsg.playerName, sizeof(spawnMsg.playerName), "%s", playerData.playerName.c_str());
-
-            size_t totalSize = sizeof(protocol::MessageHeader) + sizeof(protocol::PlayerSpawnMessage);
-            ENetPacket* spawnPacket = enet_packet_create(nullptr, totalSize, ENET_PACKET_FLAG_RELIABLE);
-
-            protocol::MessageHeader spawnHeader{};
-            spawnHeader.type = protocol::MessageType::PlayerSpawn;
-            spawnHeader.payloadSize = sizeof(protocol::PlayerSpawnMessage);
-            std::memcpy(spawnPacket->data, &spawnHeader, sizeof(protocol::MessageHeader));
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-            std::memcpy(spawnPacket->data + sizeof(protocol::MessageHeader), &spawnMsg, sizeof(spawnMsg));
+            uint32_t clientVersion = joinMsg->clientVersion;
+            LOG_INFO("Client join request from player: {} (protocol v{})", playerName, clientVersion);
 
-            for (const auto& [otherPeer, otherPlayer] : players) {
-                if (otherPeer != peer) {
-                    enet_peer_send(otherPeer, 0, enet_packet_create(spawnPacket->data, spawnPacket->dataLength, ENET_PACKET_FLAG_RELIABLE));
-                }
+            PlayerSession& session = players.getSession(sender);
+            if (session.profilePending) {
+                LOG_WARN("Ignoring repeated ClientJoin from {} (profile still loading)", playerName);
+                break;
             }
-            enet_packet_destroy(spawnPacket);
-
-            // Send chunks in radius around spawn point
-            sendChunksAroundPlayer(peer, playerData.position);
-            players[peer].lastChunkUpdatePos = playerData.position;
-
-            // Send inventory sync and spawn position to client
-            protocol::InventorySyncMessage inventoryMsg;
-            std::memcpy(inventoryMsg.hotbar, playerData.hotbar.data(), 9 * sizeof(ItemStack));
-            inventoryMsg.selectedHotbarSlot = static_cast<uint32_t>(playerData.selectedHotbarSlot);
-            inventoryMsg.position = playerData.position;
-            inventoryMsg.yaw = playerData.yaw;
-            inventoryMsg.pitch = playerData.pitch;
-
-            size_t invTotalSize = sizeof(protocol::MessageHeader) + sizeof(protocol::InventorySyncMessage);
-            ENetPacket* invPacket = enet_packet_create(nullptr, invTotalSize, ENET_PACKET_FLAG_RELIABLE);
-
-            protocol::MessageHeader invHeader{};
-            invHeader.type = protocol::MessageType::InventorySync;
-            invHeader.payloadSize = sizeof(protocol::InventorySyncMessage);
-            std::memcpy(invPacket->data, &invHeader, sizeof(protocol::MessageHeader));
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-            std::memcpy(invPacket->data + sizeof(protocol::MessageHeader), &inventoryMsg, sizeof(inventoryMsg));
 
-            enet_peer_send(peer, 0, invPacket);
+            // Agree on optional encodings before anything else is sent to this peer
+            negotiateCapabilities(peer, packet);
 
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
-            LOG_INFO("Player {} joined at ({:.1f}, {:.1f}, {:.1f})",
-                     playerName, playerData.position.x, playerData.position.y, playerData.position.z);
+            // The rest of the join runs once the saved profile is loaded (processProfileLoads)
+            session.profilePending = true;
+            profiles.requestLoad(players.getHandle(sender), playerName);
             break;
         }
 
@@ -390,47 +492,85 @@ void GameServer::onClientPacket(ENetPeer* peer, ENetPacket* packet) {
                 static_cast<const uint8_t*>(packet->data) + sizeof(protocol::MessageHeader)
             );
 
-            // Update player position and rotation
-            auto& playerData = players[peer];
-            playerData.position = moveMsg->position;
-            playerData.yaw = moveMsg->yaw;
-            playerData.pitch = moveMsg->pitch;
+            PlayerSession& session = players.getSession(sender);
 
-            // Broadcast position update to all other players
-            protocol::PlayerPositionUpdateMessage posUpdate{};
-            posUpdate.playerId = playerData.playerId;
-            posUpdate.position = moveMsg->position;
-            posUpdate.yaw = moveMsg->yaw;
-            posUpdate.pitch = moveMsg->pitch;
-
-            size_t totalSize = sizeof(protocol::MessageHeader) + sizeof(protocol::PlayerPositionUpdateMessage);
-            ENetPacket* updatePacket = enet_packet_create(nullptr, totalSize, 0);  // Unreliable for frequent updates
+            // Sequenced moves arrive unreliably - drop anything older than what we already applied
+            if (packet->dataLength >= expectedSize + sizeof(protocol::PlayerMoveSequenceMessage)) {
+                protocol::PlayerMoveSequenceMessage sequenceMsg{};
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                std::memcpy(&sequenceMsg, packet->data + expectedSize, sizeof(sequenceMsg));
 
-            protocol::MessageHeader updateHeader{};
-            updateHeader.type = protocol::MessageType::PlayerPositionUpdate;
-            updateHeader.payloadSize = sizeof(protocol::PlayerPositionUpdateMessage);
-            std::memcpy(updatePacket->data, &updateHeader, sizeof(protocol::MessageHeader));
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-            std::memcpy(updatePacket->data + sizeof(protocol::MessageHeader), &posUpdate, sizeof(posUpdate));
+                uint32_t sequence = sequenceMsg.inputSequence;
+                if (session.hasInputSequence && !protocol::isSequenceNewer(sequence, session.lastInputSequence)) {
+                    LOG_TRACE("Dropping stale move {} from {} (last {})",
+                              sequence, session.playerName, session.lastInputSequence);
+                    break;
+                }
+                session.lastInputSequence = sequence;
+                session.hasInputSequence = true;
 
-            // Send to all other players
-            for (const auto& [otherPeer, otherPlayer] : players) {
-                if (otherPeer != peer) {
-                    enet_peer_send(otherPeer, 0, enet_packet_create(updatePacket->data, updatePacket->dataLength, 0));
+                size_t ackOffset = expectedSize + sizeof(protocol::PlayerMoveSequenceMessage);
+                if (session.correctionPending && packet->dataLength >= ackOffset + sizeof(protocol::PlayerMoveAckMessage)) {
+                    protocol::PlayerMoveAckMessage ackMsg{};
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    std::memcpy(&ackMsg, packet->data + ackOffset, sizeof(ackMsg));
+                    session.correctionPending = ackMsg.correctionSequence != session.correctionSequence;
                 }
             }
-            enet_packet_destroy(updatePacket);
-
-            // Check distance from last chunk update position
-            float distanceFromLastUpdate = glm::distance(playerData.lastChunkUpdatePos, playerData.position);
 
-            // Only send new chunks if player moved significantly (1 chunk = 16 blocks)
-            if (distanceFromLastUpdate > 16.0f) {  // 1 chunk
+            // Sweep from the last accepted position, so a move through solid blocks stops at them
+            glm::vec3 requested = moveMsg->position;
+            glm::vec3 resolved = world->resolvePlayerMove(players.getPosition(sender), requested);
+            bool diverged = glm::distance(resolved, requested) > MOVE_CORRECTION_DISTANCE;
+            if (diverged) {
                 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
-                LOG_DEBUG("Player moved {:.1f} blocks from last chunk update, sending new chunks around ({:.1f}, {:.1f}, {:.1f}) | Currently loaded: {} chunks",
-                         distanceFromLastUpdate, playerData.position.x, playerData.position.y, playerData.position.z, playerData.loadedChunks.size());
-                sendChunksAroundPlayer(peer, playerData.position);
-                playerData.lastChunkUpdatePos = playerData.position;
+                LOG_DEBUG("Move from {} blocked: requested ({:.2f}, {:.2f}, {:.2f}), resolved ({:.2f}, {:.2f}, {:.2f})",
+                          session.playerName, requested.x, requested.y, requested.z,
+                          resolved.x, resolved.y, resolved.z);
+            }
+
+            // Update player position and rotation
+            players.setPose(sender, resolved, moveMsg->yaw, moveMsg->pitch);
+
+            // Don't let the client carry on from a position the server didn't accept. Moves sent
+            // before it applies a correction were made from the old position, so wait for the ack.
+            if (diverged && session.hasInputSequence && !session.correctionPending &&
+                players.hasCapability(sender, protocol::CAPABILITY_MOVE_CORRECTION)) {
+                sendMoveCorrection(sender);
+            }
+
+            // Send to the other players whose view reaches this player (once it has spawned for them)
+            nearbyPlayers.clear();
+            if (session.spawned) {
+                findPlayersInView(resolved, nearbyPlayers);
+            }
+            ENetPacket* updatePacket = nullptr;
+            ENetPacket* intervalUpdatePacket = nullptr;
+            for (uint32_t other : nearbyPlayers) {
+                if (other == sender) {
+                    continue;
+                }
+                // Built once per format, then copied for each receiver
+                bool withInterval = players.hasCapability(other, protocol::CAPABILITY_POSITION_INTERVAL);
+                ENetPacket*& sharedPacket = withInterval ? intervalUpdatePacket : updatePacket;
+                if (sharedPacket == nullptr) {
+                    sharedPacket = createPositionUpdatePacket(sender, withInterval);
+                }
+                sendPacket(players.getPeer(other), protocol::CHANNEL_UNRELIABLE,
+                           enet_packet_create(sharedPacket->data, sharedPacket->dataLength, 0));
+            }
+            if (updatePacket != nullptr) {
+                enet_packet_destroy(updatePacket);
+            }
+            if (intervalUpdatePacket != nullptr) {
+                enet_packet_destroy(intervalUpdatePacket);
+            }
+
+            // Update the view as soon as the player crosses into another chunk
+            ChunkCoord playerChunk = ChunkCoord::fromWorldPos(resolved);
+            if (session.view.hasCenter() && !session.view.isCenteredOn(playerChunk)) {
+                sendChunksAroundPlayer(peer, resolved);
+                sendNearbyPlayerPositions(sender);
             }
             break;
         }
@@ -450,12 +590,12 @@ void GameServer::onClientPacket(ENetPeer* peer, ENetPacket* packet) {
             );
 
             // Update player inventory on server
-            auto& playerData = players[peer];
-            std::memcpy(playerData.hotbar.data(), invMsg->hotbar, 9 * sizeof(ItemStack));
-            playerData.selectedHotbarSlot = static_cast<size_t>(invMsg->selectedHotbarSlot);
+            PlayerSession& session = players.getSession(sender);
+            std::memcpy(session.hotbar.data(), invMsg->hotbar, 9 * sizeof(ItemStack));
+            session.selectedHotbarSlot = static_cast<size_t>(invMsg->selectedHotbarSlot);
 
             LOG_DEBUG("Updated inventory for player {} (selected slot: {})",
-                     playerData.playerName, playerData.selectedHotbarSlot);
+                     session.playerName, session.selectedHotbarSlot);
             break;
         }
 
@@ -476,14 +616,20 @@ void GameServer::onClientPacket(ENetPeer* peer, ENetPacket* packet) {
             LOG_INFO("SERVER: Processing block place at ({}, {}, {}) | Type: {}",
                      placeMsg->x, placeMsg->y, placeMsg->z, placeMsg->blockType);
 
+            if (!BlockRegistry::isValid(placeMsg->blockType)) {
+                LOG_WARN("Player tried to place unknown block type {}", placeMsg->blockType);
+                sendBlockCorrection(peer, placeMsg->x, placeMsg->y, placeMsg->z);
+                break;
+            }
+
             // Validate player is close enough (10 block reach + 5 block buffer)
-            auto& playerData = players[peer];
             float distance = glm::distance(
-                playerData.position,
+                players.getPosition(sender),
                 glm::vec3(placeMsg->x, placeMsg->y, placeMsg->z)
             );
             if (distance > 15.0f) {
                 LOG_WARN("Player tried to place block too far away ({:.1f} blocks)", distance);
+                sendBlockCorrection(peer, placeMsg->x, placeMsg->y, placeMsg->z);
                 break;
             }
 
@@ -502,20 +648,23 @@ void GameServer::onClientPacket(ENetPeer* peer, ENetPacket* packet) {
             int localZ = placeMsg->z - (chunkCoord.z * 32);
 
             // Get current block type
-            Block currentBlock = chunk->getBlock(localX, localY, localZ);
+            Block currentBlock = std::as_const(*chunk).getBlock(localX, localY, localZ);  // const: don't unshare deduplicated blocks
             if (currentBlock.type != BlockType::Air) {
                 LOG_DEBUG("Player tried to place block in occupied space at ({}, {}, {})",
                          placeMsg->x, placeMsg->y, placeMsg->z);
+                sendBlockCorrection(peer, placeMsg->x, placeMsg->y, placeMsg->z);
                 break;
             }
 
             // Place the block
             chunk->setBlock(localX, localY, localZ, Block{static_cast<BlockType>(placeMsg->blockType)});
+            world->queueLightUpdate(glm::ivec3(placeMsg->x, placeMsg->y, placeMsg->z), currentBlock.type);
+            world->queueFallingBlockCheck(glm::ivec3(placeMsg->x, placeMsg->y, placeMsg->z));
             LOG_INFO("SERVER: Player placed block at ({}, {}, {}) | Type: {}",
                      placeMsg->x, placeMsg->y, placeMsg->z, placeMsg->blockType);
 
-            // Broadcast block update to all clients
-            LOG_INFO("SERVER: Broadcasting BlockUpdate to all clients");
+            // Send block update to the clients that have the chunk
+            LOG_INFO("SERVER: Sending BlockUpdate to players in view");
             protocol::BlockUpdateMessage updateMsg{};
             updateMsg.x = placeMsg->x;
             updateMsg.y = placeMsg->y;
@@ -532,7 +681,7 @@ void GameServer::onClientPacket(ENetPeer* peer, ENetPacket* packet) {
             // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
             std::memcpy(updatePacket->data + sizeof(protocol::MessageHeader), &updateMsg, sizeof(updateMsg));
 
-            enet_host_broadcast(server, 0, updatePacket);
+            sendToChunkViewers(glm::ivec3(placeMsg->x, placeMsg->y, placeMsg->z), 0, updatePacket);
             break;
         }
 
@@ -553,13 +702,13 @@ void GameServer::onClientPacket(ENetPeer* peer, ENetPacket* packet) {
             LOG_INFO("SERVER: Processing block break at ({}, {}, {})", breakMsg->x, breakMsg->y, breakMsg->z);
 
             // Validate player is close enough (10 block reach + 5 block buffer)
-            auto& playerData = players[peer];
             float distance = glm::distance(
-                playerData.position,
+                players.getPosition(sender),
                 glm::vec3(breakMsg->x, breakMsg->y, breakMsg->z)
             );
             if (distance > 15.0f) {
                 LOG_WARN("Player tried to break block too far away ({:.1f} blocks)", distance);
+                sendBlockCorrection(peer, breakMsg->x, breakMsg->y, breakMsg->z);
                 break;
             }
 
@@ -578,20 +727,23 @@ void GameServer::onClientPacket(ENetPeer* peer, ENetPacket* packet) {
             int localZ = breakMsg->z - (chunkCoord.z * 32);
 
             // Get current block type
-            Block currentBlock = chunk->getBlock(localX, localY, localZ);
+            Block currentBlock = std::as_const(*chunk).getBlock(localX, localY, localZ);  // const: don't unshare deduplicated blocks
             if (currentBlock.type == BlockType::Air) {
                 LOG_DEBUG("Player tried to break air block at ({}, {}, {})",
                          breakMsg->x, breakMsg->y, breakMsg->z);
+                sendBlockCorrection(peer, breakMsg->x, breakMsg->y, breakMsg->z);
                 break;
             }
 
             // Break the block (set to air)
             chunk->setBlock(localX, localY, localZ, Block{BlockType::Air});
+            world->queueLightUpdate(glm::ivec3(breakMsg->x, breakMsg->y, breakMsg->z), currentBlock.type);
+            world->queueFallingBlockCheck(glm::ivec3(breakMsg->x, breakMsg->y, breakMsg->z));
             LOG_INFO("SERVER: Player broke block at ({}, {}, {}) | Type: {}",
                      breakMsg->x, breakMsg->y, breakMsg->z, static_cast<int>(currentBlock.type));
 
-            // Broadcast block update to all clients
-            LOG_INFO("SERVER: Broadcasting BlockUpdate to all clients");
+            // Send block update to the clients that have the chunk
+            LOG_INFO("SERVER: Sending BlockUpdate to players in view");
             protocol::BlockUpdateMessage updateMsg{};
             updateMsg.x = breakMsg->x;
             updateMsg.y = breakMsg->y;
@@ -608,52 +760,489 @@ void GameServer::onClientPacket(ENetPeer* peer, ENetPacket* packet) {
             // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
             std::memcpy(updatePacket->data + sizeof(protocol::MessageHeader), &updateMsg, sizeof(updateMsg));
 
-            enet_host_broadcast(server, 0, updatePacket);
+            sendToChunkViewers(glm::ivec3(breakMsg->x, breakMsg->y, breakMsg->z), 0, updatePacket);
             break;
         }
 
+        case protocol::MessageType::KeepAlive:
+            handleKeepAlive(peer, packet);
+            break;
+
         default:
             LOG_TRACE("Unhandled message type from client: {}", static_cast<int>(header.type));
             break;
     }
 }
 
-void GameServer::cleanupNetworking() {
-    if (server != nullptr) {
-        LOG_INFO("Shutting down server networking...");
-        enet_host_destroy(server);
-        server = nullptr;
+void GameServer::negotiateCapabilities(ENetPeer* peer, const ENetPacket* packet) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto* joinMsg = reinterpret_cast<const protocol::ClientJoinMessage*>(
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        static_cast<const uint8_t*>(packet->data) + sizeof(protocol::MessageHeader)
+    );
+
+    uint32_t index = players.indexOf(peer);
+    PlayerSession& session = players.getSession(index);
+    session.clientVersion = joinMsg->clientVersion;
+
+    // Version 1 clients send a bare ClientJoinMessage - treat them as baseline only
+    const size_t capsOffset = sizeof(protocol::MessageHeader) + sizeof(protocol::ClientJoinMessage);
+    bool advertised = joinMsg->clientVersion >= 2 &&
+                      packet->dataLength >= capsOffset + sizeof(protocol::ClientCapabilitiesMessage);
+
+    uint32_t clientCapabilities = protocol::LEGACY_CAPABILITIES;
+    if (advertised) {
+        protocol::ClientCapabilitiesMessage capsMsg{};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memcpy(&capsMsg, packet->data + capsOffset, sizeof(capsMsg));
+        clientCapabilities = capsMsg.supportedCapabilities;
+    }
+
+    players.setCapabilities(index, protocol::negotiateCapabilities(clientCapabilities, serverCapabilities));
+
+    LOG_INFO("Negotiated capabilities for {}: client 0x{:08x} & server 0x{:08x} -> 0x{:08x}",
+             session.playerName, clientCapabilities, serverCapabilities, players.getCapabilities(index));
+
+    if (!advertised) {
+        return;  // Legacy client would not understand the reply
+    }
+
+    protocol::ServerCapabilitiesMessage capsReply{};
+    capsReply.protocolVersion = protocol::PROTOCOL_VERSION;
+    capsReply.enabledCapabilities = players.getCapabilities(index);
+
+    size_t totalSize = sizeof(protocol::MessageHeader) + sizeof(protocol::ServerCapabilitiesMessage);
+    ENetPacket* replyPacket = enet_packet_create(nullptr, totalSize, ENET_PACKET_FLAG_RELIABLE);
+
+    protocol::MessageHeader replyHeader{};
+    replyHeader.type = protocol::MessageType::ServerCapabilities;
+    replyHeader.payloadSize = sizeof(protocol::ServerCapabilitiesMessage);
+    std::memcpy(replyPacket->data, &replyHeader, sizeof(protocol::MessageHeader));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(replyPacket->data + sizeof(protocol::MessageHeader), &capsReply, sizeof(capsReply));
+
+    sendPacket(peer, 0, replyPacket);
+}
+
+void GameServer::sendBlockCorrection(ENetPeer* peer, int32_t worldX, int32_t worldY, int32_t worldZ) {
+    const Block* block = world->getBlockAt(worldX, worldY, worldZ);
+    if (!block) {
+        return;  // Chunk not loaded - client will roll back on timeout
     }
+
+    protocol::BlockUpdateMessage updateMsg{};
+    updateMsg.x = worldX;
+    updateMsg.y = worldY;
+    updateMsg.z = worldZ;
+    updateMsg.blockType = static_cast<uint16_t>(block->type);
+
+    size_t totalSize = sizeof(protocol::MessageHeader) + sizeof(protocol::BlockUpdateMessage);
+    ENetPacket* updatePacket = enet_packet_create(nullptr, totalSize, ENET_PACKET_FLAG_RELIABLE);
+
+    protocol::MessageHeader updateHeader{};
+    updateHeader.type = protocol::MessageType::BlockUpdate;
+    updateHeader.payloadSize = sizeof(protocol::BlockUpdateMessage);
+    std::memcpy(updatePacket->data, &updateHeader, sizeof(protocol::MessageHeader));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(updatePacket->data + sizeof(protocol::MessageHeader), &updateMsg, sizeof(updateMsg));
+
+    sendPacket(peer, 0, updatePacket);
+    uint32_t index = players.indexOf(peer);
+    LOG_DEBUG("Sent block correction to {} at ({}, {}, {})",
+              index != PlayerStore::NONE ? players.getSession(index).playerName : "unknown", worldX, worldY, worldZ);
 }
 
-void GameServer::sendChunksAroundPlayer(ENetPeer* peer, const glm::vec3& position) {
-    // Get chunks needed around this position
-    std::vector<ChunkCoord> chunksNeeded = world->getChunksInRadius(position, CHUNK_LOAD_RADIUS);
+void GameServer::sendMoveCorrection(uint32_t index) {
+    PlayerSession& session = players.getSession(index);
+
+    protocol::PlayerCorrectionMessage correction{};
+    correction.inputSequence = session.lastInputSequence;
+    correction.position = players.getPosition(index);
+
+    size_t totalSize = sizeof(protocol::MessageHeader) + sizeof(protocol::PlayerCorrectionMessage);
+    ENetPacket* correctionPacket = enet_packet_create(nullptr, totalSize, ENET_PACKET_FLAG_RELIABLE);
+
+    protocol::MessageHeader correctionHeader{};
+    correctionHeader.type = protocol::MessageType::PlayerCorrection;
+    correctionHeader.payloadSize = sizeof(protocol::PlayerCorrectionMessage);
+    std::memcpy(correctionPacket->data, &correctionHeader, sizeof(protocol::MessageHeader));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(correctionPacket->data + sizeof(protocol::MessageHeader), &correction, sizeof(correction));
+
+    sendPacket(players.getPeer(index), protocol::CHANNEL_RELIABLE, correctionPacket);
+    session.correctionSequence = session.lastInputSequence;
+    session.correctionPending = true;
+    LOG_DEBUG("Sent move correction {} to {}", session.correctionSequence, session.playerName);
+}
+
+void GameServer::findPlayersInView(const glm::vec3& position, std::vector<uint32_t>& outIndices) const {
+    constexpr float ANY_HEIGHT = std::numeric_limits<float>::max();
+    size_t first = outIndices.size();
+    players.findInBox(glm::vec3(position.x - INTEREST_RADIUS, -ANY_HEIGHT, position.z - INTEREST_RADIUS),
+                      glm::vec3(position.x + INTEREST_RADIUS, ANY_HEIGHT, position.z + INTEREST_RADIUS),
+                      outIndices);
+
+    // Players still joining don't know about anyone yet, and nobody knows about them
+    auto joining = std::remove_if(outIndices.begin() + static_cast<std::ptrdiff_t>(first), outIndices.end(),
+                                  [this](uint32_t index) { return !players.getSession(index).spawned; });
+    outIndices.erase(joining, outIndices.end());
+}
+
+void GameServer::sendToChunkViewers(const glm::ivec3& worldPos, uint8_t channel, ENetPacket* packet) {
+    ChunkCoord chunk = ChunkCoord::fromWorldPos(glm::vec3(worldPos));
+    nearbyPlayers.clear();
+    findPlayersInView(glm::vec3(worldPos), nearbyPlayers);
+    for (uint32_t index : nearbyPlayers) {
+        if (players.getSession(index).view.isSent(chunk)) {
+            sendPacket(players.getPeer(index), channel,
+                       enet_packet_create(packet->data, packet->dataLength, packet->flags));
+        }
+    }
+    enet_packet_destroy(packet);
+}
+
+void GameServer::sendNearbyPlayerPositions(uint32_t index) {
+    ENetPeer* peer = players.getPeer(index);
+    nearbyPlayers.clear();
+    findPlayersInView(players.getPosition(index), nearbyPlayers);
+    for (uint32_t other : nearbyPlayers) {
+        if (other == index) {
+            continue;
+        }
+
+        sendPacket(peer, protocol::CHANNEL_UNRELIABLE,
+                   createPositionUpdatePacket(other, players.hasCapability(index, protocol::CAPABILITY_POSITION_INTERVAL)));
+    }
+}
+
+ENetPacket* GameServer::createPositionUpdatePacket(uint32_t index, bool withInterval) const {
+    protocol::PlayerPositionUpdateMessage posUpdate{};
+    posUpdate.playerId = players.getPlayerId(index);
+    posUpdate.position = players.getPosition(index);
+    posUpdate.yaw = players.getYaw(index);
+    posUpdate.pitch = players.getPitch(index);
+
+    // Clients that don't take rate hints send at their own pace, which the server doesn't know
+    protocol::PlayerPositionIntervalMessage interval{};
+    if (players.hasCapability(index, protocol::CAPABILITY_UNRELIABLE_MOVEMENT)) {
+        interval.moveIntervalMs = players.getSession(index).moveIntervalMs;
+    }
+
+    size_t payloadSize = sizeof(posUpdate) + (withInterval ? sizeof(interval) : 0);
+    ENetPacket* updatePacket = enet_packet_create(nullptr, sizeof(protocol::MessageHeader) + payloadSize, 0);  // Unreliable for frequent updates
+
+    protocol::MessageHeader updateHeader{};
+    updateHeader.type = protocol::MessageType::PlayerPositionUpdate;
+    updateHeader.payloadSize = static_cast<uint32_t>(payloadSize);
+    std::memcpy(updatePacket->data, &updateHeader, sizeof(protocol::MessageHeader));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(updatePacket->data + sizeof(protocol::MessageHeader), &posUpdate, sizeof(posUpdate));
+    if (withInterval) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memcpy(updatePacket->data + sizeof(protocol::MessageHeader) + sizeof(posUpdate), &interval, sizeof(interval));
+    }
+    return updatePacket;
+}
+
+std::vector<BlockChange> GameServer::tickGrass() {
+    constexpr uint64_t REGION_SEED_X = 73856093u;
+    constexpr uint64_t REGION_SEED_Z = 19349663u;
+    constexpr uint64_t TICK_SEED = 83492791u;
+    const glm::ivec3 above(0, 1, 0);
+
+    uint64_t tickNumber = currentTick;
+    return world->tickRegions([tickNumber, above](RegionScheduler::RegionContext& context) {
+        const ChunkCoord& region = context.getRegion();
+        std::minstd_rand rng(static_cast<uint32_t>((tickNumber * TICK_SEED) ^
+                                                   (static_cast<uint64_t>(region.x) * REGION_SEED_X) ^
+                                                   (static_cast<uint64_t>(region.z) * REGION_SEED_Z)));
+        std::uniform_int_distribution<int32_t> local(0, static_cast<int32_t>(CHUNK_SIZE) - 1);
+
+        for (const ChunkCoord& coord : context.getChunks()) {
+            glm::ivec3 origin = glm::ivec3(coord.x, coord.y, coord.z) * static_cast<int32_t>(CHUNK_SIZE);
+            for (uint32_t pick = 0; pick < RANDOM_TICKS_PER_CHUNK; pick++) {
+                glm::ivec3 pos = origin + glm::ivec3(local(rng), local(rng), local(rng));
+                BlockType type = context.getBlock(pos);
+                if (type != BlockType::Grass && type != BlockType::Dirt) {
+                    continue;
+                }
+
+                bool covered = BlockRegistry::isOpaque(context.getBlock(pos + above));
+                if (type == BlockType::Grass) {
+                    if (covered) {
+                        context.setBlock(pos, BlockType::Dirt);
+                    }
+                    continue;
+                }
+                if (covered || !context.canRead(pos + above)) {
+                    continue;  // A cold chunk above reads as Air whatever it holds
+                }
+
+                // Uncovered dirt turns to grass next to grass (one block up or down counts)
+                bool nearGrass = false;
+                // NOLINTNEXTLINE(readability-identifier-length)
+                for (int32_t dx = -1; dx <= 1 && !nearGrass; dx++) {
+                    // NOLINTNEXTLINE(readability-identifier-length)
+                    for (int32_t dy = -1; dy <= 1 && !nearGrass; dy++) {
+                        // NOLINTNEXTLINE(readability-identifier-length)
+                        for (int32_t dz = -1; dz <= 1 && !nearGrass; dz++) {
+                            nearGrass = context.getBlock(pos + glm::ivec3(dx, dy, dz)) == BlockType::Grass;
+                        }
+                    }
+                }
+                if (nearGrass) {
+                    context.setBlock(pos, BlockType::Grass);
+                }
+            }
+        }
+    });
+}
 
-    // Get player's loaded chunks
-    auto& playerData = players[peer];
-    std::unordered_set<ChunkCoord> chunksToSend;
-    std::unordered_set<ChunkCoord> chunksToUnload;
+void GameServer::broadcastBlockChanges(const std::vector<BlockChange>& changes) {
+    constexpr size_t MAX_BATCH_ENTRIES = 4096;  // 52 KB of entries per packet
+
+    std::vector<protocol::BlockUpdateMessage> updates;
+    for (uint32_t index = 0; index < players.size(); index++) {
+        ENetPeer* peer = players.getPeer(index);
+        const ChunkViewWindow& view = players.getSession(index).view;
+        updates.clear();
+        for (const BlockChange& change : changes) {
+            if (!view.isSent(ChunkCoord::fromWorldPos(glm::vec3(change.position)))) {
+                continue;  // The chunk will carry the change when it is sent
+            }
+            protocol::BlockUpdateMessage updateMsg{};
+            updateMsg.x = change.position.x;
+            updateMsg.y = change.position.y;
+            updateMsg.z = change.position.z;
+            updateMsg.blockType = static_cast<uint16_t>(change.type);
+            updates.push_back(updateMsg);
+        }
+
+        if (!players.hasCapability(index, protocol::CAPABILITY_BLOCK_BATCH)) {
+            for (const protocol::BlockUpdateMessage& updateMsg : updates) {
+                size_t totalSize = sizeof(protocol::MessageHeader) + sizeof(protocol::BlockUpdateMessage);
+                ENetPacket* packet = enet_packet_create(nullptr, totalSize, ENET_PACKET_FLAG_RELIABLE);
 
-    // Convert needed chunks to a set for fast lookup
-    std::unordered_set<ChunkCoord> neededSet(chunksNeeded.begin(), chunksNeeded.end());
+                protocol::MessageHeader header{};
+                header.type = protocol::MessageType::BlockUpdate;
+                header.payloadSize = sizeof(protocol::BlockUpdateMessage);
+                std::memcpy(packet->data, &header, sizeof(protocol::MessageHeader));
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                std::memcpy(packet->data + sizeof(protocol::MessageHeader), &updateMsg, sizeof(updateMsg));
+                sendPacket(peer, 0, packet);
+            }
+            continue;
+        }
 
-    // Find chunks that need to be sent (not already loaded by player)
-    for (const auto& coord : chunksNeeded) {
-        if (!playerData.loadedChunks.contains(coord)) {
-            chunksToSend.insert(coord);
+        for (size_t first = 0; first < updates.size(); first += MAX_BATCH_ENTRIES) {
+            size_t count = std::min(MAX_BATCH_ENTRIES, updates.size() - first);
+            size_t payloadSize = sizeof(protocol::BlockUpdateBatchMessage) + (count * sizeof(protocol::BlockUpdateMessage));
+            ENetPacket* packet = enet_packet_create(nullptr, sizeof(protocol::MessageHeader) + payloadSize,
+                                                    ENET_PACKET_FLAG_RELIABLE);
+
+            protocol::MessageHeader header{};
+            header.type = protocol::MessageType::BlockUpdateBatch;
+            header.payloadSize = static_cast<uint32_t>(payloadSize);
+            protocol::BlockUpdateBatchMessage batchMsg{};
+            batchMsg.count = static_cast<uint16_t>(count);
+
+            uint8_t* out = packet->data;
+            std::memcpy(out, &header, sizeof(protocol::MessageHeader));
+            out += sizeof(protocol::MessageHeader);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            std::memcpy(out, &batchMsg, sizeof(batchMsg));
+            out += sizeof(batchMsg);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            std::memcpy(out, &updates[first], count * sizeof(protocol::BlockUpdateMessage));
+            sendPacket(peer, 0, packet);
         }
     }
+}
+
+void GameServer::sendPacket(ENetPeer* peer, uint8_t channel, ENetPacket* packet) {
+    protocol::MessageHeader header{};
+    std::memcpy(&header, packet->data, sizeof(protocol::MessageHeader));
+
+    serverNetStats.recordSent(header.type, packet->dataLength);
+    uint32_t index = players.indexOf(peer);
+    if (index != PlayerStore::NONE) {
+        players.getSession(index).netStats.recordSent(header.type, packet->dataLength);
+    }
+
+    enet_peer_send(peer, channel, packet);
+}
 
-    // Find chunks that need to be unloaded (loaded but not needed anymore)
-    for (const auto& coord : playerData.loadedChunks) {
-        if (!neededSet.contains(coord)) {
-            chunksToUnload.insert(coord);
+void GameServer::broadcastPacket(uint8_t channel, ENetPacket* packet) {
+    protocol::MessageHeader header{};
+    std::memcpy(&header, packet->data, sizeof(protocol::MessageHeader));
+
+    for (uint32_t index = 0; index < players.size(); index++) {
+        serverNetStats.recordSent(header.type, packet->dataLength);
+        players.getSession(index).netStats.recordSent(header.type, packet->dataLength);
+    }
+
+    enet_host_broadcast(server, channel, packet);
+}
+
+void GameServer::sendKeepAlives() {
+    protocol::KeepAliveMessage ping{};
+    ping.timestamp = NetworkStats::timestampMicros();
+    ping.isReply = 0;
+
+    size_t totalSize = sizeof(protocol::MessageHeader) + sizeof(protocol::KeepAliveMessage);
+    ENetPacket* pingPacket = enet_packet_create(nullptr, totalSize, 0);  // Unreliable - a lost ping is just a lost sample
+
+    protocol::MessageHeader pingHeader{};
+    pingHeader.type = protocol::MessageType::KeepAlive;
+    pingHeader.payloadSize = sizeof(protocol::KeepAliveMessage);
+    std::memcpy(pingPacket->data, &pingHeader, sizeof(protocol::MessageHeader));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(pingPacket->data + sizeof(protocol::MessageHeader), &ping, sizeof(ping));
+
+    // Channel 1 so pings don't queue behind reliable chunk data
+    broadcastPacket(protocol::CHANNEL_UNRELIABLE, pingPacket);
+}
+
+void GameServer::handleKeepAlive(ENetPeer* peer, const ENetPacket* packet) {
+    if (packet->dataLength < sizeof(protocol::MessageHeader) + sizeof(protocol::KeepAliveMessage)) {
+        return;
+    }
+
+    protocol::KeepAliveMessage msg{};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(&msg, packet->data + sizeof(protocol::MessageHeader), sizeof(msg));
+
+    if (msg.isReply == 0) {
+        // Client is measuring its own RTT - echo the ping back unchanged
+        msg.isReply = 1;
+        ENetPacket* echoPacket = enet_packet_create(packet->data, packet->dataLength, 0);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memcpy(echoPacket->data + sizeof(protocol::MessageHeader), &msg, sizeof(msg));
+        sendPacket(peer, protocol::CHANNEL_UNRELIABLE, echoPacket);
+        return;
+    }
+
+    uint32_t index = players.indexOf(peer);
+    uint64_t sentAt = msg.timestamp;
+    uint64_t now = NetworkStats::timestampMicros();
+    if (index == PlayerStore::NONE || sentAt > now) {
+        return;
+    }
+
+    PlayerSession& session = players.getSession(index);
+    session.netStats.addRttSample(static_cast<float>(now - sentAt) / 1000.0f);
+    adaptChunkSendRate(session);
+}
+
+uint16_t GameServer::computeMoveIntervalMs() const {
+    // Position fan-out is O(players^2), so slow everyone down as the server fills up
+    float interval = MOVE_INTERVAL_MIN_MS * std::max(1.0f, static_cast<float>(players.size()) / 8.0f);
+
+    // Back off further once ticks use more than half their time budget (2x at 75%, 3x at 100%)
+    if (tickLoad > 0.5f) {
+        interval *= 1.0f + ((tickLoad - 0.5f) * 4.0f);
+    }
+
+    return static_cast<uint16_t>(std::clamp(interval, MOVE_INTERVAL_MIN_MS, MOVE_INTERVAL_MAX_MS));
+}
+
+void GameServer::sendMoveRateHints() {
+    uint16_t intervalMs = computeMoveIntervalMs();
+
+    protocol::MoveRateHintMessage hint{};
+    hint.moveIntervalMs = intervalMs;
+
+    for (uint32_t index = 0; index < players.size(); index++) {
+        PlayerSession& session = players.getSession(index);
+        if (!players.hasCapability(index, protocol::CAPABILITY_UNRELIABLE_MOVEMENT) ||
+            session.moveIntervalMs == intervalMs) {
+            continue;
+        }
+
+        size_t totalSize = sizeof(protocol::MessageHeader) + sizeof(protocol::MoveRateHintMessage);
+        ENetPacket* hintPacket = enet_packet_create(nullptr, totalSize, ENET_PACKET_FLAG_RELIABLE);
+
+        protocol::MessageHeader hintHeader{};
+        hintHeader.type = protocol::MessageType::MoveRateHint;
+        hintHeader.payloadSize = sizeof(protocol::MoveRateHintMessage);
+        std::memcpy(hintPacket->data, &hintHeader, sizeof(protocol::MessageHeader));
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memcpy(hintPacket->data + sizeof(protocol::MessageHeader), &hint, sizeof(hint));
+
+        sendPacket(players.getPeer(index), protocol::CHANNEL_RELIABLE, hintPacket);
+        session.moveIntervalMs = intervalMs;
+        LOG_DEBUG("Move rate hint for {}: {} ms (tick load {:.0f}%)",
+                  session.playerName, intervalMs, tickLoad * 100.0f);
+    }
+}
+
+void GameServer::adaptChunkSendRate(PlayerSession& session) {
+    const NetworkStats& stats = session.netStats;
+    float queueingDelay = stats.getRtt() - stats.getMinRtt();
+
+    if (queueingDelay > QUEUE_DELAY_TARGET_MS) {
+        session.chunkSendRate = std::max(session.chunkSendRate * 0.8f, CHUNK_SEND_RATE_MIN);
+    } else if (session.view.getPendingCount() > 0) {
+        session.chunkSendRate = std::min(session.chunkSendRate * 1.25f, CHUNK_SEND_RATE_MAX);
+    }
+}
+
+void GameServer::logNetworkReport() {
+    const NetworkStats::Counter& totalSent = serverNetStats.getTotalSent();
+    const NetworkStats::Counter& totalReceived = serverNetStats.getTotalReceived();
+
+    LOG_INFO("========================================");
+    LOG_INFO("Network statistics ({} players, tick load {:.0f}%, move interval {} ms)",
+             players.size(), tickLoad * 100.0f, computeMoveIntervalMs());
+    LOG_INFO("  Sent: {} packets, {:.1f} KB ({:.1f} KB/s)",
+             totalSent.packets, static_cast<double>(totalSent.bytes) / 1024.0,
+             serverNetStats.getSendRate() / 1024.0f);
+    LOG_INFO("  Received: {} packets, {:.1f} KB ({:.1f} KB/s)",
+             totalReceived.packets, static_cast<double>(totalReceived.bytes) / 1024.0,
+             serverNetStats.getReceiveRate() / 1024.0f);
+
+    LOG_INFO("  {:<22} {:>10} {:>12} {:>10} {:>12}", "Message", "Sent", "Sent KB", "Recv", "Recv KB");
+    for (size_t i = 0; i < NetworkStats::MESSAGE_TYPE_COUNT; i++) {
+        auto type = static_cast<protocol::MessageType>(i);
+        const NetworkStats::Counter& sent = serverNetStats.getSent(type);
+        const NetworkStats::Counter& received = serverNetStats.getReceived(type);
+        if (sent.packets == 0 && received.packets == 0) {
+            continue;
         }
+        LOG_INFO("  {:<22} {:>10} {:>12.1f} {:>10} {:>12.1f}",
+                 NetworkStats::getMessageTypeName(type),
+                 sent.packets, static_cast<double>(sent.bytes) / 1024.0,
+                 received.packets, static_cast<double>(received.bytes) / 1024.0);
+    }
+
+    for (uint32_t index = 0; index < players.size(); index++) {
+        const PlayerSession& session = players.getSession(index);
+        const NetworkStats& stats = session.netStats;
+        LOG_INFO("  {}: RTT {:.1f} ms (min {:.1f}, jitter {:.1f}) | up {:.1f} KB/s down {:.1f} KB/s | "
+                 "chunk budget {:.0f} KB/s, {} pending",
+                 session.playerName, stats.getRtt(), stats.getMinRtt(), stats.getJitter(),
+                 stats.getReceiveRate() / 1024.0f, stats.getSendRate() / 1024.0f,
+                 session.chunkSendRate / 1024.0f, session.view.getPendingCount());
+    }
+    LOG_INFO("========================================");
+}
+
+void GameServer::cleanupNetworking() {
+    if (server != nullptr) {
+        LOG_INFO("Shutting down server networking...");
+        enet_host_destroy(server);
+        server = nullptr;
     }
+}
+
+void GameServer::sendChunksAroundPlayer(ENetPeer* peer, const glm::vec3& position) {
+    ChunkViewWindow& view = players.getSession(players.indexOf(peer)).view;
+    ChunkCoord center = ChunkCoord::fromWorldPos(position);
+
+    // Only the strips leaving the view are visited; entering chunks are picked
+    // up nearest-first by sendQueuedChunks() through the view's send cursor
+    view.recenter(center, viewLeaving);
 
     // Send unload messages
-    for (const auto& coord : chunksToUnload) {
+    for (const auto& coord : viewLeaving) {
         protocol::ChunkUnloadMessage msg{};
         msg.coord = coord;
 
@@ -667,95 +1256,210 @@ void GameServer::sendChunksAroundPlayer(ENetPeer* peer, const glm::vec3& positio
         // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         std::memcpy(packet->data + sizeof(protocol::MessageHeader), &msg, sizeof(msg));
 
-        enet_peer_send(peer, 0, packet);
-        playerData.loadedChunks.erase(coord);
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
-        LOG_DEBUG("Sent unload for chunk ({}, {}, {}) - player at ({:.1f}, {:.1f}, {:.1f})",
-                 coord.x, coord.y, coord.z, position.x, position.y, position.z);
+        sendPacket(peer, 0, packet);
     }
 
-    if (!chunksToUnload.empty()) {
-        LOG_DEBUG("Unloading {} chunks from player", chunksToUnload.size());
-    }
-
-    if (chunksToSend.empty()) {
-        return;
+    if (!viewLeaving.empty()) {
+        LOG_DEBUG("Unloading {} chunks from player", viewLeaving.size());
     }
 
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
-    LOG_DEBUG("Sending {} new chunks to player at ({:.1f}, {:.1f}, {:.1f})",
-              chunksToSend.size(), position.x, position.y, position.z);
+    LOG_DEBUG("View recentered for player at ({:.1f}, {:.1f}, {:.1f}) | {} chunks pending, {} already sent",
+              position.x, position.y, position.z,
+              view.getPendingCount(), view.getSentCount());
+}
 
-    size_t sentCount = 0;
+void GameServer::sendQueuedChunks() {
+    bool sentAny = false;
 
-    for (const auto& coord : chunksToSend) {
-        // Load/generate chunk if needed
-        Chunk& chunk = world->loadChunk(coord);
+    for (uint32_t index = 0; index < players.size(); index++) {
+        PlayerSession& session = players.getSession(index);
+        if (session.view.getPendingCount() == 0) {
+            session.chunkSendCredit = 0.0f;
+            continue;
+        }
 
-        // Serialize chunk
-        std::vector<uint8_t> compressedData;
-        size_t compressedSize = ChunkSerializer::serialize(chunk, compressedData);
+        // Accumulate this tick's share of the budget, capped at two ticks to avoid bursts
+        float perTick = session.chunkSendRate / static_cast<float>(tickRate);
+        session.chunkSendCredit = std::min(session.chunkSendCredit + perTick, perTick * 2.0f);
+
+        ENetPeer* peer = players.getPeer(index);
+        uint32_t capabilities = players.getCapabilities(index);
+        size_t sentCount = 0;
+        if (players.hasCapability(index, protocol::CAPABILITY_COLUMN_BATCH)) {
+            // Whole columns per packet; the budget may go negative by one column and is repaid next tick
+            int32_t chunkX = 0;
+            int32_t chunkZ = 0;
+            while (session.chunkSendCredit > 0.0f &&
+                   session.view.nextUnsentColumn(chunkX, chunkZ, columnLevels)) {
+                session.chunkSendCredit -= static_cast<float>(
+                    sendChunkColumn(peer, capabilities, chunkX, chunkZ, columnLevels));
+                for (int32_t chunkY : columnLevels) {
+                    session.view.markSent(ChunkCoord{chunkX, chunkY, chunkZ});
+                }
+                sentCount += columnLevels.size();
+            }
+        } else {
+            ChunkCoord coord{};
+            while (session.chunkSendCredit > 0.0f && session.view.nextUnsent(coord)) {
+                session.chunkSendCredit -= static_cast<float>(sendChunk(peer, capabilities, coord));
+                session.view.markSent(coord);
+                sentCount++;
+            }
+        }
 
-        // Create packet: header + ChunkDataMessage + compressed data
-        size_t totalSize = sizeof(protocol::MessageHeader) +
-                          sizeof(protocol::ChunkDataMessage) +
-                          compressedSize;
+        if (sentCount > 0) {
+            sentAny = true;
+            LOG_TRACE("Sent {} chunks to {} ({} pending, budget {:.0f} KB/s)",
+                      sentCount, session.playerName, session.view.getPendingCount(),
+                      session.chunkSendRate / 1024.0f);
+        }
+    }
 
-        ENetPacket* packet = enet_packet_create(nullptr, totalSize, ENET_PACKET_FLAG_RELIABLE);
+    // Flush packets immediately
+    if (sentAny) {
+        enet_host_flush(server);
+    }
+}
 
-        // Write message header
-        protocol::MessageHeader header{};
-        header.type = protocol::MessageType::ChunkData;
-        header.payloadSize = sizeof(protocol::ChunkDataMessage) + compressedSize;
-        std::memcpy(packet->data, &header, sizeof(protocol::MessageHeader));
+size_t GameServer::sendChunk(ENetPeer* peer, uint32_t capabilities, const ChunkCoord& coord) {
+    // Load/generate chunk if needed, and light it before it goes out
+    Chunk& chunk = world->loadChunk(coord);
+    world->updateLighting();
 
-        // Write chunk data header
-        protocol::ChunkDataMessage chunkHeader{};
-        chunkHeader.coord = coord;
-        chunkHeader.compressedSize = compressedSize;
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        std::memcpy(packet->data + sizeof(protocol::MessageHeader),
-                   &chunkHeader, sizeof(protocol::ChunkDataMessage));
+    std::vector<uint8_t> compressedData;
+    size_t compressedSize = encodeChunkPayload(chunk, capabilities, compressedData);
+    if ((capabilities & protocol::CAPABILITY_CHUNK_LIGHT) != 0) {
+        ChunkSerializer::serializeLight(chunk.getLight(), compressedData);
+    }
 
-        // Write compressed chunk data
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        std::memcpy(packet->data + sizeof(protocol::MessageHeader) + sizeof(protocol::ChunkDataMessage),
-                   compressedData.data(), compressedSize);
+    // Create packet: header + ChunkDataMessage + compressed data (+ light)
+    size_t totalSize = sizeof(protocol::MessageHeader) +
+                      sizeof(protocol::ChunkDataMessage) +
+                      compressedData.size();
 
-        // Send packet
-        enet_peer_send(peer, 0, packet);
+    ENetPacket* packet = enet_packet_create(nullptr, totalSize, ENET_PACKET_FLAG_RELIABLE);
 
-        // Mark as loaded for this player
-        playerData.loadedChunks.insert(coord);
-        sentCount++;
+    // Write message header
+    protocol::MessageHeader header{};
+    header.type = protocol::MessageType::ChunkData;
+    header.payloadSize = sizeof(protocol::ChunkDataMessage) + compressedData.size();
+    std::memcpy(packet->data, &header, sizeof(protocol::MessageHeader));
+
+    // Write chunk data header
+    protocol::ChunkDataMessage chunkHeader{};
+    chunkHeader.coord = coord;
+    chunkHeader.compressedSize = compressedSize;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(packet->data + sizeof(protocol::MessageHeader),
+               &chunkHeader, sizeof(protocol::ChunkDataMessage));
+
+    // Write compressed chunk data
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(packet->data + sizeof(protocol::MessageHeader) + sizeof(protocol::ChunkDataMessage),
+               compressedData.data(), compressedData.size());
+
+    sendPacket(peer, 0, packet);
+    return totalSize;
+}
+
+size_t GameServer::sendChunkColumn(ENetPeer* peer, uint32_t capabilities, int32_t chunkX, int32_t chunkZ,
+                                   const std::vector<int32_t>& levels) {
+    // The heightmap spans the whole column, so every level is loaded (not just the ones sent)
+    for (int32_t chunkY = world->getMinChunkY(); chunkY <= world->getMaxChunkY(); chunkY++) {
+        world->loadChunk(ChunkCoord{chunkX, chunkY, chunkZ});
     }
+    world->updateLighting();
 
-    // Flush packets immediately
-    enet_host_flush(server);
+    const World& constWorld = *world;
+    ColumnHeightmap::SectionLookup lookup = [&constWorld, chunkX, chunkZ](int32_t chunkY) {
+        return constWorld.getChunk(ChunkCoord{chunkX, chunkY, chunkZ});
+    };
+
+    ColumnHeightmap heightmap;
+    for (int32_t chunkY = world->getMinChunkY(); chunkY <= world->getMaxChunkY(); chunkY++) {
+        if (const Chunk* section = lookup(chunkY)) {
+            heightmap.setSection(*section, lookup);
+        }
+    }
+
+    // Payload: ChunkColumnDataMessage, heightmap, then (ColumnSectionHeader, data[, light size, light]) per section
+    std::vector<uint8_t> payload(sizeof(protocol::ChunkColumnDataMessage));
+    size_t heightmapSize = ChunkSerializer::serializeHeightmap(heightmap.getHeights(), payload);
+
+    std::vector<uint8_t> sectionData;
+    std::vector<uint8_t> lightData;
+    bool sendLight = (capabilities & protocol::CAPABILITY_CHUNK_LIGHT) != 0;
+    for (int32_t chunkY : levels) {
+        Chunk& chunk = world->loadChunk(ChunkCoord{chunkX, chunkY, chunkZ});
+        protocol::ColumnSectionHeader sectionHeader{};
+        sectionHeader.chunkY = chunkY;
+        sectionHeader.dataSize = static_cast<uint32_t>(encodeChunkPayload(chunk, capabilities, sectionData));
+
+        payload.insert(payload.end(),
+                       reinterpret_cast<const uint8_t*>(&sectionHeader),  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                       reinterpret_cast<const uint8_t*>(&sectionHeader) + sizeof(protocol::ColumnSectionHeader));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        payload.insert(payload.end(), sectionData.begin(), sectionData.end());
+
+        if (sendLight) {
+            lightData.clear();
+            auto lightSize = static_cast<uint32_t>(ChunkSerializer::serializeLight(chunk.getLight(), lightData));
+            payload.insert(payload.end(),
+                           reinterpret_cast<const uint8_t*>(&lightSize),  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                           reinterpret_cast<const uint8_t*>(&lightSize) + sizeof(uint32_t));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            payload.insert(payload.end(), lightData.begin(), lightData.end());
+        }
+    }
 
-    LOG_INFO("Sent {} chunks to player", sentCount);
+    protocol::ChunkColumnDataMessage columnHeader{};
+    columnHeader.chunkX = chunkX;
+    columnHeader.chunkZ = chunkZ;
+    columnHeader.sectionCount = static_cast<uint16_t>(levels.size());
+    columnHeader.heightmapSize = static_cast<uint16_t>(heightmapSize);
+    std::memcpy(payload.data(), &columnHeader, sizeof(protocol::ChunkColumnDataMessage));
+
+    size_t totalSize = sizeof(protocol::MessageHeader) + payload.size();
+    ENetPacket* packet = enet_packet_create(nullptr, totalSize, ENET_PACKET_FLAG_RELIABLE);
+
+    protocol::MessageHeader header{};
+    header.type = protocol::MessageType::ChunkColumnData;
+    header.payloadSize = static_cast<uint32_t>(payload.size());
+    std::memcpy(packet->data, &header, sizeof(protocol::MessageHeader));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(packet->data + sizeof(protocol::MessageHeader), payload.data(), payload.size());
+
+    sendPacket(peer, 0, packet);
+    return totalSize;
+}
+
+size_t GameServer::encodeChunkPayload(const Chunk& chunk, uint32_t capabilities, std::vector<uint8_t>& outBuffer) {
+    // All-air sections (most of a tall world) shrink to a one-byte marker
+    if (chunk.isEmpty() && (capabilities & protocol::CAPABILITY_EMPTY_SECTIONS) != 0) {
+        outBuffer.assign(1, protocol::EMPTY_SECTION_MARKER);
+        return outBuffer.size();
+    }
+    if ((capabilities & protocol::CAPABILITY_CHUNK_BRICKS) != 0) {
+        return ChunkSerializer::serializeBricks(chunk, outBuffer);
+    }
+    return ChunkSerializer::serialize(chunk, outBuffer);
 }
 
 void GameServer::updatePlayerChunks() {
     if (players.empty()) {
-        // No players, unload all chunks
+        // No players, every chunk ages out
         size_t unloaded = world->unloadDistantChunks({}, CHUNK_LOAD_RADIUS);
         if (unloaded > 0) {
-            LOG_DEBUG("No players online, unloaded all {} chunks", unloaded);
+            LOG_DEBUG("No players online, unloaded {} idle chunks", unloaded);
         }
         return;
     }
 
-    // Collect all player positions
-    std::vector<glm::vec3> playerPositions;
-    playerPositions.reserve(players.size());
-
-    for (const auto& [peer, playerData] : players) {
-        playerPositions.push_back(playerData.position);
-    }
-
-    // Unload chunks that are far from all players
-    world->unloadDistantChunks(playerPositions, CHUNK_LOAD_RADIUS + 2);  // +2 buffer for hysteresis
+    // Unload chunks that are far from all players (positions are already packed)
+    auto start = std::chrono::steady_clock::now();
+    world->unloadDistantChunks(players.getPositions(), CHUNK_LOAD_RADIUS + 2);  // +2 buffer for hysteresis
+    auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    LOG_TRACE("Chunk retention pass: {} players, {} chunks, {} us",
+              players.size(), world->getLoadedChunkCount(), elapsedUs);
 }
 
 bool GameServer::startTunnel(const std::string& secretKey) {
@@ -909,106 +1613,29 @@ void GameServer::stopTunnel() {
 #endif
 }
 
-// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-bool GameServer::savePlayerData(const PlayerData& playerData) {
-    // Create players directory if it doesn't exist
-    std::filesystem::create_directories("players");
-
-    // Create filename based on player name
-    std::string filename = "players/" + playerData.playerName + ".dat";
-
-    std::ofstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        LOG_ERROR("Failed to save player data for {}", playerData.playerName);
-        return false;
-    }
-
-    // Write player data:
-    // - Name length (uint32_t) + name string
-    // - Position (3 x float)
-    // - Yaw (float)
-    // - Pitch (float)
-    // - Selected hotbar slot (uint32_t)
-    // - Hotbar (9 x ItemStack)
-
-    uint32_t nameLength = static_cast<uint32_t>(playerData.playerName.length());
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    file.write(reinterpret_cast<const char*>(&nameLength), sizeof(uint32_t));
-    // NOLINTNEXTLINE(cppcoreguidelines-narrowing-conversions)
-    file.write(playerData.playerName.c_str(), nameLength);
-
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    file.write(reinterpret_cast<const char*>(&playerData.position), sizeof(glm::vec3));
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    file.write(reinterpret_cast<const char*>(&playerData.yaw), sizeof(float));
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    file.write(reinterpret_cast<const char*>(&playerData.pitch), sizeof(float));
-
-    uint32_t selectedSlot = static_cast<uint32_t>(playerData.selectedHotbarSlot);
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    file.write(reinterpret_cast<const char*>(&selectedSlot), sizeof(uint32_t));
-
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    file.write(reinterpret_cast<const char*>(playerData.hotbar.data()),
-               // NOLINTNEXTLINE(cppcoreguidelines-narrowing-conversions,bugprone-narrowing-conversions)
-               playerData.hotbar.size() * sizeof(ItemStack));
-
-    file.close();
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
-    LOG_INFO("Saved player data for {} at ({:.1f}, {:.1f}, {:.1f})",
-             playerData.playerName, playerData.position.x, playerData.position.y, playerData.position.z);
-    return true;
+void GameServer::savePlayerData(uint32_t index) {
+    const PlayerSession& session = players.getSession(index);
+
+    PlayerProfile profile;
+    profile.playerName = session.playerName;
+    profile.position = players.getPosition(index);
+    profile.yaw = players.getYaw(index);
+    profile.pitch = players.getPitch(index);
+    profile.selectedHotbarSlot = static_cast<uint32_t>(session.selectedHotbarSlot);
+    profile.hotbar = session.hotbar;
+    profiles.save(std::move(profile));
 }
 
-// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-bool GameServer::loadPlayerData(const std::string& playerName, PlayerData& outPlayerData) {
-    std::string filename = "players/" + playerName + ".dat";
-
-    if (!std::filesystem::exists(filename)) {
-        LOG_DEBUG("No saved data found for player {}", playerName);
-        return false;
-    }
-
-    std::ifstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        LOG_ERROR("Failed to load player data for {}", playerName);
-        return false;
+size_t GameServer::saveAllPlayers() {
+    size_t saved = 0;
+    for (uint32_t index = 0; index < players.size(); index++) {
+        const std::string& playerName = players.getSession(index).playerName;
+        if (!playerName.empty() && !playerName.starts_with("Player_")) {
+            savePlayerData(index);
+            saved++;
+        }
     }
-
-    // Read player data
-    uint32_t nameLength = 0;
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    file.read(reinterpret_cast<char*>(&nameLength), sizeof(uint32_t));
-
-    std::string savedName(nameLength, '\0');
-    // NOLINTNEXTLINE(cppcoreguidelines-narrowing-conversions)
-    file.read(savedName.data(), nameLength);
-
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    file.read(reinterpret_cast<char*>(&outPlayerData.position), sizeof(glm::vec3));
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    file.read(reinterpret_cast<char*>(&outPlayerData.yaw), sizeof(float));
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    file.read(reinterpret_cast<char*>(&outPlayerData.pitch), sizeof(float));
-
-    uint32_t selectedSlot = 0;
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    file.read(reinterpret_cast<char*>(&selectedSlot), sizeof(uint32_t));
-    outPlayerData.selectedHotbarSlot = static_cast<size_t>(selectedSlot);
-
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    file.read(reinterpret_cast<char*>(outPlayerData.hotbar.data()),
-              // NOLINTNEXTLINE(cppcoreguidelines-narrowing-conversions,bugprone-narrowing-conversions)
-              outPlayerData.hotbar.size() * sizeof(ItemStack));
-
-    file.close();
-
-    outPlayerData.playerName = savedName;
-
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
-    LOG_INFO("Loaded player data for {} at ({:.1f}, {:.1f}, {:.1f})",
-             playerName, outPlayerData.position.x, outPlayerData.position.y, outPlayerData.position.z);
-    return true;
+    return saved;
 }
 
 } // namespace engine
@@ -0,0 +1,480 @@
+#include "server/PlayerProfileStore.hpp"
+#include "core/Logger.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace engine {
+
+namespace {
+
+constexpr uint32_t PROFILE_LOG_MAGIC = 0x31465250;  // "PRF1"
+constexpr uint64_t LOG_HEADER_BYTES = sizeof(uint32_t);
+constexpr uint32_t RECORD_HEADER_BYTES = 2 * sizeof(uint32_t);  // [payload size][checksum]
+constexpr const char* LOG_FILE_NAME = "profiles.log";
+
+template <typename T>
+void appendValue(std::vector<uint8_t>& out, const T& value) {
+    size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+template <typename T>
+bool readValue(const uint8_t* data, size_t size, size_t& offset, T& outValue) {
+    if (size - offset < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&outValue, data + offset, sizeof(T));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    offset += sizeof(T);
+    return true;
+}
+
+/**
+ * @brief FNV-1a over a record payload, so torn or damaged records are caught
+ */
+uint32_t checksumOf(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t index = 0; index < size; index++) {
+        hash = (hash ^ data[index]) * 16777619u;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    return hash;
+}
+
+// Payload layout (the same as the previous <name>.dat files):
+// - Name length (uint32_t) + name string
+// - Position (3 x float)
+// - Yaw (float)
+// - Pitch (float)
+// - Selected hotbar slot (uint32_t)
+// - Hotbar (9 x ItemStack)
+
+void appendPayload(std::vector<uint8_t>& out, const PlayerProfile& profile) {
+    auto nameLength = static_cast<uint32_t>(profile.playerName.size());
+    appendValue(out, nameLength);
+    out.insert(out.end(), profile.playerName.begin(), profile.playerName.end());
+    appendValue(out, profile.position);
+    appendValue(out, profile.yaw);
+    appendValue(out, profile.pitch);
+    appendValue(out, profile.selectedHotbarSlot);
+    appendValue(out, profile.hotbar);
+}
+
+bool parsePayload(const uint8_t* data, size_t size, PlayerProfile& outProfile) {
+    size_t offset = 0;
+    uint32_t nameLength = 0;
+    if (!readValue(data, size, offset, nameLength) || size - offset < nameLength) {
+        return false;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    outProfile.playerName.assign(reinterpret_cast<const char*>(data + offset), nameLength);
+    offset += nameLength;
+
+    return readValue(data, size, offset, outProfile.position) &&
+           readValue(data, size, offset, outProfile.yaw) &&
+           readValue(data, size, offset, outProfile.pitch) &&
+           readValue(data, size, offset, outProfile.selectedHotbarSlot) &&
+           readValue(data, size, offset, outProfile.hotbar);
+}
+
+/**
+ * @brief Check that a name can't reach outside the directory as a file name
+ */
+bool isSafeFileName(const std::string& name) {
+    return !name.empty() && name != "." && name != ".." &&
+           name.find_first_of("/\\:") == std::string::npos;
+}
+
+} // namespace
+
+PlayerProfileStore::PlayerProfileStore(std::filesystem::path directory)
+    : directory(std::move(directory)), logPath(this->directory / LOG_FILE_NAME) {
+    worker = std::thread([this]() { workerLoop(); });
+}
+
+PlayerProfileStore::~PlayerProfileStore() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void PlayerProfileStore::requestLoad(PlayerHandle player, const std::string& playerName) {
+    Request request;
+    request.kind = Request::Kind::Load;
+    request.player = player;
+    request.profile.playerName = playerName;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(std::move(request));
+    }
+    queueReady.notify_one();
+}
+
+void PlayerProfileStore::save(PlayerProfile profile) {
+    Request request;
+    request.kind = Request::Kind::Save;
+    request.profile = std::move(profile);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(std::move(request));
+    }
+    queueReady.notify_one();
+}
+
+void PlayerProfileStore::compact() {
+    Request request;
+    request.kind = Request::Kind::Compact;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(std::move(request));
+    }
+    queueReady.notify_one();
+}
+
+void PlayerProfileStore::flush() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueDrained.wait(lock, [this]() { return queue.empty() && !busy; });
+}
+
+size_t PlayerProfileStore::pollLoads(std::vector<ProfileLoadResult>& outResults) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    size_t count = finished.size();
+    outResults.insert(outResults.end(), std::make_move_iterator(finished.begin()), std::make_move_iterator(finished.end()));
+    finished.clear();
+    return count;
+}
+
+PlayerProfileStore::Stats PlayerProfileStore::getStats() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return stats;
+}
+
+bool PlayerProfileStore::readProfileFile(const std::filesystem::path& path, PlayerProfile& outProfile) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return parsePayload(data.data(), data.size(), outProfile);
+}
+
+bool PlayerProfileStore::writeProfileFile(const std::filesystem::path& path, const PlayerProfile& profile) {
+    std::vector<uint8_t> data;
+    appendPayload(data, profile);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return file.good();
+}
+
+void PlayerProfileStore::workerLoop() {
+    openLog();
+
+    std::vector<Request> batch;
+    std::vector<ProfileLoadResult> results;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return;  // Stopping, and every queued save is written
+            }
+            batch.swap(queue);
+            busy = true;
+        }
+
+        Stats batchStats;
+        bool compactRequested = false;
+        for (Request& request : batch) {
+            switch (request.kind) {
+                case Request::Kind::Save:
+                    appendRecord(request.profile);
+                    batchStats.saves++;
+                    break;
+                case Request::Kind::Load:
+                    results.push_back(load(request.player, request.profile.playerName, batchStats));
+                    batchStats.loads++;
+                    break;
+                case Request::Kind::Compact:
+                    compactRequested = true;
+                    break;
+            }
+        }
+        writePending();
+
+        // Compact when asked to, or once superseded records outweigh the live ones
+        uint64_t deadBytes = logOpen ? logBytes - LOG_HEADER_BYTES - liveBytes : 0;
+        bool wasteful = logBytes >= COMPACT_MIN_BYTES && deadBytes > liveBytes;
+        if (deadBytes > 0 && (compactRequested || wasteful)) {
+            rewriteLog();
+            batchStats.compactions++;
+        }
+        batch.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            finished.insert(finished.end(), std::make_move_iterator(results.begin()), std::make_move_iterator(results.end()));
+            stats.loads += batchStats.loads;
+            stats.legacyLoads += batchStats.legacyLoads;
+            stats.saves += batchStats.saves;
+            stats.compactions += batchStats.compactions;
+            stats.batches++;
+            stats.logBytes = logBytes;
+            stats.liveBytes = liveBytes;
+            stats.profileCount = index.size();
+            busy = false;
+        }
+        queueDrained.notify_all();
+        results.clear();
+    }
+}
+
+void PlayerProfileStore::openLog() {
+    logOpen = false;
+    index.clear();
+    logBytes = 0;
+    liveBytes = 0;
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (!std::filesystem::exists(logPath, error)) {
+        std::ofstream create(logPath, std::ios::binary);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        create.write(reinterpret_cast<const char*>(&PROFILE_LOG_MAGIC), sizeof(PROFILE_LOG_MAGIC));
+        if (!create.good()) {
+            LOG_ERROR("Failed to create player profile log {}", logPath.string());
+            return;
+        }
+    }
+
+    log.open(logPath, std::ios::in | std::ios::out | std::ios::binary);
+    uint32_t magic = 0;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    log.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    if (!log.is_open() || !log.good() || magic != PROFILE_LOG_MAGIC) {
+        LOG_ERROR("Failed to open player profile log {} (profiles will not be saved)", logPath.string());
+        log.close();
+        return;
+    }
+
+    // Index every record; the newest of each name wins
+    uint64_t fileBytes = std::filesystem::file_size(logPath, error);
+    uint64_t offset = LOG_HEADER_BYTES;
+    PlayerProfile profile;
+    while (fileBytes - offset >= RECORD_HEADER_BYTES) {
+        uint32_t header[2] = {0, 0};  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        log.read(reinterpret_cast<char*>(header), sizeof(header));
+        uint32_t payloadBytes = header[0];
+        if (!log.good() || payloadBytes > MAX_RECORD_BYTES || fileBytes - offset - RECORD_HEADER_BYTES < payloadBytes) {
+            break;
+        }
+        recordBuffer.resize(payloadBytes);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        log.read(reinterpret_cast<char*>(recordBuffer.data()), payloadBytes);
+        if (!log.good() || checksumOf(recordBuffer.data(), payloadBytes) != header[1] ||
+            !parsePayload(recordBuffer.data(), payloadBytes, profile)) {
+            break;
+        }
+
+        uint32_t recordBytes = RECORD_HEADER_BYTES + payloadBytes;
+        auto [entry, inserted] = index.try_emplace(profile.playerName, RecordLocation{offset, recordBytes});
+        if (!inserted) {
+            liveBytes -= entry->second.size;
+            entry->second = RecordLocation{offset, recordBytes};
+        }
+        liveBytes += recordBytes;
+        offset += recordBytes;
+    }
+
+    // Cut off a record torn by a crash mid-write, so appends follow the last good one
+    if (offset < fileBytes) {
+        LOG_WARN("Player profile log {} has {} damaged bytes at the end, truncating",
+                 logPath.string(), fileBytes - offset);
+        log.close();
+        std::filesystem::resize_file(logPath, offset, error);
+        log.open(logPath, std::ios::in | std::ios::out | std::ios::binary);
+        if (error || !log.is_open()) {
+            LOG_ERROR("Failed to truncate player profile log {} (profiles will not be saved)", logPath.string());
+            log.close();
+            index.clear();
+            liveBytes = 0;
+            return;
+        }
+    }
+    log.clear();
+
+    logBytes = offset;
+    logOpen = true;
+    LOG_INFO("Opened player profile log: {} profiles, {:.1f} KB ({:.1f} KB live)",
+             index.size(), static_cast<double>(logBytes) / 1024.0, static_cast<double>(liveBytes) / 1024.0);
+}
+
+void PlayerProfileStore::appendRecord(const PlayerProfile& profile) {
+    if (!logOpen) {
+        LOG_ERROR("Dropping save for {}: player profile log is not open", profile.playerName);
+        return;
+    }
+
+    size_t recordStart = writeBuffer.size();
+    appendValue(writeBuffer, uint32_t{0});
+    appendValue(writeBuffer, uint32_t{0});
+    appendPayload(writeBuffer, profile);
+
+    // Fill in the header now the payload size is known
+    auto payloadBytes = static_cast<uint32_t>(writeBuffer.size() - recordStart - RECORD_HEADER_BYTES);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    uint32_t checksum = checksumOf(writeBuffer.data() + recordStart + RECORD_HEADER_BYTES, payloadBytes);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(writeBuffer.data() + recordStart, &payloadBytes, sizeof(uint32_t));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(writeBuffer.data() + recordStart + sizeof(uint32_t), &checksum, sizeof(uint32_t));
+
+    RecordLocation location{logBytes + recordStart, RECORD_HEADER_BYTES + payloadBytes};
+    auto [entry, inserted] = index.try_emplace(profile.playerName, location);
+    if (!inserted) {
+        liveBytes -= entry->second.size;
+        entry->second = location;
+    }
+    liveBytes += location.size;
+}
+
+void PlayerProfileStore::writePending() {
+    if (writeBuffer.empty()) {
+        return;
+    }
+
+    log.clear();
+    log.seekp(static_cast<std::streamoff>(logBytes));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    log.write(reinterpret_cast<const char*>(writeBuffer.data()), static_cast<std::streamsize>(writeBuffer.size()));
+    log.flush();
+    size_t written = writeBuffer.size();
+    writeBuffer.clear();
+
+    if (!log.good()) {
+        // The index points at records that may not exist, so rebuild it from what reached the disk
+        LOG_ERROR("Failed to write {} bytes to player profile log {}", written, logPath.string());
+        log.close();
+        openLog();
+        return;
+    }
+    logBytes += written;
+}
+
+ProfileLoadResult PlayerProfileStore::load(PlayerHandle player, const std::string& playerName, Stats& batchStats) {
+    ProfileLoadResult result;
+    result.player = player;
+    result.playerName = playerName;
+
+    // Saves earlier in the batch have to be readable first
+    writePending();
+
+    auto entry = index.find(playerName);
+    if (entry != index.end()) {
+        result.found = readRecord(entry->second, result.profile);
+        if (!result.found) {
+            LOG_ERROR("Player profile record for {} is damaged", playerName);
+        }
+        return result;
+    }
+
+    // Not saved since the log was introduced: try the previous format and carry it over
+    std::error_code error;
+    std::filesystem::path legacyPath = directory / (playerName + ".dat");
+    if (isSafeFileName(playerName) && std::filesystem::exists(legacyPath, error) &&
+        readProfileFile(legacyPath, result.profile)) {
+        result.profile.playerName = playerName;
+        result.found = true;
+        batchStats.legacyLoads++;
+        appendRecord(result.profile);
+        LOG_INFO("Migrated player profile {} from {}", playerName, legacyPath.string());
+    }
+    return result;
+}
+
+bool PlayerProfileStore::readRecord(const RecordLocation& location, PlayerProfile& outProfile) {
+    if (!readRecordBytes(location)) {
+        return false;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return parsePayload(recordBuffer.data() + RECORD_HEADER_BYTES, location.size - RECORD_HEADER_BYTES, outProfile);
+}
+
+bool PlayerProfileStore::readRecordBytes(const RecordLocation& location) {
+    recordBuffer.resize(location.size);
+    log.clear();
+    log.seekg(static_cast<std::streamoff>(location.offset));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    log.read(reinterpret_cast<char*>(recordBuffer.data()), location.size);
+    if (!log.good()) {
+        return false;
+    }
+
+    uint32_t checksum = 0;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memcpy(&checksum, recordBuffer.data() + sizeof(uint32_t), sizeof(uint32_t));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return checksumOf(recordBuffer.data() + RECORD_HEADER_BYTES, location.size - RECORD_HEADER_BYTES) == checksum;
+}
+
+void PlayerProfileStore::rewriteLog() {
+    uint64_t oldBytes = logBytes;
+    std::filesystem::path tempPath = logPath;
+    tempPath += ".tmp";
+
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    out.write(reinterpret_cast<const char*>(&PROFILE_LOG_MAGIC), sizeof(PROFILE_LOG_MAGIC));
+
+    // Copy the newest record of each name; a damaged one is dropped rather than kept
+    std::unordered_map<std::string, RecordLocation> compacted;
+    compacted.reserve(index.size());
+    uint64_t offset = LOG_HEADER_BYTES;
+    for (const auto& [playerName, location] : index) {
+        if (!readRecordBytes(location)) {
+            LOG_ERROR("Dropping damaged player profile record for {} while compacting", playerName);
+            continue;
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        out.write(reinterpret_cast<const char*>(recordBuffer.data()), location.size);
+        compacted.emplace(playerName, RecordLocation{offset, location.size});
+        offset += location.size;
+    }
+    out.close();
+
+    std::error_code error;
+    if (out.fail()) {
+        LOG_ERROR("Failed to write compacted player profile log {}", tempPath.string());
+        std::filesystem::remove(tempPath, error);
+        return;
+    }
+
+    log.close();
+    std::filesystem::rename(tempPath, logPath, error);
+    if (error) {
+        LOG_ERROR("Failed to replace player profile log {}: {}", logPath.string(), error.message());
+        std::filesystem::remove(tempPath, error);
+        openLog();
+        return;
+    }
+    log.open(logPath, std::ios::in | std::ios::out | std::ios::binary);
+    if (!log.is_open()) {
+        openLog();
+        return;
+    }
+
+    index = std::move(compacted);
+    logBytes = offset;
+    liveBytes = offset - LOG_HEADER_BYTES;
+    LOG_INFO("Compacted player profile log: {:.1f} KB -> {:.1f} KB ({} profiles)",
+             static_cast<double>(oldBytes) / 1024.0, static_cast<double>(logBytes) / 1024.0, index.size());
+}
+
+} // namespace engine
@@ -0,0 +1,112 @@
+#include "server/PlayerStore.hpp"
+
+#include <utility>
+
+namespace engine {
+
+namespace {
+
+constexpr glm::vec3 DEFAULT_POSITION{0.0f, 5.0f, 0.0f};  // Spawn at Y=5
+constexpr float DEFAULT_YAW = -90.0f;
+constexpr float DEFAULT_PITCH = -20.0f;
+
+} // namespace
+
+PlayerHandle PlayerStore::add(ENetPeer* peer, uint32_t playerId) {
+    remove(find(peer));
+
+    uint32_t slot = 0;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slotIndices.size());
+        slotIndices.push_back(NONE);
+        slotGenerations.push_back(0);
+    }
+
+    auto index = static_cast<uint32_t>(peers.size());
+    peers.push_back(peer);
+    playerIds.push_back(playerId);
+    positions.push_back(DEFAULT_POSITION);
+    yaws.push_back(DEFAULT_YAW);
+    pitches.push_back(DEFAULT_PITCH);
+    capabilities.push_back(0);
+    sessions.emplace_back();
+    indexSlots.push_back(slot);
+    slotIndices[slot] = index;
+
+    PlayerHandle handle{slot, slotGenerations[slot]};
+    peerHandles[peer] = handle;
+    grid.insert(slot, DEFAULT_POSITION);
+    return handle;
+}
+
+bool PlayerStore::remove(PlayerHandle handle) {
+    uint32_t index = indexOf(handle);
+    if (index == NONE) {
+        return false;
+    }
+
+    peerHandles.erase(peers[index]);
+    grid.remove(handle.slot);
+
+    // Move the last player into the hole so the arrays stay dense
+    auto last = static_cast<uint32_t>(peers.size() - 1);
+    if (index != last) {
+        peers[index] = peers[last];
+        playerIds[index] = playerIds[last];
+        positions[index] = positions[last];
+        yaws[index] = yaws[last];
+        pitches[index] = pitches[last];
+        capabilities[index] = capabilities[last];
+        sessions[index] = std::move(sessions[last]);
+        indexSlots[index] = indexSlots[last];
+        slotIndices[indexSlots[index]] = index;
+    }
+    peers.pop_back();
+    playerIds.pop_back();
+    positions.pop_back();
+    yaws.pop_back();
+    pitches.pop_back();
+    capabilities.pop_back();
+    sessions.pop_back();
+    indexSlots.pop_back();
+
+    slotIndices[handle.slot] = NONE;
+    slotGenerations[handle.slot]++;
+    freeSlots.push_back(handle.slot);
+    return true;
+}
+
+PlayerHandle PlayerStore::find(ENetPeer* peer) const {
+    auto handleIt = peerHandles.find(peer);
+    return handleIt != peerHandles.end() ? handleIt->second : PlayerHandle{};
+}
+
+uint32_t PlayerStore::indexOf(PlayerHandle handle) const {
+    if (handle.slot >= slotIndices.size() || slotGenerations[handle.slot] != handle.generation) {
+        return NONE;
+    }
+    return slotIndices[handle.slot];
+}
+
+void PlayerStore::findNear(const glm::vec3& center, float radius, std::vector<uint32_t>& outIndices) const {
+    size_t first = outIndices.size();
+    grid.queryRadius(center, radius, outIndices);
+    slotsToIndices(outIndices, first);
+}
+
+void PlayerStore::findInBox(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& outIndices) const {
+    size_t first = outIndices.size();
+    grid.queryBox(min, max, outIndices);
+    slotsToIndices(outIndices, first);
+}
+
+void PlayerStore::slotsToIndices(std::vector<uint32_t>& ids, size_t first) const {
+    for (size_t entry = first; entry < ids.size(); entry++) {
+        ids[entry] = slotIndices[ids[entry]];
+    }
+}
+
+} // namespace engine
@@ -0,0 +1,305 @@
+#include "server/RegionScheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <utility>
+
+namespace engine {
+
+namespace {
+
+constexpr auto CHUNK_EXTENT = static_cast<int32_t>(CHUNK_SIZE);
+
+int32_t floorDiv(int32_t value, int32_t divisor) {
+    return (value >= 0) ? (value / divisor) : ((value - divisor + 1) / divisor);
+}
+
+ChunkCoord chunkOf(const glm::ivec3& worldPos) {
+    return ChunkCoord{floorDiv(worldPos.x, CHUNK_EXTENT), floorDiv(worldPos.y, CHUNK_EXTENT), floorDiv(worldPos.z, CHUNK_EXTENT)};
+}
+
+/**
+ * @brief Colour of a region: regions of one colour are never adjacent, diagonals included
+ */
+uint32_t colorOf(const ChunkCoord& region) {
+    return static_cast<uint32_t>(region.x & 1) | (static_cast<uint32_t>(region.z & 1) << 1);
+}
+
+uint32_t indexOf(const glm::ivec3& local) {
+    return Chunk::getIndex(static_cast<uint32_t>(local.x), static_cast<uint32_t>(local.y), static_cast<uint32_t>(local.z));
+}
+
+uint64_t microsSince(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace
+
+const ChunkCoord& RegionScheduler::RegionContext::getRegion() const {
+    return region.coord;
+}
+
+const std::vector<ChunkCoord>& RegionScheduler::RegionContext::getChunks() const {
+    return region.ticking;
+}
+
+BlockType RegionScheduler::RegionContext::getBlock(const glm::ivec3& worldPos) {
+    glm::ivec3 local;
+    const Chunk* chunk = findChunk(worldPos, local);
+    if (chunk == nullptr) {
+        return BlockType::Air;
+    }
+    return chunk->getBlockData()[indexOf(local)].type;
+}
+
+bool RegionScheduler::RegionContext::canRead(const glm::ivec3& worldPos) {
+    glm::ivec3 local;
+    return findChunk(worldPos, local) != nullptr;
+}
+
+void RegionScheduler::RegionContext::setBlock(const glm::ivec3& worldPos, BlockType type) {
+    glm::ivec3 local;
+    Chunk* chunk = findChunk(worldPos, local);
+    if (chunk == nullptr || regionOf(lastCoord) != region.coord) {
+        region.deferred.push_back(DeferredEdit{worldPos, type});
+        return;
+    }
+
+    BlockType previous = chunk->getBlockData()[indexOf(local)].type;
+    if (previous != type) {
+        chunk->setBlock(static_cast<uint32_t>(local.x), static_cast<uint32_t>(local.y), static_cast<uint32_t>(local.z), Block{type});
+        region.changes.push_back(BlockChange{worldPos, type, previous});
+    }
+}
+
+Chunk* RegionScheduler::RegionContext::findChunk(const glm::ivec3& worldPos, glm::ivec3& outLocal) {
+    ChunkCoord coord = chunkOf(worldPos);
+    outLocal = worldPos - (glm::ivec3(coord.x, coord.y, coord.z) * CHUNK_EXTENT);
+    if (hasLast && coord == lastCoord) {
+        return lastChunk;
+    }
+
+    lastCoord = coord;
+    lastChunk = nullptr;
+    hasLast = true;
+    ChunkCoord target = regionOf(coord);
+    if (std::abs(target.x - region.coord.x) <= 1 && std::abs(target.z - region.coord.z) <= 1) {
+        auto chunkIt = scheduler.resolved.find(coord);
+        if (chunkIt != scheduler.resolved.end()) {
+            lastChunk = chunkIt->second;
+        }
+    }
+    return lastChunk;
+}
+
+RegionScheduler::RegionScheduler(ChunkLookup lookup, size_t workerCount)
+    : lookup(std::move(lookup)),
+      workerCount(workerCount > 0 ? workerCount : std::max(1u, std::thread::hardware_concurrency())) {}
+
+RegionScheduler::~RegionScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        stopping = true;
+    }
+    workReady.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void RegionScheduler::addChunk(const ChunkCoord& coord) {
+    ChunkCoord regionCoord = regionOf(coord);
+    auto [regionIt, inserted] = regions.try_emplace(regionCoord);
+    Region& region = regionIt->second;
+    if (inserted) {
+        region.coord = regionCoord;
+        colorsStale = true;
+    }
+    if (std::find(region.chunks.begin(), region.chunks.end(), coord) == region.chunks.end()) {
+        region.chunks.push_back(coord);
+    }
+}
+
+void RegionScheduler::removeChunk(const ChunkCoord& coord) {
+    auto regionIt = regions.find(regionOf(coord));
+    if (regionIt == regions.end()) {
+        return;
+    }
+
+    std::vector<ChunkCoord>& chunks = regionIt->second.chunks;
+    auto chunkIt = std::find(chunks.begin(), chunks.end(), coord);
+    if (chunkIt != chunks.end()) {
+        *chunkIt = chunks.back();
+        chunks.pop_back();
+    }
+    if (chunks.empty()) {
+        regions.erase(regionIt);
+        colorsStale = true;
+    }
+}
+
+void RegionScheduler::tick(const RegionTask& task, std::vector<BlockChange>& outChanges) {
+    if (regions.empty()) {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (colorsStale) {
+        rebuildColors();
+    }
+
+    // Look every chunk up here, so workers only read the resolved table
+    resolved.clear();
+    for (auto& [regionCoord, region] : regions) {
+        region.ticking.clear();
+        for (const ChunkCoord& coord : region.chunks) {
+            if (Chunk* chunk = lookup(coord)) {
+                resolved.emplace(coord, chunk);
+                region.ticking.push_back(coord);
+            }
+        }
+        region.changes.clear();
+        region.deferred.clear();
+    }
+
+    for (const std::vector<Region*>& color : colors) {
+        runBatch(color, task);
+    }
+
+    // Collect in region order, then apply the buffered writes in the same order
+    for (const std::vector<Region*>& color : colors) {
+        for (const Region* region : color) {
+            outChanges.insert(outChanges.end(), region->changes.begin(), region->changes.end());
+        }
+    }
+    for (const std::vector<Region*>& color : colors) {
+        for (const Region* region : color) {
+            for (const DeferredEdit& edit : region->deferred) {
+                if (!applyEdit(edit.position, edit.type, outChanges)) {
+                    stats.droppedEdits++;
+                }
+            }
+            stats.crossRegionEdits += region->deferred.size();
+        }
+    }
+
+    uint64_t elapsedUs = microsSince(start);
+    stats.ticks++;
+    stats.regionTicks += regions.size();
+    stats.tickMicrosTotal += elapsedUs;
+    stats.tickMicrosMax = std::max(stats.tickMicrosMax, elapsedUs);
+}
+
+ChunkCoord RegionScheduler::regionOf(const ChunkCoord& coord) {
+    return ChunkCoord{floorDiv(coord.x, REGION_CHUNKS), 0, floorDiv(coord.z, REGION_CHUNKS)};
+}
+
+void RegionScheduler::rebuildColors() {
+    for (std::vector<Region*>& color : colors) {
+        color.clear();
+    }
+    for (auto& [regionCoord, region] : regions) {
+        colors[colorOf(regionCoord)].push_back(&region);
+    }
+    for (std::vector<Region*>& color : colors) {
+        std::sort(color.begin(), color.end(), [](const Region* lhs, const Region* rhs) {
+            return lhs->coord.z != rhs->coord.z ? lhs->coord.z < rhs->coord.z : lhs->coord.x < rhs->coord.x;
+        });
+    }
+    colorsStale = false;
+}
+
+void RegionScheduler::runBatch(const std::vector<Region*>& regionsToTick, const RegionTask& task) {
+    if (workerCount <= 1 || regionsToTick.size() <= 1) {
+        for (Region* region : regionsToTick) {
+            RegionContext context(*this, *region);
+            task(context);
+        }
+        return;
+    }
+
+    if (workers.empty()) {
+        workers.reserve(workerCount - 1);
+        for (size_t worker = 1; worker < workerCount; worker++) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        batch = &regionsToTick;
+        batchTask = &task;
+        nextRegion.store(0);
+        busyWorkers = workers.size();
+        batchNumber++;
+    }
+    workReady.notify_all();
+
+    drainBatch();
+
+    std::unique_lock<std::mutex> lock(poolMutex);
+    workDone.wait(lock, [this]() { return busyWorkers == 0; });
+    batch = nullptr;
+    batchTask = nullptr;
+    if (failure) {
+        std::exception_ptr error = std::exchange(failure, nullptr);
+        lock.unlock();
+        std::rethrow_exception(error);
+    }
+}
+
+void RegionScheduler::drainBatch() {
+    for (size_t index = nextRegion.fetch_add(1); index < batch->size(); index = nextRegion.fetch_add(1)) {
+        try {
+            RegionContext context(*this, *(*batch)[index]);
+            (*batchTask)(context);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+        }
+    }
+}
+
+void RegionScheduler::workerLoop() {
+    uint64_t lastBatch = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(poolMutex);
+            workReady.wait(lock, [this, lastBatch]() { return stopping || batchNumber != lastBatch; });
+            if (stopping) {
+                return;
+            }
+            lastBatch = batchNumber;
+        }
+
+        drainBatch();
+
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (--busyWorkers == 0) {
+            workDone.notify_one();
+        }
+    }
+}
+
+bool RegionScheduler::applyEdit(const glm::ivec3& worldPos, BlockType type, std::vector<BlockChange>& outChanges) {
+    ChunkCoord coord = chunkOf(worldPos);
+    auto chunkIt = resolved.find(coord);
+    if (chunkIt == resolved.end()) {
+        return false;
+    }
+
+    Chunk& chunk = *chunkIt->second;
+    glm::ivec3 local = worldPos - (glm::ivec3(coord.x, coord.y, coord.z) * CHUNK_EXTENT);
+    BlockType previous = chunk.getBlockData()[indexOf(local)].type;
+    if (previous != type) {
+        chunk.setBlock(static_cast<uint32_t>(local.x), static_cast<uint32_t>(local.y), static_cast<uint32_t>(local.z), Block{type});
+        outChanges.push_back(BlockChange{worldPos, type, previous});
+    }
+    return true;
+}
+
+} // namespace engine
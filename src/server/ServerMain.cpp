@@ -2,13 +2,17 @@
 #include "core/CrashHandler.hpp"
 #include "server/GameServer.hpp"
 #include "server/World.hpp"
+#include "server/WorldSettings.hpp"
 
 #include <exception>
+#include <stdexcept>
 #include <csignal>
 #include <atomic>
 #include <thread>
+#include <functional>
 #include <iostream>
 #include <string>
+#include <vector>
 
 // Global flag for graceful shutdown
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables,readability-identifier-naming)
@@ -21,6 +25,89 @@ void signalHandler(int signal) {
     }
 }
 
+/**
+ * @brief A server console command
+ */
+struct ConsoleCommand {
+    std::string name;         ///< Words that select the command, without the leading slash
+    std::string usage;        ///< Arguments, as shown by /help
+    std::string description;  ///< Shown by /help
+    std::function<void(const std::string&)> run;  ///< Called with the rest of the line
+};
+
+/**
+ * @brief Strip leading and trailing whitespace
+ */
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\n\r");
+    if (first == std::string::npos) {
+        return "";
+    }
+    return text.substr(first, text.find_last_not_of(" \t\n\r") - first + 1);
+}
+
+/**
+ * @brief Find the command a console line starts with
+ * @param line Trimmed line, with or without a leading slash
+ * @param outArguments Set to the rest of the line after the command's name (trimmed)
+ * @return The command, or nullptr if none matches
+ */
+const ConsoleCommand* findCommand(const std::vector<ConsoleCommand>& commands, const std::string& line,
+                                  std::string& outArguments) {
+    std::string text = line.starts_with('/') ? line.substr(1) : line;
+    for (const ConsoleCommand& command : commands) {
+        if (text == command.name) {
+            outArguments.clear();
+            return &command;
+        }
+        if (text.starts_with(command.name + " ")) {
+            outArguments = trim(text.substr(command.name.size()));
+            return &command;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Parse the command line into world settings
+ *
+ * Options:
+ *   --world-height <min>:<max> lowest and highest chunk level (default -1:1)
+ *   --chunk-memory <MB>        resident chunk memory budget
+ *   --compress-cold <seconds>  compress chunks unused for this long
+ * @throws std::invalid_argument on an unknown option or a missing or malformed value
+ */
+engine::WorldSettings parseWorldSettings(int argc, char* argv[]) {
+    engine::WorldSettings settings;
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (option != "--world-height" && option != "--chunk-memory" && option != "--compress-cold") {
+            throw std::invalid_argument("Unknown option " + option);
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument(option + " expects a value");
+        }
+        std::string value = argv[++i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        if (option == "--world-height") {
+            size_t separator = value.find(':');
+            if (separator == std::string::npos) {
+                throw std::invalid_argument("--world-height expects <min>:<max> chunk levels");
+            }
+            settings.minChunkY = std::stoi(value.substr(0, separator));
+            settings.maxChunkY = std::stoi(value.substr(separator + 1));
+        } else if (option == "--chunk-memory") {
+            size_t budgetMb = std::stoul(value);
+            settings.memoryBudgetBytes = budgetMb * 1024 * 1024;
+            LOG_INFO("Chunk memory budget: {} MB", budgetMb);
+        } else {
+            settings.coldCompressionDelay = std::stof(value);
+            LOG_INFO("Compressing chunks unused for {:.0f} s", settings.coldCompressionDelay);
+        }
+    }
+    return settings;
+}
+
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 int main(int argc, char* argv[]) {
     // Initialize infrastructure
@@ -34,81 +121,79 @@ int main(int argc, char* argv[]) {
     LOG_INFO("=== Tidal Engine Dedicated Server Starting ===");
 
     try {
+        // Options are applied as the world is created, before any chunk is generated or loaded
+        engine::WorldSettings worldSettings = parseWorldSettings(argc, argv);
+
         // Create server (40 TPS for smooth automation)
-        engine::GameServer server(25565, 40.0);
+        engine::GameServer server(25565, 40.0, worldSettings);
 
         // Run server in a separate thread so we can check for shutdown signal
         std::thread serverThread([&server]() {
             server.run();
         });
 
+        // Console commands, with or without the leading slash
+        std::vector<ConsoleCommand> commands;
+        commands = {
+            {"stop", "", "Stop the server", [](const std::string&) {
+                LOG_INFO("Stop command received");
+                g_shutdownRequested = true;
+            }},
+            {"save", "", "Save world to disk", [&server](const std::string&) {
+                LOG_INFO("Saving world...");
+                size_t chunks = server.getWorld()->saveWorld("world");
+                LOG_INFO("Saved {} chunks", chunks);
+            }},
+            {"netstats", "", "Show RTT, bandwidth and per-message traffic", [&server](const std::string&) {
+                server.requestNetworkReport();
+            }},
+            {"memstats", "", "Show chunk memory, eviction and reload rates", [&server](const std::string&) {
+                server.getWorld()->logMemoryReport();
+            }},
+            {"lightstats", "", "Show relight counts and timings", [&server](const std::string&) {
+                server.getWorld()->logLightReport();
+            }},
+            {"tunnel start", " [secret-key]", "Start playit.gg tunnel", [&server](const std::string& secretKey) {
+                server.startTunnel(secretKey);
+            }},
+            {"tunnel stop", "", "Stop playit.gg tunnel", [&server](const std::string&) {
+                server.stopTunnel();
+            }},
+            {"tunnel status", "", "Check tunnel status", [&server](const std::string&) {
+                if (server.isTunnelRunning()) {
+                    LOG_INFO("Tunnel is currently running");
+                    LOG_INFO("Check https://playit.gg/account for tunnel address");
+                } else {
+                    LOG_INFO("Tunnel is not running");
+                }
+            }},
+            {"help", "", "Show this help message", [&commands](const std::string&) {
+                LOG_INFO("========================================");
+                LOG_INFO("Available commands:");
+                for (const ConsoleCommand& command : commands) {
+                    LOG_INFO("  /{}{} - {}", command.name, command.usage, command.description);
+                }
+                LOG_INFO("========================================");
+            }},
+        };
+
         // Input thread to listen for commands
-        // NOLINTNEXTLINE(readability-function-cognitive-complexity)
         std::thread inputThread([&]() {
             std::string line;
             while (!g_shutdownRequested && std::getline(std::cin, line)) {
-                // Trim whitespace
-                line.erase(0, line.find_first_not_of(" \t\n\r"));
-                line.erase(line.find_last_not_of(" \t\n\r") + 1);
-
+                line = trim(line);
                 if (line.empty()) {
                     continue;
                 }
 
-                // Handle commands
-                if (line == "/stop" || line == "stop") {
-                    LOG_INFO("Stop command received");
-                    g_shutdownRequested = true;
-                    break;
-                }
-                if (line == "/tunnel stop" || line == "tunnel stop") {
-                    server.stopTunnel();
-                }
-                if (line.starts_with("/tunnel start") || line.starts_with("tunnel start")) {
-                    // Extract secret key if provided
-                    size_t spacePos = line.find(' ', line.find("start") + 5);
-                    std::string secretKey;
-                    if (spacePos != std::string::npos) {
-                        secretKey = line.substr(spacePos + 1);
-                        // Trim whitespace from key
-                        secretKey.erase(0, secretKey.find_first_not_of(" \t\n\r"));
-                        secretKey.erase(secretKey.find_last_not_of(" \t\n\r") + 1);
-                    }
-                    server.startTunnel(secretKey);
-                }
-                if (line == "/tunnel status" || line == "tunnel status") {
-                    if (server.isTunnelRunning()) {
-                        LOG_INFO("Tunnel is currently running");
-                        LOG_INFO("Check https://playit.gg/account for tunnel address");
-                    } else {
-                        LOG_INFO("Tunnel is not running");
-                    }
-                }
-                if (line == "/save" || line == "save") {
-                    LOG_INFO("Saving world...");
-                    size_t chunks = server.getWorld()->saveWorld("world");
-                    LOG_INFO("Saved {} chunks", chunks);
-                }
-                if (line == "/help" || line == "help") {
-                    LOG_INFO("========================================");
-                    LOG_INFO("Available commands:");
-                    LOG_INFO("  /stop - Stop the server");
-                    LOG_INFO("  /save - Save world to disk");
-                    LOG_INFO("  /tunnel start [secret-key] - Start playit.gg tunnel");
-                    LOG_INFO("  /tunnel stop - Stop playit.gg tunnel");
-                    LOG_INFO("  /tunnel status - Check tunnel status");
-                    LOG_INFO("  /help - Show this help message");
-                    LOG_INFO("========================================");
-                }
-                if (line != "/stop" && line != "stop" &&
-                    line != "/tunnel stop" && line != "tunnel stop" &&
-                    !line.starts_with("/tunnel start") && !line.starts_with("tunnel start") &&
-                    line != "/tunnel status" && line != "tunnel status" &&
-                    line != "/save" && line != "save" &&
-                    line != "/help" && line != "help") {
+                std::string arguments;
+                const ConsoleCommand* command = findCommand(commands, line, arguments);
+                if (command == nullptr) {
                     LOG_WARN("Unknown command: {}", line);
                     LOG_INFO("Type '/help' for available commands");
+                    continue;
                 }
+                command->run(arguments);
             }
         });
 
@@ -0,0 +1,166 @@
+#include "server/SpatialHashGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine {
+
+SpatialHashGrid::SpatialHashGrid(float cellSize)
+    : cellSize(cellSize), inverseCellSize(1.0f / cellSize) {}
+
+void SpatialHashGrid::insert(uint32_t id, const glm::vec3& position) {
+    if (contains(id)) {
+        move(id, position);
+        return;
+    }
+
+    if (id >= locations.size()) {
+        locations.resize(static_cast<size_t>(id) + 1);
+    }
+    uint64_t key = cellKeyOf(position);
+    std::vector<Member>& cell = cells[key];
+    locations[id] = Location{key, static_cast<uint32_t>(cell.size())};
+    cell.push_back(Member{position, id});
+    entityCount++;
+}
+
+void SpatialHashGrid::move(uint32_t id, const glm::vec3& position) {
+    if (!contains(id)) {
+        insert(id, position);
+        return;
+    }
+
+    Location& location = locations[id];
+    uint64_t key = cellKeyOf(position);
+    if (key == location.cell) {
+        cells.find(key)->second[location.slot].position = position;
+        return;
+    }
+
+    unlink(location);
+    std::vector<Member>& cell = cells[key];
+    location = Location{key, static_cast<uint32_t>(cell.size())};
+    cell.push_back(Member{position, id});
+}
+
+bool SpatialHashGrid::remove(uint32_t id) {
+    if (!contains(id)) {
+        return false;
+    }
+    unlink(locations[id]);
+    locations[id].slot = NONE;
+    entityCount--;
+    return true;
+}
+
+void SpatialHashGrid::clear() {
+    cells.clear();
+    locations.clear();
+    entityCount = 0;
+}
+
+template<typename Visit>
+bool SpatialHashGrid::forEachInRange(float minX, float minZ, float maxX, float maxZ, Visit&& visit) const {
+    if (cells.empty()) {
+        return false;
+    }
+
+    int32_t lowX = cellOf(minX);
+    int32_t lowZ = cellOf(minZ);
+    int32_t highX = cellOf(maxX);
+    int32_t highZ = cellOf(maxZ);
+
+    // Wider than the occupied columns: visit those and skip the ones out of range
+    auto rangeX = static_cast<uint64_t>(static_cast<int64_t>(highX) - lowX + 1);
+    auto rangeZ = static_cast<uint64_t>(static_cast<int64_t>(highZ) - lowZ + 1);
+    if (rangeX > cells.size() || rangeZ > cells.size() || rangeX * rangeZ > cells.size()) {
+        for (const auto& [key, cell] : cells) {
+            auto cellX = static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+            auto cellZ = static_cast<int32_t>(static_cast<uint32_t>(key));
+            if (cellX < lowX || cellX > highX || cellZ < lowZ || cellZ > highZ) {
+                continue;
+            }
+            for (const Member& member : cell) {
+                if (visit(member)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    for (int32_t cellZ = lowZ; cellZ <= highZ; cellZ++) {
+        for (int32_t cellX = lowX; cellX <= highX; cellX++) {
+            auto cellIt = cells.find(cellKey(cellX, cellZ));
+            if (cellIt == cells.end()) {
+                continue;
+            }
+            for (const Member& member : cellIt->second) {
+                if (visit(member)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void SpatialHashGrid::queryRadius(const glm::vec3& center, float radius, std::vector<uint32_t>& outIds) const {
+    float radiusSquared = radius * radius;
+    forEachInRange(center.x - radius, center.z - radius, center.x + radius, center.z + radius,
+                   [&](const Member& member) {
+        glm::vec3 offset = member.position - center;
+        if (glm::dot(offset, offset) <= radiusSquared) {
+            outIds.push_back(member.id);
+        }
+        return false;
+    });
+}
+
+void SpatialHashGrid::queryBox(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& outIds) const {
+    forEachInRange(min.x, min.z, max.x, max.z, [&](const Member& member) {
+        const glm::vec3& position = member.position;
+        if (position.x >= min.x && position.y >= min.y && position.z >= min.z &&
+            position.x <= max.x && position.y <= max.y && position.z <= max.z) {
+            outIds.push_back(member.id);
+        }
+        return false;
+    });
+}
+
+bool SpatialHashGrid::anyWithin(const glm::vec3& center, float radius) const {
+    float radiusSquared = radius * radius;
+    return forEachInRange(center.x - radius, center.z - radius, center.x + radius, center.z + radius,
+                          [&](const Member& member) {
+        glm::vec3 offset = member.position - center;
+        return glm::dot(offset, offset) <= radiusSquared;
+    });
+}
+
+int32_t SpatialHashGrid::cellOf(float coordinate) const {
+    // Clamped so unbounded query extents don't overflow
+    constexpr float LOWEST = -2147483648.0f;
+    constexpr float HIGHEST = 2147483520.0f;  // Largest float below 2^31
+    return static_cast<int32_t>(std::clamp(std::floor(coordinate * inverseCellSize), LOWEST, HIGHEST));
+}
+
+uint64_t SpatialHashGrid::cellKey(int32_t cellX, int32_t cellZ) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32) | static_cast<uint32_t>(cellZ);
+}
+
+void SpatialHashGrid::unlink(const Location& location) {
+    auto cellIt = cells.find(location.cell);
+    std::vector<Member>& cell = cellIt->second;
+
+    // Move the last member into the hole
+    if (location.slot + 1 != cell.size()) {
+        cell[location.slot] = cell.back();
+        locations[cell[location.slot].id].slot = location.slot;
+    }
+    cell.pop_back();
+    if (cell.empty()) {
+        cells.erase(cellIt);
+    }
+}
+
+} // namespace engine
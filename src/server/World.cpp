@@ -1,25 +1,61 @@
 #include "server/World.hpp"
 #include "core/Logger.hpp"
+#include "shared/ChunkOffsetTable.hpp"
+#include "shared/ChunkSerializer.hpp"
+#include "server/SpatialHashGrid.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <fstream>
 #include <filesystem>
+#include <iterator>
+#include <stdexcept>
 #include <unordered_set>
+#include <utility>
 
 namespace engine {
 
-World::World() {
+namespace {
+
+/**
+ * @brief Integer division rounding toward negative infinity
+ */
+int32_t floorDiv(int32_t value, int32_t divisor) {
+    int32_t quotient = value / divisor;
+    return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+}
+
+} // namespace
+
+World::World(const WorldSettings& settings)
+    : minChunkY(settings.minChunkY), maxChunkY(settings.maxChunkY),
+      lightEngine([this](const ChunkCoord& coord) { return findLoadedChunk(coord); }),
+      collision([this](const ChunkCoord& coord) { return findLoadedChunk(coord); }),
+      fallingBlocks([this](const ChunkCoord& coord) { return findLoadedChunk(coord); }),
+      regions([this](const ChunkCoord& coord) { return findWarmChunk(coord); }) {
     LOG_INFO("Initializing world...");
+
+    if (minChunkY > maxChunkY) {
+        LOG_ERROR("Invalid world height range {}..{}", minChunkY, maxChunkY);
+        throw std::invalid_argument("World height range is empty");
+    }
+    LOG_INFO("World height: chunk levels {} to {} ({} blocks)", minChunkY, maxChunkY,
+             (maxChunkY - minChunkY + 1) * static_cast<int32_t>(CHUNK_SIZE));
+
+    memoryBudget = settings.memoryBudgetBytes;
+    coldDelay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float>(settings.coldCompressionDelay));
     // World will be populated by either loadWorld() or generateInitialChunks()
 }
 
 void World::generateInitialChunks() {
-    // Only generate a small spawn area (3x3x3) to reduce initial load time
+    // Only generate a small spawn area (3x3 columns) to reduce initial load time
     // Additional chunks will be generated dynamically as players explore
     // NOLINTNEXTLINE(readability-identifier-length)
     for (int32_t x = -1; x <= 1; x++) {
         // NOLINTNEXTLINE(readability-identifier-length)
-        for (int32_t y = -1; y <= 1; y++) {
+        for (int32_t y = minChunkY; y <= maxChunkY; y++) {
             // NOLINTNEXTLINE(readability-identifier-length)
             for (int32_t z = -1; z <= 1; z++) {
                 loadChunk(ChunkCoord{x, y, z});
@@ -27,48 +63,160 @@ void World::generateInitialChunks() {
         }
     }
 
-    LOG_INFO("Generated initial spawn area with {} chunks (3x3x3)", chunks.size());
+    LOG_INFO("Generated initial spawn area with {} chunks (3x{}x3)", chunks.size(), maxChunkY - minChunkY + 1);
 }
 
 void World::update() {
-    // TODO: Process block updates, chunk updates, etc.
-    // For now, this is a no-op
+    updateBlockTicks();
+    updateLighting();
 }
 
-Chunk* World::getChunk(const ChunkCoord& coord) {
+void World::updateBlockTicks() {
+    dueBlockTicks.clear();
+    {
+        std::lock_guard<std::mutex> lock(chunksMutex);
+        blockTicks.advance(dueBlockTicks);
+
+        // Keep the ticks that still apply; their chunks' saved ticks changed
+        std::erase_if(dueBlockTicks, [this](const BlockTick& tick) {
+            ChunkCoord coord{floorDiv(tick.position.x, static_cast<int32_t>(CHUNK_SIZE)),
+                             floorDiv(tick.position.y, static_cast<int32_t>(CHUNK_SIZE)),
+                             floorDiv(tick.position.z, static_cast<int32_t>(CHUNK_SIZE))};
+            Chunk* chunk = findLoadedChunk(coord);
+            if (chunk == nullptr) {
+                return true;
+            }
+            chunk->markDirty();
+            glm::ivec3 local = tick.position - (glm::ivec3(coord.x, coord.y, coord.z) * static_cast<int32_t>(CHUNK_SIZE));
+            uint32_t index = Chunk::getIndex(static_cast<uint32_t>(local.x), static_cast<uint32_t>(local.y),
+                                             static_cast<uint32_t>(local.z));
+            return chunk->getBlockData()[index].type != tick.type ||
+                   !blockTickHandlers[static_cast<size_t>(tick.type)];
+        });
+    }
+
+    // Handlers run unlocked, so they can edit blocks through the World API
+    for (const BlockTick& tick : dueBlockTicks) {
+        blockTickHandlers[static_cast<size_t>(tick.type)](tick.position);
+    }
+}
+
+BlockTickHandle World::scheduleBlockTick(const glm::ivec3& worldPos, uint32_t delay) {
+    ChunkCoord coord;
+    uint32_t localX = 0;
+    uint32_t localY = 0;
+    uint32_t localZ = 0;
+    worldToChunkLocal(worldPos.x, worldPos.y, worldPos.z, coord, localX, localY, localZ);
+
+    std::lock_guard<std::mutex> lock(chunksMutex);
+    Chunk* chunk = findLoadedChunk(coord);
+    if (chunk == nullptr) {
+        return BlockTickHandle{};
+    }
+    chunk->markDirty();
+    BlockType type = chunk->getBlockData()[Chunk::getIndex(localX, localY, localZ)].type;
+    return blockTicks.schedule(worldPos, type, delay);
+}
+
+bool World::cancelBlockTick(BlockTickHandle handle) {
+    std::lock_guard<std::mutex> lock(chunksMutex);
+    return blockTicks.cancel(handle);
+}
+
+void World::setBlockTickHandler(BlockType type, BlockTickHandler handler) {
+    blockTickHandlers[static_cast<size_t>(type)] = std::move(handler);
+}
+
+void World::updateLighting() {
+    std::lock_guard<std::mutex> lock(chunksMutex);
+    if (lightEngine.hasPending()) {
+        lightEngine.process();
+    }
+}
+
+void World::queueLightUpdate(const glm::ivec3& worldPos, BlockType previous) {
+    std::lock_guard<std::mutex> lock(chunksMutex);
+    lightEngine.enqueueEdit(worldPos, previous);
+}
+
+void World::queueFallingBlockCheck(const glm::ivec3& worldPos) {
+    std::lock_guard<std::mutex> lock(chunksMutex);
+    fallingBlocks.enqueueEdit(worldPos);
+}
+
+std::vector<BlockChange> World::updateFallingBlocks() {
+    std::vector<BlockChange> changes;
+    std::lock_guard<std::mutex> lock(chunksMutex);
+    if (!fallingBlocks.hasPending()) {
+        return changes;
+    }
+
+    fallingBlocks.step(changes);
+    for (const BlockChange& change : changes) {
+        lightEngine.enqueueEdit(change.position, change.previous);
+    }
+    return changes;
+}
+
+std::vector<BlockChange> World::tickRegions(const RegionScheduler::RegionTask& task) {
+    std::vector<BlockChange> changes;
+    std::lock_guard<std::mutex> lock(chunksMutex);
+    regions.tick(task, changes);
+    for (const BlockChange& change : changes) {
+        lightEngine.enqueueEdit(change.position, change.previous);
+        fallingBlocks.enqueueEdit(change.position);
+    }
+    return changes;
+}
+
+glm::vec3 World::resolvePlayerMove(const glm::vec3& eyeFrom, const glm::vec3& eyeTo) {
     std::lock_guard<std::mutex> lock(chunksMutex);
+    return collision.movePlayer(eyeFrom, eyeTo - eyeFrom);
+}
 
+Chunk* World::findLoadedChunk(const ChunkCoord& coord) {
     auto chunkIt = chunks.find(coord);
-    if (chunkIt != chunks.end()) {
-        return chunkIt->second.get();
+    if (chunkIt == chunks.end()) {
+        return nullptr;
     }
-    return nullptr;
+    return &accessChunk(chunkIt->first, chunkIt->second);
 }
 
-const Chunk* World::getChunk(const ChunkCoord& coord) const {
+Chunk* World::findWarmChunk(const ChunkCoord& coord) {
+    auto chunkIt = chunks.find(coord);
+    if (chunkIt == chunks.end() || chunkIt->second.isCold()) {
+        return nullptr;
+    }
+    return chunkIt->second.chunk.get();
+}
+
+Chunk* World::getChunk(const ChunkCoord& coord) {
     std::lock_guard<std::mutex> lock(chunksMutex);
 
     auto chunkIt = chunks.find(coord);
     if (chunkIt != chunks.end()) {
-        return chunkIt->second.get();
+        return &accessChunk(chunkIt->first, chunkIt->second);
     }
     return nullptr;
 }
 
+const Chunk* World::getChunk(const ChunkCoord& coord) const {
+    // Thawing a cold chunk doesn't change world contents, only its representation
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    return const_cast<World*>(this)->getChunk(coord);
+}
+
 Chunk& World::loadChunk(const ChunkCoord& coord) {
     std::lock_guard<std::mutex> lock(chunksMutex);
 
     // Check if already loaded in memory
     auto chunkIt = chunks.find(coord);
     if (chunkIt != chunks.end()) {
-        return *chunkIt->second;
+        return accessChunk(chunkIt->first, chunkIt->second);
     }
 
     // Try to load from disk first
-    std::string filename = "world/chunk_" +
-                          std::to_string(coord.x) + "_" +
-                          std::to_string(coord.y) + "_" +
-                          std::to_string(coord.z) + ".dat";
+    std::string filename = chunkFilePath(chunkDir, coord);
 
     if (std::filesystem::exists(filename)) {
         // Load from file
@@ -83,10 +231,18 @@ Chunk& World::loadChunk(const ChunkCoord& coord) {
             file.read(reinterpret_cast<char*>(data.data()), fileSize);
             file.close();
 
+            std::vector<SavedBlockTick> savedTicks;
+            BlockTickScheduler::extractSaved(data, savedTicks);
             auto chunk = std::make_unique<Chunk>(coord);
             if (chunk->deserialize(data)) {
+                blockPool.intern(*chunk);
                 auto* chunkPtr = chunk.get();
-                chunks[coord] = std::move(chunk);
+                chunks[coord] = ChunkSlot{std::move(chunk), {}, {}, false, passTime};
+                memoryStats.reloads++;
+                lightEngine.enqueueSection(coord);
+                fallingBlocks.enqueueChunk(coord);
+                blockTicks.restoreChunk(coord, savedTicks);
+                regions.addChunk(coord);
                 LOG_DEBUG("Loaded chunk ({}, {}, {}) from disk", coord.x, coord.y, coord.z);
                 return *chunkPtr;
             }
@@ -95,8 +251,12 @@ Chunk& World::loadChunk(const ChunkCoord& coord) {
 
     // Generate new chunk if not found on disk
     auto chunk = generateChunk(coord);
+    blockPool.intern(*chunk);
     auto* chunkPtr = chunk.get();
-    chunks[coord] = std::move(chunk);
+    chunks[coord] = ChunkSlot{std::move(chunk), {}, {}, false, passTime};
+    lightEngine.enqueueSection(coord);
+    fallingBlocks.enqueueChunk(coord);
+    regions.addChunk(coord);
 
     LOG_TRACE("Generated new chunk at ({}, {}, {})", coord.x, coord.y, coord.z);
 
@@ -110,6 +270,13 @@ void World::unloadChunk(const ChunkCoord& coord) {
     if (chunkIt != chunks.end()) {
         // TODO: Save chunk to disk if dirty
         chunks.erase(chunkIt);
+        blockTicks.dropChunk(coord);
+        regions.removeChunk(coord);
+        auto idleIt = idleIndex.find(coord);
+        if (idleIt != idleIndex.end()) {
+            idleChunks.erase(idleIt->second);
+            idleIndex.erase(idleIt);
+        }
         LOG_TRACE("Unloaded chunk at ({}, {}, {})", coord.x, coord.y, coord.z);
     }
 }
@@ -166,8 +333,11 @@ std::vector<const Chunk*> World::getAllChunks() const {
     std::vector<const Chunk*> result;
     result.reserve(chunks.size());
 
-    for (const auto& pair : chunks) {
-        result.push_back(pair.second.get());
+    // Thawing cold chunks doesn't change world contents, only their representation
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    auto* self = const_cast<World*>(this);
+    for (auto& [coord, slot] : self->chunks) {
+        result.push_back(&self->accessChunk(coord, slot));
     }
 
     return result;
@@ -214,6 +384,12 @@ std::unique_ptr<Chunk> World::generateChunk(const ChunkCoord& coord) {
         }
     }
 
+    // Filled block by block, so recompute which bricks are uniform
+    chunk->updateBrickMasks();
+
+    // Generated terrain can be regenerated, so it only needs saving once edited
+    chunk->clearDirty();
+
     return chunk;
 }
 
@@ -251,31 +427,14 @@ size_t World::saveWorld(const std::string& worldDir) {
     size_t savedCount = 0;
     std::vector<uint8_t> serializedData;
 
-    for (const auto& [coord, chunk] : chunks) {
+    for (auto& [coord, slot] : chunks) {
         // Only save dirty chunks
-        if (!chunk->isDirty()) {
+        if (!slot.isDirty()) {
             continue;
         }
 
-        // Serialize chunk
-        chunk->serialize(serializedData);
-
-        // Create filename: chunk_x_y_z.dat
-        std::string filename = worldDir + "/chunk_" +
-                              std::to_string(coord.x) + "_" +
-                              std::to_string(coord.y) + "_" +
-                              std::to_string(coord.z) + ".dat";
-
-        // Write to file
-        std::ofstream file(filename, std::ios::binary);
-        if (file.is_open()) {
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-narrowing-conversions,bugprone-narrowing-conversions)
-            file.write(reinterpret_cast<const char*>(serializedData.data()), serializedData.size());
-            file.close();
-            chunk->clearDirty();
+        if (writeChunkFile(worldDir, coord, thawChunk(coord, slot), serializedData)) {
             savedCount++;
-        } else {
-            LOG_ERROR("Failed to save chunk ({}, {}, {}) to {}", coord.x, coord.y, coord.z, filename);
         }
     }
 
@@ -288,34 +447,20 @@ size_t World::saveWorld(const std::string& worldDir) {
     return savedCount;
 }
 
-// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 std::vector<ChunkCoord> World::getChunksInRadius(const glm::vec3& centerPos, int32_t chunkRadius) const {
-    std::vector<ChunkCoord> result;
-
-    // Convert center position to chunk coordinate
+    // Chunks within a horizontal circle (X-Z plane) over the whole height
+    // range, column by column nearest first, each column from the center's level outwards
     ChunkCoord centerChunk = ChunkCoord::fromWorldPos(centerPos);
+    std::vector<int32_t> levels;
+    ChunkOffsetTable::levelsNearestFirst(centerChunk.y, minChunkY, maxChunkY, levels);
 
-    // Get all chunks in a horizontal circle around the center (X-Z plane only)
-    // Load all Y levels for each X-Z position
-    // NOLINTNEXTLINE(readability-identifier-length)
-    for (int32_t x = centerChunk.x - chunkRadius; x <= centerChunk.x + chunkRadius; x++) {
-        // NOLINTNEXTLINE(readability-identifier-length)
-        for (int32_t z = centerChunk.z - chunkRadius; z <= centerChunk.z + chunkRadius; z++) {
-            // Check if within circular radius (Euclidean distance in XZ plane)
-            // NOLINTNEXTLINE(readability-identifier-length)
-            int32_t dx = x - centerChunk.x;
-            // NOLINTNEXTLINE(readability-identifier-length)
-            int32_t dz = z - centerChunk.z;
-            // NOLINTNEXTLINE(readability-math-missing-parentheses)
-            float distanceXZ = std::sqrt(static_cast<float>(dx * dx + dz * dz));
-
-            if (distanceXZ <= static_cast<float>(chunkRadius)) {
-                // Add all vertical chunks at this X-Z position (typically -1 to 1 for Y)
-                // NOLINTNEXTLINE(readability-identifier-length)
-                for (int32_t y = -1; y <= 1; y++) {
-                    result.push_back(ChunkCoord{x, y, z});
-                }
-            }
+    const ChunkOffsetTable& table = ChunkOffsetTable::get(chunkRadius, 0);
+
+    std::vector<ChunkCoord> result;
+    result.reserve(table.getColumns().size() * levels.size());
+    for (const auto& column : table.getColumns()) {
+        for (int32_t chunkY : levels) {
+            result.push_back(ChunkCoord{centerChunk.x + column.x, chunkY, centerChunk.z + column.z});
         }
     }
 
@@ -323,57 +468,364 @@ std::vector<ChunkCoord> World::getChunksInRadius(const glm::vec3& centerPos, int
 }
 
 size_t World::unloadDistantChunks(const std::vector<glm::vec3>& playerPositions, int32_t keepRadius) {
+    // Grid of player chunk columns (chunk units, y = 0) with columns keepRadius
+    // wide, so a chunk is only tested against the players in the columns around it
+    SpatialHashGrid playerColumns(static_cast<float>(std::max(keepRadius, 1)));
+    for (size_t player = 0; player < playerPositions.size(); player++) {
+        ChunkCoord playerChunk = ChunkCoord::fromWorldPos(playerPositions[player]);
+        playerColumns.insert(static_cast<uint32_t>(player),
+                             glm::vec3(static_cast<float>(playerChunk.x), 0.0f, static_cast<float>(playerChunk.z)));
+    }
+
+    // Whole columns are streamed, so only the XZ distance matters
+    auto keepDistance = static_cast<float>(keepRadius);
+    auto isNeeded = [&](const ChunkCoord& coord) {
+        return playerColumns.anyWithin(glm::vec3(static_cast<float>(coord.x), 0.0f, static_cast<float>(coord.z)), keepDistance);
+    };
+
+    auto now = std::chrono::steady_clock::now();
+
     std::lock_guard<std::mutex> lock(chunksMutex);
 
-    // Build set of chunks that should be kept loaded
-    std::unordered_set<ChunkCoord> chunksToKeep;
+    // Chunks out of range go to the back of the idle LRU; chunks back in range leave it
+    passTime = now;
+    for (const auto& [coord, slot] : chunks) {
+        auto idleIt = idleIndex.find(coord);
+        if (isNeeded(coord)) {
+            if (idleIt != idleIndex.end()) {
+                idleChunks.erase(idleIt->second);
+                idleIndex.erase(idleIt);
+            }
+        } else if (idleIt == idleIndex.end()) {
+            idleChunks.push_back(IdleChunk{coord, now});
+            idleIndex.emplace(coord, std::prev(idleChunks.end()));
+        }
+    }
+
+    // A chunk is unloaded only after it has been out of range of every player
+    // for the retention time, so chunks at the edge aren't thrashed. Dirty
+    // chunks stay until the next save writes them out.
+    size_t unloadedCount = 0;
+    for (auto idleIt = idleChunks.begin(); idleIt != idleChunks.end() && now - idleIt->since >= CHUNK_RETENTION;) {
+        auto chunkIt = chunks.find(idleIt->coord);
+        if (chunkIt->second.isDirty()) {
+            ++idleIt;
+            continue;
+        }
+        chunks.erase(chunkIt);
+        blockTicks.dropChunk(idleIt->coord);
+        regions.removeChunk(idleIt->coord);
+        idleIndex.erase(idleIt->coord);
+        idleIt = idleChunks.erase(idleIt);
+        unloadedCount++;
+    }
+    memoryStats.unloads += unloadedCount;
+
+    size_t evictedCount = enforceMemoryBudget();
+    compressColdChunks(now);
+    blockPool.prune();
+    updateMemoryRates(now);
+
+    if (unloadedCount > 0 || evictedCount > 0) {
+        size_t blockBuffers = 0;
+        LOG_DEBUG("Unloaded {} distant chunks, evicted {} over budget, {} chunks remaining ({} idle, {:.1f} MB)",
+                  unloadedCount, evictedCount, chunks.size(), idleChunks.size(),
+                  static_cast<double>(computeResidentBytes(blockBuffers)) / (1024.0 * 1024.0));
+    }
 
-    for (const auto& pos : playerPositions) {
-        ChunkCoord playerChunk = ChunkCoord::fromWorldPos(pos);
+    return unloadedCount + evictedCount;
+}
 
-        // Mark all chunks in radius around this player
-        // NOLINTNEXTLINE(readability-identifier-length)
-        for (int32_t x = playerChunk.x - keepRadius; x <= playerChunk.x + keepRadius; x++) {
-            // NOLINTNEXTLINE(readability-identifier-length)
-            for (int32_t y = playerChunk.y - keepRadius; y <= playerChunk.y + keepRadius; y++) {
-                // NOLINTNEXTLINE(readability-identifier-length)
-                for (int32_t z = playerChunk.z - keepRadius; z <= playerChunk.z + keepRadius; z++) {
-                    chunksToKeep.insert(ChunkCoord{x, y, z});
+size_t World::enforceMemoryBudget() {
+    if (memoryBudget == 0) {
+        return 0;
+    }
+
+    size_t blockBuffers = 0;
+    size_t residentBytes = computeResidentBytes(blockBuffers);
+    auto overBudget = [this, &residentBytes]() { return residentBytes > memoryBudget; };
+    if (!overBudget()) {
+        return 0;
+    }
+
+    // Least recently in range first. Clean chunks go first since dropping them
+    // costs at most a reload; dirty chunks are written back before dropping.
+    size_t evictedCount = 0;
+    for (bool evictDirty : {false, true}) {
+        if (evictDirty) {
+            std::filesystem::create_directories(chunkDir);
+        }
+        for (auto idleIt = idleChunks.begin(); idleIt != idleChunks.end() && overBudget();) {
+            auto chunkIt = chunks.find(idleIt->coord);
+            size_t freedBytes = slotBytes(chunkIt->second);
+            if (chunkIt->second.isDirty()) {
+                if (!evictDirty ||
+                    !writeChunkFile(chunkDir, idleIt->coord, thawChunk(idleIt->coord, chunkIt->second), writeBackBuffer)) {
+                    ++idleIt;
+                    continue;
                 }
+                memoryStats.writeBacks++;
             }
+
+            residentBytes -= freedBytes;
+            chunks.erase(chunkIt);
+            blockTicks.dropChunk(idleIt->coord);
+            regions.removeChunk(idleIt->coord);
+            idleIndex.erase(idleIt->coord);
+            idleIt = idleChunks.erase(idleIt);
+            evictedCount++;
         }
     }
+    memoryStats.evictions += evictedCount;
 
-    // Unload chunks not in the keep set
-    size_t unloadedCount = 0;
-    std::vector<ChunkCoord> toUnload;
+    if (overBudget()) {
+        LOG_WARN("Chunk memory over budget: {:.1f} MB resident, {:.1f} MB budget, no idle chunks left to evict",
+                 static_cast<double>(residentBytes) / (1024.0 * 1024.0),
+                 static_cast<double>(memoryBudget) / (1024.0 * 1024.0));
+    }
+
+    return evictedCount;
+}
+
+void World::updateMemoryRates(std::chrono::steady_clock::time_point now) {
+    float elapsed = std::chrono::duration<float>(now - rateWindowStart).count();
+    if (elapsed < 1.0f) {
+        return;
+    }
+
+    memoryStats.evictionRate = static_cast<float>(memoryStats.evictions + memoryStats.unloads - rateWindowEvictions) / elapsed;
+    memoryStats.reloadRate = static_cast<float>(memoryStats.reloads - rateWindowReloads) / elapsed;
+    memoryStats.thawRate = static_cast<float>(memoryStats.thaws - rateWindowThaws) / elapsed;
+
+    rateWindowStart = now;
+    rateWindowEvictions = memoryStats.evictions + memoryStats.unloads;
+    rateWindowReloads = memoryStats.reloads;
+    rateWindowThaws = memoryStats.thaws;
+}
+
+Chunk& World::accessChunk(const ChunkCoord& coord, ChunkSlot& slot) {
+    slot.lastAccess = passTime;
+    if (!slot.isCold()) {
+        return *slot.chunk;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Chunk& chunk = thawChunk(coord, slot);
+    auto elapsedUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+
+    memoryStats.thaws++;
+    memoryStats.thawMicrosTotal += elapsedUs;
+    memoryStats.thawMicrosMax = std::max(memoryStats.thawMicrosMax, elapsedUs);
+    return chunk;
+}
+
+Chunk& World::thawChunk(const ChunkCoord& coord, ChunkSlot& slot) {
+    if (!slot.isCold()) {
+        return *slot.chunk;
+    }
+
+    auto chunk = std::make_unique<Chunk>(coord);
+    if (!ChunkSerializer::deserializeBricks(slot.compressed.data(), slot.compressed.size(), *chunk)) {
+        LOG_ERROR("Failed to decompress cold chunk ({}, {}, {})", coord.x, coord.y, coord.z);
+        throw std::runtime_error("Corrupted cold chunk data");
+    }
+    if (!ChunkSerializer::deserializeLight(slot.compressedLight.data(), slot.compressedLight.size(), chunk->getLight())) {
+        LOG_ERROR("Failed to decompress cold chunk light ({}, {}, {})", coord.x, coord.y, coord.z);
+        throw std::runtime_error("Corrupted cold chunk light data");
+    }
+    if (!slot.coldDirty) {
+        chunk->clearDirty();
+    }
+    blockPool.intern(*chunk);
+
+    slot.chunk = std::move(chunk);
+    std::vector<uint8_t>().swap(slot.compressed);
+    std::vector<uint8_t>().swap(slot.compressedLight);
+    return *slot.chunk;
+}
+
+void World::compressColdChunks(std::chrono::steady_clock::time_point now) {
+    if (coldDelay.count() <= 0) {
+        return;
+    }
+
+    // Shared buffers are already cheap, so only chunks with private blocks are compressed
+    size_t compressedCount = 0;
+    for (auto& [coord, slot] : chunks) {
+        if (compressedCount >= MAX_COMPRESSIONS_PER_PASS) {
+            break;
+        }
+        if (slot.isCold() || slot.chunk->isBlockDataShared() || now - slot.lastAccess < coldDelay) {
+            continue;
+        }
 
-    for (const auto& [coord, chunk] : chunks) {
-        if (!chunksToKeep.contains(coord)) {
-            toUnload.push_back(coord);
+        ChunkSerializer::serializeBricks(*slot.chunk, compressBuffer);
+        if (compressBuffer.size() * 2 > sizeof(ChunkBlocks)) {
+            // Too noisy to be worth it; check again after another delay
+            slot.lastAccess = now;
+            continue;
         }
+
+        slot.compressed.assign(compressBuffer.begin(), compressBuffer.end());
+        compressBuffer.clear();
+        ChunkSerializer::serializeLight(slot.chunk->getLight(), compressBuffer);
+        slot.compressedLight.assign(compressBuffer.begin(), compressBuffer.end());
+        slot.coldDirty = slot.chunk->isDirty();
+        slot.chunk.reset();
+        compressedCount++;
+    }
+
+    memoryStats.compressions += compressedCount;
+    if (compressedCount > 0) {
+        LOG_TRACE("Compressed {} cold chunks", compressedCount);
     }
+}
+
+void World::setColdCompressionDelay(float seconds) {
+    std::lock_guard<std::mutex> lock(chunksMutex);
+    coldDelay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(seconds));
+}
 
-    // Unload chunks (do this outside the iteration to avoid iterator invalidation)
-    for (const auto& coord : toUnload) {
-        // Save chunk if dirty before unloading
-        auto chunkIt = chunks.find(coord);
-        if (chunkIt != chunks.end() && chunkIt->second->isDirty()) {
-            // Will be saved in next autosave
+size_t World::slotBytes(const ChunkSlot& slot) {
+    if (slot.isCold()) {
+        return SLOT_OVERHEAD + slot.compressed.capacity() + slot.compressedLight.capacity();
+    }
+    // A deduplicated buffer is only freed with its last chunk
+    return SLOT_OVERHEAD + WARM_OVERHEAD + slot.chunk->getLight().getAllocatedBytes() +
+           (slot.chunk->isBlockDataShared() ? 0 : sizeof(ChunkBlocks));
+}
+
+size_t World::computeResidentBytes(size_t& outBlockBuffers) const {
+    std::unordered_set<const ChunkBlocks*> sharedBuffers;
+    size_t privateBuffers = 0;
+    size_t totalBytes = chunks.size() * SLOT_OVERHEAD;
+    for (const auto& [coord, slot] : chunks) {
+        if (slot.isCold()) {
+            totalBytes += slot.compressed.capacity() + slot.compressedLight.capacity();
+            continue;
+        }
+        totalBytes += WARM_OVERHEAD + slot.chunk->getLight().getAllocatedBytes();
+        if (slot.chunk->isBlockDataShared()) {
+            sharedBuffers.insert(slot.chunk->getSharedBlockData().get());
+        } else {
+            privateBuffers++;
         }
-        chunks.erase(coord);
-        unloadedCount++;
     }
 
-    if (unloadedCount > 0) {
-        LOG_DEBUG("Unloaded {} distant chunks, {} chunks remaining", unloadedCount, chunks.size());
+    outBlockBuffers = privateBuffers + sharedBuffers.size();
+    return totalBytes + (outBlockBuffers * sizeof(ChunkBlocks));
+}
+
+void World::setMemoryBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(chunksMutex);
+    memoryBudget = bytes;
+}
+
+World::MemoryStats World::getMemoryStats() const {
+    std::lock_guard<std::mutex> lock(chunksMutex);
+
+    MemoryStats stats = memoryStats;
+    stats.residentChunks = chunks.size();
+    stats.residentBytes = computeResidentBytes(stats.blockBuffers);
+    stats.coldChunks = 0;
+    stats.coldBytes = 0;
+    for (const auto& [coord, slot] : chunks) {
+        if (slot.isCold()) {
+            stats.coldChunks++;
+            stats.coldBytes += slot.compressed.capacity() + slot.compressedLight.capacity();
+        }
+    }
+    stats.dedupSavedBytes = (chunks.size() - stats.coldChunks - stats.blockBuffers) * sizeof(ChunkBlocks);
+    stats.budgetBytes = memoryBudget;
+    stats.coldDelaySeconds = std::chrono::duration<float>(coldDelay).count();
+    stats.idleChunks = idleChunks.size();
+    return stats;
+}
+
+void World::logMemoryReport() const {
+    MemoryStats stats = getMemoryStats();
+    constexpr double MEGABYTE = 1024.0 * 1024.0;
+
+    if (stats.budgetBytes > 0) {
+        LOG_INFO("Chunk memory: {} chunks, {:.1f} / {:.1f} MB ({:.0f}% of budget), {} idle",
+                 stats.residentChunks, static_cast<double>(stats.residentBytes) / MEGABYTE,
+                 static_cast<double>(stats.budgetBytes) / MEGABYTE,
+                 100.0 * static_cast<double>(stats.residentBytes) / static_cast<double>(stats.budgetBytes),
+                 stats.idleChunks);
+    } else {
+        LOG_INFO("Chunk memory: {} chunks, {:.1f} MB (no budget), {} idle",
+                 stats.residentChunks, static_cast<double>(stats.residentBytes) / MEGABYTE, stats.idleChunks);
+    }
+    if (stats.blockBuffers > 0) {
+        LOG_INFO("  Dedup: {} block buffers for {} chunks ({:.1f}:1), {:.1f} MB saved",
+                 stats.blockBuffers, stats.residentChunks,
+                 static_cast<double>(stats.residentChunks) / static_cast<double>(stats.blockBuffers),
+                 static_cast<double>(stats.dedupSavedBytes) / MEGABYTE);
+    }
+    if (stats.coldDelaySeconds > 0.0f) {
+        LOG_INFO("  Cold: {} chunks compressed to {:.1f} MB after {:.0f} s unused | hits {:.1f}/s ({} total), "
+                 "decompress avg {:.0f} us, max {} us",
+                 stats.coldChunks, static_cast<double>(stats.coldBytes) / MEGABYTE, stats.coldDelaySeconds,
+                 stats.thawRate, stats.thaws,
+                 stats.thaws > 0 ? static_cast<double>(stats.thawMicrosTotal) / static_cast<double>(stats.thaws) : 0.0,
+                 stats.thawMicrosMax);
+    }
+    LOG_INFO("  Evictions: {:.1f}/s ({} over budget, {} written back, {} idle unloads) | Reloads: {:.1f}/s ({} total)",
+             stats.evictionRate, stats.evictions, stats.writeBacks, stats.unloads,
+             stats.reloadRate, stats.reloads);
+}
+
+LightEngine::Stats World::getLightStats() const {
+    std::lock_guard<std::mutex> lock(chunksMutex);
+    return lightEngine.getStats();
+}
+
+void World::logLightReport() const {
+    LightEngine::Stats stats = getLightStats();
+
+    auto average = [](uint64_t total, uint64_t count) {
+        return count > 0 ? static_cast<double>(total) / static_cast<double>(count) : 0.0;
+    };
+    LOG_INFO("Lighting: {} sections in {} batches, avg {:.0f} us/section, slowest batch {} us",
+             stats.sections, stats.sectionBatches, average(stats.sectionMicrosTotal, stats.sections),
+             stats.sectionMicrosMax);
+    LOG_INFO("  Edits: {} relit in {} batches, avg {:.0f} us/batch, slowest batch {} us",
+             stats.edits, stats.editBatches, average(stats.editMicrosTotal, stats.editBatches), stats.editMicrosMax);
+}
+
+std::string World::chunkFilePath(const std::string& worldDir, const ChunkCoord& coord) {
+    // chunk_x_y_z.dat
+    return worldDir + "/chunk_" +
+           std::to_string(coord.x) + "_" +
+           std::to_string(coord.y) + "_" +
+           std::to_string(coord.z) + ".dat";
+}
+
+bool World::writeChunkFile(const std::string& worldDir, const ChunkCoord& coord, Chunk& chunk,
+                           std::vector<uint8_t>& buffer) {
+    chunk.serialize(buffer);
+    std::vector<SavedBlockTick> savedTicks;
+    blockTicks.saveChunk(coord, savedTicks);
+    BlockTickScheduler::appendSaved(savedTicks, buffer);
+
+    std::string filename = chunkFilePath(worldDir, coord);
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to save chunk ({}, {}, {}) to {}", coord.x, coord.y, coord.z, filename);
+        return false;
     }
 
-    return unloadedCount;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-narrowing-conversions,bugprone-narrowing-conversions)
+    file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    file.close();
+    chunk.clearDirty();
+    return true;
 }
 
 size_t World::loadWorld(const std::string& worldDir) {
     std::lock_guard<std::mutex> lock(chunksMutex);
+    chunkDir = worldDir;
 
     if (!std::filesystem::exists(worldDir)) {
         LOG_INFO("World directory {} does not exist, will generate new world", worldDir);
@@ -428,10 +880,17 @@ size_t World::loadWorld(const std::string& worldDir) {
 
         ChunkCoord coord{x, y, z};
 
-        // Create chunk and deserialize
+        // Create chunk and deserialize (block ticks are appended after the chunk data)
+        std::vector<SavedBlockTick> savedTicks;
+        BlockTickScheduler::extractSaved(data, savedTicks);
         auto chunk = std::make_unique<Chunk>(coord);
         if (chunk->deserialize(data)) {
-            chunks[coord] = std::move(chunk);
+            blockPool.intern(*chunk);
+            chunks[coord] = ChunkSlot{std::move(chunk), {}, {}, false, passTime};
+            lightEngine.enqueueSection(coord);
+            fallingBlocks.enqueueChunk(coord);
+            blockTicks.restoreChunk(coord, savedTicks);
+            regions.addChunk(coord);
             loadedCount++;
         } else {
             LOG_ERROR("Failed to deserialize chunk ({}, {}, {}) from {}", x, y, z, filename);
@@ -1,26 +1,112 @@
 #include "shared/Chunk.hpp"
 #include "core/Logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cmath>
 #include <stdexcept>
 #include <cstring>
 
 namespace engine {
 
+namespace {
+
+constexpr size_t COORD_BYTES = 3 * sizeof(int32_t);
+constexpr size_t LEGACY_SIZE = COORD_BYTES + (CHUNK_VOLUME * sizeof(Block));
+constexpr uint32_t BRICK_FORMAT_MAGIC = 0x314B5242;  // "BRK1"
+constexpr size_t BRICK_HEADER_BYTES = COORD_BYTES + sizeof(uint32_t) + (2 * sizeof(uint64_t));
+
+template <typename T>
+void writeValue(std::vector<uint8_t>& out, size_t& offset, const T& value) {
+    std::memcpy(out.data() + offset, &value, sizeof(T));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    offset += sizeof(T);
+}
+
+template <typename T>
+T readValue(const std::vector<uint8_t>& data, size_t& offset) {
+    T value{};
+    std::memcpy(&value, data.data() + offset, sizeof(T));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    offset += sizeof(T);
+    return value;
+}
+
+} // namespace
+
+void ChunkLight::set(uint32_t index, uint8_t value) {
+    if (!values) {
+        if (value == uniformValue) {
+            return;
+        }
+        values = std::make_shared<Values>();
+        values->fill(uniformValue);
+    } else if (values.use_count() > 1) {
+        values = std::make_shared<Values>(*values);
+    }
+    (*values)[index] = value;
+}
+
+void ChunkLight::fill(uint8_t sky, uint8_t block) {
+    values.reset();
+    uniformValue = pack(sky, block);
+}
+
+void ChunkLight::assign(const Values& newValues) {
+    uint8_t first = newValues[0];
+    if (std::all_of(newValues.begin(), newValues.end(), [first](uint8_t value) { return value == first; })) {
+        values.reset();
+        uniformValue = first;
+        return;
+    }
+    values = std::make_shared<Values>(newValues);
+}
+
 Chunk::Chunk(const ChunkCoord& coord)
-    : coord(coord) {
+    : coord(coord), blocks(std::make_shared<ChunkBlocks>()) {
     // Initialize all blocks to air
-    for (auto& block : blocks) {
+    for (auto& block : *blocks) {
         block.type = BlockType::Air;
     }
 }
 
+Chunk::Chunk(const Chunk& other)
+    : coord(other.coord), blocks(other.blocks), dirty(other.dirty),
+      occupiedBricks(other.occupiedBricks), uniformBricks(other.uniformBricks), light(other.light) {
+}
+
+Chunk& Chunk::operator=(const Chunk& other) {
+    if (this != &other) {
+        coord = other.coord;
+        blocks = other.blocks;
+        dirty = other.dirty;
+        occupiedBricks = other.occupiedBricks;
+        uniformBricks = other.uniformBricks;
+        light = other.light;
+        revision++;
+    }
+    return *this;
+}
+
+uint64_t Chunk::newRevisionRange() {
+    // 2^32 revisions per chunk object; mutations then bump a plain member
+    static std::atomic<uint64_t> nextRange{0};
+    return nextRange.fetch_add(1, std::memory_order_relaxed) << 32;
+}
+
 Block& Chunk::getBlock(uint32_t x, uint32_t y, uint32_t z) {  // NOLINT(readability-identifier-length)
     if (x >= CHUNK_SIZE || y >= CHUNK_SIZE || z >= CHUNK_SIZE) {
         LOG_ERROR("Block access out of bounds: ({}, {}, {}) in chunk ({}, {}, {})",
                   x, y, z, coord.x, coord.y, coord.z);
         throw std::out_of_range("Block coordinates out of chunk bounds");
     }
-    return blocks[getIndex(x, y, z)];
+    makeBlocksUnique();
+    revision++;
+
+    // The caller may write anything through the reference
+    uint64_t bit = uint64_t{1} << getBrickIndexAt(x, y, z);
+    occupiedBricks |= bit;
+    uniformBricks &= ~bit;
+
+    return (*blocks)[getIndex(x, y, z)];
 }
 
 const Block& Chunk::getBlock(uint32_t x, uint32_t y, uint32_t z) const {  // NOLINT(readability-identifier-length)
@@ -29,7 +115,7 @@ const Block& Chunk::getBlock(uint32_t x, uint32_t y, uint32_t z) const {  // NOL
                   x, y, z, coord.x, coord.y, coord.z);
         throw std::out_of_range("Block coordinates out of chunk bounds");
     }
-    return blocks[getIndex(x, y, z)];
+    return (*blocks)[getIndex(x, y, z)];
 }
 
 void Chunk::setBlock(uint32_t x, uint32_t y, uint32_t z, const Block& block) {  // NOLINT(readability-identifier-length)
@@ -38,55 +124,121 @@ void Chunk::setBlock(uint32_t x, uint32_t y, uint32_t z, const Block& block) {
                   x, y, z, coord.x, coord.y, coord.z);
         throw std::out_of_range("Block coordinates out of chunk bounds");
     }
-    blocks[getIndex(x, y, z)] = block;
+    makeBlocksUnique();
+    Block& target = (*blocks)[getIndex(x, y, z)];
+    BlockType previous = target.type;
+    target = block;
     dirty = true;
+
+    if (previous == block.type) {
+        return;
+    }
+    revision++;
+
+    uint32_t brickIndex = getBrickIndexAt(x, y, z);
+    if (block.type == BlockType::Air) {
+        // Removing a block may have emptied the brick, which only a rescan can tell
+        updateBrick(brickIndex);
+    } else {
+        uint64_t bit = uint64_t{1} << brickIndex;
+        occupiedBricks |= bit;
+        uniformBricks &= ~bit;
+    }
 }
 
-void Chunk::setBlockData(const std::array<Block, CHUNK_VOLUME>& data) {
-    blocks = data;
+void Chunk::setBlockData(const ChunkBlocks& data) {
+    if (isBlockDataShared()) {
+        blocks = std::make_shared<ChunkBlocks>(data);
+    } else {
+        *blocks = data;
+    }
     dirty = true;
+    revision++;
+    updateBrickMasks();
+}
+
+void Chunk::updateBrickMasks() {
+    for (uint32_t brickIndex = 0; brickIndex < BRICK_COUNT; brickIndex++) {
+        updateBrick(brickIndex);
+    }
+}
+
+void Chunk::updateBrick(uint32_t brickIndex) {
+    const ChunkBlocks& data = *blocks;
+    BlockType first = data[getBrickBlockIndex(brickIndex, 0)].type;
+
+    // Uniform until the first mismatch; a mismatch in an air brick means it is occupied
+    bool uniform = true;
+    for (uint32_t local = 1; local < BRICK_VOLUME; local++) {
+        if (data[getBrickBlockIndex(brickIndex, local)].type != first) {
+            uniform = false;
+            break;
+        }
+    }
+
+    uint64_t bit = uint64_t{1} << brickIndex;
+    if (!uniform || first != BlockType::Air) {
+        occupiedBricks |= bit;
+    } else {
+        occupiedBricks &= ~bit;
+    }
+    if (uniform) {
+        uniformBricks |= bit;
+    } else {
+        uniformBricks &= ~bit;
+    }
+}
+
+void Chunk::makeBlocksUnique() {
+    if (isBlockDataShared()) {
+        blocks = std::make_shared<ChunkBlocks>(*blocks);
+    }
 }
 
 void Chunk::serialize(std::vector<uint8_t>& outData) const {
-    outData.clear();
+    // Format: [chunk_x][chunk_y][chunk_z][magic][occupied:u64][uniform:u64][bricks]
+    // Occupied bricks follow in index order: one Block if uniform, else
+    // BRICK_VOLUME Blocks. Empty bricks take no space.
+    uint64_t uniform = uniformBricks & occupiedBricks;
+    size_t uniformCount = static_cast<size_t>(std::popcount(uniform));
+    size_t denseCount = static_cast<size_t>(std::popcount(occupiedBricks)) - uniformCount;
 
-    // Format: [chunk_x][chunk_y][chunk_z][block_data]
-    // Chunk coordinates (3 x int32_t = 12 bytes)
-    outData.resize(12 + (CHUNK_VOLUME * sizeof(Block)));
+    outData.clear();
+    outData.resize(BRICK_HEADER_BYTES + ((uniformCount + (denseCount * BRICK_VOLUME)) * sizeof(Block)));
 
     size_t offset = 0;
+    writeValue(outData, offset, coord.x);
+    writeValue(outData, offset, coord.y);
+    writeValue(outData, offset, coord.z);
+    writeValue(outData, offset, BRICK_FORMAT_MAGIC);
+    writeValue(outData, offset, occupiedBricks);
+    writeValue(outData, offset, uniform);
 
-    // Write chunk coordinates
-    std::memcpy(outData.data() + offset, &coord.x, sizeof(int32_t));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    offset += sizeof(int32_t);
-    std::memcpy(outData.data() + offset, &coord.y, sizeof(int32_t));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    offset += sizeof(int32_t);
-    std::memcpy(outData.data() + offset, &coord.z, sizeof(int32_t));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    offset += sizeof(int32_t);
-
-    // Write block data
-    std::memcpy(outData.data() + offset, blocks.data(), CHUNK_VOLUME * sizeof(Block));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const ChunkBlocks& data = *blocks;
+    for (uint64_t remaining = occupiedBricks; remaining != 0; remaining &= remaining - 1) {
+        auto brickIndex = static_cast<uint32_t>(std::countr_zero(remaining));
+        uint32_t localCount = ((uniform >> brickIndex) & 1u) != 0 ? 1 : BRICK_VOLUME;
+        for (uint32_t local = 0; local < localCount; local++) {
+            writeValue(outData, offset, data[getBrickBlockIndex(brickIndex, local)]);
+        }
+    }
 }
 
 bool Chunk::deserialize(const std::vector<uint8_t>& data) {
-    // Verify size
-    const size_t EXPECTED_SIZE = 12 + (CHUNK_VOLUME * sizeof(Block));
-    if (data.size() != EXPECTED_SIZE) {
-        LOG_ERROR("Chunk deserialization failed: invalid data size {} (expected {})",
-                  data.size(), EXPECTED_SIZE);
+    // Legacy files are a fixed-size coordinate header followed by every block
+    bool legacy = data.size() == LEGACY_SIZE;
+    size_t offset = 0;
+
+    if (!legacy && data.size() < BRICK_HEADER_BYTES) {
+        LOG_ERROR("Chunk deserialization failed: invalid data size {}", data.size());
         return false;
     }
 
-    size_t offset = 0;
-
     // Read chunk coordinates
     ChunkCoord loadedCoord;
-    std::memcpy(&loadedCoord.x, data.data() + offset, sizeof(int32_t));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    offset += sizeof(int32_t);
-    std::memcpy(&loadedCoord.y, data.data() + offset, sizeof(int32_t));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    offset += sizeof(int32_t);
-    std::memcpy(&loadedCoord.z, data.data() + offset, sizeof(int32_t));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    offset += sizeof(int32_t);
+    loadedCoord.x = readValue<int32_t>(data, offset);
+    loadedCoord.y = readValue<int32_t>(data, offset);
+    loadedCoord.z = readValue<int32_t>(data, offset);
 
     // Verify coordinates match
     if (loadedCoord.x != coord.x || loadedCoord.y != coord.y || loadedCoord.z != coord.z) {
@@ -95,9 +247,54 @@ bool Chunk::deserialize(const std::vector<uint8_t>& data) {
         return false;
     }
 
-    // Read block data
-    std::memcpy(blocks.data(), data.data() + offset, CHUNK_VOLUME * sizeof(Block));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (legacy) {
+        makeBlocksUnique();
+        std::memcpy(blocks->data(), data.data() + offset, CHUNK_VOLUME * sizeof(Block));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        revision++;
+        updateBrickMasks();
+        dirty = false; // Freshly loaded chunks are clean
+        return true;
+    }
+
+    auto magic = readValue<uint32_t>(data, offset);
+    auto occupied = readValue<uint64_t>(data, offset);
+    auto uniform = readValue<uint64_t>(data, offset);
+    if (magic != BRICK_FORMAT_MAGIC || (uniform & ~occupied) != 0) {
+        LOG_ERROR("Chunk deserialization failed: bad brick header in chunk ({}, {}, {})",
+                  coord.x, coord.y, coord.z);
+        return false;
+    }
+
+    size_t uniformCount = static_cast<size_t>(std::popcount(uniform));
+    size_t denseCount = static_cast<size_t>(std::popcount(occupied)) - uniformCount;
+    const size_t EXPECTED_SIZE = BRICK_HEADER_BYTES + ((uniformCount + (denseCount * BRICK_VOLUME)) * sizeof(Block));
+    if (data.size() != EXPECTED_SIZE) {
+        LOG_ERROR("Chunk deserialization failed: invalid data size {} (expected {})",
+                  data.size(), EXPECTED_SIZE);
+        return false;
+    }
+
+    makeBlocksUnique();
+    revision++;
+    ChunkBlocks& out = *blocks;
+    std::fill(out.begin(), out.end(), Block{});
+    for (uint64_t remaining = occupied; remaining != 0; remaining &= remaining - 1) {
+        auto brickIndex = static_cast<uint32_t>(std::countr_zero(remaining));
+        if (((uniform >> brickIndex) & 1u) != 0) {
+            auto fill = readValue<Block>(data, offset);
+            for (uint32_t local = 0; local < BRICK_VOLUME; local++) {
+                out[getBrickBlockIndex(brickIndex, local)] = fill;
+            }
+        } else {
+            for (uint32_t local = 0; local < BRICK_VOLUME; local++) {
+                out[getBrickBlockIndex(brickIndex, local)] = readValue<Block>(data, offset);
+            }
+        }
+    }
 
+    // The saved masks still describe the blocks just read
+    occupiedBricks = occupied;
+    uniformBricks = uniform | ~occupied;
     dirty = false; // Freshly loaded chunks are clean
     return true;
 }
@@ -0,0 +1,88 @@
+#include "shared/ChunkOffsetTable.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace engine {
+
+const ChunkOffsetTable& ChunkOffsetTable::get(int32_t radius, int32_t verticalExtent) {
+    static std::mutex cacheMutex;
+    static std::map<std::pair<int32_t, int32_t>, std::unique_ptr<ChunkOffsetTable>> cache;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto& table = cache[{radius, verticalExtent}];
+    if (!table) {
+        table = std::make_unique<ChunkOffsetTable>(radius, verticalExtent);
+    }
+    return *table;
+}
+
+void ChunkOffsetTable::levelsNearestFirst(int32_t centerY, int32_t minChunkY, int32_t maxChunkY,
+                                          std::vector<int32_t>& outLevels) {
+    int32_t start = std::clamp(centerY, minChunkY, maxChunkY);
+
+    outLevels.clear();
+    outLevels.push_back(start);
+    for (int32_t distance = 1; start - distance >= minChunkY || start + distance <= maxChunkY; distance++) {
+        if (start - distance >= minChunkY) {
+            outLevels.push_back(start - distance);
+        }
+        if (start + distance <= maxChunkY) {
+            outLevels.push_back(start + distance);
+        }
+    }
+}
+
+ChunkOffsetTable::ChunkOffsetTable(int32_t radius, int32_t verticalExtent)
+    : radius(radius), verticalExtent(verticalExtent) {
+
+    // Largest |dx| with dx^2 + dz^2 <= r^2 for each row
+    rowHalfWidth.resize(static_cast<size_t>((2 * radius) + 1));
+    for (int32_t dz = -radius; dz <= radius; dz++) {  // NOLINT(readability-identifier-length)
+        int32_t halfWidth = 0;
+        while (((halfWidth + 1) * (halfWidth + 1)) + (dz * dz) <= radius * radius) {
+            halfWidth++;
+        }
+        rowHalfWidth[static_cast<size_t>(dz + radius)] = halfWidth;
+    }
+
+    for (int32_t dz = -radius; dz <= radius; dz++) {  // NOLINT(readability-identifier-length)
+        int32_t halfWidth = rowHalfWidth[static_cast<size_t>(dz + radius)];
+        for (int32_t dx = -halfWidth; dx <= halfWidth; dx++) {  // NOLINT(readability-identifier-length)
+            columns.push_back(ChunkCoord{dx, 0, dz});
+            for (int32_t dy = -verticalExtent; dy <= verticalExtent; dy++) {  // NOLINT(readability-identifier-length)
+                offsets.push_back(ChunkCoord{dx, dy, dz});
+            }
+        }
+    }
+
+    auto lengthSq = [](const ChunkCoord& offset) {
+        return (offset.x * offset.x) + (offset.y * offset.y) + (offset.z * offset.z);
+    };
+    auto nearerFirst = [&lengthSq](const ChunkCoord& lhs, const ChunkCoord& rhs) {
+        int32_t lhsLength = lengthSq(lhs);
+        int32_t rhsLength = lengthSq(rhs);
+        if (lhsLength != rhsLength) {
+            return lhsLength < rhsLength;
+        }
+        return std::abs(lhs.y) < std::abs(rhs.y);
+    };
+
+    // Stable so equal distances keep scan order and the table is deterministic
+    std::stable_sort(columns.begin(), columns.end(), nearerFirst);
+    std::stable_sort(offsets.begin(), offsets.end(), nearerFirst);
+
+    size_t side = static_cast<size_t>((2 * radius) + 1);
+    columnRank.assign(side * side, 0);
+    for (size_t rank = 0; rank < columns.size(); rank++) {
+        const ChunkCoord& column = columns[rank];
+        columnRank[(static_cast<size_t>(column.z + radius) * side) + static_cast<size_t>(column.x + radius)] =
+            static_cast<uint32_t>(rank);
+    }
+}
+
+} // namespace engine
@@ -1,6 +1,10 @@
 #include "shared/ChunkSerializer.hpp"
+#include "shared/BlockRegistry.hpp"
 #include "core/Logger.hpp"
+#include <algorithm>
+#include <bit>
 #include <cstring>
+#include <limits>
 
 namespace engine {
 
@@ -36,6 +40,220 @@ bool ChunkSerializer::deserialize(const uint8_t* buffer, size_t size, Chunk& out
     return true;
 }
 
+size_t ChunkSerializer::serializeBricks(const Chunk& chunk, std::vector<uint8_t>& outBuffer) {
+    outBuffer.clear();
+
+    uint64_t occupied = chunk.getOccupiedBricks();
+    uint64_t uniform = chunk.getUniformBricks();
+    const auto& blockData = chunk.getBlockData();
+
+    outBuffer.insert(outBuffer.end(),
+                    reinterpret_cast<const uint8_t*>(&occupied),  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                    reinterpret_cast<const uint8_t*>(&occupied) + sizeof(uint64_t));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    // Runs continue across brick boundaries; at most 64 * 512 blocks, so a run always fits a uint16_t
+    BlockType runType = BlockType::Air;
+    uint32_t runLength = 0;
+    auto extendRun = [&](BlockType type, uint32_t count) {
+        if (runLength > 0 && type != runType) {
+            appendRun(static_cast<uint16_t>(runLength), runType, outBuffer);
+            runLength = 0;
+        }
+        runType = type;
+        runLength += count;
+    };
+
+    for (uint64_t remaining = occupied; remaining != 0; remaining &= remaining - 1) {
+        auto brickIndex = static_cast<uint32_t>(std::countr_zero(remaining));
+        if (((uniform >> brickIndex) & 1u) != 0) {
+            extendRun(blockData[Chunk::getBrickBlockIndex(brickIndex, 0)].type, BRICK_VOLUME);
+            continue;
+        }
+        for (uint32_t local = 0; local < BRICK_VOLUME; local++) {
+            extendRun(blockData[Chunk::getBrickBlockIndex(brickIndex, local)].type, 1);
+        }
+    }
+    if (runLength > 0) {
+        appendRun(static_cast<uint16_t>(runLength), runType, outBuffer);
+    }
+
+    LOG_TRACE("Serialized chunk ({}, {}, {}) with bricks | Occupied: {}/{} | Compressed: {} bytes",
+              chunk.getCoord().x, chunk.getCoord().y, chunk.getCoord().z,
+              std::popcount(occupied), BRICK_COUNT, outBuffer.size());
+
+    return outBuffer.size();
+}
+
+bool ChunkSerializer::deserializeBricks(const uint8_t* buffer, size_t size, Chunk& outChunk) {
+    if (size < sizeof(uint64_t)) {
+        LOG_ERROR("Corrupted brick data: missing occupancy mask");
+        return false;
+    }
+
+    uint64_t occupied = 0;
+    std::memcpy(&occupied, buffer, sizeof(uint64_t));
+
+    // Decode the occupied bricks back to back, then scatter them into place
+    size_t brickCount = static_cast<size_t>(std::popcount(occupied));
+    std::vector<Block> packed(brickCount * BRICK_VOLUME);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (!decompressRLE(buffer + sizeof(uint64_t), size - sizeof(uint64_t), packed.data(), packed.size())) {
+        LOG_ERROR("Failed to decompress brick chunk data");
+        return false;
+    }
+
+    ChunkBlocks blocks{};
+    size_t packedPos = 0;
+    for (uint64_t remaining = occupied; remaining != 0; remaining &= remaining - 1) {
+        auto brickIndex = static_cast<uint32_t>(std::countr_zero(remaining));
+        for (uint32_t local = 0; local < BRICK_VOLUME; local++) {
+            blocks[Chunk::getBrickBlockIndex(brickIndex, local)] = packed[packedPos++];
+        }
+    }
+
+    outChunk.setBlockData(blocks);
+    return true;
+}
+
+size_t ChunkSerializer::serializeLight(const ChunkLight& light, std::vector<uint8_t>& outBuffer) {
+    size_t startSize = outBuffer.size();
+
+    if (light.isUniform()) {
+        outBuffer.push_back(light.getUniformValue());
+        return 1;
+    }
+
+    uint32_t idx = 0;
+    while (idx < CHUNK_VOLUME) {
+        uint8_t value = light.get(idx);
+        uint16_t runLength = 1;
+        while (idx + runLength < CHUNK_VOLUME && runLength < UINT16_MAX && light.get(idx + runLength) == value) {
+            runLength++;
+        }
+
+        outBuffer.insert(outBuffer.end(),
+                        reinterpret_cast<const uint8_t*>(&runLength),  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                        reinterpret_cast<const uint8_t*>(&runLength) + sizeof(uint16_t));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        outBuffer.push_back(value);
+
+        idx += runLength;
+    }
+
+    return outBuffer.size() - startSize;
+}
+
+bool ChunkSerializer::deserializeLight(const uint8_t* buffer, size_t size, ChunkLight& outLight) {
+    if (size == 1) {
+        outLight.fill(buffer[0] >> 4, buffer[0] & 0x0F);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return true;
+    }
+
+    constexpr size_t RUN_BYTES = sizeof(uint16_t) + sizeof(uint8_t);
+    if (size == 0 || size % RUN_BYTES != 0) {
+        LOG_ERROR("Corrupted light data: {} bytes", size);
+        return false;
+    }
+
+    // Start from the first run's value so a mostly-uniform store writes little
+    uint8_t firstValue = buffer[sizeof(uint16_t)];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    outLight.fill(firstValue >> 4, firstValue & 0x0F);
+
+    uint32_t lightPos = 0;
+    for (size_t bufferPos = 0; bufferPos < size; bufferPos += RUN_BYTES) {
+        uint16_t runLength = 0;
+        std::memcpy(&runLength, buffer + bufferPos, sizeof(uint16_t));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        uint8_t value = buffer[bufferPos + sizeof(uint16_t)];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        if (lightPos + runLength > CHUNK_VOLUME) {
+            LOG_ERROR("Corrupted light data: run would overflow the chunk");
+            return false;
+        }
+        if (value != firstValue) {
+            for (uint32_t i = 0; i < runLength; i++) {
+                outLight.set(lightPos + i, value);
+            }
+        }
+        lightPos += runLength;
+    }
+
+    if (lightPos != CHUNK_VOLUME) {
+        LOG_ERROR("Corrupted light data: decoded {} of {} values", lightPos, CHUNK_VOLUME);
+        return false;
+    }
+    return true;
+}
+
+size_t ChunkSerializer::serializeHeightmap(const ColumnHeightmap::Heights& heights, std::vector<uint8_t>& outBuffer) {
+    size_t startSize = outBuffer.size();
+
+    auto toStored = [](int32_t height) -> int16_t {
+        if (height == ColumnHeightmap::NO_BLOCKS) {
+            return std::numeric_limits<int16_t>::min();
+        }
+        return static_cast<int16_t>(std::clamp<int32_t>(height, std::numeric_limits<int16_t>::min() + 1,
+                                                         std::numeric_limits<int16_t>::max()));
+    };
+
+    size_t idx = 0;
+    while (idx < heights.size()) {
+        int16_t stored = toStored(heights[idx]);
+        uint16_t runLength = 1;
+        while (idx + runLength < heights.size() && toStored(heights[idx + runLength]) == stored) {
+            runLength++;
+        }
+
+        outBuffer.insert(outBuffer.end(),
+                        reinterpret_cast<const uint8_t*>(&runLength),  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                        reinterpret_cast<const uint8_t*>(&runLength) + sizeof(uint16_t));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        outBuffer.insert(outBuffer.end(),
+                        reinterpret_cast<const uint8_t*>(&stored),  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                        reinterpret_cast<const uint8_t*>(&stored) + sizeof(int16_t));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        idx += runLength;
+    }
+
+    return outBuffer.size() - startSize;
+}
+
+bool ChunkSerializer::deserializeHeightmap(const uint8_t* buffer, size_t size, ColumnHeightmap::Heights& outHeights) {
+    size_t bufferPos = 0;
+    size_t heightPos = 0;
+
+    while (bufferPos + sizeof(uint16_t) + sizeof(int16_t) <= size) {
+        uint16_t runLength = 0;
+        int16_t stored = 0;
+        std::memcpy(&runLength, buffer + bufferPos, sizeof(uint16_t));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memcpy(&stored, buffer + bufferPos + sizeof(uint16_t), sizeof(int16_t));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        bufferPos += sizeof(uint16_t) + sizeof(int16_t);
+
+        if (heightPos + runLength > outHeights.size()) {
+            LOG_ERROR("Corrupted heightmap: run would overflow the column");
+            return false;
+        }
+
+        int32_t height = stored == std::numeric_limits<int16_t>::min() ? ColumnHeightmap::NO_BLOCKS : stored;
+        std::fill_n(outHeights.begin() + static_cast<std::ptrdiff_t>(heightPos), runLength, height);
+        heightPos += runLength;
+    }
+
+    if (bufferPos != size || heightPos != outHeights.size()) {
+        LOG_ERROR("Corrupted heightmap: decoded {} of {} heights", heightPos, outHeights.size());
+        return false;
+    }
+
+    return true;
+}
+
+void ChunkSerializer::appendRun(uint16_t runLength, BlockType type, std::vector<uint8_t>& outBuffer) {
+    auto typeValue = static_cast<uint16_t>(type);
+    outBuffer.insert(outBuffer.end(),
+                    reinterpret_cast<const uint8_t*>(&runLength),  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                    reinterpret_cast<const uint8_t*>(&runLength) + sizeof(uint16_t));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    outBuffer.insert(outBuffer.end(),
+                    reinterpret_cast<const uint8_t*>(&typeValue),  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                    reinterpret_cast<const uint8_t*>(&typeValue) + sizeof(uint16_t));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
 size_t ChunkSerializer::compressRLE(const Block* blocks, size_t count, std::vector<uint8_t>& outBuffer) {
     outBuffer.reserve(count * sizeof(Block) / 4); // Estimate 4:1 compression
 
@@ -90,6 +308,10 @@ bool ChunkSerializer::decompressRLE(const uint8_t* buffer, size_t size, Block* o
         uint16_t blockType = 0;
         std::memcpy(&blockType, buffer + bufferPos, sizeof(uint16_t));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         bufferPos += sizeof(uint16_t);
+        if (!BlockRegistry::isValid(blockType)) {
+            LOG_ERROR("Corrupted RLE data: unknown block type {}", blockType);
+            return false;
+        }
 
         // Validate we won't overflow output
         if (blockPos + runLength > maxBlocks) {
@@ -0,0 +1,207 @@
+#include "shared/Collision.hpp"
+#include "shared/BlockRegistry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace engine {
+
+namespace {
+
+constexpr auto CHUNK_EXTENT = static_cast<int32_t>(CHUNK_SIZE);
+
+/// Tolerance for boxes resting exactly on block boundaries
+constexpr float EPSILON = 1e-4f;
+
+int32_t floorDiv(int32_t value, int32_t divisor) {
+    return (value >= 0) ? (value / divisor) : ((value - divisor + 1) / divisor);
+}
+
+int32_t floorToInt(float value) {
+    return static_cast<int32_t>(std::floor(value));
+}
+
+/**
+ * @brief Blocks a box covers on each axis, ignoring faces that only touch a block
+ */
+void coveredBlocks(const AABB& box, glm::ivec3& outLow, glm::ivec3& outHigh) {
+    for (int axis = 0; axis < 3; axis++) {
+        outLow[axis] = floorToInt(box.min[axis] + EPSILON);
+        outHigh[axis] = floorToInt(box.max[axis] - EPSILON);
+    }
+}
+
+} // namespace
+
+CollisionResolver::CollisionResolver(ChunkLookup lookup) : lookup(std::move(lookup)) {}
+
+CollisionResolver::MoveResult CollisionResolver::move(const AABB& box, const glm::vec3& displacement) {
+    MoveResult result;
+    for (int axis = 0; axis < 3; axis++) {
+        if (!std::isfinite(displacement[axis]) || std::abs(displacement[axis]) > MAX_MOVE_DISTANCE) {
+            result.blocked = glm::bvec3(true);
+            return result;
+        }
+    }
+
+    if (overlapsSolid(box)) {
+        result.offset = displacement;
+        result.startedInside = true;
+        return result;
+    }
+
+    // Vertical first, so walking into a step or ledge slides along its top
+    AABB current = box;
+    for (int axis : {1, 0, 2}) {
+        float distance = displacement[axis];
+        if (distance == 0.0f) {
+            continue;
+        }
+
+        float allowed = sweepAxis(current, axis, distance);
+        result.blocked[axis] = allowed != distance;
+        result.offset[axis] = allowed;
+        current.min[axis] += allowed;
+        current.max[axis] += allowed;
+    }
+    return result;
+}
+
+glm::vec3 CollisionResolver::movePlayer(const glm::vec3& eyePos, const glm::vec3& displacement) {
+    return eyePos + move(playerBoxAt(eyePos), displacement).offset;
+}
+
+bool CollisionResolver::overlapsSolid(const AABB& box) {
+    hasLast = false;
+
+    glm::ivec3 low;
+    glm::ivec3 high;
+    coveredBlocks(box, low, high);
+    return anySolid(low, high);
+}
+
+void CollisionResolver::clearCache() {
+    cache.clear();
+    hasLast = false;
+}
+
+float CollisionResolver::sweepAxis(const AABB& box, int axis, float distance) {
+    glm::ivec3 low;
+    glm::ivec3 high;
+    coveredBlocks(box, low, high);
+
+    // Walk the block layers the leading face enters, nearest first
+    if (distance > 0.0f) {
+        int32_t first = floorToInt(box.max[axis] - EPSILON) + 1;
+        int32_t last = floorToInt(box.max[axis] + distance - EPSILON);
+        for (int32_t layer = first; layer <= last; layer++) {
+            low[axis] = layer;
+            high[axis] = layer;
+            if (anySolid(low, high)) {
+                return std::min(distance, static_cast<float>(layer) - box.max[axis]);
+            }
+        }
+    } else {
+        int32_t first = static_cast<int32_t>(std::ceil(box.min[axis] + EPSILON)) - 1;
+        int32_t last = static_cast<int32_t>(std::ceil(box.min[axis] + distance + EPSILON)) - 1;
+        for (int32_t layer = first; layer >= last; layer--) {
+            low[axis] = layer;
+            high[axis] = layer;
+            if (anySolid(low, high)) {
+                return std::max(distance, static_cast<float>(layer + 1) - box.min[axis]);
+            }
+        }
+    }
+    return distance;
+}
+
+bool CollisionResolver::anySolid(const glm::ivec3& low, const glm::ivec3& high) {
+    for (int32_t chunkY = floorDiv(low.y, CHUNK_EXTENT); chunkY <= floorDiv(high.y, CHUNK_EXTENT); chunkY++) {
+        for (int32_t chunkZ = floorDiv(low.z, CHUNK_EXTENT); chunkZ <= floorDiv(high.z, CHUNK_EXTENT); chunkZ++) {
+            for (int32_t chunkX = floorDiv(low.x, CHUNK_EXTENT); chunkX <= floorDiv(high.x, CHUNK_EXTENT); chunkX++) {
+                const CachedSolidity* solidity = getSolidity(ChunkCoord{chunkX, chunkY, chunkZ});
+                if (solidity == nullptr || solidity->empty) {
+                    continue;
+                }
+
+                glm::ivec3 origin = glm::ivec3(chunkX, chunkY, chunkZ) * CHUNK_EXTENT;
+                glm::ivec3 localLow = glm::max(low - origin, glm::ivec3(0));
+                glm::ivec3 localHigh = glm::min(high - origin, glm::ivec3(CHUNK_EXTENT - 1));
+
+                auto rowMask = static_cast<uint32_t>(((uint64_t{1} << (localHigh.x - localLow.x + 1)) - 1) << localLow.x);
+                for (int32_t localY = localLow.y; localY <= localHigh.y; localY++) {
+                    for (int32_t localZ = localLow.z; localZ <= localHigh.z; localZ++) {
+                        if ((solidity->rows[(localY * CHUNK_EXTENT) + localZ] & rowMask) != 0) {
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+const CollisionResolver::CachedSolidity* CollisionResolver::getSolidity(const ChunkCoord& coord) {
+    if (hasLast && coord == lastCoord) {
+        return lastSolidity;
+    }
+
+    const CachedSolidity* solidity = nullptr;
+    if (const Chunk* chunk = lookup(coord)) {
+        if (cache.size() >= MAX_CACHED_CHUNKS && cache.find(coord) == cache.end()) {
+            cache.clear();
+        }
+        CachedSolidity& entry = cache[coord];
+        if (entry.chunk != chunk || entry.revision != chunk->getRevision()) {
+            buildSolidity(*chunk, entry);
+        }
+        solidity = &entry;
+    }
+
+    lastCoord = coord;
+    lastSolidity = solidity;
+    hasLast = true;
+    return solidity;
+}
+
+void CollisionResolver::buildSolidity(const Chunk& chunk, CachedSolidity& out) {
+    out.chunk = &chunk;
+    out.revision = chunk.getRevision();
+    out.rows.fill(0);
+    out.empty = true;
+
+    const ChunkBlocks& blocks = chunk.getBlockData();
+    for (uint32_t brickIndex = 0; brickIndex < BRICK_COUNT; brickIndex++) {
+        BrickState state = chunk.getBrickState(brickIndex);
+        uint32_t originIndex = Chunk::getBrickBlockIndex(brickIndex, 0);
+        if (state == BrickState::Empty ||
+            (state == BrickState::Uniform && !BlockRegistry::isSolid(blocks[originIndex].type))) {
+            continue;
+        }
+
+        uint32_t originX = originIndex % CHUNK_SIZE;
+        uint32_t originZ = (originIndex / CHUNK_SIZE) % CHUNK_SIZE;
+        uint32_t originY = originIndex / (CHUNK_SIZE * CHUNK_SIZE);
+
+        for (uint32_t y = originY; y < originY + BRICK_SIZE; y++) {  // NOLINT(readability-identifier-length)
+            for (uint32_t z = originZ; z < originZ + BRICK_SIZE; z++) {  // NOLINT(readability-identifier-length)
+                uint32_t& row = out.rows[(y * CHUNK_SIZE) + z];
+                if (state == BrickState::Uniform) {
+                    row |= ((1u << BRICK_SIZE) - 1) << originX;
+                    continue;
+                }
+                for (uint32_t x = originX; x < originX + BRICK_SIZE; x++) {  // NOLINT(readability-identifier-length)
+                    if (BlockRegistry::isSolid(blocks[Chunk::getIndex(x, y, z)].type)) {
+                        row |= 1u << x;
+                    }
+                }
+            }
+        }
+    }
+
+    out.empty = std::all_of(out.rows.begin(), out.rows.end(), [](uint32_t row) { return row == 0; });
+}
+
+} // namespace engine
@@ -0,0 +1,137 @@
+#include "shared/ColumnHeightmap.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace engine {
+
+namespace {
+
+constexpr auto SECTION_HEIGHT = static_cast<int32_t>(CHUNK_SIZE);
+
+/**
+ * @brief Get the chunk level a world Y lies in
+ */
+int32_t levelOf(int32_t worldY) {
+    return worldY >= 0 ? worldY / SECTION_HEIGHT : ((worldY + 1) / SECTION_HEIGHT) - 1;
+}
+
+} // namespace
+
+ColumnHeightmap::ColumnHeightmap() {
+    heights.fill(NO_BLOCKS);
+}
+
+void ColumnHeightmap::setSection(const Chunk& chunk, const SectionLookup& lookup) {
+    int32_t chunkY = chunk.getCoord().y;
+    if (sectionEmpty.contains(chunkY)) {
+        removeSection(chunkY, lookup);
+    }
+
+    sectionEmpty[chunkY] = chunk.isEmpty();
+    if (chunk.isEmpty()) {
+        return;
+    }
+
+    int32_t base = chunkY * SECTION_HEIGHT;
+    for (uint32_t localZ = 0; localZ < CHUNK_SIZE; localZ++) {
+        for (uint32_t localX = 0; localX < CHUNK_SIZE; localX++) {
+            int32_t& height = heights[(localZ * CHUNK_SIZE) + localX];
+            if (height >= base + SECTION_HEIGHT) {
+                continue;  // A higher section already covers this (x, z)
+            }
+            int32_t top = scanColumn(chunk, localX, localZ);
+            if (top >= 0) {
+                height = std::max(height, base + top);
+            }
+        }
+    }
+}
+
+void ColumnHeightmap::setColumn(const std::vector<int32_t>& levels, const std::vector<bool>& emptyFlags,
+                                const Heights& columnHeights) {
+    for (size_t i = 0; i < levels.size() && i < emptyFlags.size(); i++) {
+        sectionEmpty[levels[i]] = emptyFlags[i];
+    }
+    heights = columnHeights;
+}
+
+void ColumnHeightmap::removeSection(int32_t chunkY, const SectionLookup& lookup) {
+    auto sectionIt = sectionEmpty.find(chunkY);
+    if (sectionIt == sectionEmpty.end()) {
+        return;
+    }
+
+    bool wasEmpty = sectionIt->second;
+    sectionEmpty.erase(sectionIt);
+    if (wasEmpty) {
+        return;
+    }
+
+    for (uint32_t index = 0; index < COLUMN_AREA; index++) {
+        if (heights[index] != NO_BLOCKS && levelOf(heights[index]) == chunkY) {
+            heights[index] = scanBelow(index, chunkY, lookup);
+        }
+    }
+}
+
+void ColumnHeightmap::updateBlockColumn(const Chunk& chunk, uint32_t localX, uint32_t localZ,
+                                        const SectionLookup& lookup) {
+    int32_t chunkY = chunk.getCoord().y;
+    sectionEmpty[chunkY] = chunk.isEmpty();
+
+    uint32_t index = (localZ * CHUNK_SIZE) + localX;
+    int32_t& height = heights[index];
+    if (height != NO_BLOCKS && levelOf(height) > chunkY) {
+        return;  // The top block is in a higher section
+    }
+
+    int32_t top = scanColumn(chunk, localX, localZ);
+    if (top >= 0) {
+        height = (chunkY * SECTION_HEIGHT) + top;
+    } else if (height != NO_BLOCKS && levelOf(height) == chunkY) {
+        height = scanBelow(index, chunkY, lookup);
+    }
+}
+
+bool ColumnHeightmap::isSectionEmpty(int32_t chunkY) const {
+    auto sectionIt = sectionEmpty.find(chunkY);
+    return sectionIt != sectionEmpty.end() && sectionIt->second;
+}
+
+int32_t ColumnHeightmap::scanColumn(const Chunk& chunk, uint32_t localX, uint32_t localZ) {
+    for (uint32_t brickY = BRICKS_PER_AXIS; brickY-- > 0;) {
+        if (chunk.isBrickEmpty(Chunk::getBrickIndex(localX / BRICK_SIZE, brickY, localZ / BRICK_SIZE))) {
+            continue;
+        }
+        for (uint32_t localY = (brickY + 1) * BRICK_SIZE; localY-- > brickY * BRICK_SIZE;) {
+            if (chunk.getBlock(localX, localY, localZ).type != BlockType::Air) {
+                return static_cast<int32_t>(localY);
+            }
+        }
+    }
+    return -1;
+}
+
+int32_t ColumnHeightmap::scanBelow(uint32_t index, int32_t belowChunkY, const SectionLookup& lookup) const {
+    uint32_t localX = index % CHUNK_SIZE;
+    uint32_t localZ = index / CHUNK_SIZE;
+
+    for (auto sectionIt = std::make_reverse_iterator(sectionEmpty.lower_bound(belowChunkY));
+         sectionIt != sectionEmpty.rend(); ++sectionIt) {
+        if (sectionIt->second) {
+            continue;
+        }
+        const Chunk* section = lookup(sectionIt->first);
+        if (section == nullptr) {
+            continue;
+        }
+        int32_t top = scanColumn(*section, localX, localZ);
+        if (top >= 0) {
+            return (sectionIt->first * SECTION_HEIGHT) + top;
+        }
+    }
+    return NO_BLOCKS;
+}
+
+} // namespace engine
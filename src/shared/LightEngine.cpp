@@ -0,0 +1,549 @@
+#include "shared/LightEngine.hpp"
+#include "core/Logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace engine {
+
+namespace {
+
+constexpr int32_t SIZE = static_cast<int32_t>(CHUNK_SIZE);
+constexpr uint32_t COLUMN_AREA = CHUNK_SIZE * CHUNK_SIZE;
+constexpr uint8_t MAX_LEVEL = ChunkLight::MAX_LEVEL;
+
+/// Unit step of each direction, in BlockFace order
+constexpr std::array<std::array<int32_t, 3>, BLOCK_FACE_COUNT> DIRECTIONS{{
+    {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}
+}};
+constexpr int DOWN = static_cast<int>(BlockFace::NegY);
+constexpr int UP = static_cast<int>(BlockFace::PosY);
+
+uint8_t channelLevel(uint8_t packed, bool sky) {
+    return sky ? static_cast<uint8_t>(packed >> 4) : static_cast<uint8_t>(packed & 0x0F);
+}
+
+uint8_t withChannelLevel(uint8_t packed, bool sky, uint8_t level) {
+    return sky ? ChunkLight::pack(level, packed & 0x0F) : ChunkLight::pack(packed >> 4, level);
+}
+
+/**
+ * @brief Level light arrives with after one step (skylight keeps full strength going down)
+ */
+uint8_t stepLevel(uint8_t level, bool sky, int direction) {
+    return (sky && direction == DOWN && level == MAX_LEVEL) ? MAX_LEVEL : static_cast<uint8_t>(level - 1);
+}
+
+bool isOpaqueAt(const Chunk& chunk, uint32_t index) {
+    return BlockRegistry::isOpaque(chunk.getBlockData()[index].type);
+}
+
+uint64_t microsSince(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+/**
+ * @brief Flood one channel through a section from queued block indices
+ */
+void floodSection(const Chunk& chunk, ChunkLight::Values& values, std::vector<uint32_t>& queue, bool sky) {
+    for (size_t head = 0; head < queue.size(); head++) {
+        uint32_t index = queue[head];
+        uint8_t level = channelLevel(values[index], sky);
+        if (level <= 1) {
+            continue;
+        }
+
+        auto localX = static_cast<int32_t>(index % CHUNK_SIZE);
+        auto localZ = static_cast<int32_t>((index / CHUNK_SIZE) % CHUNK_SIZE);
+        auto localY = static_cast<int32_t>(index / COLUMN_AREA);
+        for (int direction = 0; direction < static_cast<int>(BLOCK_FACE_COUNT); direction++) {
+            int32_t nextX = localX + DIRECTIONS[direction][0];
+            int32_t nextY = localY + DIRECTIONS[direction][1];
+            int32_t nextZ = localZ + DIRECTIONS[direction][2];
+            if (nextX < 0 || nextX >= SIZE || nextY < 0 || nextY >= SIZE || nextZ < 0 || nextZ >= SIZE) {
+                continue;
+            }
+
+            uint32_t nextIndex = Chunk::getIndex(nextX, nextY, nextZ);
+            uint8_t nextLevel = stepLevel(level, sky, direction);
+            if (channelLevel(values[nextIndex], sky) >= nextLevel || isOpaqueAt(chunk, nextIndex)) {
+                continue;
+            }
+            values[nextIndex] = withChannelLevel(values[nextIndex], sky, nextLevel);
+            queue.push_back(nextIndex);
+        }
+    }
+}
+
+} // namespace
+
+LightEngine::LightEngine(ChunkLookup lookup) : lookup(std::move(lookup)) {}
+
+void LightEngine::enqueueSection(const ChunkCoord& coord) {
+    freshSections.push_back(coord);
+}
+
+void LightEngine::enqueueBorderMerge(const ChunkCoord& coord) {
+    mergeSections.push_back(coord);
+}
+
+void LightEngine::enqueueEdit(const glm::ivec3& worldPos, BlockType previous) {
+    edits.push_back(PendingEdit{worldPos, previous});
+}
+
+void LightEngine::process(std::unordered_set<ChunkCoord>* outChanged) {
+    changed = outChanged;
+    lastMarked = nullptr;
+
+    if (!freshSections.empty()) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<ChunkCoord> coords;
+        coords.swap(freshSections);
+        size_t litCount = processFresh(coords);
+
+        if (litCount > 0) {
+            uint64_t elapsedUs = microsSince(start);
+            stats.sections += litCount;
+            stats.sectionBatches++;
+            stats.sectionMicrosTotal += elapsedUs;
+            stats.sectionMicrosMax = std::max(stats.sectionMicrosMax, elapsedUs);
+        }
+    }
+
+    if (!mergeSections.empty()) {
+        std::unordered_set<ChunkCoord> batch;
+        std::vector<Chunk*> sections;
+        for (const ChunkCoord& coord : mergeSections) {
+            Chunk* chunk = lookup(coord);
+            if (chunk != nullptr && batch.insert(coord).second) {
+                sections.push_back(chunk);
+            }
+        }
+        mergeSections.clear();
+
+        seedBorders(sections, batch);
+        propagate(skyQueues, true);
+        propagate(blockQueues, false);
+        stats.merges += sections.size();
+    }
+
+    if (!edits.empty()) {
+        auto start = std::chrono::steady_clock::now();
+        size_t editCount = edits.size();
+        processEdits();
+
+        uint64_t elapsedUs = microsSince(start);
+        stats.edits += editCount;
+        stats.editBatches++;
+        stats.editMicrosTotal += elapsedUs;
+        stats.editMicrosMax = std::max(stats.editMicrosMax, elapsedUs);
+    }
+
+    changed = nullptr;
+}
+
+size_t LightEngine::processFresh(const std::vector<ChunkCoord>& coords) {
+    std::unordered_set<ChunkCoord> batch;
+    std::vector<Chunk*> sections;
+    for (const ChunkCoord& coord : coords) {
+        Chunk* chunk = lookup(coord);
+        if (chunk != nullptr && batch.insert(coord).second) {
+            sections.push_back(chunk);
+        }
+    }
+    if (sections.empty()) {
+        return 0;
+    }
+
+    // Column by column, top section first, so each section can read the
+    // straight-down skylight leaving the one above it
+    std::sort(sections.begin(), sections.end(), [](const Chunk* lhs, const Chunk* rhs) {
+        const ChunkCoord& lhsCoord = lhs->getCoord();
+        const ChunkCoord& rhsCoord = rhs->getCoord();
+        if (lhsCoord.x != rhsCoord.x) { return lhsCoord.x < rhsCoord.x; }
+        if (lhsCoord.z != rhsCoord.z) { return lhsCoord.z < rhsCoord.z; }
+        return lhsCoord.y > rhsCoord.y;
+    });
+
+    std::vector<std::vector<bool>> skyFromAbove(sections.size());
+    std::unordered_map<ChunkCoord, std::vector<bool>> skyLeaving;  ///< Full skylight leaving each batch section's bottom
+    for (size_t i = 0; i < sections.size(); i++) {
+        const Chunk& chunk = *sections[i];
+        ChunkCoord above{chunk.getCoord().x, chunk.getCoord().y + 1, chunk.getCoord().z};
+
+        std::vector<bool>& incoming = skyFromAbove[i];
+        auto leavingIt = skyLeaving.find(above);
+        if (leavingIt != skyLeaving.end()) {
+            incoming = leavingIt->second;
+        } else if (const Chunk* aboveChunk = lookup(above)) {
+            incoming.resize(COLUMN_AREA);
+            for (uint32_t localZ = 0; localZ < CHUNK_SIZE; localZ++) {
+                for (uint32_t localX = 0; localX < CHUNK_SIZE; localX++) {
+                    incoming[(localZ * CHUNK_SIZE) + localX] =
+                        aboveChunk->getLight().getSky(Chunk::getIndex(localX, 0, localZ)) == MAX_LEVEL;
+                }
+            }
+        } else {
+            // Nothing loaded above: open sky
+            incoming.assign(COLUMN_AREA, true);
+        }
+
+        std::vector<bool> leaving = incoming;
+        if (!chunk.isEmpty()) {
+            for (uint32_t localZ = 0; localZ < CHUNK_SIZE; localZ++) {
+                for (uint32_t localX = 0; localX < CHUNK_SIZE; localX++) {
+                    uint32_t column = (localZ * CHUNK_SIZE) + localX;
+                    for (uint32_t localY = 0; localY < CHUNK_SIZE && leaving[column]; localY++) {
+                        if (isOpaqueAt(chunk, Chunk::getIndex(localX, localY, localZ))) {
+                            leaving[column] = false;
+                        }
+                    }
+                }
+            }
+        }
+        skyLeaving[chunk.getCoord()] = std::move(leaving);
+    }
+
+    // Sections light independently now that their incoming skylight is known
+    size_t workerCount = std::min<size_t>(sections.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::future<void>> workers;
+    workers.reserve(workerCount);
+    for (size_t worker = 0; worker < workerCount; worker++) {
+        workers.push_back(std::async(std::launch::async, [&, worker]() {
+            for (size_t i = worker; i < sections.size(); i += workerCount) {
+                lightSection(*sections[i], skyFromAbove[i]);
+            }
+        }));
+    }
+    for (auto& future : workers) {
+        future.get();
+    }
+
+    if (changed != nullptr) {
+        for (const Chunk* chunk : sections) {
+            changed->insert(chunk->getCoord());
+        }
+    }
+
+    seedBorders(sections, batch);
+    propagate(skyQueues, true);
+    propagate(blockQueues, false);
+    return sections.size();
+}
+
+void LightEngine::lightSection(Chunk& chunk, const std::vector<bool>& skyFromAbove) {
+    bool allSky = std::all_of(skyFromAbove.begin(), skyFromAbove.end(), [](bool sky) { return sky; });
+    bool noSky = std::none_of(skyFromAbove.begin(), skyFromAbove.end(), [](bool sky) { return sky; });
+    if (chunk.isEmpty() && (allSky || noSky)) {
+        // Air doesn't emit, so an empty section is uniformly lit or dark
+        chunk.getLight().fill(allSky ? MAX_LEVEL : 0, 0);
+        return;
+    }
+
+    ChunkLight::Values values{};
+    std::vector<uint32_t> queue;
+
+    // Straight-down skylight, stopping at the first opaque block
+    for (uint32_t localZ = 0; localZ < CHUNK_SIZE; localZ++) {
+        for (uint32_t localX = 0; localX < CHUNK_SIZE; localX++) {
+            if (!skyFromAbove[(localZ * CHUNK_SIZE) + localX]) {
+                continue;
+            }
+            for (int32_t localY = SIZE - 1; localY >= 0; localY--) {
+                uint32_t index = Chunk::getIndex(localX, localY, localZ);
+                if (isOpaqueAt(chunk, index)) {
+                    break;
+                }
+                values[index] = ChunkLight::pack(MAX_LEVEL, 0);
+            }
+        }
+    }
+
+    // Only full-sky blocks next to a darker open block have anywhere to spread
+    for (uint32_t index = 0; index < CHUNK_VOLUME; index++) {
+        if (channelLevel(values[index], true) != MAX_LEVEL) {
+            continue;
+        }
+        auto localX = static_cast<int32_t>(index % CHUNK_SIZE);
+        auto localZ = static_cast<int32_t>((index / CHUNK_SIZE) % CHUNK_SIZE);
+        auto localY = static_cast<int32_t>(index / COLUMN_AREA);
+        for (int direction = 0; direction < static_cast<int>(BLOCK_FACE_COUNT); direction++) {
+            if (direction == DOWN || direction == UP) {
+                continue;
+            }
+            int32_t nextX = localX + DIRECTIONS[direction][0];
+            int32_t nextZ = localZ + DIRECTIONS[direction][2];
+            if (nextX < 0 || nextX >= SIZE || nextZ < 0 || nextZ >= SIZE) {
+                continue;
+            }
+            uint32_t nextIndex = Chunk::getIndex(nextX, localY, nextZ);
+            if (channelLevel(values[nextIndex], true) != MAX_LEVEL && !isOpaqueAt(chunk, nextIndex)) {
+                queue.push_back(index);
+                break;
+            }
+        }
+    }
+    floodSection(chunk, values, queue, true);
+
+    queue.clear();
+    if (!chunk.isEmpty()) {
+        const ChunkBlocks& blocks = chunk.getBlockData();
+        for (uint32_t index = 0; index < CHUNK_VOLUME; index++) {
+            uint8_t emission = BlockRegistry::getLightEmission(blocks[index].type);
+            if (emission > 0) {
+                values[index] = withChannelLevel(values[index], false, emission);
+                queue.push_back(index);
+            }
+        }
+    }
+    floodSection(chunk, values, queue, false);
+
+    chunk.getLight().assign(values);
+}
+
+void LightEngine::seedBorders(const std::vector<Chunk*>& sections, const std::unordered_set<ChunkCoord>& batch) {
+    auto seed = [this](const LightNode& node) {
+        uint8_t packed = node.chunk->getLight().get(Chunk::getIndex(node.x, node.y, node.z));
+        if (channelLevel(packed, true) > 1) {
+            skyQueues.add.push_back(node);
+        }
+        if (channelLevel(packed, false) > 1) {
+            blockQueues.add.push_back(node);
+        }
+    };
+
+    for (Chunk* section : sections) {
+        const ChunkCoord& coord = section->getCoord();
+        for (int direction = 0; direction < static_cast<int>(BLOCK_FACE_COUNT); direction++) {
+            ChunkCoord neighborCoord{coord.x + DIRECTIONS[direction][0], coord.y + DIRECTIONS[direction][1],
+                                     coord.z + DIRECTIONS[direction][2]};
+            Chunk* neighbor = lookup(neighborCoord);
+            if (neighbor == nullptr) {
+                continue;
+            }
+            // Batch neighbours seed their own borders
+            bool neighborInBatch = batch.contains(neighborCoord);
+
+            int axis = direction / 2;
+            int tangentU = (axis + 1) % 3;
+            int tangentV = (axis + 2) % 3;
+            bool positive = (direction % 2) != 0;
+            for (int32_t cellV = 0; cellV < SIZE; cellV++) {
+                for (int32_t cellU = 0; cellU < SIZE; cellU++) {
+                    std::array<int32_t, 3> own{};
+                    own[axis] = positive ? SIZE - 1 : 0;
+                    own[tangentU] = cellU;
+                    own[tangentV] = cellV;
+                    std::array<int32_t, 3> across = own;
+                    across[axis] = positive ? 0 : SIZE - 1;
+
+                    LightNode ownNode{section, static_cast<uint8_t>(own[0]), static_cast<uint8_t>(own[1]),
+                                      static_cast<uint8_t>(own[2]), 0};
+                    LightNode acrossNode{neighbor, static_cast<uint8_t>(across[0]), static_cast<uint8_t>(across[1]),
+                                         static_cast<uint8_t>(across[2]), 0};
+                    seed(ownNode);
+                    if (neighborInBatch) {
+                        continue;
+                    }
+                    seed(acrossNode);
+
+                    // The section below may have been lit as open sky before this one arrived
+                    if (direction == DOWN) {
+                        ChunkLight& belowLight = neighbor->getLight();
+                        uint32_t belowIndex = Chunk::getIndex(across[0], across[1], across[2]);
+                        if (belowLight.getSky(belowIndex) == MAX_LEVEL &&
+                            section->getLight().getSky(Chunk::getIndex(own[0], own[1], own[2])) != MAX_LEVEL) {
+                            belowLight.setSky(belowIndex, 0);
+                            markChanged(acrossNode);
+                            acrossNode.level = MAX_LEVEL;
+                            skyQueues.remove.push_back(acrossNode);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void LightEngine::processEdits() {
+    for (const PendingEdit& edit : edits) {
+        ChunkCoord coord = ChunkCoord::fromWorldPos(glm::vec3(edit.worldPos));
+        Chunk* chunk = lookup(coord);
+        if (chunk == nullptr) {
+            continue;
+        }
+
+        glm::ivec3 local = edit.worldPos - (glm::ivec3(coord.x, coord.y, coord.z) * SIZE);
+        LightNode node{chunk, static_cast<uint8_t>(local.x), static_cast<uint8_t>(local.y),
+                       static_cast<uint8_t>(local.z), 0};
+        uint32_t index = Chunk::getIndex(node.x, node.y, node.z);
+        ChunkLight& light = chunk->getLight();
+        BlockType current = chunk->getBlockData()[index].type;
+        if (current == edit.previous) {
+            continue;
+        }
+
+        // Clear whatever light passed through or came from the old block
+        uint8_t packed = light.get(index);
+        light.set(index, 0);
+        markChanged(node);
+        for (bool sky : {true, false}) {
+            uint8_t level = channelLevel(packed, sky);
+            if (level > 0) {
+                LightNode removal = node;
+                removal.level = level;
+                (sky ? skyQueues : blockQueues).remove.push_back(removal);
+            }
+        }
+
+        uint8_t emission = BlockRegistry::getLightEmission(current);
+        if (emission > 0) {
+            light.setBlock(index, emission);
+            blockQueues.add.push_back(node);
+        }
+
+        // An open block refills from its neighbours
+        if (!BlockRegistry::isOpaque(current)) {
+            for (int direction = 0; direction < static_cast<int>(BLOCK_FACE_COUNT); direction++) {
+                LightNode neighbor{};
+                if (step(node, direction, neighbor)) {
+                    skyQueues.add.push_back(neighbor);
+                    blockQueues.add.push_back(neighbor);
+                } else if (direction == UP) {
+                    // Nothing loaded above: open sky
+                    light.setSky(index, MAX_LEVEL);
+                    skyQueues.add.push_back(node);
+                }
+            }
+        }
+    }
+    edits.clear();
+
+    propagate(skyQueues, true);
+    propagate(blockQueues, false);
+}
+
+void LightEngine::propagate(ChannelQueues& queues, bool sky) {
+    propagateRemove(queues, sky);
+    propagateAdd(queues, sky);
+}
+
+void LightEngine::propagateRemove(ChannelQueues& queues, bool sky) {
+    for (size_t head = 0; head < queues.remove.size(); head++) {
+        LightNode node = queues.remove[head];
+        for (int direction = 0; direction < static_cast<int>(BLOCK_FACE_COUNT); direction++) {
+            LightNode neighbor{};
+            if (!step(node, direction, neighbor)) {
+                continue;
+            }
+
+            ChunkLight& light = neighbor.chunk->getLight();
+            uint32_t index = Chunk::getIndex(neighbor.x, neighbor.y, neighbor.z);
+            uint8_t packed = light.get(index);
+            uint8_t level = channelLevel(packed, sky);
+            if (level == 0) {
+                continue;
+            }
+
+            // Light lower than ours (or full skylight straight below) may have come from us
+            bool dependent = level < node.level || (sky && direction == DOWN && node.level == MAX_LEVEL && level == MAX_LEVEL);
+            if (!dependent) {
+                queues.add.push_back(neighbor);
+                continue;
+            }
+
+            uint8_t emission = sky ? 0 : BlockRegistry::getLightEmission(neighbor.chunk->getBlockData()[index].type);
+            light.set(index, withChannelLevel(packed, sky, emission));
+            markChanged(neighbor);
+            neighbor.level = level;
+            queues.remove.push_back(neighbor);
+            if (emission > 0) {
+                queues.add.push_back(neighbor);
+            }
+        }
+    }
+    queues.remove.clear();
+}
+
+void LightEngine::propagateAdd(ChannelQueues& queues, bool sky) {
+    for (size_t head = 0; head < queues.add.size(); head++) {
+        LightNode node = queues.add[head];
+        uint8_t level = channelLevel(node.chunk->getLight().get(Chunk::getIndex(node.x, node.y, node.z)), sky);
+        if (level <= 1) {
+            continue;
+        }
+
+        for (int direction = 0; direction < static_cast<int>(BLOCK_FACE_COUNT); direction++) {
+            LightNode neighbor{};
+            if (!step(node, direction, neighbor)) {
+                continue;
+            }
+
+            uint32_t index = Chunk::getIndex(neighbor.x, neighbor.y, neighbor.z);
+            uint8_t nextLevel = stepLevel(level, sky, direction);
+            ChunkLight& light = neighbor.chunk->getLight();
+            uint8_t packed = light.get(index);
+            if (channelLevel(packed, sky) >= nextLevel || isOpaqueAt(*neighbor.chunk, index)) {
+                continue;
+            }
+
+            light.set(index, withChannelLevel(packed, sky, nextLevel));
+            markChanged(neighbor);
+            queues.add.push_back(neighbor);
+        }
+    }
+    queues.add.clear();
+}
+
+bool LightEngine::step(const LightNode& node, int direction, LightNode& outNeighbor) {
+    int32_t nextX = node.x + DIRECTIONS[direction][0];
+    int32_t nextY = node.y + DIRECTIONS[direction][1];
+    int32_t nextZ = node.z + DIRECTIONS[direction][2];
+    Chunk* chunk = node.chunk;
+
+    if (nextX < 0 || nextX >= SIZE || nextY < 0 || nextY >= SIZE || nextZ < 0 || nextZ >= SIZE) {
+        // Crossing into the neighbouring chunk (only one axis can be out of range)
+        const ChunkCoord& coord = chunk->getCoord();
+        chunk = lookup(ChunkCoord{coord.x + DIRECTIONS[direction][0], coord.y + DIRECTIONS[direction][1],
+                                  coord.z + DIRECTIONS[direction][2]});
+        if (chunk == nullptr) {
+            return false;
+        }
+        nextX = (nextX + SIZE) % SIZE;
+        nextY = (nextY + SIZE) % SIZE;
+        nextZ = (nextZ + SIZE) % SIZE;
+    }
+
+    outNeighbor = LightNode{chunk, static_cast<uint8_t>(nextX), static_cast<uint8_t>(nextY),
+                            static_cast<uint8_t>(nextZ), 0};
+    return true;
+}
+
+void LightEngine::markChanged(const LightNode& node) {
+    if (changed == nullptr) {
+        return;
+    }
+
+    const ChunkCoord& coord = node.chunk->getCoord();
+    if (node.chunk != lastMarked) {
+        changed->insert(coord);
+        lastMarked = node.chunk;
+    }
+
+    // Faces of the neighbouring chunk facing this block are shaded by it
+    constexpr uint8_t LAST = CHUNK_SIZE - 1;
+    if (node.x == 0) { changed->insert(ChunkCoord{coord.x - 1, coord.y, coord.z}); }
+    if (node.x == LAST) { changed->insert(ChunkCoord{coord.x + 1, coord.y, coord.z}); }
+    if (node.y == 0) { changed->insert(ChunkCoord{coord.x, coord.y - 1, coord.z}); }
+    if (node.y == LAST) { changed->insert(ChunkCoord{coord.x, coord.y + 1, coord.z}); }
+    if (node.z == 0) { changed->insert(ChunkCoord{coord.x, coord.y, coord.z - 1}); }
+    if (node.z == LAST) { changed->insert(ChunkCoord{coord.x, coord.y, coord.z + 1}); }
+}
+
+} // namespace engine
@@ -0,0 +1,86 @@
+#include "shared/NetworkStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine {
+
+void NetworkStats::recordSent(protocol::MessageType type, size_t bytes) {
+    Counter& counter = sent[static_cast<uint8_t>(type)];
+    counter.packets++;
+    counter.bytes += bytes;
+    totalSent.packets++;
+    totalSent.bytes += bytes;
+}
+
+void NetworkStats::recordReceived(protocol::MessageType type, size_t bytes) {
+    Counter& counter = received[static_cast<uint8_t>(type)];
+    counter.packets++;
+    counter.bytes += bytes;
+    totalReceived.packets++;
+    totalReceived.bytes += bytes;
+}
+
+void NetworkStats::addRttSample(float rttMs) {
+    lastRtt = rttMs;
+
+    if (rttSamples == 0) {
+        smoothedRtt = rttMs;
+        rttVariance = rttMs / 2.0f;
+        minRtt = rttMs;
+    } else {
+        rttVariance = (0.75f * rttVariance) + (0.25f * std::abs(smoothedRtt - rttMs));
+        smoothedRtt = (0.875f * smoothedRtt) + (0.125f * rttMs);
+        minRtt = std::min(minRtt, rttMs);
+    }
+
+    rttSamples++;
+}
+
+void NetworkStats::updateRates() {
+    auto now = std::chrono::steady_clock::now();
+    float elapsed = std::chrono::duration<float>(now - rateWindowStart).count();
+    if (elapsed < 1.0f) {
+        return;
+    }
+
+    sendRate = static_cast<float>(totalSent.bytes - rateWindowSentBytes) / elapsed;
+    receiveRate = static_cast<float>(totalReceived.bytes - rateWindowReceivedBytes) / elapsed;
+
+    rateWindowStart = now;
+    rateWindowSentBytes = totalSent.bytes;
+    rateWindowReceivedBytes = totalReceived.bytes;
+}
+
+const char* NetworkStats::getMessageTypeName(protocol::MessageType type) {
+    using protocol::MessageType;
+
+    switch (type) {
+        case MessageType::ClientJoin: return "ClientJoin";
+        case MessageType::PlayerMove: return "PlayerMove";
+        case MessageType::BlockPlace: return "BlockPlace";
+        case MessageType::BlockBreak: return "BlockBreak";
+        case MessageType::InventoryUpdate: return "InventoryUpdate";
+        case MessageType::ChunkData: return "ChunkData";
+        case MessageType::ChunkUnload: return "ChunkUnload";
+        case MessageType::BlockUpdate: return "BlockUpdate";
+        case MessageType::PlayerSpawn: return "PlayerSpawn";
+        case MessageType::PlayerPositionUpdate: return "PlayerPositionUpdate";
+        case MessageType::PlayerRemove: return "PlayerRemove";
+        case MessageType::InventorySync: return "InventorySync";
+        case MessageType::ServerCapabilities: return "ServerCapabilities";
+        case MessageType::MoveRateHint: return "MoveRateHint";
+        case MessageType::ChunkColumnData: return "ChunkColumnData";
+        case MessageType::BlockUpdateBatch: return "BlockUpdateBatch";
+        case MessageType::Disconnect: return "Disconnect";
+        case MessageType::KeepAlive: return "KeepAlive";
+    }
+    return "Unknown";
+}
+
+uint64_t NetworkStats::timestampMicros() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace engine
@@ -0,0 +1,271 @@
+#include "shared/Raycaster.hpp"
+#include "shared/BlockRegistry.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace engine {
+
+namespace {
+
+constexpr auto CHUNK_EXTENT = static_cast<int32_t>(CHUNK_SIZE);
+
+/**
+ * @brief Safely compute 1/x, returning a large value if x is near zero
+ */
+float safeDivide(float numerator, float denominator) {
+    constexpr float EPSILON = 1e-8f;
+    if (std::abs(denominator) < EPSILON) {
+        return std::numeric_limits<float>::max();
+    }
+    return numerator / denominator;
+}
+
+int32_t floorDiv(int32_t value, int32_t divisor) {
+    return (value >= 0) ? (value / divisor) : ((value - divisor + 1) / divisor);
+}
+
+/**
+ * @brief Position of a ray in chunk-local block coordinates, with its chunk cached
+ *
+ * Chunks are looked up only when a step crosses a chunk border, and the
+ * lookups are remembered in a small table indexed by the low bit of each
+ * chunk coordinate, so neighbouring chunks never evict each other. The
+ * table is kept across the rays of a batch, so rays from the same area look
+ * each chunk up once.
+ */
+class ChunkCursor {
+public:
+    explicit ChunkCursor(const Raycaster::ChunkLookup& lookup) : lookup(lookup) {}
+
+    /**
+     * @brief Place the cursor on a world block position
+     */
+    void moveTo(const glm::ivec3& voxel) {
+        glm::ivec3 pos(floorDiv(voxel.x, CHUNK_EXTENT), floorDiv(voxel.y, CHUNK_EXTENT), floorDiv(voxel.z, CHUNK_EXTENT));
+        local = voxel - (pos * CHUNK_EXTENT);
+        enterChunk(pos);
+    }
+
+    /**
+     * @brief Step one block along an axis
+     * @return true if the step crossed into another chunk
+     */
+    bool step(int axis, int direction) {
+        local[axis] += direction;
+        if (local[axis] >= 0 && local[axis] < CHUNK_EXTENT) {
+            return false;
+        }
+        local[axis] -= direction * CHUNK_EXTENT;
+        glm::ivec3 next = chunkPos;
+        next[axis] += direction;
+        enterChunk(next);
+        return true;
+    }
+
+    /**
+     * @brief Move along an axis without leaving the current chunk
+     */
+    void advance(int axis, int32_t distance) { local[axis] += distance; }
+
+    const Chunk* getChunk() const { return chunk; }
+    const glm::ivec3& getLocal() const { return local; }
+
+private:
+    struct CachedChunk {
+        glm::ivec3 pos{0};
+        const Chunk* chunk = nullptr;
+        bool valid = false;
+    };
+
+    const Raycaster::ChunkLookup& lookup;
+    std::array<CachedChunk, 8> cached{};
+    glm::ivec3 chunkPos{0};
+    glm::ivec3 local{0};
+    const Chunk* chunk = nullptr;
+
+    void enterChunk(const glm::ivec3& pos) {
+        chunkPos = pos;
+        CachedChunk& slot = cached[(pos.x & 1) | ((pos.y & 1) << 1) | ((pos.z & 1) << 2)];
+        if (!slot.valid || slot.pos != pos) {
+            slot.pos = pos;
+            slot.chunk = lookup(ChunkCoord{pos.x, pos.y, pos.z});
+            slot.valid = true;
+        }
+        chunk = slot.chunk;
+    }
+};
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity,cppcoreguidelines-pro-type-union-access)
+std::optional<RaycastHit> castWithCursor(const Ray& ray, ChunkCursor& cursor) {
+    const glm::vec3& origin = ray.origin;
+
+    // Normalize direction
+    glm::vec3 dir = glm::normalize(ray.direction);
+
+    // Current voxel position (floor of ray origin)
+    glm::ivec3 voxel(
+        static_cast<int>(std::floor(origin.x)),
+        static_cast<int>(std::floor(origin.y)),
+        static_cast<int>(std::floor(origin.z))
+    );
+    cursor.moveTo(voxel);
+
+    // Step direction, tDelta (distance along ray to traverse one voxel) and
+    // tMax (distance along ray to the next voxel boundary) for each axis
+    glm::ivec3 step(0);
+    glm::vec3 tDelta;
+    glm::vec3 tMax;
+    for (int axis = 0; axis < 3; axis++) {
+        tDelta[axis] = std::abs(safeDivide(1.0f, dir[axis]));
+        if (dir[axis] > 0) {
+            step[axis] = 1;
+            tMax[axis] = (static_cast<float>(voxel[axis] + 1) - origin[axis]) / dir[axis];
+        } else if (dir[axis] < 0) {
+            step[axis] = -1;
+            tMax[axis] = (static_cast<float>(voxel[axis]) - origin[axis]) / dir[axis];
+        } else {
+            tMax[axis] = std::numeric_limits<float>::max();
+        }
+    }
+
+    // Track which face we hit
+    glm::ivec3 normal(0, 0, 0);
+    float distance = 0.0f;
+
+    // DDA traversal
+    while (distance < ray.maxDistance) {
+        // Size of the aligned cube around the current voxel known to hold no
+        // solid block (1 = the voxel itself was read)
+        int32_t skipSize = CHUNK_EXTENT;
+        const Chunk* chunk = cursor.getChunk();
+        const glm::ivec3& local = cursor.getLocal();
+        if (chunk != nullptr && !chunk->isEmpty()) {
+            auto localX = static_cast<uint32_t>(local.x);
+            auto localY = static_cast<uint32_t>(local.y);
+            auto localZ = static_cast<uint32_t>(local.z);
+            uint32_t brickIndex = Chunk::getBrickIndexAt(localX, localY, localZ);
+            BrickState state = chunk->getBrickState(brickIndex);
+            skipSize = static_cast<int32_t>(BRICK_SIZE);
+            if (state != BrickState::Empty) {
+                BlockType blockType = chunk->getBlockData()[Chunk::getIndex(localX, localY, localZ)].type;
+                if (BlockRegistry::isSolid(blockType)) {
+                    // Hit a solid block
+                    RaycastHit hit{};
+                    hit.blockPos = voxel;
+                    hit.placePos = voxel + normal;  // Place on the face we hit
+                    hit.normal = normal;
+                    hit.hitPoint = origin + dir * distance;
+                    hit.distance = distance;
+                    hit.blockType = blockType;
+                    return hit;
+                }
+                if (state == BrickState::Dense) {
+                    skipSize = 1;
+                }
+            }
+        }
+
+        if (skipSize == 1) {
+            // Step to next voxel: choose axis with smallest tMax
+            int axis = 2;
+            if (tMax.x < tMax.y) {
+                if (tMax.x < tMax.z) {
+                    axis = 0;
+                }
+            } else if (tMax.y < tMax.z) {
+                axis = 1;
+            }
+
+            voxel[axis] += step[axis];
+            distance = tMax[axis];
+            tMax[axis] += tDelta[axis];
+            normal = glm::ivec3(0);
+            normal[axis] = -step[axis];
+            cursor.step(axis, step[axis]);
+            continue;
+        }
+
+        // Leave the skippable cube in one jump: find the axis whose boundary
+        // the ray crosses out of it first, then take every step the voxel
+        // walk would have taken before that crossing
+        int exitAxis = -1;
+        float exitDistance = std::numeric_limits<float>::max();
+        glm::ivec3 stepsInside(0);
+        for (int axis = 0; axis < 3; axis++) {
+            if (step[axis] == 0) {
+                continue;
+            }
+            int32_t offset = local[axis] & (skipSize - 1);  // Cube sizes are powers of two
+            stepsInside[axis] = step[axis] > 0 ? skipSize - 1 - offset : offset;
+            float crossing = tMax[axis] + (static_cast<float>(stepsInside[axis]) * tDelta[axis]);
+            if (crossing < exitDistance) {
+                exitDistance = crossing;
+                exitAxis = axis;
+            }
+        }
+        if (exitAxis < 0 || exitDistance >= ray.maxDistance) {
+            break;
+        }
+
+        for (int axis = 0; axis < 3; axis++) {
+            if (step[axis] == 0) {
+                continue;
+            }
+            int32_t steps = stepsInside[axis];
+            if (axis != exitAxis) {
+                // Boundaries crossed before the exit, capped so rounding can't leave the cube early
+                steps = tMax[axis] >= exitDistance
+                            ? 0
+                            : std::min(steps, static_cast<int32_t>((exitDistance - tMax[axis]) * std::abs(dir[axis])) + 1);
+            }
+            voxel[axis] += steps * step[axis];
+            tMax[axis] += static_cast<float>(steps) * tDelta[axis];
+            cursor.advance(axis, steps * step[axis]);
+        }
+
+        voxel[exitAxis] += step[exitAxis];
+        distance = tMax[exitAxis];
+        tMax[exitAxis] += tDelta[exitAxis];
+        normal = glm::ivec3(0);
+        normal[exitAxis] = -step[exitAxis];
+        cursor.step(exitAxis, step[exitAxis]);
+    }
+
+    // No hit within max distance
+    return std::nullopt;
+}
+
+} // namespace
+
+std::optional<RaycastHit> Raycaster::cast(
+    const glm::vec3& origin,
+    const glm::vec3& direction,
+    float maxDistance,
+    const ChunkLookup& lookup
+) {
+    if (!lookup) {
+        return std::nullopt;
+    }
+
+    ChunkCursor cursor(lookup);
+    return castWithCursor(Ray{origin, direction, maxDistance}, cursor);
+}
+
+std::vector<std::optional<RaycastHit>> Raycaster::castMany(const std::vector<Ray>& rays, const ChunkLookup& lookup) {
+    std::vector<std::optional<RaycastHit>> hits;
+    if (!lookup) {
+        hits.resize(rays.size());
+        return hits;
+    }
+    hits.reserve(rays.size());
+
+    ChunkCursor cursor(lookup);
+    for (const Ray& ray : rays) {
+        hits.push_back(castWithCursor(ray, cursor));
+    }
+    return hits;
+}
+
+} // namespace engine